@@ -2,6 +2,14 @@
 #include "PlatoStandard.h"
 #include "AnalogueDIDs.h"
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PLATO_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define PLATO_SSE
+#endif
+
 namespace Plato {
 
     AndInputPad::AndInputPad(Container* creator, Container& parent, Identifier& identity, PropertyScopesEnum scope)
@@ -27,15 +35,116 @@ namespace Plato {
         return p;
     }
 
-    AndDID::AndDID(Container* creator, Container* parent, Identifier& elementName, PropertyScopesEnum scope) 
-        : Disposition(creator,parent,elementName,scope) {
-        // TO DO.
+#pragma region // AnalogueDID.
+    const ClassTypeInfo* AnalogueDID::TypeInfo = NULL;
+
+    void AnalogueDID::Initializer() {
+        TypeInfo = new ClassTypeInfo("AnalogueDID",400,1,NULL,Disposition::TypeInfo);
+    }
+
+    void AnalogueDID::Finalizer() {
+        delete TypeInfo;
+    }
+
+    AnalogueDID::AnalogueDID(AnalogueOperationsEnum operation, Container* creator, Container* parent, 
+        Identifier& elementName, PropertyScopesEnum scope) 
+        : Disposition(creator,parent,elementName,scope), Operation(operation) {
+        mKernel = NULL;
+        mKernelBatch = -1;
+        mKernelLane = -1;
+    }
+
+    AnalogueDID::~AnalogueDID() {
+        if (mKernel != NULL) {
+            mKernel->Detach(*this);
+        }
+    }
+
+    void AnalogueDID::GetPads(Container& container, vector<Pad*>& pads, bool isInput) {
+        vector<Property*>* properties = container.GetOrderedProperties();
+        vector<Property*>::iterator itr;
+        for (itr = properties->begin(); itr != properties->end(); ++itr) {
+            Property* p = *itr;
+            if (p->Flags.IsProxied) {
+                continue;
+            }
+            if (isInput ? p->Flags.IsInputPad : p->Flags.IsOutputPad) {
+                pads.push_back((Pad*)p);
+            } else if (p->Flags.IsContainer 
+                && ClassTypeInfo::GetInheritanceDifference(*Bundle::TypeInfo, *p->GetClassTypeInfo()) >= 0) {
+                GetPads(*(Container*)p, pads, isInput);
+            }
+        }
+    }
+
+    void AnalogueDID::GetInputPads(vector<InputPad*>& pads) {
+        vector<Pad*> tmp;
+        GetPads(*this, tmp, true);
+        vector<Pad*>::iterator itr;
+        for (itr = tmp.begin(); itr != tmp.end(); ++itr) {
+            pads.push_back((InputPad*)*itr);
+        }
+    }
+
+    void AnalogueDID::GetOutputPads(vector<OutputPad*>& pads) {
+        vector<Pad*> tmp;
+        GetPads(*this, tmp, false);
+        vector<Pad*>::iterator itr;
+        for (itr = tmp.begin(); itr != tmp.end(); ++itr) {
+            pads.push_back((OutputPad*)*itr);
+        }
     }
 
-    void AndDID::Update() {
+    float AnalogueDID::Reduce(AnalogueOperationsEnum operation, const float* values, int count) {
+        if (count <= 0) {
+            return 0.0f;
+        }
+        float result = values[0];
+        if (operation == AnalogueOperations::And) {
+            for (int index = 1; index < count; ++index) {
+                result *= values[index];
+            }
+        } else {
+            for (int index = 1; index < count; ++index) {
+                result += values[index];
+            }
+            if (result > 1.0f) {
+                result = 1.0f;
+            }
+        }
+        return result;
+    }
+
+    void AnalogueDID::Update() {
         Disposition::Update();
-        // TO DO arithmetic multiply each input.
-        // normalise etc.
+        vector<InputPad*> inputs;
+        GetInputPads(inputs);
+        vector<InputPad*>::iterator itr;
+        int count = 0;
+        for (itr = inputs.begin(); itr != inputs.end(); ++itr) {
+            count += (*itr)->GetInputCount();
+        }
+        float result = 0.0f;
+        if (count > 0) {
+            vector<float> values(count);
+            float* v = &values[0];
+            for (itr = inputs.begin(); itr != inputs.end(); ++itr) {
+                v += (*itr)->GatherInputs(v);
+            }
+            result = Reduce(Operation, &values[0], count);
+        }
+        vector<OutputPad*> outputs;
+        GetOutputPads(outputs);
+        vector<OutputPad*>::iterator oitr;
+        for (oitr = outputs.begin(); oitr != outputs.end(); ++oitr) {
+            (*oitr)->SetOutputValue(result);
+        }
+    }
+#pragma endregion
+
+#pragma region // AndDID and OrDID.
+    AndDID::AndDID(Container* creator, Container* parent, Identifier& elementName, PropertyScopesEnum scope) 
+        : AnalogueDID(AnalogueOperations::And,creator,parent,elementName,scope) {
     }
 
     bool AndDID::AddBundle(Identifier& name, bool isInput) {
@@ -43,13 +152,284 @@ namespace Plato {
     }
 
     OrDID::OrDID(Container* creator, Container* parent, Identifier& elementName, PropertyScopesEnum scope) 
-        : Disposition(creator,parent,elementName,scope) {
-        // TO DO.
+        : AnalogueDID(AnalogueOperations::Or,creator,parent,elementName,scope) {
     }
+#pragma endregion
 
-    void OrDID::Update() {
-        Disposition::Update();
-        // TO DO sum over inputs.
-        // normalise etc.
+#pragma region // AnalogueKernel.
+    /// <summary>
+    /// Combines a row of input values into the accumulated values of a chunk of lanes.
+    /// </summary>
+    static void CombineLanes(AnalogueOperationsEnum operation, float* acc, const float* values, int count) {
+        int index = 0;
+        if (operation == AnalogueOperations::And) {
+#if defined(PLATO_AVX)
+            for (; index + 8 <= count; index += 8) {
+                _mm256_storeu_ps(acc + index, _mm256_mul_ps(_mm256_loadu_ps(acc + index), _mm256_loadu_ps(values + index)));
+            }
+#elif defined(PLATO_SSE)
+            for (; index + 4 <= count; index += 4) {
+                _mm_storeu_ps(acc + index, _mm_mul_ps(_mm_loadu_ps(acc + index), _mm_loadu_ps(values + index)));
+            }
+#endif
+            for (; index < count; ++index) {
+                acc[index] *= values[index];
+            }
+        } else {
+#if defined(PLATO_AVX)
+            for (; index + 8 <= count; index += 8) {
+                _mm256_storeu_ps(acc + index, _mm256_add_ps(_mm256_loadu_ps(acc + index), _mm256_loadu_ps(values + index)));
+            }
+#elif defined(PLATO_SSE)
+            for (; index + 4 <= count; index += 4) {
+                _mm_storeu_ps(acc + index, _mm_add_ps(_mm_loadu_ps(acc + index), _mm_loadu_ps(values + index)));
+            }
+#endif
+            for (; index < count; ++index) {
+                acc[index] += values[index];
+            }
+        }
+    }
+
+    /// <summary>
+    /// Limits the accumulated values of a chunk of lanes to at most one.
+    /// </summary>
+    static void SaturateLanes(float* acc, int count) {
+        int index = 0;
+#if defined(PLATO_AVX)
+        __m256 ones = _mm256_set1_ps(1.0f);
+        for (; index + 8 <= count; index += 8) {
+            _mm256_storeu_ps(acc + index, _mm256_min_ps(_mm256_loadu_ps(acc + index), ones));
+        }
+#elif defined(PLATO_SSE)
+        __m128 ones = _mm_set1_ps(1.0f);
+        for (; index + 4 <= count; index += 4) {
+            _mm_storeu_ps(acc + index, _mm_min_ps(_mm_loadu_ps(acc + index), ones));
+        }
+#endif
+        for (; index < count; ++index) {
+            if (acc[index] > 1.0f) {
+                acc[index] = 1.0f;
+            }
+        }
+    }
+
+    /// <summary>
+    /// A pool task that evaluates a chunk of a batch.
+    /// </summary>
+    class AnalogueKernelTask : public ThreadPool::Task {
+    public:
+        AnalogueKernelTask(AnalogueKernel& kernel, int batch, int first, int last)
+            : mKernel(kernel), mBatch(batch), mFirst(first), mLast(last) {
+        }
+        virtual void Execute() {
+            mKernel.Evaluate(mBatch, mFirst, mLast);
+        }
+    private:
+        AnalogueKernel& mKernel;
+        int mBatch;
+        int mFirst;
+        int mLast;
+    };
+
+    AnalogueKernel::AnalogueKernel(Model& model) 
+        : Container(*Container::PropertyTypes, NULL, &model, Identifier::Generate("AnalogueKernel"), PropertyScopes::Private) {
+        mCount = 0;
+    }
+
+    AnalogueKernel::~AnalogueKernel() {
+        vector<Batch*>::iterator itr;
+        for (itr = mBatches.begin(); itr != mBatches.end(); ++itr) {
+            vector<AnalogueDID*>::iterator ditr;
+            for (ditr = (*itr)->DIDs.begin(); ditr != (*itr)->DIDs.end(); ++ditr) {
+                AnalogueDID* did = *ditr;
+                if (did != NULL) {
+                    did->mKernel = NULL;
+                    did->mKernelBatch = -1;
+                    did->mKernelLane = -1;
+                    did->DoEmulate = true;
+                }
+            }
+            delete *itr;
+        }
+    }
+
+    AnalogueKernel* AnalogueKernel::Compile(Model& model) {
+        AnalogueKernel* kernel = new AnalogueKernel(model);
+        hash_map<size_t,int> batchIds;
+        kernel->Compile(model, batchIds);
+        if (kernel->mCount == 0) {
+            delete kernel;
+            return NULL;
+        }
+        // The inputs were appended lane by lane, transpose them so each input row is contiguous.
+        vector<Batch*>::iterator itr;
+        for (itr = kernel->mBatches.begin(); itr != kernel->mBatches.end(); ++itr) {
+            Batch* b = *itr;
+            int count = b->Count();
+            vector<int> inputs(b->Inputs.size());
+            for (int lane = 0; lane < count; ++lane) {
+                for (int k = 0; k < b->Arity; ++k) {
+                    inputs[k * count + lane] = b->Inputs[lane * b->Arity + k];
+                }
+            }
+            b->Inputs.swap(inputs);
+        }
+        model.Add(*kernel);
+        string& tmp = kernel->StatusReport();
+        Trace::WriteLine(2, "AnalogueKernel.Compile: %s", tmp.c_str());
+        delete &tmp;
+        return kernel;
+    }
+
+    void AnalogueKernel::Compile(Container& container, hash_map<size_t,int>& batchIds) {
+        vector<Property*>::iterator itr;
+        vector<Property*>* properties = container.GetOrderedProperties();
+        for (itr = properties->begin(); itr != properties->end(); ++itr) {
+            Property* p = *itr;
+            if (!p->Flags.IsContainer || p->Flags.IsProxied || p->Flags.IsFilter || p->Flags.IsGroupContainer) {
+                continue;
+            }
+            Compile(*(Container*)p, batchIds);
+            if (ClassTypeInfo::GetInheritanceDifference(*AnalogueDID::TypeInfo, *p->GetClassTypeInfo()) < 0) {
+                continue;
+            }
+            AnalogueDID* did = (AnalogueDID*)p;
+            if (!did->DoEmulate || did->mKernel != NULL) {
+                continue;
+            }
+            vector<InputPad*> inputs;
+            did->GetInputPads(inputs);
+            vector<InputPad*>::iterator iitr;
+            int arity = 0;
+            for (iitr = inputs.begin(); iitr != inputs.end(); ++iitr) {
+                arity += (*iitr)->GetInputCount();
+            }
+            // A DID without inputs has a constant output, so leave it to Model::Update.
+            if (arity == 0) {
+                continue;
+            }
+            size_t key = ((size_t)arity << 1) | (size_t)did->Operation;
+            hash_map<size_t,int>::iterator hitr = batchIds.find(key);
+            Batch* b;
+            int batch;
+            if (hitr == batchIds.end()) {
+                batch = (int)mBatches.size();
+                batchIds[key] = batch;
+                b = new Batch();
+                b->Operation = did->Operation;
+                b->Arity = arity;
+                b->OutputOffsets.push_back(0);
+                mBatches.push_back(b);
+            } else {
+                batch = hitr->second;
+                b = mBatches[batch];
+            }
+            size_t first = b->Inputs.size();
+            b->Inputs.resize(first + arity);
+            int* signals = &b->Inputs[first];
+            for (iitr = inputs.begin(); iitr != inputs.end(); ++iitr) {
+                signals += (*iitr)->GetInputSignals(signals);
+            }
+            vector<OutputPad*> outputs;
+            did->GetOutputPads(outputs);
+            vector<OutputPad*>::iterator oitr;
+            for (oitr = outputs.begin(); oitr != outputs.end(); ++oitr) {
+                b->Outputs.push_back((*oitr)->SignalIndex);
+            }
+            b->OutputOffsets.push_back((int)b->Outputs.size());
+            did->mKernel = this;
+            did->mKernelBatch = batch;
+            did->mKernelLane = b->Count();
+            did->DoEmulate = false;
+            b->DIDs.push_back(did);
+            ++mCount;
+        }
+    }
+
+    void AnalogueKernel::Detach(AnalogueDID& did) {
+        mBatches[did.mKernelBatch]->DIDs[did.mKernelLane] = NULL;
+        --mCount;
+    }
+
+    void AnalogueKernel::Update() {
+        ThreadPool* pool = ContainerModel->UpdateThreadPool;
+        ThreadPool::TaskGroup group;
+        int batchCount = (int)mBatches.size();
+        for (int batch = 0; batch < batchCount; ++batch) {
+            int count = mBatches[batch]->Count();
+            for (int first = 0; first < count; first += ChunkSize) {
+                int last = first + ChunkSize < count ? first + ChunkSize : count;
+                if (pool == NULL) {
+                    Evaluate(batch, first, last);
+                } else {
+                    pool->Submit(*new AnalogueKernelTask(*this, batch, first, last), group);
+                }
+            }
+        }
+        if (pool != NULL) {
+            int failures = pool->Wait(group);
+            if (failures > 0) {
+                Error::Log(false, *ContainerModel->ModelErrorContext, *GetClassTypeInfo(), "Update", 1, 
+                    "Exception in %d analogue kernel tasks.", failures);
+            }
+        }
+    }
+
+    void AnalogueKernel::Evaluate(int batch, int first, int last) {
+        Batch* b = mBatches[batch];
+        SignalArena* arena = ContainerModel->ModelSignals;
+        const float* signals = arena->Current;
+        float* next = arena->Next;
+        float acc[ChunkSize];
+        float values[ChunkSize];
+        int count = b->Count();
+        const int* row = &b->Inputs[0] + first;
+        const int* offsets = &b->OutputOffsets[0];
+        const int* outputs = b->Outputs.empty() ? NULL : &b->Outputs[0];
+        for (int chunk = first; chunk < last; chunk += ChunkSize) {
+            int lanes = last - chunk < ChunkSize ? last - chunk : ChunkSize;
+            const int* input = row + (chunk - first);
+            for (int lane = 0; lane < lanes; ++lane) {
+                acc[lane] = signals[input[lane]];
+            }
+            for (int k = 1; k < b->Arity; ++k) {
+                input += count;
+                for (int lane = 0; lane < lanes; ++lane) {
+                    values[lane] = signals[input[lane]];
+                }
+                CombineLanes(b->Operation, acc, values, lanes);
+            }
+            if (b->Operation == AnalogueOperations::Or) {
+                SaturateLanes(acc, lanes);
+            }
+            for (int lane = 0; lane < lanes; ++lane) {
+                if (b->DIDs[chunk + lane] == NULL) {
+                    continue;
+                }
+                float value = acc[lane];
+                for (int index = offsets[chunk + lane]; index < offsets[chunk + lane + 1]; ++index) {
+                    next[outputs[index]] = value;
+                }
+            }
+        }
+    }
+
+    string& AnalogueKernel::StatusReport() const {
+        string& result = *new string("AnalogueKernel(DIDs=");
+        string& dids = Numbers::ToString(mCount);
+        string& batches = Numbers::ToString((int)mBatches.size());
+#if defined(PLATO_AVX)
+        const char* lanes = "AVX";
+#elif defined(PLATO_SSE)
+        const char* lanes = "SSE";
+#else
+        const char* lanes = "Scalar";
+#endif
+        result += dids + ",Batches=" + batches + ",Lanes=" + lanes + ")";
+        delete &batches;
+        delete &dids;
+        return result;
     }
+#pragma endregion
 }
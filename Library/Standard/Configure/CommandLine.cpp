@@ -63,9 +63,13 @@ namespace Plato {
                         isOption = true;
                         key = new string(s.substr(0, index));
                         ++index;
-                        val = (index<(int)s.size()) ? new string(s.substr(index + 1)) : new string("");
+                        val = (index<(int)s.size()) ? new string(s.substr(index)) : new string("");
                     } else {
                         key = new string(s);
+                        // A bare option, such as --FreezeConnections, switches the option on.
+                        if (isOption) {
+                            val = new string("true");
+                        }
                     }
                     isArg |= !isOption;
                     if (isArg) {
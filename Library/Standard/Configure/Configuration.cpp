@@ -3,6 +3,7 @@
 #include "Numbers.h"
 #include "Trace.h"
 #include "CommandLine.h"
+#include "Mutex.h"
 #include "Configuration.h"
 
 namespace Plato {
@@ -44,10 +45,22 @@ namespace Plato {
         return (isString ? (void*)&(Numbers::ToString(*((bool*)varAdrs))) : varAdrs);
     }
 
+    const void* VariableAccessor::FloatAccessor(const void* varAdrs,const void* valuePtr,bool isSetting,bool isString) {
+        if(isSetting) {
+            *((float*)varAdrs) = isString ? Numbers::ToFloat(*((string*)valuePtr)) : *((float*)valuePtr);
+            return NULL;
+        }
+        return (isString ? (void*)&(Numbers::ToString(*((float*)varAdrs))) : varAdrs);
+    }
+
 
     const void* VariableAccessor::StringAccessor(const void* varAdrs,const void* valuePtr,bool isSetting,bool isString) {
         if(isSetting) {
-            *((string*)varAdrs) =  *((string*)valuePtr);
+            // String options are held by pointer, see Strings::CheckValue.
+            const string** var = (const string**)varAdrs;
+            const string* value = new string(*((const string*)valuePtr));
+            delete *var;
+            *var = value;
             return NULL;
         }
         return varAdrs;
@@ -70,15 +83,28 @@ namespace Plato {
         "Plato library options:\n"
         "--acknowledgements\t\tDisplay copyright and contribution information.\n"
         "--ArchivePath=FilePath\t\tLocal path to file containing previously archived application state.\n"
-        "--BinarySerialize[=true|false]\tIndicates to serialise in binary rather than xml.\n"
+        "--BinarySerialize[=true|false]\tIndicates to serialise in binary rather than xml, default = true.\n"
         "--ConfigFile=FilePath\t\tUse this configuration file.\n"
         "--DebugLevel=Number\t\tSet to a postive integer for increasing debug information.\n"
         "--RunDiagnostics[=true|false]\tTurn diagnostic tests on or off.\n"
+        "--FreezeConnections[=true|false]\tCompile pad connections after configuring, default = false.\n"
+        "--IncrementalUpdates[=true|false]\tOnly update dispositions whose inputs changed, default = false.\n"
+        "--ChangeEpsilon=Number\t\tThe output change that triggers incremental updates, default = 0.\n"
+        "--VectoriseDIDs[=true|false]\tEvaluate the analogue DIDs in batches after configuring, default = true.\n"
+        "--UseModelArena[=true|false]\tAllocate the model's properties from one arena, default = true.\n"
+        "--MemoisePaths[=true|false]\tReuse path resolutions until the containers involved change, default = true.\n"
+        "--RandomSeed=Number\t\tThe seed of the model's random streams, default = 0.\n"
+        "--CheckpointInterval=Number\tEpochs between checkpoints to the ArchivePath, 0 = none, default = 0.\n"
+        "--CheckpointDeltas=Number\tChanged signal checkpoints between full checkpoints, default = 16.\n"
+        "--ProfileUpdates[=true|false]\tCount and time the updates of each class and each epoch, default = false.\n"
+        "--ProfilePath=FilePath\t\tWrite the profile to this file in JSON after each run.\n"
         "--EpochCount=Number\t\tThe number of epochs to run model for, default = -1, i.e. non-stop.\n"
         "--help\t\t\t\tDisplay this usage information.\n"
         "--PathPrefix=DirPath\t\tUse this as a prefix for file system paths.\n"
         "--PlatoPrefix=DirPath\t\tThe installation directory of the Plato library.\n"
         "--TraceLevel=Number\t\tSet to a postive integer for increasing trace information.\n"
+        "--UpdateThreads=Number\t\tThreads used to update the model each epoch, 0 = one per processor, default = 1.\n"
+        "--ConfigureThreads=Number\tThreads used to configure the model's elements, 0 = one per processor, default = 1.\n"
         "--version\t\t\tDisplay version information."; 
     const char* Configuration::Version = "Plato Library, version:0.1.0.0";
 
@@ -86,11 +112,14 @@ namespace Plato {
     int Configuration::TraceLevel = 0;
     string* Configuration::mFullPathPtr = NULL;
     string* Configuration::mDirectoryPtr = NULL;
+    Mutex Configuration::mPathLock;
     Configuration::HashMap* Configuration::mVariableAccessorHashMap = NULL;
 
     void Configuration::Initializer() {
         mFullPathPtr = NULL;
         mDirectoryPtr = NULL;
+        DebugLevel = 10;
+        TraceLevel = 10;
         mVariableAccessorHashMap = new HashMap();
         string* s; // This is to avoid a VS /W4:C4709 warning.
         (*mVariableAccessorHashMap)[s=new string("ArchivePath")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::ArchivePath,VariableAccessor::StringAccessor);
@@ -98,10 +127,23 @@ namespace Plato {
         (*mVariableAccessorHashMap)[s=new string("ConfigFile")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::ConfigFile,VariableAccessor::StringAccessor);
         (*mVariableAccessorHashMap)[s=new string("DebugLevel")]=new VariableAccessor((const void*)&Configuration::DebugLevel,VariableAccessor::IntAccessor);
         (*mVariableAccessorHashMap)[s=new string("RunDiagnostics")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::RunDiagnostics,VariableAccessor::BoolAccessor);
+        (*mVariableAccessorHashMap)[s=new string("FreezeConnections")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::FreezeConnections,VariableAccessor::BoolAccessor);
+        (*mVariableAccessorHashMap)[s=new string("IncrementalUpdates")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::IncrementalUpdates,VariableAccessor::BoolAccessor);
+        (*mVariableAccessorHashMap)[s=new string("ChangeEpsilon")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::ChangeEpsilon,VariableAccessor::FloatAccessor);
+        (*mVariableAccessorHashMap)[s=new string("VectoriseDIDs")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::VectoriseDIDs,VariableAccessor::BoolAccessor);
+        (*mVariableAccessorHashMap)[s=new string("UseModelArena")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::UseModelArena,VariableAccessor::BoolAccessor);
+        (*mVariableAccessorHashMap)[s=new string("MemoisePaths")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::MemoisePaths,VariableAccessor::BoolAccessor);
+        (*mVariableAccessorHashMap)[s=new string("RandomSeed")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::RandomSeed,VariableAccessor::IntAccessor);
+        (*mVariableAccessorHashMap)[s=new string("CheckpointInterval")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::CheckpointInterval,VariableAccessor::LongAccessor);
+        (*mVariableAccessorHashMap)[s=new string("CheckpointDeltas")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::CheckpointDeltas,VariableAccessor::IntAccessor);
+        (*mVariableAccessorHashMap)[s=new string("ProfileUpdates")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::ProfileUpdates,VariableAccessor::BoolAccessor);
+        (*mVariableAccessorHashMap)[s=new string("ProfilePath")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::ProfilePath,VariableAccessor::StringAccessor);
         (*mVariableAccessorHashMap)[s=new string("EpochCount")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::EpochCount,VariableAccessor::LongAccessor);
         (*mVariableAccessorHashMap)[s=new string("PathPrefix")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::PathPrefix,VariableAccessor::StringAccessor);
         (*mVariableAccessorHashMap)[s=new string("PlatoPrefix")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::PlatoPrefix,VariableAccessor::StringAccessor);
         (*mVariableAccessorHashMap)[s=new string("TraceLevel")]=new VariableAccessor((const void*)&Configuration::TraceLevel,VariableAccessor::IntAccessor);
+        (*mVariableAccessorHashMap)[s=new string("UpdateThreads")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::UpdateThreads,VariableAccessor::IntAccessor);
+        (*mVariableAccessorHashMap)[s=new string("ConfigureThreads")]=new VariableAccessor((VariableAccessor::VariablePtr)&Configuration::ConfigureThreads,VariableAccessor::IntAccessor);
     }
 
     void Configuration::Finalizer() {
@@ -119,11 +161,22 @@ namespace Plato {
     }
 
     Configuration::Configuration(const string& modelName, char* arguments[]) {
-        DebugLevel = 0;
-        TraceLevel = 0;
         BinarySerialize = false;
         RunDiagnostics = false;
         EpochCount = 0;
+        UpdateThreads = 1;
+        ConfigureThreads = 1;
+        FreezeConnections = false;
+        IncrementalUpdates = false;
+        ChangeEpsilon = 0.0f;
+        VectoriseDIDs = true;
+        UseModelArena = true;
+        MemoisePaths = true;
+        RandomSeed = 0;
+        CheckpointInterval = 0;
+        CheckpointDeltas = 16;
+        ProfileUpdates = false;
+        ProfilePath = NULL;
         ArchivePath = NULL;
         ConfigFile = NULL;
         PathPrefix = NULL;
@@ -168,6 +221,7 @@ namespace Plato {
 
     Configuration::~Configuration() {
         delete ArchivePath;
+        delete ProfilePath;
         delete ConfigFile;
         delete PathPrefix;
         delete PlatoPrefix;
@@ -176,14 +230,28 @@ namespace Plato {
 
     void Configuration::CheckOptionValues(bool reset) {
         Strings::CheckValue(ArchivePath, "", reset);
-        Numbers::CheckValue(BinarySerialize, false, true, false, reset);
+        Numbers::CheckValue(BinarySerialize, false, true, true, reset);
         Strings::CheckValue(ConfigFile, "Plato.config", reset);
-        Numbers::CheckValue(DebugLevel, 0, 10, 10, reset);
+        // The levels are shared by every model, so only the library initializer resets them.
+        Numbers::CheckValue(DebugLevel, 0, 10, 10, false);
         Numbers::CheckValue(RunDiagnostics, false, true, true, reset);
         Numbers::CheckValue(EpochCount, 0, LONG_MAX, -1, reset);
+        Numbers::CheckValue(FreezeConnections, false, true, false, reset);
+        Numbers::CheckValue(IncrementalUpdates, false, true, false, reset);
+        Numbers::CheckValue(ChangeEpsilon, 0.0f, FLT_MAX, 0.0f, reset);
+        Numbers::CheckValue(VectoriseDIDs, false, true, true, reset);
+        Numbers::CheckValue(UseModelArena, false, true, true, reset);
+        Numbers::CheckValue(MemoisePaths, false, true, true, reset);
+        Numbers::CheckValue(RandomSeed, 0, INT_MAX, 0, reset);
+        Numbers::CheckValue(CheckpointInterval, 0, LONG_MAX, 0, reset);
+        Numbers::CheckValue(CheckpointDeltas, 0, INT_MAX, 16, reset);
+        Numbers::CheckValue(ProfileUpdates, false, true, false, reset);
+        Strings::CheckValue(ProfilePath, "", reset);
         Strings::CheckValue(PathPrefix, "$(PlatoPrefix)Plato", reset);
         Strings::CheckValue(PlatoPrefix, GetExecutableDirectory(), reset);
-        Numbers::CheckValue(TraceLevel, 0, 10, 10, reset);
+        Numbers::CheckValue(TraceLevel, 0, 10, 10, false);
+        Numbers::CheckValue(UpdateThreads, 0, 256, 1, reset);
+        Numbers::CheckValue(ConfigureThreads, 0, 256, 1, reset);
     }
 
     const void* Configuration::GetProperty(const string& name,bool isString) const {
@@ -215,6 +283,7 @@ namespace Plato {
     }
 
     const string& Configuration::GetExecutableFullPath() {
+        MutexLock lock(mPathLock);
         if (mFullPathPtr == NULL) {
             mFullPathPtr = &(GetExecutablePath());
         }
@@ -222,8 +291,10 @@ namespace Plato {
     }
 
     const string& Configuration::GetExecutableDirectory() {
+        const string& fullPath = GetExecutableFullPath();
+        MutexLock lock(mPathLock);
         if (mDirectoryPtr == NULL) {
-            string* path = &GetDirectoryPath(GetExecutableFullPath());
+            string* path = &GetDirectoryPath(fullPath);
             // DEBUG: kludge for when developing: MS regularly cleans Debug dir.
             if (Strings::EndsWith(*path,"debug")) {
                 string* tmp = path;
@@ -1,6 +1,9 @@
 #include "PlatoIncludes.h"
 #include "Strings.h"
 #include "Configuration.h"
+#include "ThreadLocalVariable.h"
+#include "Mutex.h"
+#include "LogWriter.h"
 #include "Debug.h"
 
 namespace Plato {
@@ -41,9 +44,8 @@ namespace Plato {
         if (Configuration::DebugLevel >= level) {
             va_list argPtr;
             va_start(argPtr, format);
-            char* messagePtr = Strings::Sprintf(format,argPtr);
-            cerr << messagePtr << "\n";
-            delete [] messagePtr;
+            LogWriter::Write(format,argPtr);
+            va_end(argPtr);
         }
     }
 }
@@ -6,6 +6,19 @@
 #include "RegexesTest.h"
 #include "ContainerTest.h"
 #include "PathTest.h"
+#include "FlatHashMapTest.h"
+#include "ThreadPoolTest.h"
+#include "ConnectionGraphTest.h"
+#include "AnalogueKernelTest.h"
+#include "ChangeTrackerTest.h"
+#include "ModelArenaTest.h"
+#include "SymbolTest.h"
+#include "ModelTest.h"
+#include "ProximityRelatorTest.h"
+#include "DistributionTest.h"
+#include "RandomStreamTest.h"
+#include "LogWriterTest.h"
+#include "ProfilerTest.h"
 
 namespace Plato {
 
@@ -17,6 +30,19 @@ namespace Plato {
         DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("ArchiverTest",ArchiverTest::ConductUnitTest));
         DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("ContainerTest",ContainerTest::ConductUnitTest));
         DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("PathTest",PathTest::ConductUnitTest));
+        DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("FlatHashMapTest",FlatHashMapTest::ConductUnitTest));
+        DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("ThreadPoolTest",ThreadPoolTest::ConductUnitTest));
+        DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("ConnectionGraphTest",ConnectionGraphTest::ConductUnitTest));
+        DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("AnalogueKernelTest",AnalogueKernelTest::ConductUnitTest));
+        DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("ChangeTrackerTest",ChangeTrackerTest::ConductUnitTest));
+        DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("ModelArenaTest",ModelArenaTest::ConductUnitTest));
+        DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("SymbolTest",SymbolTest::ConductUnitTest));
+        DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("ModelTest",ModelTest::ConductUnitTest));
+        DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("ProximityRelatorTest",ProximityRelatorTest::ConductUnitTest));
+        DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("DistributionTest",DistributionTest::ConductUnitTest));
+        DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("RandomStreamTest",RandomStreamTest::ConductUnitTest));
+        DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("LogWriterTest",LogWriterTest::ConductUnitTest));
+        DiagnosticsCatalogueTable->push_back(new DiagnosticsCatalogueEntry("ProfilerTest",ProfilerTest::ConductUnitTest));
     }
 
     void DiagnosticsCatalogue::Finalizer() {
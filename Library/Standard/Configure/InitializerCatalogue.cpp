@@ -1,6 +1,7 @@
 #include "PlatoIncludes.h"
 // This pulls in all the library headers.
 #include "PlatoStandard.h"
+#include "PlatoComponents.h"
 
 #define AddInitializer(className) InitializerCatalogueTable->push_back(new InitializerCatalogueEntry(className::Initializer,className::Finalizer))
 
@@ -18,14 +19,19 @@ namespace Plato {
         InitializerCatalogueTable = new vector<InitializerCatalogueEntry*>();
 
 #pragma region // Class initializer details should be added to the table here in dependency order.
+        // Converter, Transducer and Region refer to the TypeInfo of classes initialized after them,
+        // which is still NULL then. Those classes' finalizers reset their TypeInfo to NULL,
+        // so that the library is initialized the same way again after the last model is deleted.
         // General
         AddInitializer(Strings); 
+        AddInitializer(LogWriter); 
         AddInitializer(Regexes); 
         // Configure
         AddInitializer(ClassCatalogue); 
         AddInitializer(Configuration); 
         AddInitializer(DiagnosticsCatalogue); 
         // Primitives
+        AddInitializer(Symbol); 
         AddInitializer(Point); 
         AddInitializer(Property); 
         AddInitializer(Container); 
@@ -90,6 +96,8 @@ namespace Plato {
         AddInitializer(Flow); 
         AddInitializer(Region); 
         AddInitializer(Phenomenon);
+        // Components
+        AddInitializer(AnalogueDID);
 #pragma endregion
 
         // Now call the class initializers.
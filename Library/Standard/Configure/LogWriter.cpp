@@ -0,0 +1,602 @@
+#include "PlatoIncludes.h"
+#include "ThreadLocalVariable.h"
+#include "Mutex.h"
+#include "LogWriter.h"
+
+namespace Plato {
+
+    /// <summary>
+    /// The types of argument a format can refer to, as passed through "...".
+    /// </summary>
+    enum LogArgumentType {
+        NoLogArgument, IntLogArgument, LongLogArgument, Int64LogArgument, SizeLogArgument,
+        DoubleLogArgument, LongDoubleLogArgument, StringLogArgument, PointerLogArgument
+    };
+
+    /// <summary>
+    /// A conversion specification in a format: the text from '%' to the conversion character.
+    /// </summary>
+    struct LogFormatSpec {
+        const char* Start;
+        const char* End;
+        /// <summary>
+        /// The number of '*' width and precision arguments before the value.
+        /// </summary>
+        int Stars;
+        LogArgumentType Type;
+    };
+
+    /// <summary>
+    /// A message waiting in a ring: its format and the arguments it refers to, each 8 byte aligned.
+    /// </summary>
+    struct LogRecord {
+        long Sequence;
+        const char* Format;
+        /// <summary>
+        /// The number of arguments captured, which is less than the format refers to if they did not fit.
+        /// </summary>
+        int Count;
+        bool IsTruncated;
+        static const int ArgumentSize = LogWriter::RecordSize - 32;
+        union {
+            double Alignment;
+            char Arguments[ArgumentSize];
+        };
+    };
+
+    struct LogWriter::Ring {
+        /// <summary>
+        /// The number of records added, written only by the ring's thread.
+        /// </summary>
+        Atomic::Value Head;
+        char HeadPadding[64 - sizeof(Atomic::Value)];
+        /// <summary>
+        /// The number of records written out, written only by the writer thread.
+        /// </summary>
+        Atomic::Value Tail;
+        char TailPadding[64 - sizeof(Atomic::Value)];
+        /// <summary>
+        /// Set when the ring's thread has released it, after its last record.
+        /// </summary>
+        volatile bool IsReleased;
+        LogRecord Records[RingSize];
+    };
+
+    ThreadLocalVariable::Key LogWriter::mRingKey;
+    vector<LogWriter::Ring*>* LogWriter::mRings = NULL;
+    Mutex* LogWriter::mRingsLock = NULL;
+    Atomic::Value LogWriter::mUserCount = 0;
+    Atomic::Value LogWriter::mSequence = 0;
+    Atomic::Value LogWriter::mDropCount = 0;
+    volatile bool LogWriter::mIsRunning = false;
+    volatile bool LogWriter::mIsStopping = false;
+    LogWriter::ThreadHandle LogWriter::mThread;
+    // The drop count last reported by the writer thread.
+    static long ReportedDropCount = 0;
+
+    static void SleepBriefly() {
+#ifdef WIN32
+        Sleep(1);
+#else
+        usleep(1000);
+#endif
+    }
+
+    static int FormatArguments(char* buffer, int size, const char* format, va_list arguments) {
+#ifdef WIN32
+        int length = _vsnprintf_s(buffer, size, _TRUNCATE, format, arguments);
+#else
+        int length = vsnprintf(buffer, size, format, arguments);
+#endif
+        // Both report truncation differently: as -1, or as the length that was needed.
+        if (length < 0 || length >= size) {
+            length = size - 1;
+            buffer[length] = '\0';
+        }
+        return length;
+    }
+
+    static int FormatValues(char* buffer, int size, const char* format, ...) {
+        va_list arguments;
+        va_start(arguments, format);
+        int length = FormatArguments(buffer, size, format, arguments);
+        va_end(arguments);
+        return length;
+    }
+
+    template <class T> static int FormatValue(char* buffer, int size, const char* spec, int stars, const int* star, T value) {
+        if (stars == 0) {
+            return FormatValues(buffer, size, spec, value);
+        } else if (stars == 1) {
+            return FormatValues(buffer, size, spec, star[0], value);
+        }
+        return FormatValues(buffer, size, spec, star[0], star[1], value);
+    }
+
+    // Finds the next conversion from format on, advancing format past it.
+    // Returns false when there are none left. "%%" and unknown conversions have no argument.
+    static bool NextSpec(const char*& format, LogFormatSpec& spec) {
+        const char* p = strchr(format, '%');
+        if (p == NULL) {
+            return false;
+        }
+        spec.Start = p++;
+        spec.Stars = 0;
+        while (*p != '\0' && strchr("-+ #0'", *p) != NULL) {
+            ++p;
+        }
+        if (*p == '*') {
+            ++spec.Stars;
+            ++p;
+        }
+        while (isdigit((unsigned char)*p)) {
+            ++p;
+        }
+        if (*p == '.') {
+            ++p;
+            if (*p == '*') {
+                ++spec.Stars;
+                ++p;
+            }
+            while (isdigit((unsigned char)*p)) {
+                ++p;
+            }
+        }
+        int longs = 0;
+        char size = '\0';
+        for (;; ++p) {
+            if (*p == 'l') {
+                ++longs;
+            } else if (*p == 'z' || *p == 't' || *p == 'j' || *p == 'q' || *p == 'L') {
+                size = *p;
+            } else if (p[0] == 'I' && p[1] == '6' && p[2] == '4') {
+                size = 'j';
+                p += 2;
+            } else if (*p != 'h') {
+                break;
+            }
+        }
+        char conversion = *p;
+        if (conversion != '\0') {
+            ++p;
+        }
+        spec.End = p;
+        switch (conversion) {
+            case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+                spec.Type = longs >= 2 || size == 'j' || size == 'q' ? Int64LogArgument
+                    : size == 'z' || size == 't' ? SizeLogArgument : longs == 1 ? LongLogArgument : IntLogArgument;
+                break;
+            case 'c':
+                spec.Type = IntLogArgument;
+                break;
+            case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+                spec.Type = size == 'L' ? LongDoubleLogArgument : DoubleLogArgument;
+                break;
+            case 's':
+                spec.Type = longs == 0 ? StringLogArgument : PointerLogArgument;
+                break;
+            case 'p': case 'n':
+                spec.Type = PointerLogArgument;
+                break;
+            default:
+                spec.Type = NoLogArgument;
+                break;
+        }
+        format = p;
+        return true;
+    }
+
+    // Appends a value to a record's arguments, or returns false if it does not fit.
+    static bool PutArgument(LogRecord& record, int& offset, const void* value, int size) {
+        offset = (offset + 7) & ~7;
+        if (offset + size > LogRecord::ArgumentSize) {
+            return false;
+        }
+        memcpy(record.Arguments + offset, value, size);
+        offset += size;
+        ++record.Count;
+        return true;
+    }
+
+    // Copies the arguments a format refers to into a record.
+    static void CaptureArguments(LogRecord& record, const char* format, va_list arguments) {
+        record.Count = 0;
+        record.IsTruncated = false;
+        int offset = 0;
+        LogFormatSpec spec;
+        bool fits = true;
+        while (fits && NextSpec(format, spec)) {
+            for (int star = 0; fits && star < spec.Stars; ++star) {
+                int value = va_arg(arguments, int);
+                fits = PutArgument(record, offset, &value, sizeof(value));
+            }
+            if (!fits) {
+                break;
+            }
+            switch (spec.Type) {
+                case IntLogArgument: {
+                    int value = va_arg(arguments, int);
+                    fits = PutArgument(record, offset, &value, sizeof(value));
+                    break;
+                }
+                case LongLogArgument: {
+                    long value = va_arg(arguments, long);
+                    fits = PutArgument(record, offset, &value, sizeof(value));
+                    break;
+                }
+                case Int64LogArgument: {
+                    int64_t value = va_arg(arguments, int64_t);
+                    fits = PutArgument(record, offset, &value, sizeof(value));
+                    break;
+                }
+                case SizeLogArgument: {
+                    size_t value = va_arg(arguments, size_t);
+                    fits = PutArgument(record, offset, &value, sizeof(value));
+                    break;
+                }
+                case DoubleLogArgument: {
+                    double value = va_arg(arguments, double);
+                    fits = PutArgument(record, offset, &value, sizeof(value));
+                    break;
+                }
+                case LongDoubleLogArgument: {
+                    long double value = va_arg(arguments, long double);
+                    fits = PutArgument(record, offset, &value, sizeof(value));
+                    break;
+                }
+                case PointerLogArgument: {
+                    void* value = va_arg(arguments, void*);
+                    fits = PutArgument(record, offset, &value, sizeof(value));
+                    break;
+                }
+                case StringLogArgument: {
+                    // The characters themselves, since the string may be gone by the time it is formatted.
+                    const char* value = va_arg(arguments, const char*);
+                    if (value == NULL) {
+                        value = "(null)";
+                    }
+                    offset = (offset + 7) & ~7;
+                    int room = LogRecord::ArgumentSize - offset - 1;
+                    int length = (int)strlen(value);
+                    if (room <= 0) {
+                        fits = false;
+                        break;
+                    }
+                    if (length > room) {
+                        length = room;
+                        record.IsTruncated = true;
+                    }
+                    memcpy(record.Arguments + offset, value, length);
+                    record.Arguments[offset + length] = '\0';
+                    offset += length + 1;
+                    ++record.Count;
+                    fits = !record.IsTruncated;
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+        record.IsTruncated = record.IsTruncated || !fits;
+    }
+
+    // Appends text to a message, returning the new length.
+    static int AppendText(char* buffer, int size, int length, const char* text, int count) {
+        if (count > size - 1 - length) {
+            count = size - 1 - length;
+        }
+        memcpy(buffer + length, text, count);
+        length += count;
+        buffer[length] = '\0';
+        return length;
+    }
+
+    // Formats a record's message from its captured arguments.
+    static int FormatRecord(const LogRecord& record, char* buffer, int size) {
+        int length = 0;
+        buffer[0] = '\0';
+        const char* format = record.Format;
+        const char* text = format;
+        int offset = 0;
+        int used = 0;
+        LogFormatSpec spec;
+        while (NextSpec(format, spec)) {
+            length = AppendText(buffer, size, length, text, (int)(spec.Start - text));
+            text = spec.End;
+            if (spec.Type == NoLogArgument) {
+                if (spec.End > spec.Start && spec.End[-1] == '%') {
+                    length = AppendText(buffer, size, length, "%", 1);
+                }
+                continue;
+            }
+            if (used + spec.Stars + 1 > record.Count) {
+                length = AppendText(buffer, size, length, "...", 3);
+                return length;
+            }
+            int star[2] = { 0, 0 };
+            for (int index = 0; index < spec.Stars; ++index) {
+                offset = (offset + 7) & ~7;
+                memcpy(&star[index], record.Arguments + offset, sizeof(int));
+                offset += sizeof(int);
+            }
+            used += spec.Stars + 1;
+            offset = (offset + 7) & ~7;
+            const char* value = record.Arguments + offset;
+            char specText[32];
+            int specLength = (int)(spec.End - spec.Start);
+            if (specLength >= (int)sizeof(specText)) {
+                specLength = 0;
+            }
+            memcpy(specText, spec.Start, specLength);
+            specText[specLength] = '\0';
+            char* out = buffer + length;
+            int room = size - length;
+            switch (spec.Type) {
+                case IntLogArgument:
+                    length += FormatValue(out, room, specText, spec.Stars, star, *(const int*)value);
+                    offset += sizeof(int);
+                    break;
+                case LongLogArgument:
+                    length += FormatValue(out, room, specText, spec.Stars, star, *(const long*)value);
+                    offset += sizeof(long);
+                    break;
+                case Int64LogArgument:
+                    length += FormatValue(out, room, specText, spec.Stars, star, *(const int64_t*)value);
+                    offset += sizeof(int64_t);
+                    break;
+                case SizeLogArgument:
+                    length += FormatValue(out, room, specText, spec.Stars, star, *(const size_t*)value);
+                    offset += sizeof(size_t);
+                    break;
+                case DoubleLogArgument:
+                    length += FormatValue(out, room, specText, spec.Stars, star, *(const double*)value);
+                    offset += sizeof(double);
+                    break;
+                case LongDoubleLogArgument:
+                    length += FormatValue(out, room, specText, spec.Stars, star, *(const long double*)value);
+                    offset += sizeof(long double);
+                    break;
+                case StringLogArgument:
+                    length += FormatValue(out, room, specText, spec.Stars, star, value);
+                    offset += (int)strlen(value) + 1;
+                    break;
+                case PointerLogArgument:
+                    // %n must not write through a pointer that may be gone, and %ls is not captured.
+                    if (specText[specLength - 1] == 'p') {
+                        length += FormatValue(out, room, specText, spec.Stars, star, *(void* const*)value);
+                    }
+                    offset += sizeof(void*);
+                    break;
+                default:
+                    break;
+            }
+        }
+        if (record.IsTruncated) {
+            return AppendText(buffer, size, length, "...", 3);
+        }
+        return AppendText(buffer, size, length, text, (int)strlen(text));
+    }
+
+    static bool CompareSequence(const LogRecord* a, const LogRecord* b) {
+        return a->Sequence < b->Sequence;
+    }
+
+#pragma region // Methods.
+    void LogWriter::Write(const char* format, va_list arguments) {
+        if (!BeginUse()) {
+            EndUse();
+            char message[MessageSize + 1];
+            Format(message, sizeof(message), format, arguments);
+            cerr << message << "\n";
+            return;
+        }
+        Ring& ring = GetRing();
+        long head = ring.Head;
+        if ((unsigned long)(head - ring.Tail) >= (unsigned long)RingSize) {
+            Atomic::Increment(&mDropCount);
+            EndUse();
+            return;
+        }
+        LogRecord& record = ring.Records[(unsigned long)head % RingSize];
+        record.Sequence = Atomic::Increment(&mSequence);
+        record.Format = format;
+        CaptureArguments(record, format, arguments);
+        // Publishes the record to the writer thread.
+        Atomic::Increment(&ring.Head);
+        EndUse();
+    }
+
+    void LogWriter::Flush() {
+        if (!BeginUse()) {
+            EndUse();
+            return;
+        }
+        while (mIsRunning) {
+            bool isEmpty = true;
+            mRingsLock->Lock();
+            vector<Ring*>::iterator itr;
+            for (itr = mRings->begin(); itr != mRings->end(); ++itr) {
+                if ((*itr)->Head != (*itr)->Tail) {
+                    isEmpty = false;
+                    break;
+                }
+            }
+            mRingsLock->Unlock();
+            if (isEmpty) {
+                break;
+            }
+            SleepBriefly();
+        }
+        EndUse();
+    }
+
+    int LogWriter::GetRingCount() {
+        int count = 0;
+        if (BeginUse()) {
+            MutexLock lock(*mRingsLock);
+            count = (int)mRings->size();
+        }
+        EndUse();
+        return count;
+    }
+
+    void LogWriter::ReleaseRing() {
+        if (BeginUse()) {
+            Ring* ring = (Ring*)ThreadLocalVariable::GetVariableValue(mRingKey);
+            if (ring != NULL) {
+                ThreadLocalVariable::SetVariableValue(mRingKey, NULL);
+                ring->IsReleased = true;
+            }
+        }
+        EndUse();
+    }
+
+    int LogWriter::Format(char* buffer, int size, const char* format, va_list arguments) {
+        return FormatArguments(buffer, size, format, arguments);
+    }
+
+    void LogWriter::Initializer() {
+        if (mIsRunning) {
+            return;
+        }
+        mRingKey = ThreadLocalVariable::GetKey();
+        mRings = new vector<Ring*>();
+        mRingsLock = new Mutex();
+        mUserCount = 0;
+        mSequence = 0;
+        mDropCount = 0;
+        ReportedDropCount = 0;
+        mIsStopping = false;
+        mIsRunning = true;
+#ifdef WIN32
+        mThread = CreateThread(NULL, 0, WriterStart, NULL, 0, NULL);
+#else
+        pthread_create(&mThread, NULL, WriterStart, NULL);
+#endif
+    }
+
+    void LogWriter::Finalizer() {
+        if (!mIsRunning) {
+            return;
+        }
+        // Later messages are written directly. Those being added now are waited for,
+        // so that the writer writes them and no thread is left using a ring that is freed.
+        mIsRunning = false;
+        while (Atomic::Add(&mUserCount, 0) != 0) {
+            Atomic::YieldThread();
+        }
+        mIsStopping = true;
+#ifdef WIN32
+        WaitForSingleObject(mThread, INFINITE);
+        CloseHandle(mThread);
+#else
+        pthread_join(mThread, NULL);
+#endif
+        vector<Ring*>::iterator itr;
+        for (itr = mRings->begin(); itr != mRings->end(); ++itr) {
+            delete *itr;
+        }
+        delete mRings;
+        mRings = NULL;
+        delete mRingsLock;
+        mRingsLock = NULL;
+        ThreadLocalVariable::FreeKey(mRingKey);
+    }
+
+    LogWriter::Ring& LogWriter::GetRing() {
+        Ring* ring = (Ring*)ThreadLocalVariable::GetVariableValue(mRingKey);
+        if (ring == NULL) {
+            ring = new Ring();
+            ring->Head = 0;
+            ring->Tail = 0;
+            ring->IsReleased = false;
+            MutexLock lock(*mRingsLock);
+            mRings->push_back(ring);
+            ThreadLocalVariable::SetVariableValue(mRingKey, (ThreadLocalVariable::ValuePtr)ring);
+        }
+        return *ring;
+    }
+
+    bool LogWriter::BeginUse() {
+        // The count is raised before the flag is read, and Finalizer clears the flag before
+        // reading the count, so either Finalizer waits for this thread or this thread sees it stopped.
+        Atomic::Increment(&mUserCount);
+        return mIsRunning;
+    }
+
+    int LogWriter::Drain() {
+        // A ring is released after its last record is published, so once it is written out it is done with.
+        mRingsLock->Lock();
+        for (size_t index = 0; index < mRings->size(); ) {
+            Ring* ring = (*mRings)[index];
+            if (ring->IsReleased && Atomic::Add(&ring->Head, 0) == ring->Tail) {
+                (*mRings)[index] = mRings->back();
+                mRings->pop_back();
+                delete ring;
+            } else {
+                ++index;
+            }
+        }
+        vector<Ring*> rings(*mRings);
+        mRingsLock->Unlock();
+
+        // Take what each ring holds now, and write it in the order it was added across the threads.
+        vector<long> heads(rings.size());
+        vector<const LogRecord*> records;
+        for (size_t index = 0; index < rings.size(); ++index) {
+            Ring& ring = *rings[index];
+            heads[index] = Atomic::Add(&ring.Head, 0);
+            for (long position = ring.Tail; position != heads[index]; ++position) {
+                records.push_back(&ring.Records[(unsigned long)position % RingSize]);
+            }
+        }
+        long dropCount = mDropCount;
+        if (records.empty() && dropCount == ReportedDropCount) {
+            return 0;
+        }
+        sort(records.begin(), records.end(), CompareSequence);
+
+        string output;
+        char message[MessageSize + 1];
+        vector<const LogRecord*>::iterator itr;
+        for (itr = records.begin(); itr != records.end(); ++itr) {
+            output.append(message, FormatRecord(**itr, message, sizeof(message)));
+            output += '\n';
+        }
+        if (dropCount != ReportedDropCount) {
+            FormatValues(message, sizeof(message), "LogWriter: %ld messages dropped.\n", dropCount - ReportedDropCount);
+            output += message;
+            ReportedDropCount = dropCount;
+        }
+        cerr.write(output.data(), (streamsize)output.size());
+        cerr.flush();
+
+        // Only now hand the records back to their threads.
+        for (size_t index = 0; index < rings.size(); ++index) {
+            Atomic::Add(&rings[index]->Tail, heads[index] - rings[index]->Tail);
+        }
+        return (int)records.size();
+    }
+
+    void LogWriter::WriterLoop() {
+        while (!mIsStopping) {
+            if (Drain() == 0) {
+                SleepBriefly();
+            }
+        }
+        Drain();
+    }
+
+#ifdef WIN32
+    DWORD WINAPI LogWriter::WriterStart(LPVOID) {
+        WriterLoop();
+        return 0;
+    }
+#else
+    void* LogWriter::WriterStart(void*) {
+        WriterLoop();
+        return NULL;
+    }
+#endif
+#pragma endregion
+}
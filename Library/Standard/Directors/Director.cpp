@@ -11,20 +11,20 @@
 
 namespace Plato {
 
-    const string* Director::InputName = NULL;
-    const string* Director::OutputName = NULL;
-    const string* Director::DefaultName = NULL;
-    const string* Director::InputDirectorName = NULL;
-    const string* Director::OutputDirectorName = NULL;
-    const string* Director::DefaultDirectorName = NULL;
+    const Identifier* Director::InputName = NULL;
+    const Identifier* Director::OutputName = NULL;
+    const Identifier* Director::DefaultName = NULL;
+    const Identifier* Director::InputDirectorName = NULL;
+    const Identifier* Director::OutputDirectorName = NULL;
+    const Identifier* Director::DefaultDirectorName = NULL;
 
     void Director::Initializer() {
-        InputName = new string("input");
-        OutputName = new string("output");
-        DefaultName = new string("default");
-        InputDirectorName = new string("InputDirector");
-        OutputDirectorName = new string("OutputDirector");
-        DefaultDirectorName = new string("DefaultDirector");
+        InputName = new Identifier("input");
+        OutputName = new Identifier("output");
+        DefaultName = new Identifier("default");
+        InputDirectorName = new Identifier("InputDirector");
+        OutputDirectorName = new Identifier("OutputDirector");
+        DefaultDirectorName = new Identifier("DefaultDirector");
     }
 
     void Director::Finalizer() {
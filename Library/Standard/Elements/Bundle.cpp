@@ -9,6 +9,8 @@
 #include "ConfigurePhases.h"
 #include "ResolutionModes.h"
 #include "Container.h"
+#include "Mutex.h"
+#include "SignalArena.h"
 #include "Pad.h"
 #include "InputPad.h"
 #include "OutputPad.h"
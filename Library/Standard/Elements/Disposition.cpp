@@ -9,11 +9,16 @@
 #include "ConfigurePhases.h"
 #include "ResolutionModes.h"
 #include "Container.h"
+#include "ThreadLocalVariable.h"
+#include "Model.h"
+#include "Mutex.h"
+#include "SignalArena.h"
 #include "Pad.h"
 #include "InputPad.h"
 #include "OutputPad.h"
 #include "Bundle.h"
 #include "Disposition.h"
+#include "ConnectionGraph.h"
 
 namespace Plato {
 
@@ -30,15 +35,25 @@ namespace Plato {
     void Disposition::Finalizer() {
         delete TypeInfo;
         delete PropertyTypes;
+        TypeInfo = NULL;
+        PropertyTypes = NULL;
     }
 
     Disposition::Disposition(Container* creator, Container* parent, Identifier& elementName, PropertyScopesEnum scope) 
         : Container(*PropertyTypes, creator, parent, elementName, scope) {
+        Flags.ClassKind = ClassKinds::Disposition;
         IsSuperposed = false;
         IsInputSafe = true;
+        GraphIndex = -1;
     }
 
     Disposition::~Disposition() {
+        if (GraphIndex >= 0) {
+            ConnectionGraph* graph = ContainerModel->ModelConnections;
+            if (graph != NULL) {
+                graph->Dispositions[GraphIndex] = NULL;
+            }
+        }
     }
 
     void Disposition::Update() {
@@ -9,6 +9,8 @@
 #include "ConfigurePhases.h"
 #include "ResolutionModes.h"
 #include "Container.h"
+#include "Mutex.h"
+#include "SignalArena.h"
 #include "Pad.h"
 #include "InputPad.h"
 #include "OutputPad.h"
@@ -43,6 +45,8 @@ namespace Plato {
     void Flow::Finalizer() {
         delete TypeInfo;
         delete PropertyTypes;
+        TypeInfo = NULL;
+        PropertyTypes = NULL;
     }
 
     Flow::Flow(Container* creator, Container* parent, Identifier& elementName, PropertyScopesEnum scope) 
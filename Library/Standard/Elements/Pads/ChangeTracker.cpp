@@ -0,0 +1,70 @@
+#include "PlatoIncludes.h"
+#include "Strings.h"
+#include "ClassTypeInfo.h"
+#include "Identifier.h"
+#include "IdentifierRegex.h"
+#include "PropertyScopes.h"
+#include "PropertyModes.h"
+#include "ConfigurePhases.h"
+#include "Property.h"
+#include "Container.h"
+#include "Mutex.h"
+#include "SignalArena.h"
+#include "ConnectionGraph.h"
+#include "ChangeTracker.h"
+
+namespace Plato {
+
+    ChangeTracker::ChangeTracker(SignalArena& signals, const ConnectionGraph& graph, float epsilon)
+        : mSignals(signals), mGraph(graph) {
+        Epsilon = epsilon;
+        mDirtyCount = 0;
+        mDirty.assign(mGraph.DispositionCount(), 0);
+        mNextDirty.assign(mGraph.DispositionCount(), 0);
+        mPublished.assign(mSignals.Current, mSignals.Current + mSignals.Count());
+        MarkAll();
+    }
+
+    void ChangeTracker::MarkAll() {
+        if (!mNextDirty.empty()) {
+            memset(&mNextDirty[0], 1, mNextDirty.size());
+        }
+    }
+
+    void ChangeTracker::BeginEpoch() {
+        Publish();
+        mDirty.swap(mNextDirty);
+        if (!mNextDirty.empty()) {
+            memset(&mNextDirty[0], 0, mNextDirty.size());
+        }
+        mDirtyCount = 0;
+        vector<unsigned char>::const_iterator itr;
+        for (itr = mDirty.begin(); itr != mDirty.end(); ++itr) {
+            mDirtyCount += *itr;
+        }
+        memcpy(mSignals.Next, mSignals.Current, mSignals.Count() * sizeof(float));
+    }
+
+    void ChangeTracker::Publish() {
+        int count = mSignals.Count();
+        if ((int)mPublished.size() < count) {
+            mPublished.resize(count, 0.0f);
+        }
+        const float* current = mSignals.Current;
+        float* published = &mPublished[0];
+        for (int slot = 0; slot < count; ++slot) {
+            float delta = current[slot] - published[slot];
+            if (delta <= Epsilon && delta >= -Epsilon) {
+                continue;
+            }
+            published[slot] = current[slot];
+            int dependents = mGraph.DependentCount(slot);
+            if (dependents > 0) {
+                const int* d = mGraph.DependentsOf(slot);
+                for (int index = 0; index < dependents; ++index) {
+                    mNextDirty[d[index]] = 1;
+                }
+            }
+        }
+    }
+}
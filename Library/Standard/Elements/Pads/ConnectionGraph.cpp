@@ -0,0 +1,173 @@
+#include "PlatoIncludes.h"
+#include "Strings.h"
+#include "Numbers.h"
+#include "ClassTypeInfo.h"
+#include "Identifier.h"
+#include "IdentifierRegex.h"
+#include "PropertyScopes.h"
+#include "PropertyModes.h"
+#include "ConfigurePhases.h"
+#include "Property.h"
+#include "Container.h"
+#include "Mutex.h"
+#include "SignalArena.h"
+#include "Pad.h"
+#include "InputPad.h"
+#include "OutputPad.h"
+#include "ConnectionGraph.h"
+#include "Disposition.h"
+
+namespace Plato {
+
+    ConnectionGraph::ConnectionGraph(Container& root) {
+        hash_map<size_t,int> connectorIds;
+        vector<int> edgeOwners;
+        Offsets.push_back(0);
+        Compile(root, connectorIds, NULL, edgeOwners);
+        CompileDependents(edgeOwners);
+    }
+
+    ConnectionGraph::~ConnectionGraph() {
+        vector<InputPad*>::iterator itr;
+        for (itr = Pads.begin(); itr != Pads.end(); ++itr) {
+            if (*itr != NULL) {
+                (*itr)->GraphIndex = -1;
+            }
+        }
+        vector<Disposition*>::iterator ditr;
+        for (ditr = Dispositions.begin(); ditr != Dispositions.end(); ++ditr) {
+            if (*ditr != NULL) {
+                (*ditr)->GraphIndex = -1;
+            }
+        }
+    }
+
+    void ConnectionGraph::Compile(Container& container, hash_map<size_t,int>& connectorIds, 
+            Disposition* owner, vector<int>& edgeOwners) {
+        vector<Property*>::iterator itr;
+        vector<Property*>* properties = container.GetOrderedProperties();
+        for (itr = properties->begin(); itr != properties->end(); ++itr) {
+            Property* p = *itr;
+            // Proxies and filters refer to properties owned elsewhere in the tree.
+            if (p->Flags.IsProxied || p->Flags.IsFilter || p->Flags.IsGroupContainer) {
+                continue;
+            }
+            if (p->Flags.IsContainer) {
+                Disposition* childOwner = owner;
+                if (p->Flags.ClassKind == ClassKinds::Disposition) {
+                    Disposition* d = (Disposition*)p;
+                    childOwner = d->IsInputSafe ? d : NULL;
+                }
+                Compile(*(Container*)p, connectorIds, childOwner, edgeOwners);
+            } else if (p->Flags.IsInputPad) {
+                InputPad* pad = (InputPad*)p;
+                int index = pad->GraphIndex;
+                if (index >= 0 && index < (int)Pads.size() && Pads[index] == pad) {
+                    continue;
+                }
+                pad->GraphIndex = (int)Pads.size();
+                Pads.push_back(pad);
+                int ownerIndex = -1;
+                if (owner != NULL && !pad->InputConnections->empty()) {
+                    ownerIndex = owner->GraphIndex;
+                    if (ownerIndex < 0 || ownerIndex >= (int)Dispositions.size() || Dispositions[ownerIndex] != owner) {
+                        ownerIndex = (int)Dispositions.size();
+                        owner->GraphIndex = ownerIndex;
+                        Dispositions.push_back(owner);
+                    }
+                }
+                vector<InputConnection*>::iterator citr;
+                for (citr = pad->InputConnections->begin(); citr != pad->InputConnections->end(); ++citr) {
+                    InputConnection* c = *citr;
+                    SourceSignals.push_back(c->SourceOutputPad->SignalIndex);
+                    size_t key = (size_t)c->OriginatingConnector;
+                    hash_map<size_t,int>::iterator hitr = connectorIds.find(key);
+                    int id;
+                    if (hitr == connectorIds.end()) {
+                        id = (int)Connectors.size();
+                        connectorIds[key] = id;
+                        Connectors.push_back(c->OriginatingConnector);
+                    } else {
+                        id = hitr->second;
+                    }
+                    ConnectorIds.push_back(id);
+                    edgeOwners.push_back(ownerIndex);
+                }
+                Offsets.push_back((int)SourceSignals.size());
+            }
+        }
+    }
+
+    void ConnectionGraph::CompileDependents(const vector<int>& edgeOwners) {
+        // Counting sort of the edges by source slot, keeping one entry per slot and Disposition.
+        int slotCount = 0;
+        vector<int>::const_iterator itr;
+        for (itr = SourceSignals.begin(); itr != SourceSignals.end(); ++itr) {
+            if (*itr >= slotCount) {
+                slotCount = *itr + 1;
+            }
+        }
+        DependentOffsets.assign(slotCount + 1, 0);
+        int edgeCount = EdgeCount();
+        for (int edge = 0; edge < edgeCount; ++edge) {
+            if (edgeOwners[edge] >= 0) {
+                ++DependentOffsets[SourceSignals[edge] + 1];
+            }
+        }
+        for (int slot = 0; slot < slotCount; ++slot) {
+            DependentOffsets[slot + 1] += DependentOffsets[slot];
+        }
+        Dependents.assign(DependentOffsets[slotCount], -1);
+        vector<int> fill(DependentOffsets.begin(), DependentOffsets.end() - 1);
+        for (int edge = 0; edge < edgeCount; ++edge) {
+            int owner = edgeOwners[edge];
+            if (owner < 0) {
+                continue;
+            }
+            int slot = SourceSignals[edge];
+            // Skip a Disposition reading the same slot through consecutive edges.
+            if (fill[slot] > DependentOffsets[slot] && Dependents[fill[slot] - 1] == owner) {
+                continue;
+            }
+            Dependents[fill[slot]++] = owner;
+        }
+        // Close up the gaps left by repeats.
+        int next = 0;
+        for (int slot = 0; slot < slotCount; ++slot) {
+            int first = DependentOffsets[slot];
+            DependentOffsets[slot] = next;
+            for (int index = first; index < fill[slot]; ++index) {
+                Dependents[next++] = Dependents[index];
+            }
+        }
+        DependentOffsets[slotCount] = next;
+        Dependents.resize(next);
+    }
+
+    int ConnectionGraph::Gather(int pad, const float* signals, float* values) const {
+        int first = Offsets[pad];
+        int last = Offsets[pad+1];
+        if (first == last) {
+            return 0;
+        }
+        const int* sources = &SourceSignals[0];
+        for (int index = first; index < last; ++index) {
+            *values++ = signals[sources[index]];
+        }
+        return last - first;
+    }
+
+    string& ConnectionGraph::StatusReport() const {
+        string& result = *new string("ConnectionGraph(Pads=");
+        string& pads = Numbers::ToString(PadCount());
+        string& edges = Numbers::ToString(EdgeCount());
+        string& connectors = Numbers::ToString((int)Connectors.size());
+        string& dispositions = Numbers::ToString(DispositionCount());
+        result += pads + ",Edges=" + edges + ",Connectors=" + connectors + ",Dispositions=" + dispositions + ")";
+        delete &dispositions;
+        delete &connectors;
+        delete &edges;
+        delete &pads;
+        return result;
+    }
+}
@@ -9,10 +9,15 @@
 #include "Property.h"
 #include "Container.h"
 #include "ResolutionModes.h"
+#include "ThreadLocalVariable.h"
+#include "Model.h"
+#include "Mutex.h"
+#include "SignalArena.h"
 #include "Pad.h"
 #include "InputPad.h"
 #include "OutputPad.h"
 #include "Connector.h"
+#include "ConnectionGraph.h"
 
 namespace Plato {
 
@@ -37,10 +42,17 @@ namespace Plato {
     InputPad::InputPad(Container* creator, Container& parent, Identifier& identity, PropertyScopesEnum scope) 
             : Pad(creator,parent,identity,scope) {
         InputConnections = new vector<InputConnection*>();
+        GraphIndex = -1;
         Flags.IsInputPad = true;
     }
 
     InputPad::~InputPad() {
+        if (GraphIndex >= 0) {
+            ConnectionGraph* graph = Model::Current().ModelConnections;
+            if (graph != NULL) {
+                graph->Pads[GraphIndex] = NULL;
+            }
+        }
         vector<InputConnection*>::iterator itr;
         for(itr=InputConnections->begin();itr!=InputConnections->end();++itr) {
             delete *itr;
@@ -49,7 +61,49 @@ namespace Plato {
     }
 
     bool InputPad::Add(OutputPad& outputPad, Connector& connector) {
+        // Once the graph is the only copy of the pad's wiring, a new connection would never be read.
+        if (GraphIndex >= 0 && Model::Current().IsConnectionsReleased()) {
+            return false;
+        }
+        // Connectors configuring other elements may be adding to the same pad.
+        ConfigureLock lock(Model::Current());
         InputConnections->push_back(new InputConnection(outputPad,connector));
         return true;
     }
+
+    int InputPad::GetInputCount() const {
+        if (GraphIndex >= 0) {
+            return Model::Current().ModelConnections->InputCount(GraphIndex);
+        }
+        return (int)InputConnections->size();
+    }
+
+    int InputPad::GatherInputs(float* values) const {
+        if (GraphIndex >= 0) {
+            Model& model = Model::Current();
+            return model.ModelConnections->Gather(GraphIndex, model.ModelSignals->Current, values);
+        }
+        vector<InputConnection*>::const_iterator itr;
+        for(itr=InputConnections->begin();itr!=InputConnections->end();++itr) {
+            *values++ = (*itr)->SourceOutputPad->GetOutputValue();
+        }
+        return (int)InputConnections->size();
+    }
+
+    int InputPad::GetInputSignals(int* signals) const {
+        if (GraphIndex >= 0) {
+            ConnectionGraph* graph = Model::Current().ModelConnections;
+            int count = graph->InputCount(GraphIndex);
+            const int* sources = graph->Sources(GraphIndex);
+            for (int index = 0; index < count; ++index) {
+                *signals++ = sources[index];
+            }
+            return count;
+        }
+        vector<InputConnection*>::const_iterator itr;
+        for(itr=InputConnections->begin();itr!=InputConnections->end();++itr) {
+            *signals++ = (*itr)->SourceOutputPad->SignalIndex;
+        }
+        return (int)InputConnections->size();
+    }
 }
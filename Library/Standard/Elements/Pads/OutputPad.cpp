@@ -9,6 +9,10 @@
 #include "Property.h"
 #include "Container.h"
 #include "ResolutionModes.h"
+#include "ThreadLocalVariable.h"
+#include "Model.h"
+#include "Mutex.h"
+#include "SignalArena.h"
 #include "Pad.h"
 #include "OutputPad.h"
 
@@ -16,8 +20,6 @@ namespace Plato {
 
     const ClassTypeInfo* OutputPad::TypeInfo = NULL;
 
-    int OutputPad::CurrentBuffer = 0;
-
     void OutputPad::Initializer() {
         TypeInfo = new ClassTypeInfo("OutputPad",301,1,NULL,Pad::TypeInfo);
     }
@@ -29,18 +31,25 @@ namespace Plato {
     OutputPad::OutputPad(Container* creator, Container& parent, Identifier& identity, PropertyScopesEnum scope) 
             : Pad(creator,parent,identity,scope) {
         Flags.IsOutputPad = true;
+        Signals = Model::Current().ModelSignals;
+        SignalIndex = Signals->Allocate();
     }
 
     OutputPad::OutputPad(Container& parent, Identifier& identity, PropertyScopesEnum scope) 
             : Pad(&parent,parent,identity,scope) {
         Flags.IsOutputPad = true;
+        Signals = Model::Current().ModelSignals;
+        SignalIndex = Signals->Allocate();
     }
 
     OutputPad::OutputPad(Container& parent, const char* identity, PropertyScopesEnum scope) 
             : Pad(&parent,parent,*new Identifier(identity),scope) {
         Flags.IsOutputPad = true;
+        Signals = Model::Current().ModelSignals;
+        SignalIndex = Signals->Allocate();
     }
 
     OutputPad::~OutputPad() {
+        Signals->Release(SignalIndex);
     }
 }
@@ -0,0 +1,81 @@
+#include "PlatoIncludes.h"
+#include "Mutex.h"
+#include "SignalArena.h"
+
+namespace Plato {
+
+    SignalArena::SignalArena(int initialCapacity) {
+        mCount = 0;
+        mCapacity = 0;
+        mCurrentBlock = NULL;
+        mNextBlock = NULL;
+        Current = NULL;
+        Next = NULL;
+        Reserve(initialCapacity < BlockSize ? BlockSize : initialCapacity);
+    }
+
+    SignalArena::~SignalArena() {
+        delete[] mCurrentBlock;
+        delete[] mNextBlock;
+    }
+
+    float* SignalArena::AllocateAligned(int capacity, char*& block) {
+        block = new char[capacity * sizeof(float) + Alignment];
+        size_t offset = (size_t)block & (Alignment - 1);
+        float* result = (float*)(block + (offset == 0 ? 0 : Alignment - offset));
+        memset(result, 0, capacity * sizeof(float));
+        return result;
+    }
+
+    void SignalArena::Reserve(int capacity) {
+        if (capacity <= mCapacity) {
+            return;
+        }
+        // Round up to whole blocks so kernels can process full lanes.
+        capacity = (capacity + BlockSize - 1) & ~(BlockSize - 1);
+        char* currentBlock;
+        char* nextBlock;
+        float* current = AllocateAligned(capacity, currentBlock);
+        float* next = AllocateAligned(capacity, nextBlock);
+        if (mCount > 0) {
+            memcpy(current, Current, mCount * sizeof(float));
+            memcpy(next, Next, mCount * sizeof(float));
+        }
+        delete[] mCurrentBlock;
+        delete[] mNextBlock;
+        mCurrentBlock = currentBlock;
+        mNextBlock = nextBlock;
+        Current = current;
+        Next = next;
+        mCapacity = capacity;
+    }
+
+    int SignalArena::Allocate() {
+        MutexLock lock(mLock);
+        int slot;
+        if (!mFreeSlots.empty()) {
+            slot = mFreeSlots.back();
+            mFreeSlots.pop_back();
+        } else {
+            if (mCount >= mCapacity) {
+                Reserve(mCapacity * 2);
+            }
+            slot = mCount++;
+        }
+        Current[slot] = 0.0f;
+        Next[slot] = 0.0f;
+        return slot;
+    }
+
+    void SignalArena::Release(int slot) {
+        MutexLock lock(mLock);
+        if (slot < 0 || slot >= mCount) {
+            return;
+        }
+        if (slot == mCount - 1) {
+            --mCount;
+        } else {
+            mFreeSlots.push_back(slot);
+        }
+    }
+}
@@ -11,6 +11,8 @@
 #include "Container.h"
 #include "ThreadLocalVariable.h"
 #include "Model.h"
+#include "Mutex.h"
+#include "SignalArena.h"
 #include "Pad.h"
 #include "InputPad.h"
 #include "OutputPad.h"
@@ -46,6 +48,8 @@ namespace Plato {
     void Phenomenon::Finalizer() {
         delete TypeInfo;
         delete PropertyTypes;
+        TypeInfo = NULL;
+        PropertyTypes = NULL;
     }
 
     Phenomenon::Phenomenon(Container* creator, Container* parent, Identifier& elementName, PropertyScopesEnum scope) 
@@ -11,6 +11,8 @@
 #include "Container.h"
 #include "ThreadLocalVariable.h"
 #include "Model.h"
+#include "Mutex.h"
+#include "SignalArena.h"
 #include "Pad.h"
 #include "InputPad.h"
 #include "OutputPad.h"
@@ -45,6 +47,8 @@ namespace Plato {
     void Region::Finalizer() {
         delete TypeInfo;
         delete PropertyTypes;
+        TypeInfo = NULL;
+        PropertyTypes = NULL;
     }
 
     Region::Region(Container* creator, Container* parent, Identifier& elementName, PropertyScopesEnum scope) 
@@ -9,6 +9,7 @@
 #include "Container.h"
 #include "Arguments.h"
 #include "Filter.h"
+#include "ScopeEnumerator.h"
 
 namespace Plato {
 
@@ -62,4 +63,18 @@ namespace Plato {
             Arguments->Source = filter;
         }
     }
+
+    static bool IsAddedBefore(const Property* a, const Property* b) {
+        return a->Order < b->Order;
+    }
+
+    void Filter::AddFound(vector<Property*>& found) {
+        sort(found.begin(), found.end(), IsAddedBefore);
+        vector<Property*>::iterator itr;
+        for (itr = found.begin(); itr != found.end(); ++itr) {
+            if (ScopeEnumerator::IsInScope(**itr, Arguments->Requester)) {
+                Add(**itr);
+            }
+        }
+    }
 }
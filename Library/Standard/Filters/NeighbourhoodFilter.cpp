@@ -12,6 +12,8 @@
 #include "Arguments.h"
 #include "Filter.h"
 #include "NeighbourhoodFilter.h"
+#include "Point.h"
+#include "SpatialIndex.h"
 
 namespace Plato {
 
@@ -52,6 +54,45 @@ namespace Plato {
 
     void NeighbourhoodFilter::RefreshContents() {
         Flags.Refresh = false;
+        Clear(false);
+        const Property* requester = Arguments->Requester;
+        if (requester == NULL || requester->Identity->Position == NULL) {
+            return;
+        }
+        Container* source = Arguments->Source;
+        source->AccessContents();
+        const SpatialIndex* index = source->GetSpatialIndex();
+        if (index == NULL) {
+            return;
+        }
+        NeighbourhoodFilterArguments* nfa = (NeighbourhoodFilterArguments*)(Arguments->AdditionalArguments);
+        const Point& centre = *requester->Identity->Position;
+        vector<Property*> found;
+        if (nfa->IsLayers) {
+            // Layer n holds the lattice points n unit steps away along any coordinate.
+            float reach = (float)nfa->NumberOfLayers;
+            Point lower(centre);
+            Point upper(centre);
+            for (int i = 0; i < Point::NumberOfSpatialCoordinates; ++i) {
+                lower.Coordinates[i] -= reach;
+                upper.Coordinates[i] += reach;
+            }
+            index->FindInBox(lower, upper, found);
+        } else {
+            // The container size is taken as the diagonal of the box around its positioned properties.
+            Point lower;
+            Point upper;
+            index->GetExtent(lower, upper);
+            float diagonalSquared = 0.0f;
+            for (int i = 0; i < Point::NumberOfSpatialCoordinates; ++i) {
+                float d = upper.Coordinates[i] - lower.Coordinates[i];
+                diagonalSquared += d * d;
+            }
+            index->FindInSphere(centre, nfa->PercentageDistance / 100.0f * (float)sqrt(diagonalSquared), found);
+        }
+        // A property is not its own neighbour.
+        found.erase(remove(found.begin(), found.end(), requester), found.end());
+        AddFound(found);
     }
 
     NeighbourhoodFilter* NeighbourhoodFilter::Factory(FilterArguments* arguments) {
@@ -11,10 +11,14 @@
 #include "Container.h"
 #include "Arguments.h"
 #include "Filter.h"
+#include "Point.h"
+#include "Size.h"
+#include "Bounds.h"
 #include "PointSpace.h"
 #include "PointRegex.h"
 #include "PointFilter.h"
 #include "ScopeEnumerator.h"
+#include "SpatialIndex.h"
 
 namespace Plato {
 
@@ -53,28 +57,54 @@ namespace Plato {
 
     void PointFilter::RefreshContents() {
         Flags.Refresh = false;
+        Clear(false);
         PointFilterArguments* pfa = (PointFilterArguments*)(Arguments->AdditionalArguments);
         PointRegex* regexPoint = pfa->RegexPoint;
-        ScopeEnumerator* e = new ScopeEnumerator(*(Arguments->Source),Arguments->Requester);
+        Container* source = Arguments->Source;
+        source->AccessContents();
         if(pfa->IncludeWhenMatches) {
-            while (e->MoveNext()) {
-                Property* p = e->Current;
-                if (regexPoint->Match(*p->Identity->Position)) {
-                    Add(*p);
+            // Only positioned properties can match, so only the index need be searched.
+            const SpatialIndex* index = source->GetSpatialIndex();
+            if (index == NULL) {
+                return;
+            }
+            Point lower;
+            Point upper;
+            Bounds* box = regexPoint->BoundingBox();
+            if (box != NULL) {
+                // The upper corner is the lower corner moved by the width of the box.
+                lower = *box->LowerBound;
+                for (int i = 0; i < Point::NumberOfSpatialCoordinates; ++i) {
+                    upper.Coordinates[i] = lower.Coordinates[i] + box->Width->Sizes[i];
+                }
+                upper.UpdateHashCode();
+                delete box;
+            } else if (!index->GetExtent(lower, upper)) {
+                return;
+            }
+            vector<Property*> found;
+            index->FindInBox(lower, upper, found);
+            size_t count = 0;
+            for (size_t i = 0; i < found.size(); ++i) {
+                if (regexPoint->Match(*found[i]->Identity->Position)) {
+                    found[count++] = found[i];
                 }
             }
+            found.resize(count);
+            AddFound(found);
         } else {
+            ScopeEnumerator* e = new ScopeEnumerator(*source,Arguments->Requester);
             while (e->MoveNext()) {
                 Property* p = e->Current;
-                if (!regexPoint->Match(*p->Identity->Position)) {
+                // A property without a position matches no regex point.
+                if (p->Identity->Position == NULL || !regexPoint->Match(*p->Identity->Position)) {
                    Add(*p);
                 }
             }
+            delete e;
         }
-        delete e;
     }
 
-    
     PointFilter* PointFilter::Factory(FilterArguments* arguments) {
         return new PointFilter(*arguments);
     }
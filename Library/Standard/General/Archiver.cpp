@@ -1,4 +1,5 @@
 #include "PlatoIncludes.h"
+#include "ModelSnapshot.h"
 #include "Archiver.h"
 
 namespace Plato {
@@ -7,7 +8,12 @@ namespace Plato {
         void *obj = NULL;
         if(!archivePath.empty()) {
             // Open file and deserialize the object from it.
-            // DEBUG: TO DO.
+            // Only binary snapshots exist so far, which are recognised by their header.
+            // Map the file to use it in place, and read it where it cannot be mapped.
+            obj = (void*)ModelSnapshot::Map(archivePath);
+            if (obj == NULL) {
+                obj = (void*)ModelSnapshot::Read(archivePath);
+            }
         }
         return obj;
     }
@@ -16,7 +22,10 @@ namespace Plato {
         int result = 0;
         if (!archivePath.empty() && obj != NULL) {
             // Open file and serialize the object into it.
-            // DEBUG: TO DO.
+            if (!inBinary) {
+                return 3;
+            }
+            result = ((const ModelSnapshot*)obj)->Write(archivePath);
         }
         return result;
     }
@@ -0,0 +1,392 @@
+#include "PlatoIncludes.h"
+#include "Strings.h"
+#include "ClassTypeInfo.h"
+#include "Identifier.h"
+#include "PropertyScopes.h"
+#include "PropertyModes.h"
+#include "ConfigurePhases.h"
+#include "Property.h"
+#include "Container.h"
+#include "Mutex.h"
+#include "PathMemo.h"
+#include "SignalArena.h"
+#include "Pad.h"
+#include "OutputPad.h"
+#include "ModelSnapshot.h"
+#include "Checkpointer.h"
+
+namespace Plato {
+
+    static const char DeltaMagic[8] = { 'P', 'L', 'A', 'T', 'O', 'D', 'L', 'T' };
+    static const uint32_t DeltaByteOrder = 0x01020304u;
+
+    static void GetDeltaPath(const string& path, uint32_t sequence, string& deltaPath) {
+        char suffix[16];
+        sprintf(suffix, ".%u", sequence);
+        deltaPath = path + suffix;
+    }
+
+    // Replaces a file with the one written under a temporary name.
+    static int ReplaceFile(const string& temporaryPath, const string& path) {
+#ifdef WIN32
+        remove(path.c_str());
+#endif
+        return rename(temporaryPath.c_str(), path.c_str()) == 0 ? 0 : 4;
+    }
+
+    // Appends the runs encoding a page of XORed words.
+    static void EncodePage(const uint32_t* words, int count, vector<uint32_t>& encoded) {
+        int index = 0;
+        while (index < count) {
+            int first = index;
+            while (index < count && words[index] == 0) {
+                ++index;
+            }
+            int unchanged = index - first;
+            first = index;
+            while (index < count && words[index] != 0) {
+                ++index;
+            }
+            encoded.push_back(((uint32_t)unchanged << 16) | (uint32_t)(index - first));
+            encoded.insert(encoded.end(), words + first, words + index);
+        }
+    }
+
+    // XORs the runs of an encoded page into count words.
+    // Returns the number of encoded words read, or zero if the runs do not fit.
+    static size_t DecodePage(const uint32_t* encoded, size_t size, uint32_t* words, int count) {
+        size_t read = 0;
+        int index = 0;
+        while (index < count) {
+            if (read == size) {
+                return 0;
+            }
+            uint32_t run = encoded[read++];
+            index += (int)(run >> 16);
+            int changed = (int)(run & 0xFFFF);
+            if (index + changed > count || read + changed > size) {
+                return 0;
+            }
+            for (int end = index + changed; index < end; ++index) {
+                words[index] ^= encoded[read++];
+            }
+        }
+        return read;
+    }
+
+#pragma region // Constructors.
+    Checkpointer::Checkpointer(const string& path, int deltasPerBase) : mPath(path) {
+        mDeltasPerBase = deltasPerBase;
+        mBaseEpochTime = 0;
+        mSequence = 0;
+        mGeneration = 0;
+        mNeedsBase = true;
+        mPendingBase = NULL;
+        memset(&mPendingHeader, 0, sizeof(mPendingHeader));
+        mWriteResult = 0;
+        mIsWriting = false;
+        mIsStopping = false;
+#ifdef WIN32
+        mThread = CreateThread(NULL, 0, WriterStart, (LPVOID)this, 0, NULL);
+#else
+        pthread_create(&mThread, NULL, WriterStart, (void*)this);
+#endif
+    }
+
+    Checkpointer::~Checkpointer() {
+        // The writer finishes the pending checkpoint before it exits.
+        mLock.Lock();
+        mIsStopping = true;
+        mCondition.Broadcast();
+        mLock.Unlock();
+#ifdef WIN32
+        WaitForSingleObject(mThread, INFINITE);
+        CloseHandle(mThread);
+#else
+        pthread_join(mThread, NULL);
+#endif
+        delete mPendingBase;
+    }
+#pragma endregion
+
+#pragma region // Methods.
+    int Checkpointer::Checkpoint(Container& root, const SignalArena& signals, const ConnectionGraph* graph, long epochTime) {
+        mLock.Lock();
+        bool isWriting = mIsWriting;
+        int result = isWriting ? 0 : mWriteResult;
+        if (!isWriting) {
+            mWriteResult = 0;
+        }
+        mLock.Unlock();
+        if (isWriting) {
+            return 0;
+        }
+        if (result != 0) {
+            // A lost checkpoint breaks the chain of deltas.
+            mNeedsBase = true;
+        }
+
+        bool isPending = true;
+        if (mNeedsBase || mGeneration != PathMemo::CurrentGeneration() || mSequence >= (uint32_t)mDeltasPerBase) {
+            TakeBase(root, signals, graph, epochTime);
+        } else {
+            isPending = TakeDelta(signals, epochTime);
+        }
+        if (isPending) {
+            mLock.Lock();
+            mIsWriting = true;
+            mCondition.Broadcast();
+            mLock.Unlock();
+        }
+        return result;
+    }
+
+    int Checkpointer::Flush() {
+        mLock.Lock();
+        while (mIsWriting) {
+            mCondition.Wait(mLock);
+        }
+        int result = mWriteResult;
+        mWriteResult = 0;
+        mLock.Unlock();
+        if (result != 0) {
+            mNeedsBase = true;
+        }
+        return result;
+    }
+
+    int Checkpointer::Replay(const ModelSnapshot& base, const string& path, Container& root, SignalArena& signals, long& epochTime) {
+        const ModelSnapshot::Header& header = base.GetHeader();
+        const int words = 2 * (int)header.SignalCount;
+        vector<uint32_t> values(words);
+        for (int index = 0; index < (int)header.SignalCount; ++index) {
+            const ModelSnapshot::SignalRecord& record = base.GetSignal(index);
+            memcpy(&values[2 * index], &record.Current, sizeof(uint32_t));
+            memcpy(&values[2 * index + 1], &record.Next, sizeof(uint32_t));
+        }
+
+        int applied = 0;
+        string deltaPath;
+        vector<uint32_t> data;
+        vector<uint32_t> next;
+        for (uint32_t sequence = 1; ; ++sequence) {
+            GetDeltaPath(path, sequence, deltaPath);
+            ifstream file(deltaPath.c_str(), ios::in | ios::binary);
+            if (file.fail()) {
+                break;
+            }
+            DeltaHeader delta;
+            file.read((char*)&delta, sizeof(delta));
+            if (file.fail() || memcmp(delta.Magic, DeltaMagic, sizeof(delta.Magic)) != 0 || delta.Version != Version
+                    || delta.ByteOrder != DeltaByteOrder || delta.BaseEpochTime != header.EpochTime
+                    || delta.Sequence != sequence || delta.SignalCount != header.SignalCount) {
+                break;
+            }
+            data.resize(delta.WordCount);
+            if (delta.WordCount > 0) {
+                file.read((char*)&data[0], (streamsize)(delta.WordCount * sizeof(uint32_t)));
+            }
+            if (file.fail()) {
+                break;
+            }
+            // Apply the pages to a copy, so a damaged delta leaves the values as they were.
+            next = values;
+            size_t read = 0;
+            uint32_t page = 0;
+            for (; page < delta.PageCount; ++page) {
+                if (read + 2 > data.size()) {
+                    break;
+                }
+                uint32_t first = data[read] * PageSize;
+                uint32_t size = data[read + 1];
+                read += 2;
+                if (first >= (uint32_t)words || size > data.size() - read) {
+                    break;
+                }
+                int count = words - (int)first < PageSize ? words - (int)first : PageSize;
+                if (DecodePage(&data[read], size, &next[first], count) != size) {
+                    break;
+                }
+                read += size;
+            }
+            if (page != delta.PageCount) {
+                break;
+            }
+            values.swap(next);
+            epochTime = (long)delta.EpochTime;
+            ++applied;
+        }
+
+        if (applied > 0) {
+            vector<Property*> properties;
+            base.Match(root, properties);
+            for (int index = 0; index < (int)header.SignalCount; ++index) {
+                int32_t record = base.GetSignal(index).Property;
+                Property* p = record < 0 || record >= (int32_t)properties.size() ? NULL : properties[record];
+                if (p == NULL || !p->Flags.IsOutputPad) {
+                    continue;
+                }
+                int slot = ((OutputPad*)p)->SignalIndex;
+                memcpy(&signals.Current[slot], &values[2 * index], sizeof(float));
+                memcpy(&signals.Next[slot], &values[2 * index + 1], sizeof(float));
+            }
+        }
+        return applied;
+    }
+
+    void Checkpointer::TakeBase(Container& root, const SignalArena& signals, const ConnectionGraph* graph, long epochTime) {
+        mGeneration = PathMemo::CurrentGeneration();
+        mPendingBase = ModelSnapshot::Capture(root, signals, graph, epochTime);
+        mBaseEpochTime = epochTime;
+        mSequence = 0;
+        mNeedsBase = false;
+
+        // The deltas follow the base's signal table, so a replay can match them without the slots.
+        vector<Property*> properties;
+        mPendingBase->Match(root, properties);
+        const int count = (int)mPendingBase->GetHeader().SignalCount;
+        mSlots.resize(count);
+        mShadow.resize(2 * count);
+        for (int index = 0; index < count; ++index) {
+            const ModelSnapshot::SignalRecord& record = mPendingBase->GetSignal(index);
+            Property* p = properties[record.Property];
+            mSlots[index] = p != NULL && p->Flags.IsOutputPad ? ((OutputPad*)p)->SignalIndex : -1;
+            memcpy(&mShadow[2 * index], &record.Current, sizeof(uint32_t));
+            memcpy(&mShadow[2 * index + 1], &record.Next, sizeof(uint32_t));
+        }
+    }
+
+    bool Checkpointer::TakeDelta(const SignalArena& signals, long epochTime) {
+        mPendingPages.clear();
+        mPendingWords.clear();
+        const int words = (int)mShadow.size();
+        uint32_t page[PageSize];
+        for (int first = 0; first < words; first += PageSize) {
+            int count = words - first < PageSize ? words - first : PageSize;
+            uint32_t* shadow = &mShadow[first];
+            for (int index = 0; index < count; index += 2) {
+                int slot = mSlots[(first + index) / 2];
+                if (slot < 0) {
+                    page[index] = shadow[index];
+                    page[index + 1] = shadow[index + 1];
+                } else {
+                    memcpy(&page[index], &signals.Current[slot], sizeof(uint32_t));
+                    memcpy(&page[index + 1], &signals.Next[slot], sizeof(uint32_t));
+                }
+            }
+            if (memcmp(page, shadow, count * sizeof(uint32_t)) == 0) {
+                continue;
+            }
+            mPendingPages.push_back((uint32_t)(first / PageSize));
+            for (int index = 0; index < count; ++index) {
+                mPendingWords.push_back(page[index] ^ shadow[index]);
+            }
+            memcpy(shadow, page, count * sizeof(uint32_t));
+        }
+        if (mPendingPages.empty()) {
+            return false;
+        }
+        DeltaHeader& header = mPendingHeader;
+        memcpy(header.Magic, DeltaMagic, sizeof(header.Magic));
+        header.Version = Version;
+        header.ByteOrder = DeltaByteOrder;
+        header.BaseEpochTime = mBaseEpochTime;
+        header.EpochTime = epochTime;
+        header.Sequence = ++mSequence;
+        header.SignalCount = (uint32_t)mSlots.size();
+        header.PageCount = (uint32_t)mPendingPages.size();
+        header.WordCount = 0;
+        return true;
+    }
+
+    int Checkpointer::WritePending() {
+        string temporaryPath = mPath + ".tmp";
+        if (mPendingBase != NULL) {
+            int result = mPendingBase->Write(temporaryPath);
+            delete mPendingBase;
+            mPendingBase = NULL;
+            if (result == 0) {
+                result = ReplaceFile(temporaryPath, mPath);
+            }
+            if (result == 0) {
+                // The previous base's deltas, including any left by an earlier run.
+                string deltaPath;
+                for (uint32_t sequence = 1; ; ++sequence) {
+                    GetDeltaPath(mPath, sequence, deltaPath);
+                    if (remove(deltaPath.c_str()) != 0) {
+                        break;
+                    }
+                }
+            }
+            return result;
+        }
+
+        // Encode the changed pages, which are stored one after another in mPendingWords.
+        vector<uint32_t> encoded;
+        encoded.reserve(mPendingWords.size() / 4 + 2 * mPendingPages.size());
+        const int words = 2 * (int)mPendingHeader.SignalCount;
+        size_t offset = 0;
+        for (size_t index = 0; index < mPendingPages.size(); ++index) {
+            int first = (int)mPendingPages[index] * PageSize;
+            int count = words - first < PageSize ? words - first : PageSize;
+            encoded.push_back(mPendingPages[index]);
+            encoded.push_back(0);
+            size_t start = encoded.size();
+            EncodePage(&mPendingWords[offset], count, encoded);
+            encoded[start - 1] = (uint32_t)(encoded.size() - start);
+            offset += count;
+        }
+        mPendingHeader.WordCount = (uint32_t)encoded.size();
+
+        string deltaPath;
+        GetDeltaPath(mPath, mPendingHeader.Sequence, deltaPath);
+        ofstream file(temporaryPath.c_str(), ios::out | ios::binary | ios::trunc);
+        if (file.fail()) {
+            return 1;
+        }
+        file.write((const char*)&mPendingHeader, sizeof(mPendingHeader));
+        file.write((const char*)&encoded[0], (streamsize)(encoded.size() * sizeof(uint32_t)));
+        file.close();
+        if (file.fail()) {
+            return 2;
+        }
+        return ReplaceFile(temporaryPath, deltaPath);
+    }
+
+    void Checkpointer::WriterLoop() {
+        mLock.Lock();
+        for (;;) {
+            while (!mIsWriting && !mIsStopping) {
+                mCondition.Wait(mLock);
+            }
+            if (!mIsWriting) {
+                break;
+            }
+            mLock.Unlock();
+            int result;
+            try {
+                result = WritePending();
+            } catch (...) {
+                result = 3;
+            }
+            mLock.Lock();
+            mWriteResult = result;
+            mIsWriting = false;
+            mCondition.Broadcast();
+        }
+        mLock.Unlock();
+    }
+
+#ifdef WIN32
+    DWORD WINAPI Checkpointer::WriterStart(LPVOID arg) {
+        ((Checkpointer*)arg)->WriterLoop();
+        return 0;
+    }
+#else
+    void* Checkpointer::WriterStart(void* arg) {
+        ((Checkpointer*)arg)->WriterLoop();
+        return NULL;
+    }
+#endif
+#pragma endregion
+}
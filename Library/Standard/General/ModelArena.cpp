@@ -0,0 +1,100 @@
+#include "PlatoIncludes.h"
+#include "Strings.h"
+#include "Numbers.h"
+#include "ClassTypeInfo.h"
+#include "Identifier.h"
+#include "PropertyScopes.h"
+#include "PropertyModes.h"
+#include "ConfigurePhases.h"
+#include "ResolutionModes.h"
+#include "Property.h"
+#include "Container.h"
+#include "ThreadLocalVariable.h"
+#include "Mutex.h"
+#include "ModelArena.h"
+#include "Model.h"
+#include "Profiler.h"
+
+namespace Plato {
+
+    ModelArena::ModelArena() {
+        IsActive = false;
+        mNext = NULL;
+        mEnd = NULL;
+        mBlockSize = MinimumBlockSize;
+        mReservedBytes = 0;
+        mUsedBytes = 0;
+    }
+
+    ModelArena::~ModelArena() {
+        vector<char*>::iterator itr;
+        for (itr = mBlocks.begin(); itr != mBlocks.end(); ++itr) {
+            ::operator delete(*itr);
+        }
+    }
+
+    void* ModelArena::New(size_t size) {
+        // Round up so the next allocation stays aligned.
+        size_t total = sizeof(Header) + ((size + Alignment - 1) & ~(size_t)(Alignment - 1));
+        Model* model = Model::FindCurrent();
+        ModelArena* arena = model == NULL ? NULL : model->ModelMemory;
+        if (model != NULL && model->ModelProfile != NULL) {
+            model->ModelProfile->CountAllocation(size);
+        }
+        Header* header;
+        if (arena != NULL && arena->IsActive) {
+            header = (Header*)arena->Allocate(total);
+            header->Owner = arena;
+        } else {
+            header = (Header*)::operator new(total);
+            header->Owner = NULL;
+        }
+        return header + 1;
+    }
+
+    void ModelArena::Delete(void* memory) {
+        if (memory == NULL) {
+            return;
+        }
+        Header* header = (Header*)memory - 1;
+        if (header->Owner == NULL) {
+            ::operator delete(header);
+        }
+    }
+
+    char* ModelArena::Allocate(size_t size) {
+        MutexLock lock(mLock);
+        mUsedBytes += size;
+        if (size > (size_t)(mEnd - mNext)) {
+            // Large objects get a block of their own, leaving the current block in use.
+            if (size > mBlockSize / 4) {
+                char* block = (char*)::operator new(size);
+                mBlocks.push_back(block);
+                mReservedBytes += size;
+                return block;
+            }
+            mNext = (char*)::operator new(mBlockSize);
+            mEnd = mNext + mBlockSize;
+            mBlocks.push_back(mNext);
+            mReservedBytes += mBlockSize;
+            if (mBlockSize < MaximumBlockSize) {
+                mBlockSize *= 2;
+            }
+        }
+        char* result = mNext;
+        mNext += size;
+        return result;
+    }
+
+    string& ModelArena::StatusReport() const {
+        string& result = *new string("ModelArena(Blocks=");
+        string& blocks = Numbers::ToString((int)mBlocks.size());
+        string& reserved = Numbers::ToString((long)mReservedBytes);
+        string& used = Numbers::ToString((long)mUsedBytes);
+        result += blocks + ",Reserved=" + reserved + ",Used=" + used + ")";
+        delete &used;
+        delete &reserved;
+        delete &blocks;
+        return result;
+    }
+}
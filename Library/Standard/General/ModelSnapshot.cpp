@@ -0,0 +1,427 @@
+#include "PlatoIncludes.h"
+#include "Strings.h"
+#include "ClassTypeInfo.h"
+#include "Identifier.h"
+#include "PropertyScopes.h"
+#include "PropertyModes.h"
+#include "ConfigurePhases.h"
+#include "Property.h"
+#include "Container.h"
+#include "ResolutionModes.h"
+#include "Point.h"
+#include "Connector.h"
+#include "Mutex.h"
+#include "SignalArena.h"
+#include "Pad.h"
+#include "InputPad.h"
+#include "OutputPad.h"
+#include "ConnectionGraph.h"
+#include "ModelSnapshot.h"
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace Plato {
+
+    static const char SnapshotMagic[8] = { 'P', 'L', 'A', 'T', 'O', 'S', 'N', 'P' };
+    static const uint32_t SnapshotByteOrder = 0x01020304u;
+
+    /// <summary>
+    /// The tables of a snapshot while it is being captured.
+    /// </summary>
+    struct SnapshotTables {
+        vector<Property*> Properties;
+        vector<ModelSnapshot::PropertyRecord> Records;
+        vector<ModelSnapshot::PadRecord> Pads;
+        vector<ModelSnapshot::EdgeRecord> Edges;
+        vector<ModelSnapshot::SignalRecord> Signals;
+        vector<float> Positions;
+        string Names;
+        /// <summary>
+        /// The record index of each property, keyed by address.
+        /// </summary>
+        hash_map<size_t,int> Indices;
+    };
+
+    static uint64_t AlignTable(uint64_t offset) {
+        return (offset + 7) & ~(uint64_t)7;
+    }
+
+    static int FindIndex(const SnapshotTables& tables, const void* prop) {
+        hash_map<size_t,int>::const_iterator itr = tables.Indices.find((size_t)prop);
+        return itr == tables.Indices.end() ? -1 : itr->second;
+    }
+
+    static void Collect(SnapshotTables& tables, Property& prop, int parent, const SignalArena& signals) {
+        int index = (int)tables.Records.size();
+        ModelSnapshot::PropertyRecord record;
+        record.Parent = parent;
+        record.Order = prop.Order;
+        record.TypeCode = (uint32_t)prop.GetClassTypeInfo()->TypeCode;
+        record.Scope = (int32_t)prop.Scope;
+        record.Name = (int32_t)tables.Names.size();
+        if (prop.Identity->Name != NULL) {
+            tables.Names += *prop.Identity->Name;
+        }
+        tables.Names += '\0';
+        record.Position = -1;
+        const Point* position = prop.Identity->Position;
+        if (position != NULL) {
+            record.Position = (int32_t)(tables.Positions.size() / Point::NumberOfCoordinates);
+            tables.Positions.insert(tables.Positions.end(), position->Coordinates, position->Coordinates + Point::NumberOfCoordinates);
+        }
+        record.Signal = -1;
+        if (prop.Flags.IsOutputPad) {
+            OutputPad& pad = (OutputPad&)prop;
+            ModelSnapshot::SignalRecord signal;
+            signal.Property = index;
+            signal.Current = signals.Current[pad.SignalIndex];
+            signal.Next = signals.Next[pad.SignalIndex];
+            record.Signal = (int32_t)tables.Signals.size();
+            tables.Signals.push_back(signal);
+        }
+        record.Pad = -1;
+        if (prop.Flags.IsInputPad) {
+            ModelSnapshot::PadRecord pad;
+            pad.Property = index;
+            pad.FirstEdge = 0;
+            pad.EdgeCount = 0;
+            record.Pad = (int32_t)tables.Pads.size();
+            tables.Pads.push_back(pad);
+        }
+        tables.Records.push_back(record);
+        tables.Properties.push_back(&prop);
+        tables.Indices[(size_t)&prop] = index;
+
+        if (prop.Flags.IsContainer) {
+            vector<Property*>* properties = ((Container&)prop).GetOrderedProperties();
+            vector<Property*>::iterator itr;
+            for (itr = properties->begin(); itr != properties->end(); ++itr) {
+                Property* p = *itr;
+                // Proxies and filters refer to properties owned elsewhere in the tree.
+                if (p->Flags.IsProxied || p->Flags.IsFilter || p->Flags.IsGroupContainer) {
+                    continue;
+                }
+                Collect(tables, *p, index, signals);
+            }
+        }
+    }
+
+    static void CollectEdges(SnapshotTables& tables, const ConnectionGraph* graph) {
+        // Signal slot to output pad record, for the pads whose connections were released into the graph.
+        hash_map<int,int> slotRecords;
+        vector<ModelSnapshot::SignalRecord>::iterator sitr;
+        for (sitr = tables.Signals.begin(); sitr != tables.Signals.end(); ++sitr) {
+            slotRecords[((OutputPad*)tables.Properties[sitr->Property])->SignalIndex] = sitr->Property;
+        }
+        vector<ModelSnapshot::PadRecord>::iterator pitr;
+        for (pitr = tables.Pads.begin(); pitr != tables.Pads.end(); ++pitr) {
+            InputPad& pad = *(InputPad*)tables.Properties[pitr->Property];
+            pitr->FirstEdge = (int32_t)tables.Edges.size();
+            ModelSnapshot::EdgeRecord edge;
+            int graphIndex = pad.GraphIndex;
+            if (pad.InputConnections->empty() && graph != NULL && graphIndex >= 0 && graphIndex < graph->PadCount()
+                    && graph->Pads[graphIndex] == &pad) {
+                const int* sources = graph->Sources(graphIndex);
+                int first = graph->Offsets[graphIndex];
+                for (int index = 0; index < graph->InputCount(graphIndex); ++index) {
+                    hash_map<int,int>::iterator hitr = slotRecords.find(sources[index]);
+                    edge.Source = hitr == slotRecords.end() ? -1 : hitr->second;
+                    edge.Connector = FindIndex(tables, graph->Connectors[graph->ConnectorIds[first + index]]);
+                    tables.Edges.push_back(edge);
+                }
+            } else {
+                vector<InputConnection*>::iterator citr;
+                for (citr = pad.InputConnections->begin(); citr != pad.InputConnections->end(); ++citr) {
+                    edge.Source = FindIndex(tables, (Property*)(*citr)->SourceOutputPad);
+                    edge.Connector = FindIndex(tables, (Property*)(*citr)->OriginatingConnector);
+                    tables.Edges.push_back(edge);
+                }
+            }
+            pitr->EdgeCount = (int32_t)tables.Edges.size() - pitr->FirstEdge;
+        }
+    }
+
+    template <class Record> static void CopyTable(char* data, uint64_t offset, const vector<Record>& table) {
+        if (!table.empty()) {
+            memcpy(data + offset, &table[0], table.size() * sizeof(Record));
+        }
+    }
+
+#pragma region // Constructors.
+    ModelSnapshot::ModelSnapshot(char* data, size_t mappedSize) {
+        mData = data;
+        mMappedSize = mappedSize;
+#ifdef WIN32
+        mMapping = NULL;
+#endif
+    }
+
+    ModelSnapshot::~ModelSnapshot() {
+        if (mMappedSize == 0) {
+            delete[] mData;
+            return;
+        }
+#ifdef WIN32
+        UnmapViewOfFile(mData);
+        CloseHandle(mMapping);
+#else // POSIX
+        munmap(mData, mMappedSize);
+#endif
+    }
+#pragma endregion
+
+#pragma region // Methods.
+    ModelSnapshot* ModelSnapshot::Capture(Container& root, const SignalArena& signals, const ConnectionGraph* graph, long epochTime) {
+        SnapshotTables tables;
+        Collect(tables, root, -1, signals);
+        CollectEdges(tables, graph);
+
+        Header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.Magic, SnapshotMagic, sizeof(header.Magic));
+        header.Version = Version;
+        header.ByteOrder = SnapshotByteOrder;
+        header.EpochTime = epochTime;
+        header.PropertyCount = (uint32_t)tables.Records.size();
+        header.PadCount = (uint32_t)tables.Pads.size();
+        header.EdgeCount = (uint32_t)tables.Edges.size();
+        header.SignalCount = (uint32_t)tables.Signals.size();
+        header.PositionCount = (uint32_t)(tables.Positions.size() / Point::NumberOfCoordinates);
+        header.NamesSize = (uint32_t)tables.Names.size();
+        uint64_t offset = AlignTable(sizeof(Header));
+        header.PropertiesOffset = offset;
+        offset = AlignTable(offset + header.PropertyCount * sizeof(PropertyRecord));
+        header.PadsOffset = offset;
+        offset = AlignTable(offset + header.PadCount * sizeof(PadRecord));
+        header.EdgesOffset = offset;
+        offset = AlignTable(offset + header.EdgeCount * sizeof(EdgeRecord));
+        header.SignalsOffset = offset;
+        offset = AlignTable(offset + header.SignalCount * sizeof(SignalRecord));
+        header.PositionsOffset = offset;
+        offset = AlignTable(offset + tables.Positions.size() * sizeof(float));
+        header.NamesOffset = offset;
+        header.Size = AlignTable(offset + header.NamesSize);
+
+        char* data = new char[(size_t)header.Size];
+        memset(data, 0, (size_t)header.Size);
+        memcpy(data, &header, sizeof(header));
+        CopyTable(data, header.PropertiesOffset, tables.Records);
+        CopyTable(data, header.PadsOffset, tables.Pads);
+        CopyTable(data, header.EdgesOffset, tables.Edges);
+        CopyTable(data, header.SignalsOffset, tables.Signals);
+        CopyTable(data, header.PositionsOffset, tables.Positions);
+        memcpy(data + header.NamesOffset, tables.Names.data(), tables.Names.size());
+        return new ModelSnapshot(data);
+    }
+
+    ModelSnapshot* ModelSnapshot::Read(const string& path) {
+        ifstream file(path.c_str(), ios::in | ios::binary);
+        if (file.fail()) {
+            return NULL;
+        }
+        Header header;
+        file.read((char*)&header, sizeof(header));
+        if (file.fail() || !IsValid((const char*)&header, sizeof(header))) {
+            return NULL;
+        }
+        char* data = new char[(size_t)header.Size];
+        memcpy(data, &header, sizeof(header));
+        file.read(data + sizeof(header), (streamsize)(header.Size - sizeof(header)));
+        if (file.fail() || !IsValid(data, (size_t)header.Size)) {
+            delete[] data;
+            return NULL;
+        }
+        return new ModelSnapshot(data);
+    }
+
+    ModelSnapshot* ModelSnapshot::Map(const string& path) {
+        size_t size;
+        char* data;
+#ifdef WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) {
+            return NULL;
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(Header)) {
+            CloseHandle(file);
+            return NULL;
+        }
+        size = (size_t)fileSize.QuadPart;
+        // The mapping keeps the file open after its handle is closed.
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        CloseHandle(file);
+        if (mapping == NULL) {
+            return NULL;
+        }
+        data = (char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == NULL) {
+            CloseHandle(mapping);
+            return NULL;
+        }
+        if (!IsValid(data, size)) {
+            UnmapViewOfFile(data);
+            CloseHandle(mapping);
+            return NULL;
+        }
+        ModelSnapshot* snapshot = new ModelSnapshot(data, size);
+        snapshot->mMapping = mapping;
+        return snapshot;
+#else // POSIX
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            return NULL;
+        }
+        struct stat info;
+        if (fstat(file, &info) != 0 || info.st_size < (off_t)sizeof(Header)) {
+            close(file);
+            return NULL;
+        }
+        size = (size_t)info.st_size;
+        // The mapping keeps the file open after its descriptor is closed.
+        void* mapped = mmap(NULL, size, PROT_READ, MAP_SHARED, file, 0);
+        close(file);
+        if (mapped == MAP_FAILED) {
+            return NULL;
+        }
+        data = (char*)mapped;
+        if (!IsValid(data, size)) {
+            munmap(mapped, size);
+            return NULL;
+        }
+        return new ModelSnapshot(data, size);
+#endif
+    }
+
+    int ModelSnapshot::Write(const string& path) const {
+        ofstream file(path.c_str(), ios::out | ios::binary | ios::trunc);
+        if (file.fail()) {
+            return 1;
+        }
+        file.write(mData, (streamsize)Size());
+        file.close();
+        return file.fail() ? 2 : 0;
+    }
+
+    void ModelSnapshot::Match(Container& root, vector<Property*>& properties) const {
+        const Header& header = GetHeader();
+        const PropertyRecord* records = GetTable<PropertyRecord>(header.PropertiesOffset);
+        // A parent's record always precedes its children's.
+        // The records are checked here rather than when the snapshot is opened, so a mapped
+        // snapshot is only read as far as it is used; a record out of range is unmatched.
+        const int32_t propertyCount = (int32_t)header.PropertyCount;
+        properties.assign(header.PropertyCount, (Property*)NULL);
+        for (int32_t index = 0; index < propertyCount; ++index) {
+            const PropertyRecord& record = records[index];
+            Property* p = NULL;
+            if (record.Parent < 0) {
+                if (index == 0) {
+                    p = &root;
+                }
+            } else if (record.Parent < index) {
+                Property* parent = properties[record.Parent];
+                if (parent != NULL && parent->Flags.IsContainer) {
+                    Container& container = *(Container*)parent;
+                    int position = container.BinarySearch(record.Order);
+                    if (position >= 0) {
+                        p = (*container.GetOrderedProperties())[position];
+                    }
+                }
+            }
+            if (p != NULL && (uint32_t)p->GetClassTypeInfo()->TypeCode == record.TypeCode) {
+                properties[index] = p;
+            }
+        }
+    }
+
+    int ModelSnapshot::Restore(Container& root, SignalArena& signals) const {
+        const Header& header = GetHeader();
+        const int32_t propertyCount = (int32_t)header.PropertyCount;
+        vector<Property*> properties;
+        Match(root, properties);
+
+        int missing = 0;
+        const SignalRecord* signalRecords = GetTable<SignalRecord>(header.SignalsOffset);
+        for (uint32_t index = 0; index < header.SignalCount; ++index) {
+            const SignalRecord& record = signalRecords[index];
+            Property* p = record.Property < 0 || record.Property >= propertyCount ? NULL : properties[record.Property];
+            if (p == NULL || !p->Flags.IsOutputPad) {
+                ++missing;
+                continue;
+            }
+            int slot = ((OutputPad*)p)->SignalIndex;
+            signals.Current[slot] = record.Current;
+            signals.Next[slot] = record.Next;
+        }
+
+        const PadRecord* pads = GetTable<PadRecord>(header.PadsOffset);
+        const EdgeRecord* edges = GetTable<EdgeRecord>(header.EdgesOffset);
+        for (uint32_t index = 0; index < header.PadCount; ++index) {
+            const PadRecord& record = pads[index];
+            Property* p = record.Property < 0 || record.Property >= propertyCount ? NULL : properties[record.Property];
+            if (p == NULL || !p->Flags.IsInputPad || record.FirstEdge < 0 || record.EdgeCount < 0
+                    || (uint64_t)record.FirstEdge + record.EdgeCount > header.EdgeCount) {
+                ++missing;
+                continue;
+            }
+            InputPad& pad = *(InputPad*)p;
+            vector<InputConnection*>::iterator citr;
+            for (citr = pad.InputConnections->begin(); citr != pad.InputConnections->end(); ++citr) {
+                delete *citr;
+            }
+            pad.InputConnections->clear();
+            for (int edge = record.FirstEdge; edge < record.FirstEdge + record.EdgeCount; ++edge) {
+                const EdgeRecord& edgeRecord = edges[edge];
+                Property* source = edgeRecord.Source < 0 || edgeRecord.Source >= propertyCount ? NULL : properties[edgeRecord.Source];
+                Property* connector = edgeRecord.Connector < 0 || edgeRecord.Connector >= propertyCount ? NULL : properties[edgeRecord.Connector];
+                if (source == NULL || !source->Flags.IsOutputPad || connector == NULL) {
+                    ++missing;
+                    continue;
+                }
+                pad.Add(*(OutputPad*)source, *(Connector*)connector);
+            }
+        }
+        return missing;
+    }
+
+    const float* ModelSnapshot::GetPosition(const PropertyRecord& record) const {
+        if (record.Position < 0 || (uint32_t)record.Position >= GetHeader().PositionCount) {
+            return NULL;
+        }
+        return GetTable<float>(GetHeader().PositionsOffset) + record.Position * Point::NumberOfCoordinates;
+    }
+
+    bool ModelSnapshot::IsValid(const char* data, size_t size) {
+        if (size < sizeof(Header)) {
+            return false;
+        }
+        const Header& header = *(const Header*)data;
+        if (memcmp(header.Magic, SnapshotMagic, sizeof(header.Magic)) != 0 || header.Version != Version
+                || header.ByteOrder != SnapshotByteOrder || header.Size < sizeof(Header)) {
+            return false;
+        }
+        if (size == sizeof(Header)) {
+            // Only the header has been read so far.
+            return true;
+        }
+        // Check every table is aligned and lies within the block; Restore checks the indices in the records.
+        uint64_t offsets = header.PropertiesOffset | header.PadsOffset | header.EdgesOffset
+            | header.SignalsOffset | header.PositionsOffset | header.NamesOffset;
+        if (header.Size != size || (offsets & 7) != 0 || (offsets >> 62) != 0
+                || header.PropertiesOffset + (uint64_t)header.PropertyCount * sizeof(PropertyRecord) > size
+                || header.PadsOffset + (uint64_t)header.PadCount * sizeof(PadRecord) > size
+                || header.EdgesOffset + (uint64_t)header.EdgeCount * sizeof(EdgeRecord) > size
+                || header.SignalsOffset + (uint64_t)header.SignalCount * sizeof(SignalRecord) > size
+                || header.PositionsOffset + (uint64_t)header.PositionCount * Point::NumberOfCoordinates * sizeof(float) > size
+                || header.NamesOffset + header.NamesSize > size
+                || header.PropertyCount == 0 || header.NamesSize == 0 || data[header.NamesOffset + header.NamesSize - 1] != '\0') {
+            return false;
+        }
+        return true;
+    }
+#pragma endregion
+}
@@ -78,4 +78,10 @@ namespace Plato {
             v = defaultValue;
         return v;
     }
+
+    float Numbers::CheckValue(float& v, float lo, float hi, float defaultValue, bool reset) {
+        if (!(v >= lo && v <= hi) || reset)
+            v = defaultValue;
+        return v;
+    }
 }
@@ -0,0 +1,290 @@
+#include "PlatoIncludes.h"
+#include "Strings.h"
+#include "ClassTypeInfo.h"
+#include "Identifier.h"
+#include "PropertyScopes.h"
+#include "PropertyModes.h"
+#include "ConfigurePhases.h"
+#include "Property.h"
+#include "Container.h"
+#include "ThreadLocalVariable.h"
+#include "Mutex.h"
+#include "Profiler.h"
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+namespace Plato {
+
+    /// <summary>
+    /// The counts made by one thread.
+    /// </summary>
+    struct Profiler::ThreadCounters {
+        typedef FlatHashMap<ClassTypeInfo::ConstClassTypeInfoPtr, TypeCounters, ClassTypeInfoPtrTraits> TypeMap;
+        TypeMap Types;
+        /// <summary>
+        /// The ticks taken by the containers updated by the container being updated.
+        /// </summary>
+        uint64_t ChildTicks;
+        uint64_t Allocations;
+        uint64_t Bytes;
+        ThreadCounters() : ChildTicks(0), Allocations(0), Bytes(0) {
+        }
+    };
+
+    uint64_t Profiler::GetNanoseconds() {
+#ifdef WIN32
+        LARGE_INTEGER count;
+        LARGE_INTEGER frequency;
+        QueryPerformanceCounter(&count);
+        QueryPerformanceFrequency(&frequency);
+        return (uint64_t)((double)count.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else // POSIX
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+#endif
+    }
+
+    // Orders classes by decreasing own ticks, then by type code so reports are stable.
+    static bool CompareSelfTicks(const Profiler::TypeCounters& x, const Profiler::TypeCounters& y) {
+        if (x.SelfTicks != y.SelfTicks) {
+            return x.SelfTicks > y.SelfTicks;
+        }
+        return x.Type->TypeCode < y.Type->TypeCode;
+    }
+
+    Profiler::Profiler() {
+        mCountersKey = ThreadLocalVariable::GetKey();
+        for (int bucket = 0; bucket < HistogramSize; ++bucket) {
+            mHistogram[bucket] = 0;
+        }
+        mEpochs = 0;
+        mEpochTicks = 0;
+        mMinimumEpochTicks = 0;
+        mMaximumEpochTicks = 0;
+        mEpochStart = 0;
+        mStartNanoseconds = GetNanoseconds();
+        mStartTicks = GetTicks();
+    }
+
+    Profiler::~Profiler() {
+        vector<ThreadCounters*>::iterator itr;
+        for (itr = mThreads.begin(); itr != mThreads.end(); ++itr) {
+            delete *itr;
+        }
+        // A later key may reuse this one, so it must not find the counters just deleted.
+        ThreadLocalVariable::SetVariableValue(mCountersKey, NULL);
+        ThreadLocalVariable::FreeKey(mCountersKey);
+    }
+
+    uint64_t Profiler::GetTicks() {
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+        return (uint64_t)__rdtsc();
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+        return (uint64_t)__builtin_ia32_rdtsc();
+#else
+        return GetNanoseconds();
+#endif
+    }
+
+    double Profiler::GetTicksPerSecond() const {
+        uint64_t nanoseconds = GetNanoseconds() - mStartNanoseconds;
+        uint64_t ticks = GetTicks() - mStartTicks;
+        if (nanoseconds == 0 || ticks == 0) {
+            return 1e9;
+        }
+        return (double)ticks * 1e9 / (double)nanoseconds;
+    }
+
+    Profiler::ThreadCounters& Profiler::GetCounters() {
+        ThreadCounters* counters = (ThreadCounters*)ThreadLocalVariable::GetVariableValue(mCountersKey);
+        if (counters == NULL) {
+            counters = new ThreadCounters();
+            {
+                MutexLock lock(mLock);
+                mThreads.push_back(counters);
+            }
+            ThreadLocalVariable::SetVariableValue(mCountersKey, (ThreadLocalVariable::ValuePtr)counters);
+        }
+        return *counters;
+    }
+
+    void Profiler::Update(Container& container) {
+        ThreadCounters& counters = GetCounters();
+        uint64_t outerChildTicks = counters.ChildTicks;
+        uint64_t allocations = counters.Allocations;
+        counters.ChildTicks = 0;
+        uint64_t start = GetTicks();
+        try {
+            container.Update();
+        } catch (...) {
+            counters.ChildTicks = outerChildTicks;
+            throw;
+        }
+        uint64_t ticks = GetTicks() - start;
+        // Look the class up after the update, since the containers it updated may have grown the table.
+        const ClassTypeInfo* type = container.GetClassTypeInfo();
+        TypeCounters& typeCounters = counters.Types[type];
+        typeCounters.Type = type;
+        ++typeCounters.Updates;
+        typeCounters.Ticks += ticks;
+        typeCounters.SelfTicks += ticks > counters.ChildTicks ? ticks - counters.ChildTicks : 0;
+        typeCounters.Allocations += counters.Allocations - allocations;
+        counters.ChildTicks = outerChildTicks + ticks;
+    }
+
+    void Profiler::CountAllocation(size_t size) {
+        ThreadCounters& counters = GetCounters();
+        ++counters.Allocations;
+        counters.Bytes += size;
+    }
+
+    void Profiler::EndEpoch() {
+        uint64_t ticks = GetTicks() - mEpochStart;
+        int bucket = 0;
+        while (bucket < HistogramSize - 1 && (ticks >> (bucket + 1)) != 0) {
+            ++bucket;
+        }
+        ++mHistogram[bucket];
+        if (mEpochs == 0 || ticks < mMinimumEpochTicks) {
+            mMinimumEpochTicks = ticks;
+        }
+        if (ticks > mMaximumEpochTicks) {
+            mMaximumEpochTicks = ticks;
+        }
+        mEpochTicks += ticks;
+        ++mEpochs;
+    }
+
+    void Profiler::Merge(vector<TypeCounters>& types, uint64_t& allocations, uint64_t& bytes) {
+        ThreadCounters::TypeMap merged;
+        allocations = 0;
+        bytes = 0;
+        {
+            MutexLock lock(mLock);
+            vector<ThreadCounters*>::iterator itr;
+            for (itr = mThreads.begin(); itr != mThreads.end(); ++itr) {
+                ThreadCounters& counters = **itr;
+                allocations += counters.Allocations;
+                bytes += counters.Bytes;
+                ThreadCounters::TypeMap::iterator typeItr;
+                for (typeItr = counters.Types.begin(); typeItr != counters.Types.end(); ++typeItr) {
+                    const TypeCounters& from = typeItr->second;
+                    TypeCounters& to = merged[typeItr->first];
+                    to.Type = from.Type;
+                    to.Updates += from.Updates;
+                    to.Ticks += from.Ticks;
+                    to.SelfTicks += from.SelfTicks;
+                    to.Allocations += from.Allocations;
+                }
+            }
+        }
+        types.clear();
+        ThreadCounters::TypeMap::iterator itr;
+        for (itr = merged.begin(); itr != merged.end(); ++itr) {
+            types.push_back(itr->second);
+        }
+        sort(types.begin(), types.end(), CompareSelfTicks);
+    }
+
+    bool Profiler::GetCounters(const ClassTypeInfo& type, TypeCounters& counters) {
+        vector<TypeCounters> types;
+        uint64_t allocations;
+        uint64_t bytes;
+        Merge(types, allocations, bytes);
+        vector<TypeCounters>::iterator itr;
+        for (itr = types.begin(); itr != types.end(); ++itr) {
+            if (itr->Type == &type) {
+                counters = *itr;
+                return true;
+            }
+        }
+        counters.Type = &type;
+        counters.Updates = 0;
+        counters.Ticks = 0;
+        counters.SelfTicks = 0;
+        counters.Allocations = 0;
+        return false;
+    }
+
+    string& Profiler::StatusReport() {
+        vector<TypeCounters> types;
+        uint64_t allocations;
+        uint64_t bytes;
+        Merge(types, allocations, bytes);
+        double ticksPerSecond = GetTicksPerSecond();
+        double epochTicks = mEpochTicks > 0 ? (double)mEpochTicks : 1.0;
+
+        string& result = Strings::Format("Profiler(Epochs=%.0f,Seconds=%.6f,Allocations=%.0f,AllocatedBytes=%.0f,TicksPerSecond=%.0f)",
+            (double)mEpochs, (double)mEpochTicks / ticksPerSecond, (double)allocations, (double)bytes, ticksPerSecond);
+        vector<TypeCounters>::iterator itr;
+        for (itr = types.begin(); itr != types.end(); ++itr) {
+            string& line = Strings::Format("\n  %s(Updates=%.0f,Seconds=%.6f,SelfSeconds=%.6f,SelfShare=%.1f%%,Allocations=%.0f)",
+                itr->Type->ClassName->c_str(), (double)itr->Updates, (double)itr->Ticks / ticksPerSecond,
+                (double)itr->SelfTicks / ticksPerSecond, 100.0 * (double)itr->SelfTicks / epochTicks, (double)itr->Allocations);
+            result += line;
+            delete &line;
+        }
+        if (mEpochs > 0) {
+            string& line = Strings::Format("\n  EpochMicroseconds(Minimum=%.3f,Mean=%.3f,Maximum=%.3f)",
+                1e6 * (double)mMinimumEpochTicks / ticksPerSecond, 1e6 * (double)mEpochTicks / (double)mEpochs / ticksPerSecond,
+                1e6 * (double)mMaximumEpochTicks / ticksPerSecond);
+            result += line;
+            delete &line;
+        }
+        for (int bucket = 0; bucket < HistogramSize; ++bucket) {
+            if (mHistogram[bucket] > 0) {
+                string& line = Strings::Format("\n  EpochMicroseconds[%.3f,%.3f)=%.0f",
+                    1e6 * ldexp(1.0, bucket) / ticksPerSecond, 1e6 * ldexp(1.0, bucket + 1) / ticksPerSecond, (double)mHistogram[bucket]);
+                result += line;
+                delete &line;
+            }
+        }
+        return result;
+    }
+
+    int Profiler::Write(const string& path) {
+        vector<TypeCounters> types;
+        uint64_t allocations;
+        uint64_t bytes;
+        Merge(types, allocations, bytes);
+        double ticksPerSecond = GetTicksPerSecond();
+
+        ofstream file(path.c_str(), ios::out | ios::trunc);
+        if (!file.is_open()) {
+            return 1;
+        }
+        file << "{\n  \"ticksPerSecond\": " << (uint64_t)ticksPerSecond
+            << ",\n  \"epochs\": " << mEpochs
+            << ",\n  \"epochTicks\": " << mEpochTicks
+            << ",\n  \"minimumEpochTicks\": " << mMinimumEpochTicks
+            << ",\n  \"maximumEpochTicks\": " << mMaximumEpochTicks
+            << ",\n  \"allocations\": " << allocations
+            << ",\n  \"allocatedBytes\": " << bytes
+            << ",\n  \"classes\": [";
+        vector<TypeCounters>::iterator itr;
+        for (itr = types.begin(); itr != types.end(); ++itr) {
+            file << (itr == types.begin() ? "\n" : ",\n")
+                << "    {\"class\": \"" << *itr->Type->ClassName
+                << "\", \"typeCode\": " << (uint64_t)itr->Type->TypeCode
+                << ", \"updates\": " << itr->Updates
+                << ", \"ticks\": " << itr->Ticks
+                << ", \"selfTicks\": " << itr->SelfTicks
+                << ", \"allocations\": " << itr->Allocations << "}";
+        }
+        file << "\n  ],\n  \"epochHistogram\": [";
+        bool first = true;
+        for (int bucket = 0; bucket < HistogramSize; ++bucket) {
+            if (mHistogram[bucket] > 0) {
+                file << (first ? "\n" : ",\n")
+                    << "    {\"minimumTicks\": " << ((uint64_t)1 << bucket)
+                    << ", \"count\": " << mHistogram[bucket] << "}";
+                first = false;
+            }
+        }
+        file << "\n  ]\n}\n";
+        file.close();
+        return file.fail() ? 2 : 0;
+    }
+}
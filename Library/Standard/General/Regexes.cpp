@@ -1,45 +1,214 @@
 #include "PlatoIncludes.h"
+#include "Strings.h"
+#include "Mutex.h"
 #include "Regexes.h"
 
 #define PCRE_STATIC 1
 #include "pcre/pcre.h"
 
+// PCRE 8.20 and later can JIT compile patterns when they are studied.
+#ifdef PCRE_STUDY_JIT_COMPILE
+#define PLATO_PCRE_STUDY_OPTIONS PCRE_STUDY_JIT_COMPILE
+#define PLATO_PCRE_FREE_STUDY(extra) pcre_free_study((pcre_extra*)(extra))
+#else
+#define PLATO_PCRE_STUDY_OPTIONS 0
+#define PLATO_PCRE_FREE_STUDY(extra) pcre_free(extra)
+#endif
+
 namespace Plato {
 
+    CompiledRegex::CompiledRegex(const char* pattern, size_t length, uint32_t hash)
+        : Pattern(pattern, length) {
+        const char *errorMessage;
+        int errorOffset;
+        RegexPatternPtr = (void*)pcre_compile(Pattern.c_str(),0,&errorMessage,&errorOffset,NULL);
+        RegexExtraPtr = RegexPatternPtr == NULL ? NULL
+            : (void*)pcre_study((pcre*)RegexPatternPtr,PLATO_PCRE_STUDY_OPTIONS,&errorMessage);
+        mHash = hash;
+        mUseCount = 0;
+        mNext = NULL;
+        mNewer = NULL;
+        mOlder = NULL;
+        Classify();
+    }
+
+    CompiledRegex::~CompiledRegex() {
+        if (RegexExtraPtr != NULL) {
+            PLATO_PCRE_FREE_STUDY(RegexExtraPtr);
+        }
+        pcre_free(RegexPatternPtr);
+    }
+
+    void CompiledRegex::Classify() {
+        Kind = RegexPatternKinds::Regex;
+        IsStartAnchored = false;
+        IsEndAnchored = false;
+        if (RegexPatternPtr == NULL) {
+            return;
+        }
+        size_t begin = 0;
+        size_t end = Pattern.size();
+        if (begin < end && Pattern[begin] == '^') {
+            IsStartAnchored = true;
+            ++begin;
+        }
+        if (end > begin && Pattern[end - 1] == '$' && !IsEscaped(end - 1)) {
+            IsEndAnchored = true;
+            --end;
+        }
+        // A leading or trailing ".*" just removes the anchor at that end.
+        if (end - begin >= 2 && Pattern.compare(begin, 2, ".*") == 0) {
+            IsStartAnchored = false;
+            begin += 2;
+        }
+        if (end - begin >= 2 && Pattern.compare(end - 2, 2, ".*") == 0 && !IsEscaped(end - 2)) {
+            IsEndAnchored = false;
+            end -= 2;
+        }
+        if (begin == end && !(IsStartAnchored && IsEndAnchored)) {
+            Kind = RegexPatternKinds::Any;
+        } else if (Pattern.compare(begin, end - begin, ".+") == 0) {
+            Kind = RegexPatternKinds::NonEmpty;
+        } else if (end - begin >= 2 && Pattern[begin] == '(' && Pattern[end - 1] == ')' && !IsEscaped(end - 1)) {
+            begin += Pattern.compare(begin, 3, "(?:") == 0 ? 3 : 1;
+            if (SplitLiterals(begin, end - 1)) {
+                Kind = RegexPatternKinds::Literals;
+            }
+        } else if (SplitLiterals(begin, end)) {
+            // Anchors only apply to the first and last of ungrouped alternatives.
+            if (Literals.size() == 1 || (!IsStartAnchored && !IsEndAnchored)) {
+                Kind = RegexPatternKinds::Literals;
+            }
+        }
+        if (Kind != RegexPatternKinds::Literals) {
+            Literals.clear();
+        }
+    }
+
+    bool CompiledRegex::SplitLiterals(size_t begin, size_t end) {
+        string literal;
+        for (size_t i = begin; i < end; ++i) {
+            char c = Pattern[i];
+            if (c == '\\') {
+                // Only escaped punctuation is literal, \d and the like are classes.
+                if (++i == end || isalnum((unsigned char)Pattern[i])) {
+                    return false;
+                }
+                literal += Pattern[i];
+            } else if (c == '|') {
+                Literals.push_back(literal);
+                literal.clear();
+            } else if (memchr(Regexes::RegexSpecialCharacters, c, sizeof(Regexes::RegexSpecialCharacters)) != NULL) {
+                return false;
+            } else {
+                literal += c;
+            }
+        }
+        Literals.push_back(literal);
+        return true;
+    }
+
+    bool CompiledRegex::IsEscaped(size_t position) const {
+        size_t count = 0;
+        while (position > count && Pattern[position - count - 1] == '\\') {
+            ++count;
+        }
+        return (count & 1) != 0;
+    }
+
+    bool CompiledRegex::MatchesLiterals(const char* text, size_t length) const {
+        vector<string>::const_iterator itr;
+        for (itr = Literals.begin(); itr != Literals.end(); ++itr) {
+            const char* literal = itr->data();
+            size_t literalLength = itr->size();
+            if (literalLength > length) {
+                continue;
+            }
+            if (IsStartAnchored) {
+                if ((!IsEndAnchored || literalLength == length) && memcmp(text, literal, literalLength) == 0) {
+                    return true;
+                }
+            } else if (IsEndAnchored) {
+                if (memcmp(text + length - literalLength, literal, literalLength) == 0) {
+                    return true;
+                }
+            } else {
+                if (literalLength == 0) {
+                    return true;
+                }
+                const char* last = text + length - literalLength;
+                for (const char* p = text; p <= last; ++p) {
+                    p = (const char*)memchr(p, literal[0], last - p + 1);
+                    if (p == NULL) {
+                        break;
+                    }
+                    if (memcmp(p, literal, literalLength) == 0) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
     RegexMatcher::RegexMatcher(const string* pattern) {
         IsPatternString = true;
         PatternString = pattern;
-        const char *errorMessage;
-        int errorOffset;
-        RegexPatternPtr = (void*)pcre_compile(pattern->c_str(),0,&errorMessage,&errorOffset,NULL);
-        RegexExtraPtr = (void*)pcre_study((pcre*)RegexPatternPtr,0,&errorMessage);
+        mCompiledRegex = &Regexes::Acquire(pattern->data(),pattern->size());
     }
 
     RegexMatcher::RegexMatcher(const char* pattern) {
         IsPatternString = false;
         PatternCharPtr = pattern;
-        const char *errorMessage;
-        int errorOffset;
-        RegexPatternPtr = (void*)pcre_compile(pattern,0,&errorMessage,&errorOffset,NULL);
-        RegexExtraPtr = (void*)pcre_study((pcre*)RegexPatternPtr,0,&errorMessage);
+        mCompiledRegex = &Regexes::Acquire(pattern,strlen(pattern));
     }
 
     RegexMatcher::~RegexMatcher() {
-        pcre_free(RegexPatternPtr);
-        pcre_free(RegexExtraPtr);
+        Regexes::Release(*mCompiledRegex);
     }
 
     bool RegexMatcher::Matches(const string& text) {
-        return pcre_exec((pcre*)RegexPatternPtr,(pcre_extra*)RegexExtraPtr,text.data(),(int)text.size(),0,0,NULL,0)>=0;
+        return Matches(text.data(),text.size());
     }
 
     bool RegexMatcher::Matches(const char* text) {
-        return pcre_exec((pcre*)RegexPatternPtr,(pcre_extra*)RegexExtraPtr,text,(int)strlen(text),0,0,NULL,0)>=0;
+        return Matches(text,strlen(text));
+    }
+
+    bool RegexMatcher::Matches(const char* text, size_t length) {
+        const CompiledRegex& regex = *mCompiledRegex;
+        // The fast paths agree with the package on '.' and '$' as long as there are no newlines.
+        if (regex.Kind != RegexPatternKinds::Regex && memchr(text,'\n',length) == NULL) {
+            switch (regex.Kind) {
+                case RegexPatternKinds::Any:
+                    return true;
+                case RegexPatternKinds::NonEmpty:
+                    return length != 0;
+                default:
+                    return regex.MatchesLiterals(text,length);
+            }
+        }
+        return pcre_exec((pcre*)regex.RegexPatternPtr,(pcre_extra*)regex.RegexExtraPtr,
+            text,(int)length,0,0,NULL,0)>=0;
+    }
+
+    const string* RegexMatcher::GetExactLiteral() const {
+        const CompiledRegex& regex = *mCompiledRegex;
+        if (regex.Kind == RegexPatternKinds::Literals && regex.Literals.size() == 1
+                && regex.IsStartAnchored && regex.IsEndAnchored) {
+            return &regex.Literals[0];
+        }
+        return NULL;
     }
 
     const char Regexes::RegexSpecialCharacters[] = { '.','$','^','{','[','(','|',')','*','+','?','\\' };
     const string* Regexes::WildPatternString = NULL;
     const string* Regexes::AnyPatternString = NULL;
+    vector<CompiledRegex*>* Regexes::mBuckets = NULL;
+    CompiledRegex* Regexes::mNewest = NULL;
+    CompiledRegex* Regexes::mOldest = NULL;
+    int Regexes::mCacheCount = 0;
+    Mutex Regexes::mLock;
 
     void Regexes::Initializer() {
         WildPatternString = new string(".+");
@@ -49,6 +218,107 @@ namespace Plato {
     void Regexes::Finalizer() {
         delete WildPatternString;
         delete AnyPatternString;
+        MutexLock lock(mLock);
+        // Patterns still in use are left to be freed by Release.
+        CompiledRegex* regex = mOldest;
+        while (regex != NULL) {
+            CompiledRegex* newer = regex->mNewer;
+            regex->mNext = NULL;
+            regex->mNewer = NULL;
+            regex->mOlder = NULL;
+            if (regex->mUseCount == 0) {
+                delete regex;
+            }
+            regex = newer;
+        }
+        delete mBuckets;
+        mBuckets = NULL;
+        mNewest = NULL;
+        mOldest = NULL;
+        mCacheCount = 0;
+    }
+
+    CompiledRegex& Regexes::Acquire(const char* pattern, size_t length) {
+        uint32_t hash = Strings::SuperFastHash(pattern,(int)length);
+        MutexLock lock(mLock);
+        // Matchers may be created before the library is initialized.
+        if (mBuckets == NULL) {
+            mBuckets = new vector<CompiledRegex*>(2 * CacheCapacity, (CompiledRegex*)NULL);
+        }
+        CompiledRegex*& head = (*mBuckets)[hash & (mBuckets->size() - 1)];
+        CompiledRegex* regex;
+        for (regex = head; regex != NULL; regex = regex->mNext) {
+            if (regex->mHash == hash && regex->Pattern.size() == length
+                    && memcmp(regex->Pattern.data(), pattern, length) == 0) {
+                Unlink(*regex);
+                break;
+            }
+        }
+        if (regex == NULL) {
+            regex = new CompiledRegex(pattern, length, hash);
+            regex->mNext = head;
+            head = regex;
+            ++mCacheCount;
+        }
+        // Make it the most recently used.
+        regex->mOlder = mNewest;
+        if (mNewest != NULL) {
+            mNewest->mNewer = regex;
+        } else {
+            mOldest = regex;
+        }
+        mNewest = regex;
+        ++regex->mUseCount;
+        if (mCacheCount > CacheCapacity) {
+            Evict();
+        }
+        return *regex;
+    }
+
+    void Regexes::Release(CompiledRegex& regex) {
+        MutexLock lock(mLock);
+        // Patterns orphaned by the finalizer are no longer in the recently used list.
+        if (--regex.mUseCount == 0 && regex.mNewer == NULL && mNewest != &regex) {
+            delete &regex;
+        }
+    }
+
+    int Regexes::CacheCount() {
+        MutexLock lock(mLock);
+        return mCacheCount;
+    }
+
+    void Regexes::Unlink(CompiledRegex& regex) {
+        if (regex.mNewer != NULL) {
+            regex.mNewer->mOlder = regex.mOlder;
+        } else {
+            mNewest = regex.mOlder;
+        }
+        if (regex.mOlder != NULL) {
+            regex.mOlder->mNewer = regex.mNewer;
+        } else {
+            mOldest = regex.mNewer;
+        }
+        regex.mNewer = NULL;
+        regex.mOlder = NULL;
+    }
+
+    void Regexes::Evict() {
+        CompiledRegex* regex = mOldest;
+        while (regex != NULL && mCacheCount > CacheCapacity) {
+            CompiledRegex* newer = regex->mNewer;
+            if (regex->mUseCount == 0) {
+                Unlink(*regex);
+                CompiledRegex** link = &(*mBuckets)[regex->mHash & (mBuckets->size() - 1)];
+                while (*link != regex) {
+                    link = &(*link)->mNext;
+                }
+                *link = regex->mNext;
+                --mCacheCount;
+                delete regex;
+            }
+            regex = newer;
+        }
     }
 
     bool Regexes::Matches(const char* inputText, const char* regularExpression) {
@@ -89,6 +359,11 @@ namespace Plato {
     }
 
     bool Regexes::IsRegex(const char* inputText) {
-        return strcspn(inputText,RegexSpecialCharacters)!=strlen(inputText);
+        for (const char* c = inputText; *c != '\0'; ++c) {
+            if (memchr(RegexSpecialCharacters, *c, sizeof(RegexSpecialCharacters)) != NULL) {
+                return true;
+            }
+        }
+        return false;
     }
 }
@@ -1,6 +1,11 @@
 #include "PlatoIncludes.h"
 #include "Strings.h"
 
+// va_copy is C99, and only an extension in C++ before C++11.
+#if !defined(WIN32) && !defined(va_copy)
+#define va_copy(dest,src) __va_copy(dest,src)
+#endif
+
 namespace Plato {
 
 #undef get16bits
@@ -165,14 +170,19 @@ namespace Plato {
     }
 
     char* Strings::Sprintf(const char* format,va_list argPtr) {
-        va_list tmpPtr = argPtr;
 #ifdef WIN32
+        va_list tmpPtr = argPtr;
         int len = _vscprintf(format,argPtr)+1;
         char* charBuffer = new char[len];
         vsprintf_s(charBuffer,sizeof(char)*len,format,tmpPtr);
 #else
-        char* charBuffer = new char[1024];
-        vsprintf(charBuffer,format,tmpPtr);
+        // Measure first rather than assume a buffer size, using a copy as measuring consumes the arguments.
+        va_list tmpPtr;
+        va_copy(tmpPtr,argPtr);
+        int len = vsnprintf(NULL,0,format,argPtr)+1;
+        char* charBuffer = new char[len];
+        vsnprintf(charBuffer,len,format,tmpPtr);
+        va_end(tmpPtr);
 #endif
         return charBuffer;
     }
@@ -0,0 +1,193 @@
+#include "PlatoIncludes.h"
+#include "ThreadLocalVariable.h"
+#include "Mutex.h"
+#include "ThreadPool.h"
+#include "LogWriter.h"
+
+namespace Plato {
+
+#pragma region // Constructors.
+    ThreadPool::ThreadPool(int numberOfThreads, ThreadLocalVariable::Key contextKey, ThreadLocalVariable::ValuePtr contextValue) {
+        if (numberOfThreads <= 0) {
+            numberOfThreads = GetProcessorCount();
+        }
+        mContextKey = contextKey;
+        mContextValue = contextValue;
+        mQueuedCount = 0;
+        mSleepingCount = 0;
+        mIsStopping = false;
+        mWorkerKey = ThreadLocalVariable::GetKey();
+        // Slot 0 belongs to the threads outside of the pool, i.e. the thread running the model.
+        for (int index = 0; index < numberOfThreads; ++index) {
+            Worker* w = new Worker();
+            w->Pool = this;
+            w->Index = index;
+            mWorkers.push_back(w);
+        }
+        for (int index = 1; index < numberOfThreads; ++index) {
+            Worker* w = mWorkers[index];
+#ifdef WIN32
+            w->Thread = CreateThread(NULL, 0, WorkerStart, (LPVOID)w, 0, NULL);
+#else
+            pthread_create(&w->Thread, NULL, WorkerStart, (void*)w);
+#endif
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        mIdleLock.Lock();
+        mIsStopping = true;
+        mIdleCondition.Broadcast();
+        mIdleLock.Unlock();
+        // Join every worker before freeing any queue, since idle workers still try to steal.
+        vector<Worker*>::iterator itr;
+        for (itr = mWorkers.begin(); itr != mWorkers.end(); ++itr) {
+            Worker* w = *itr;
+            if (w->Index > 0) {
+#ifdef WIN32
+                WaitForSingleObject(w->Thread, INFINITE);
+                CloseHandle(w->Thread);
+#else
+                pthread_join(w->Thread, NULL);
+#endif
+            }
+        }
+        for (itr = mWorkers.begin(); itr != mWorkers.end(); ++itr) {
+            Worker* w = *itr;
+            TaskDeque::iterator titr;
+            for (titr = w->Queue.begin(); titr != w->Queue.end(); ++titr) {
+                delete *titr;
+            }
+            delete w;
+        }
+        ThreadLocalVariable::FreeKey(mWorkerKey);
+    }
+#pragma endregion
+
+#pragma region // Methods.
+    int ThreadPool::GetProcessorCount() {
+#ifdef WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        int count = (int)info.dwNumberOfProcessors;
+#else
+        int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+        return count < 1 ? 1 : count;
+    }
+
+    int ThreadPool::GetWorkerIndex() const {
+        // Zero is returned for threads outside the pool, which submit to slot 0.
+        size_t slot = (size_t)ThreadLocalVariable::GetVariableValue(mWorkerKey);
+        return slot > 0 ? (int)(slot - 1) : 0;
+    }
+
+    void ThreadPool::Submit(Task& task, TaskGroup& group) {
+        task.Group = &group;
+        Atomic::Increment(&group.Pending);
+        Worker* w = mWorkers[GetWorkerIndex()];
+        w->QueueLock.Lock();
+        w->Queue.push_back(&task);
+        w->QueueLock.Unlock();
+        // The count is raised before taking the idle lock, so a worker checking for work
+        // under the lock either sees the task or is already waiting for the signal.
+        Atomic::Increment(&mQueuedCount);
+        mIdleLock.Lock();
+        if (mSleepingCount > 0) {
+            mIdleCondition.Signal();
+        }
+        mIdleLock.Unlock();
+    }
+
+    ThreadPool::Task* ThreadPool::TryTake(int self) {
+        Task* task = NULL;
+        int count = (int)mWorkers.size();
+        // Pop the most recently pushed task from our own deque.
+        Worker* w = mWorkers[self];
+        w->QueueLock.Lock();
+        if (!w->Queue.empty()) {
+            task = w->Queue.back();
+            w->Queue.pop_back();
+        }
+        w->QueueLock.Unlock();
+        // Otherwise steal the oldest task from another deque.
+        for (int offset = 1; task == NULL && offset < count; ++offset) {
+            w = mWorkers[(self + offset) % count];
+            w->QueueLock.Lock();
+            if (!w->Queue.empty()) {
+                task = w->Queue.front();
+                w->Queue.pop_front();
+            }
+            w->QueueLock.Unlock();
+        }
+        if (task != NULL) {
+            Atomic::Decrement(&mQueuedCount);
+        }
+        return task;
+    }
+
+    void ThreadPool::Run(Task* task) {
+        TaskGroup* group = task->Group;
+        try {
+            task->Execute();
+        } catch (...) {
+            Atomic::Increment(&group->Failures);
+        }
+        delete task;
+        Atomic::Decrement(&group->Pending);
+    }
+
+    int ThreadPool::Wait(TaskGroup& group) {
+        int self = GetWorkerIndex();
+        while (group.Pending > 0) {
+            Task* task = TryTake(self);
+            if (task != NULL) {
+                Run(task);
+            } else {
+                // The remaining tasks are running on other threads.
+                Atomic::YieldThread();
+            }
+        }
+        return (int)group.Failures;
+    }
+
+    void ThreadPool::WorkerLoop(Worker& worker) {
+        ThreadLocalVariable::SetVariableValue(mWorkerKey, (ThreadLocalVariable::ValuePtr)(size_t)(worker.Index + 1));
+        ThreadLocalVariable::SetVariableValue(mContextKey, mContextValue);
+        for (;;) {
+            Task* task = TryTake(worker.Index);
+            if (task != NULL) {
+                Run(task);
+                continue;
+            }
+            mIdleLock.Lock();
+            while (mQueuedCount == 0 && !mIsStopping) {
+                ++mSleepingCount;
+                mIdleCondition.Wait(mIdleLock);
+                --mSleepingCount;
+            }
+            bool isStopping = mIsStopping;
+            mIdleLock.Unlock();
+            if (isStopping) {
+                break;
+            }
+        }
+    }
+
+#ifdef WIN32
+    DWORD WINAPI ThreadPool::WorkerStart(LPVOID arg) {
+        Worker* w = (Worker*)arg;
+        w->Pool->WorkerLoop(*w);
+        LogWriter::ReleaseRing();
+        return 0;
+    }
+#else
+    void* ThreadPool::WorkerStart(void* arg) {
+        Worker* w = (Worker*)arg;
+        w->Pool->WorkerLoop(*w);
+        LogWriter::ReleaseRing();
+        return NULL;
+    }
+#endif
+#pragma endregion
+}
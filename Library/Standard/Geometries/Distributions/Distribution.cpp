@@ -1,6 +1,8 @@
 #include "PlatoIncludes.h"
 #include "Numbers.h"
 #include "UnivariateDistribution.h"
+#include "UnivariateDistributionEnumerator.h"
+#include "UniformUnivariateDistribution.h"
 #include "CoordinateOperations.h"
 #include "CoordinateNames.h"
 #include "Point.h"
@@ -45,4 +47,8 @@ namespace Plato {
         // DEBUG: This could use GetPoint.
         return Numbers::OutOfRangeValue;
     }
+
+    UnivariateDistribution* Distribution::CreateUnivariateDistribution(CoordinateNamesEnum coordinate) const {
+        return new UniformUnivariateDistribution(mCapacity);
+    }
 }
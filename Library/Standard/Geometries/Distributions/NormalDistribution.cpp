@@ -24,6 +24,9 @@ namespace Plato {
 
     NormalDistribution::NormalDistribution(const NormalDistribution& distribution) {
         mCapacity = distribution.mCapacity;
+        for (int i = 0; i < 3; ++i) {
+            mUnivariateDistributions[i] = (NormalUnivariateDistribution*)distribution.mUnivariateDistributions[i]->Clone();
+        }
     }
 
     DistributionEnumerator* NormalDistribution::GetEnumerator() {
@@ -34,6 +37,13 @@ namespace Plato {
         return new NormalDistribution(*this);
     }
 
+    UnivariateDistribution* NormalDistribution::CreateUnivariateDistribution(CoordinateNamesEnum coordinate) const {
+        if (coordinate < 0 || coordinate >= 3) {
+            return Distribution::CreateUnivariateDistribution(coordinate);
+        }
+        return mUnivariateDistributions[coordinate]->Clone();
+    }
+
     NormalDistributionEnumerator::NormalDistributionEnumerator(NormalDistribution& distribution) 
             : DistributionEnumerator(distribution) {
         Reset();
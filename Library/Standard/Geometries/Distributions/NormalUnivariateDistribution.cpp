@@ -4,12 +4,67 @@
 #include "UnivariateDistributionEnumerator.h"
 #include "NormalUnivariateDistribution.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PLATO_SSE2
+#endif
+
 namespace Plato {
 
     const double NormalUnivariateDistribution::NormPulseCoeff = 0.5 / sqrt(2.0 * log(2.0));
     const float NormalUnivariateDistribution::DefaultSigma = 0.5f;
     const float NormalUnivariateDistribution::DefaultMean = 0.5f;
 
+#if defined(PLATO_SSE2)
+    /// <summary>
+    /// Computes the natural logarithm of four positive values, to within a few units in the last place.
+    /// </summary>
+    /// <remarks>
+    /// The value is split into an exponent and a mantissa in [sqrt(0.5),sqrt(2)),
+    /// and the logarithm of the mantissa found with the Cephes minimax polynomial.
+    /// Subnormal values, which the tails of narrow distributions reach, are scaled up by 2^23 first.
+    /// </remarks>
+    static __m128 LogLanes(__m128 x) {
+        const __m128 one = _mm_set1_ps(1.0f);
+        __m128 isSubnormal = _mm_cmplt_ps(x, _mm_set1_ps(FLT_MIN));
+        x = _mm_or_ps(_mm_and_ps(isSubnormal, _mm_mul_ps(x, _mm_set1_ps(8388608.0f))), _mm_andnot_ps(isSubnormal, x));
+        x = _mm_max_ps(x, _mm_set1_ps(FLT_MIN));
+        __m128i bits = _mm_castps_si128(x);
+        __m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0x7f)));
+        e = _mm_sub_ps(e, _mm_and_ps(isSubnormal, _mm_set1_ps(23.0f)));
+        // Mantissa in [0.5,1).
+        x = _mm_or_ps(_mm_castsi128_ps(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff))), _mm_set1_ps(0.5f));
+        e = _mm_add_ps(e, one);
+        __m128 isSmall = _mm_cmplt_ps(x, _mm_set1_ps(0.707106781186547524f));
+        __m128 tmp = _mm_and_ps(x, isSmall);
+        x = _mm_sub_ps(x, one);
+        e = _mm_sub_ps(e, _mm_and_ps(one, isSmall));
+        x = _mm_add_ps(x, tmp);
+        __m128 z = _mm_mul_ps(x, x);
+        __m128 y = _mm_set1_ps(7.0376836292E-2f);
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.1514610310E-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.1676998740E-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.2420140846E-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.4249322787E-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.6668057665E-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(2.0000714765E-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-2.4999993993E-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(3.3333331174E-1f));
+        y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+        y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+        y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+        x = _mm_add_ps(x, y);
+        return _mm_add_ps(x, _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+    }
+
+    /// <summary>
+    /// Selects lanes of a where mask is set, and of b elsewhere.
+    /// </summary>
+    static inline __m128 SelectLanes(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+#endif
+
     float NormalUnivariateDistribution::NormalisedSigma(int capacity) {
         return (float)(NormPulseCoeff / (float)(capacity == UnivariateDistribution::UnboundedCapacity ? 1 : capacity));
     }
@@ -42,6 +97,7 @@ namespace Plato {
         mGaussCoeff = (float)(-0.5 / (Sigma * Sigma));
         YLow = (float)(Gauss(UnivariateDistribution::MinimumX));
         YHigh = (float)(Gauss(UnivariateDistribution::MaximumX));
+        SetCapacity(capacity);
     }
 
     NormalUnivariateDistribution::~NormalUnivariateDistribution() {
@@ -49,6 +105,7 @@ namespace Plato {
 
     NormalUnivariateDistribution::NormalUnivariateDistribution(const NormalUnivariateDistribution& distribution) {
         mCapacity = distribution.mCapacity;
+        mDivisor = distribution.mDivisor;
         Mean = distribution.Mean;
         Sigma = distribution.Sigma;
         mGaussCoeff = distribution.mGaussCoeff;
@@ -89,6 +146,49 @@ namespace Plato {
         return (float)(Mean - InverseGauss(y));
     }
 
+    int NormalUnivariateDistribution::Fill(int first, int count, float* values) {
+        if (first < 0) {
+            return 0;
+        }
+        int available = mDivisor - first + 1;
+        int filled = count < available ? count : available;
+        if (filled <= 0) {
+            return 0;
+        }
+        int index = 0;
+#if defined(PLATO_SSE2)
+        if (mDivisor != 0) {
+            // Both halves of the indexer are evaluated and the lanes selected by which half a lies in.
+            const __m128 one = _mm_set1_ps(UnivariateDistribution::MaximumY);
+            const __m128 two = _mm_set1_ps(2.0f);
+            __m128 divisor = _mm_set1_ps((float)mDivisor);
+            __m128 half = _mm_set1_ps(DefaultMean);
+            __m128 yHigh = _mm_set1_ps(YHigh);
+            __m128 yLow = _mm_set1_ps(YLow);
+            __m128 mean = _mm_set1_ps(Mean);
+            __m128 sigma = _mm_set1_ps(Sigma);
+            __m128i step = _mm_set1_epi32(4);
+            __m128i indices = _mm_add_epi32(_mm_set1_epi32(first), _mm_set_epi32(3, 2, 1, 0));
+            for (; index + 4 <= filled; index += 4) {
+                __m128 a = _mm_div_ps(_mm_cvtepi32_ps(indices), divisor);
+                __m128 isHigh = _mm_cmpge_ps(a, half);
+                __m128 high = _mm_add_ps(yHigh, _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(one, yHigh), two), _mm_sub_ps(one, a)));
+                __m128 low = _mm_add_ps(yLow, _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(one, yLow), two), a));
+                __m128 y = SelectLanes(isHigh, high, low);
+                // InverseGauss: Sigma * sqrt(2 * log(1 / y)), or zero when y is not positive.
+                __m128 squared = _mm_max_ps(_mm_mul_ps(_mm_set1_ps(-2.0f), LogLanes(y)), _mm_setzero_ps());
+                __m128 offset = _mm_and_ps(_mm_mul_ps(sigma, _mm_sqrt_ps(squared)), _mm_cmpgt_ps(y, _mm_setzero_ps()));
+                _mm_storeu_ps(values + index, SelectLanes(isHigh, _mm_add_ps(mean, offset), _mm_sub_ps(mean, offset)));
+                indices = _mm_add_epi32(indices, step);
+            }
+        }
+#endif
+        for (; index < filled; ++index) {
+            values[index] = NormalUnivariateDistribution::operator[](first + index);
+        }
+        return filled;
+    }
+
     NormalUnivariateDistributionEnumerator::NormalUnivariateDistributionEnumerator(NormalUnivariateDistribution& distribution)
         : UnivariateDistributionEnumerator(distribution) {
         Reset();
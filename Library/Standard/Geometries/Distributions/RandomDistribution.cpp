@@ -0,0 +1,71 @@
+#include "PlatoIncludes.h"
+#include "Numbers.h"
+#include "Strings.h"
+#include "ClassTypeInfo.h"
+#include "Identifier.h"
+#include "PropertyScopes.h"
+#include "PropertyModes.h"
+#include "Property.h"
+#include "ThreadLocalVariable.h"
+#include "ConfigurePhases.h"
+#include "ResolutionModes.h"
+#include "Container.h"
+#include "Model.h"
+#include "CoordinateOperations.h"
+#include "CoordinateNames.h"
+#include "Point.h"
+#include "PointSpace.h"
+#include "RandomStream.h"
+#include "UnivariateDistribution.h"
+#include "UnivariateDistributionEnumerator.h"
+#include "RandomUnivariateDistribution.h"
+#include "Distribution.h"
+#include "DistributionEnumerator.h"
+#include "RandomDistribution.h"
+
+namespace Plato {
+
+    RandomDistribution::RandomDistribution(const Property& owner, int aCapacity, int bCapacity, int cCapacity)
+        : Distribution(aCapacity) {
+        int capacities[3] = { aCapacity, bCapacity, cCapacity };
+        RandomStream* stream = Model::Current().CreateRandomStream(owner);
+        for (int i = 0; i < 3; ++i) {
+            stream->Seek(i * CoordinateStride);
+            mUnivariateDistributions[i] = new RandomUnivariateDistribution(capacities[i], *stream);
+        }
+        delete stream;
+    }
+
+    RandomDistribution::RandomDistribution(const RandomDistribution& distribution)
+        : Distribution(distribution) {
+        for (int i = 0; i < 3; ++i) {
+            mUnivariateDistributions[i] = (RandomUnivariateDistribution*)distribution.mUnivariateDistributions[i]->Clone();
+        }
+    }
+
+    RandomDistribution::~RandomDistribution() {
+        for (int i = 0; i < 3; ++i) {
+            delete mUnivariateDistributions[i];
+        }
+    }
+
+    DistributionEnumerator* RandomDistribution::GetEnumerator() {
+        return new RandomDistributionEnumerator(*this);
+    }
+
+    Distribution* RandomDistribution::Clone() const {
+        return new RandomDistribution(*this);
+    }
+
+    UnivariateDistribution* RandomDistribution::CreateUnivariateDistribution(CoordinateNamesEnum coordinate) const {
+        if (coordinate < 0 || coordinate >= 3) {
+            return Distribution::CreateUnivariateDistribution(coordinate);
+        }
+        return mUnivariateDistributions[coordinate]->Clone();
+    }
+
+    RandomDistributionEnumerator::RandomDistributionEnumerator(RandomDistribution& distribution)
+        : DistributionEnumerator(distribution) {
+        Reset();
+    }
+}
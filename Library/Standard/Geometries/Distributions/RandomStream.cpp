@@ -0,0 +1,204 @@
+#include "PlatoIncludes.h"
+#include "RandomStream.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PLATO_SSE2
+#endif
+
+namespace Plato {
+
+    // The Philox4x32 multipliers and Weyl sequence key increments.
+    static const uint32_t Multiplier0 = 0xD2511F53u;
+    static const uint32_t Multiplier1 = 0xCD9E8D57u;
+    static const uint32_t KeyIncrement0 = 0x9E3779B9u;
+    static const uint32_t KeyIncrement1 = 0xBB67AE85u;
+    static const int NumberOfRounds = 10;
+    // 2^-24, to map the top 24 bits of a value onto [0,1).
+    static const float FloatScale = 1.0f / 16777216.0f;
+
+    static inline float ToFloat(uint32_t value) {
+        return (float)(value >> 8) * FloatScale;
+    }
+
+#ifdef PLATO_SSE2
+    // Multiplies each lane by m, giving the high and low 32 bits of the 64 bit products.
+    static inline void MultiplyLanes(__m128i a, __m128i m, __m128i& high, __m128i& low) {
+        const __m128i evenLanes = _mm_set_epi32(0, -1, 0, -1);
+        __m128i even = _mm_mul_epu32(a, m);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+        low = _mm_or_si128(_mm_and_si128(even, evenLanes), _mm_slli_epi64(odd, 32));
+        high = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_andnot_si128(evenLanes, odd));
+    }
+#endif
+
+#pragma region // Constructors.
+    RandomStream::RandomStream(uint32_t seed, uint32_t stream, uint32_t epoch) {
+        mKey[0] = seed;
+        mKey[1] = stream;
+        SetEpoch(epoch);
+    }
+#pragma endregion
+
+#pragma region // Methods.
+    void RandomStream::Generate(const uint32_t key[2], const uint32_t counter[BlockSize], uint32_t result[BlockSize]) {
+        uint32_t k0 = key[0];
+        uint32_t k1 = key[1];
+        uint32_t c0 = counter[0];
+        uint32_t c1 = counter[1];
+        uint32_t c2 = counter[2];
+        uint32_t c3 = counter[3];
+        for (int round = 0; round < NumberOfRounds; ++round) {
+            uint64_t p0 = (uint64_t)Multiplier0 * c0;
+            uint64_t p1 = (uint64_t)Multiplier1 * c2;
+            c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+            c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+            c1 = (uint32_t)p1;
+            c3 = (uint32_t)p0;
+            k0 += KeyIncrement0;
+            k1 += KeyIncrement1;
+        }
+        result[0] = c0;
+        result[1] = c1;
+        result[2] = c2;
+        result[3] = c3;
+    }
+
+    void RandomStream::SetEpoch(uint32_t epoch) {
+        mEpoch = epoch;
+        Seek(0);
+    }
+
+    void RandomStream::Seek(uint64_t position) {
+        mBlock = position / BlockSize;
+        mBufferIndex = BlockSize;
+        int offset = (int)(position % BlockSize);
+        if (offset != 0) {
+            NextBlock();
+            mBufferIndex = offset;
+        }
+    }
+
+    uint32_t RandomStream::NextUInt() {
+        if (mBufferIndex == BlockSize) {
+            NextBlock();
+        }
+        return mBuffer[mBufferIndex++];
+    }
+
+    double RandomStream::NextDouble() {
+        uint32_t a = NextUInt() >> 5;
+        uint32_t b = NextUInt() >> 6;
+        return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+    }
+
+    float RandomStream::NextFloat() {
+        return ToFloat(NextUInt());
+    }
+
+    int RandomStream::Next(int maxValue) {
+        if (maxValue < 1) {
+            return 0;
+        }
+        return (int)(maxValue * NextDouble());
+    }
+
+    void RandomStream::Fill(float* values, int count) {
+        // Finish the buffered block, then generate whole blocks a chunk at a time.
+        const int chunkSize = 64;
+        uint32_t chunk[chunkSize];
+        int index = 0;
+        while (index < count && mBufferIndex < BlockSize) {
+            values[index++] = ToFloat(mBuffer[mBufferIndex++]);
+        }
+        while (count - index >= BlockSize) {
+            int blocks = (count - index) / BlockSize;
+            if (blocks > chunkSize / BlockSize) {
+                blocks = chunkSize / BlockSize;
+            }
+            GenerateBlocks(chunk, blocks);
+            int n = blocks * BlockSize;
+            int i = 0;
+#ifdef PLATO_SSE2
+            const __m128 scale = _mm_set1_ps(FloatScale);
+            for (; i < n; i += BlockSize) {
+                __m128i u = _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(chunk + i)), 8);
+                _mm_storeu_ps(values + index + i, _mm_mul_ps(_mm_cvtepi32_ps(u), scale));
+            }
+#endif
+            for (; i < n; ++i) {
+                values[index + i] = ToFloat(chunk[i]);
+            }
+            index += n;
+        }
+        while (index < count) {
+            values[index++] = NextFloat();
+        }
+    }
+
+    void RandomStream::Fill(uint32_t* values, int count) {
+        int index = 0;
+        while (index < count && mBufferIndex < BlockSize) {
+            values[index++] = mBuffer[mBufferIndex++];
+        }
+        int blocks = (count - index) / BlockSize;
+        GenerateBlocks(values + index, blocks);
+        index += blocks * BlockSize;
+        while (index < count) {
+            values[index++] = NextUInt();
+        }
+    }
+
+    void RandomStream::NextBlock() {
+        uint32_t counter[BlockSize] = { (uint32_t)mBlock, (uint32_t)(mBlock >> 32), mEpoch, 0 };
+        Generate(mKey, counter, mBuffer);
+        ++mBlock;
+        mBufferIndex = 0;
+    }
+
+    void RandomStream::GenerateBlocks(uint32_t* values, int count) {
+        int block = 0;
+#ifdef PLATO_SSE2
+        // Four blocks at a time, one per lane, while the low counter word does not wrap within the group.
+        const __m128i m0 = _mm_set1_epi32((int)Multiplier0);
+        const __m128i m1 = _mm_set1_epi32((int)Multiplier1);
+        for (; block + BlockSize <= count && (uint32_t)mBlock <= 0xFFFFFFFFu - BlockSize; block += BlockSize) {
+            uint32_t low = (uint32_t)mBlock;
+            __m128i c0 = _mm_set_epi32((int)(low + 3), (int)(low + 2), (int)(low + 1), (int)low);
+            __m128i c1 = _mm_set1_epi32((int)(uint32_t)(mBlock >> 32));
+            __m128i c2 = _mm_set1_epi32((int)mEpoch);
+            __m128i c3 = _mm_setzero_si128();
+            uint32_t k0 = mKey[0];
+            uint32_t k1 = mKey[1];
+            for (int round = 0; round < NumberOfRounds; ++round) {
+                __m128i high0, low0, high1, low1;
+                MultiplyLanes(c0, m0, high0, low0);
+                MultiplyLanes(c2, m1, high1, low1);
+                c0 = _mm_xor_si128(_mm_xor_si128(high1, c1), _mm_set1_epi32((int)k0));
+                c2 = _mm_xor_si128(_mm_xor_si128(high0, c3), _mm_set1_epi32((int)k1));
+                c1 = low1;
+                c3 = low0;
+                k0 += KeyIncrement0;
+                k1 += KeyIncrement1;
+            }
+            // Transpose so each block's four words are stored together.
+            __m128i t0 = _mm_unpacklo_epi32(c0, c1);
+            __m128i t1 = _mm_unpacklo_epi32(c2, c3);
+            __m128i t2 = _mm_unpackhi_epi32(c0, c1);
+            __m128i t3 = _mm_unpackhi_epi32(c2, c3);
+            __m128i* out = (__m128i*)(values + block * BlockSize);
+            _mm_storeu_si128(out, _mm_unpacklo_epi64(t0, t1));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi64(t0, t1));
+            _mm_storeu_si128(out + 2, _mm_unpacklo_epi64(t2, t3));
+            _mm_storeu_si128(out + 3, _mm_unpackhi_epi64(t2, t3));
+            mBlock += BlockSize;
+        }
+#endif
+        for (; block < count; ++block) {
+            uint32_t counter[BlockSize] = { (uint32_t)mBlock, (uint32_t)(mBlock >> 32), mEpoch, 0 };
+            Generate(mKey, counter, values + block * BlockSize);
+            ++mBlock;
+        }
+    }
+#pragma endregion
+}
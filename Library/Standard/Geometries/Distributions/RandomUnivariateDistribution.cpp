@@ -1,26 +1,35 @@
 #include "PlatoIncludes.h"
 #include "Numbers.h"
-#include "Random.h"
+#include "RandomStream.h"
 #include "UnivariateDistribution.h"
 #include "UnivariateDistributionEnumerator.h"
 #include "RandomUnivariateDistribution.h"
 
 namespace Plato {
 
-    RandomUnivariateDistribution::RandomUnivariateDistribution(int capacity) 
+    RandomUnivariateDistribution::RandomUnivariateDistribution(int capacity, uint32_t seed) 
         : UnivariateDistribution(capacity) {
         mDistributionValues = NULL;
+        mStream = new RandomStream(seed);
+        Reset();
+    }
+
+    RandomUnivariateDistribution::RandomUnivariateDistribution(int capacity, const RandomStream& stream)
+        : UnivariateDistribution(capacity) {
+        mDistributionValues = NULL;
+        mStream = new RandomStream(stream);
         Reset();
     }
 
     RandomUnivariateDistribution::RandomUnivariateDistribution(const RandomUnivariateDistribution& distribution) {
         mCapacity = distribution.mCapacity;
-        mDistributionValues = NULL;
-        // DEBUG: To do: Copy mDistributionValues.
+        mStream = new RandomStream(*distribution.mStream);
+        mDistributionValues = new vector<float>(*distribution.mDistributionValues);
     }
 
     RandomUnivariateDistribution::~RandomUnivariateDistribution() {
         delete mDistributionValues;
+        delete mStream;
     }
 
     UnivariateDistributionEnumerator* RandomUnivariateDistribution::GetEnumerator() {
@@ -37,18 +46,29 @@ namespace Plato {
         if(mDistributionValues!=NULL) {
             mDistributionValues->clear();
         } else {
-            mDistributionValues = new vector<float>(mCapacity);
+            mDistributionValues = new vector<float>();
         }
-        Random& rnd = *new Random();
+        if (mCapacity <= 0) {
+            return;
+        }
+        vector<float>& values = *mDistributionValues;
+        RandomStream rnd(*mStream);
         float maxValue = (1.0f + (float)mCapacity) * 1000.0f;
         float divisor = maxValue - 1.0f;
-        int index = 0;
-        while ((int)mDistributionValues->size() < mCapacity) {
-            float r = (float)((rnd.NextDouble() * maxValue) / divisor); // Map r to [0.0,1.0].
-            if (r > UnivariateDistribution::MaximumX) {
-                r = UnivariateDistribution::MaximumX;
+        // Draw in bulk, then top up with fresh values for any duplicates removed.
+        while ((int)values.size() < mCapacity) {
+            int size = (int)values.size();
+            values.resize(mCapacity);
+            rnd.Fill(&values[size], mCapacity - size);
+            for (int index = size; index < mCapacity; ++index) {
+                float r = (values[index] * maxValue) / divisor; // Map r to [0.0,1.0].
+                values[index] = r > UnivariateDistribution::MaximumX ? UnivariateDistribution::MaximumX : r;
+            }
+            sort(values.begin(), values.end());
+            if (mCapacity <= 1 << 24) {
+                // Beyond 2^24 values there are not enough distinct floats, so duplicates are kept.
+                values.erase(unique(values.begin(), values.end()), values.end());
             }
-            (*mDistributionValues)[index++] = r;
         }
     }
 
@@ -63,6 +83,17 @@ namespace Plato {
         return (*mDistributionValues)[index];
     }
 
+    int RandomUnivariateDistribution::Fill(int first, int count, float* values) {
+        int size = (int)mDistributionValues->size();
+        if (first < 0 || first >= size) {
+            return 0;
+        }
+        int filled = count < size - first ? count : size - first;
+        // The values are drawn when the capacity is set, so a run is a block copy.
+        memcpy(values, &(*mDistributionValues)[first], filled * sizeof(float));
+        return filled;
+    }
+
     RandomUnivariateDistributionEnumerator::RandomUnivariateDistributionEnumerator(RandomUnivariateDistribution& distribution)
         : UnivariateDistributionEnumerator(distribution) {
         Reset();
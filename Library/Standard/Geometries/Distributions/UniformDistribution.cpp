@@ -7,6 +7,7 @@
 #include "UnivariateDistribution.h"
 #include "UnivariateDistributionEnumerator.h"
 #include "NormalUnivariateDistribution.h"
+#include "UniformUnivariateDistribution.h"
 #include "Distribution.h"
 #include "DistributionEnumerator.h"
 #include "UniformDistribution.h"
@@ -21,6 +22,9 @@ namespace Plato {
     }
     UniformDistribution::UniformDistribution(const UniformDistribution& distribution) {
         mCapacity = distribution.mCapacity;
+        for (int i = 0; i < 3; ++i) {
+            mCapacities[i] = distribution.mCapacities[i];
+        }
     }
     
     UniformDistribution::~UniformDistribution() {
@@ -34,6 +38,13 @@ namespace Plato {
         return new UniformDistribution(*this);
     }
 
+    UnivariateDistribution* UniformDistribution::CreateUnivariateDistribution(CoordinateNamesEnum coordinate) const {
+        if (coordinate < 0 || coordinate >= 3) {
+            return Distribution::CreateUnivariateDistribution(coordinate);
+        }
+        return new UniformUnivariateDistribution(mCapacities[coordinate]);
+    }
+
     UniformDistributionEnumerator::UniformDistributionEnumerator(UniformDistribution& distribution)
         : DistributionEnumerator(distribution) {
     }
@@ -4,14 +4,21 @@
 #include "UnivariateDistributionEnumerator.h"
 #include "UniformUnivariateDistribution.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PLATO_SSE2
+#endif
+
 namespace Plato {
 
     UniformUnivariateDistribution::UniformUnivariateDistribution(int capacity) 
         : UnivariateDistribution(capacity) {    
+        SetCapacity(capacity);
     }
 
     UniformUnivariateDistribution::UniformUnivariateDistribution(const UniformUnivariateDistribution& distribution) {
         mCapacity = distribution.mCapacity;
+        mDivisor = distribution.mDivisor;
     }
 
     UniformUnivariateDistribution::~UniformUnivariateDistribution() {
@@ -39,6 +46,35 @@ namespace Plato {
         return (float)((float)(index) / (float)mDivisor);
     }
 
+    int UniformUnivariateDistribution::Fill(int first, int count, float* values) {
+        if (first < 0) {
+            return 0;
+        }
+        int available = (int)mDivisor - first + 1;
+        int filled = count < available ? count : available;
+        if (filled <= 0) {
+            return 0;
+        }
+        if (mDivisor == 0) {
+            values[0] = 0.0f;
+            return filled;
+        }
+        int index = 0;
+#if defined(PLATO_SSE2)
+        __m128 divisor = _mm_set1_ps(mDivisor);
+        __m128i step = _mm_set1_epi32(4);
+        __m128i indices = _mm_add_epi32(_mm_set1_epi32(first), _mm_set_epi32(3, 2, 1, 0));
+        for (; index + 4 <= filled; index += 4) {
+            _mm_storeu_ps(values + index, _mm_div_ps(_mm_cvtepi32_ps(indices), divisor));
+            indices = _mm_add_epi32(indices, step);
+        }
+#endif
+        for (; index < filled; ++index) {
+            values[index] = (float)(first + index) / mDivisor;
+        }
+        return filled;
+    }
+
     UniformUnivariateDistributionEnumerator::UniformUnivariateDistributionEnumerator(UniformUnivariateDistribution& distribution) 
         : UnivariateDistributionEnumerator(distribution) {
     }
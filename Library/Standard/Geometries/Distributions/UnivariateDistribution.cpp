@@ -1,4 +1,5 @@
 #include "PlatoIncludes.h"
+#include "Numbers.h"
 #include "UnivariateDistribution.h"
 
 namespace Plato {
@@ -40,4 +41,16 @@ namespace Plato {
     float UnivariateDistribution::operator[](int index) {
         return 0.0f;
     }
+
+    int UnivariateDistribution::Fill(int first, int count, float* values) {
+        int filled = 0;
+        while (filled < count) {
+            float value = (*this)[first + filled];
+            if (value == Numbers::OutOfRangeValue) {
+                break;
+            }
+            values[filled++] = value;
+        }
+        return filled;
+    }
 }
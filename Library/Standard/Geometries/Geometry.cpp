@@ -1,8 +1,11 @@
 #include "PlatoIncludes.h"
+#include "Mutex.h"
+#include "ModelArena.h"
 #include "Numbers.h"
 #include "CoordinateNames.h"
 #include "CoordinateOperations.h"
 #include "Point.h"
+#include "PointBatch.h"
 #include "Bounds.h"
 #include "Size.h"
 #include "Scale.h"
@@ -58,6 +61,14 @@ namespace Plato {
         delete PointDistribution;
     }
 
+    void* Geometry::operator new(size_t size) {
+        return ModelArena::New(size);
+    }
+
+    void Geometry::operator delete(void* memory) {
+        ModelArena::Delete(memory);
+    }
+
     const Point& Geometry::GetUpperLimitPoint() {
         return *UpperLimitPoint;
     }
@@ -85,6 +96,22 @@ namespace Plato {
         return NULL;
     }
 
+    int Geometry::GetPoints(CoordinateOperationsEnum operation, PointBatch& batch) {
+        batch.Count = 0;
+        while (batch.Count < batch.Capacity) {
+            Point* point = GetPoint(operation, NULL);
+            if (point == NULL) {
+                break;
+            }
+            for (int i = 0; i < Point::NumberOfCoordinates; ++i) {
+                batch.Coordinates[i][batch.Count] = point->Coordinates[i];
+            }
+            delete point;
+            ++batch.Count;
+        }
+        return batch.Count;
+    }
+
     float Geometry::GetCoordinate(CoordinateOperationsEnum operation, CoordinateNamesEnum coordinate, const PointSpace* pointSpace) {
         // DEBUG: This could use GetPoint.
         return Numbers::OutOfRangeValue;
@@ -3,6 +3,7 @@
 #include "CoordinateNames.h"
 #include "CoordinateOperations.h"
 #include "Point.h"
+#include "PointBatch.h"
 #include "Bounds.h"
 #include "Size.h"
 #include "Scale.h"
@@ -19,57 +20,76 @@ namespace Plato {
 
     LayerGeometry::LayerGeometry(Bounds& bounds, Scale& scale, Point* orientation, Distribution& distribution) 
         : Geometry(bounds, scale, orientation, distribution) {
+        mDX = NULL;
+        mDY = NULL;
         Reset();
     }
 
     LayerGeometry::LayerGeometry(int capacityX, int capacityY) 
         : Geometry(*new Bounds(*new Size((float)capacityX, (float)capacityY, 1.0f, Numbers::UnboundedValue)),
             *new Scale(*Scale::Unity), NULL, *new UniformDistribution()) {
+        mDX = NULL;
+        mDY = NULL;
         Reset();
     }
 
-    void LayerGeometry::Reset() {
-        mDX = PointDistribution->Clone();
-        mDX->SetCapacity((int)(InternalBounds->Width->Sizes[CoordinateNames::X]));
-        mEX = NULL;
+    LayerGeometry::~LayerGeometry() {
+        delete mDX;
+        delete mDY;
+    }
 
-        mDY = PointDistribution->Clone();
-        mDY->SetCapacity((int)(InternalBounds->Width->Sizes[CoordinateNames::Y]));
-        mEY = NULL;
+    void LayerGeometry::Reset() {
+        // The distributions are created when the first point is allocated.
+        delete mDX;
+        mDX = NULL;
+        delete mDY;
+        mDY = NULL;
+        mNextColumn = 0;
+        mNextRow = 0;
     }
 
     Point* LayerGeometry::GetPoint(CoordinateOperationsEnum operation, const PointSpace& pointSpace) {
-        switch (operation) {
-            case CoordinateOperations::New:
-                // Fetch the next new point.
-                // Uses two enumerators, but could use counters via the distribution indexers.
-                // Returns a new point or NULL if full.
-                if (mEY == NULL) {
-                    mEY = mDY->GetEnumerator();
-                    if (!mEY->MoveNext()) {
-                        return NULL;
-                    }
-                }
-
-                if (mEX == NULL) {
-                    mEX = mDX->GetEnumerator();
-                }
+        // Fetch the next new point, or NULL if full.
+        float values[Point::NumberOfCoordinates];
+        PointBatch batch(1, values);
+        return GetPoints(operation, batch) == 0 ? NULL : batch.GetPoint(0);
+    }
 
-                while (!mEX->MoveNext()) {
-                    if (!mEY->MoveNext()) {
-                        return NULL;
-                    }
-                    mEX = mDX->GetEnumerator();
+    int LayerGeometry::GetPoints(CoordinateOperationsEnum operation, PointBatch& batch) {
+        if (operation != CoordinateOperations::New) {
+            return Geometry::GetPoints(operation, batch);
+        }
+        float widthX = InternalBounds->Width->Sizes[CoordinateNames::X];
+        float widthY = InternalBounds->Width->Sizes[CoordinateNames::Y];
+        if (mDX == NULL) {
+            mDX = PointDistribution->CreateUnivariateDistribution(CoordinateNames::X);
+            mDX->SetCapacity((int)widthX);
+            mDY = PointDistribution->CreateUnivariateDistribution(CoordinateNames::Y);
+            mDY->SetCapacity((int)widthY);
+        }
+        float* xs = batch.Coordinates[CoordinateNames::X];
+        float* ys = batch.Coordinates[CoordinateNames::Y];
+        float y;
+        // Fill the rest of the current row, then move on to the next row, until the batch or layer is full.
+        batch.Count = 0;
+        while (batch.Count < batch.Capacity && mDY->Fill(mNextRow, 1, &y) == 1) {
+            int filled = mDX->Fill(mNextColumn, batch.Capacity - batch.Count, xs + batch.Count);
+            if (filled == 0) {
+                if (mNextColumn == 0) {
+                    // The rows are empty.
+                    break;
                 }
-
-                return new Point( // DEBUG: Sort out.
-                    0.0f, // (float)((float)(mEX->Current) * InternalBounds->Width->Sizes[CoordinateNames::X]),
-                    0.0f, // (float)((float)(mEY->Current) * InternalBounds->Width->Sizes[CoordinateNames::Y]),
-                    0.0f,
-                    0.0f);
-            default:
-                break;
+                ++mNextRow;
+                mNextColumn = 0;
+                continue;
+            }
+            fill(ys + batch.Count, ys + batch.Count + filled, y * widthY);
+            mNextColumn += filled;
+            batch.Count += filled;
         }
-        return NULL;
+        batch.ScaleCoordinate(CoordinateNames::X, 0, widthX);
+        batch.SetCoordinate(CoordinateNames::Z, 0, 0.0f);
+        batch.SetCoordinate(CoordinateNames::OverLayID, 0, 0.0f);
+        return batch.Count;
     }
 }
@@ -3,6 +3,7 @@
 #include "CoordinateNames.h"
 #include "CoordinateOperations.h"
 #include "Point.h"
+#include "PointBatch.h"
 #include "Bounds.h"
 #include "Size.h"
 #include "Scale.h"
@@ -18,52 +19,57 @@ namespace Plato {
 
     PipeGeometry::PipeGeometry(Bounds& bounds, Scale& scale, Point* orientation, Distribution& distribution) 
         : Geometry(bounds, scale, orientation, distribution) {
+        mDX = NULL;
         Reset();
     }
 
     PipeGeometry::PipeGeometry(int capacityX) 
         : Geometry(*new Bounds(*new Size((float)capacityX, 1.0f, 1.0f, Numbers::UnboundedValue)), 
         *new Scale(*Scale::Unity), NULL, *new UniformDistribution()) {
+        mDX = NULL;
         Reset();
     }
 
     PipeGeometry::PipeGeometry(float capacityX) 
         : Geometry(*new Bounds(*new Size(capacityX, 1.0f, 1.0f, Numbers::UnboundedValue)), 
         * new Scale(*Scale::Unity), NULL, *new UniformDistribution()) {
+        mDX = NULL;
         Reset();
     }
 
     PipeGeometry::~PipeGeometry() {
         delete mDX;
-        delete mEX;
     }
 
     void PipeGeometry::Reset() {
-        mDX = PointDistribution->Clone();
-        mDX->SetCapacity((int)(InternalBounds->Width->Sizes[CoordinateNames::X]));
-        mEX = NULL;
+        // The distribution is created when the first point is allocated.
+        delete mDX;
+        mDX = NULL;
+        mNextIndex = 0;
     }
 
     Point* PipeGeometry::GetPoint(CoordinateOperationsEnum operation, const PointSpace& pointSpace) {
-        switch(operation) {
-            case CoordinateOperations::New:
-                // Fetch the next new point.
-                // Uses one enumerator, but could use a counter via the distribution indexer.
-                // Returns a new point or NULL if full.
-                if (mEX == NULL) {
-                    mEX = mDX->GetEnumerator();
-                }
-
-                if (!mEX->MoveNext()) {
-                    return NULL;
-                }
+        // Fetch the next new point, or NULL if full.
+        float values[Point::NumberOfCoordinates];
+        PointBatch batch(1, values);
+        return GetPoints(operation, batch) == 0 ? NULL : batch.GetPoint(0);
+    }
 
-                return new Point( // DEBUG: Sort out.
-                    0.0f, // (float)(mEX->Current) * mBounds->Size.WX, 
-                    0.0f, 0.0f, 0.0f);
-            default:
-                break;
+    int PipeGeometry::GetPoints(CoordinateOperationsEnum operation, PointBatch& batch) {
+        if (operation != CoordinateOperations::New) {
+            return Geometry::GetPoints(operation, batch);
+        }
+        float widthX = InternalBounds->Width->Sizes[CoordinateNames::X];
+        if (mDX == NULL) {
+            mDX = PointDistribution->CreateUnivariateDistribution(CoordinateNames::X);
+            mDX->SetCapacity((int)widthX);
         }
-        return NULL;
+        batch.Count = mDX->Fill(mNextIndex, batch.Capacity, batch.Coordinates[CoordinateNames::X]);
+        mNextIndex += batch.Count;
+        batch.ScaleCoordinate(CoordinateNames::X, 0, widthX);
+        batch.SetCoordinate(CoordinateNames::Y, 0, 0.0f);
+        batch.SetCoordinate(CoordinateNames::Z, 0, 0.0f);
+        batch.SetCoordinate(CoordinateNames::OverLayID, 0, 0.0f);
+        return batch.Count;
     }
 }
@@ -16,6 +16,8 @@
 #include "Translator.h"
 #include "Transducer.h"
 #include "PathEnumerator.h"
+#include "Mutex.h"
+#include "SignalArena.h"
 #include "Pad.h"
 #include "InputPad.h"
 #include "OutputPad.h"
@@ -194,11 +196,11 @@ namespace Plato {
 
     bool Connector::ConnectGroupsOneToOne(GroupContainer& toGroup, GroupContainer& fromGroup) {
 
-        vector<Property*> * toProperties = toGroup.OrderedProperties;
+        vector<Property*> * toProperties = toGroup.GetOrderedProperties();
         vector<Property*>::iterator toItr = toProperties->begin();
         vector<Property*>::iterator toEnd = toProperties->end();
 
-        vector<Property*> * fromProperties = fromGroup.OrderedProperties;
+        vector<Property*> * fromProperties = fromGroup.GetOrderedProperties();
         vector<Property*>::iterator fromItr = fromProperties->begin();
         vector<Property*>::iterator fromEnd = fromProperties->end();
 
@@ -226,11 +228,11 @@ namespace Plato {
 
     bool Connector::ConnectGroupsFanIn(GroupContainer& toGroup, GroupContainer& fromGroup) {
 
-        vector<Property*> * toProperties = toGroup.OrderedProperties;
+        vector<Property*> * toProperties = toGroup.GetOrderedProperties();
         vector<Property*>::iterator toItr = toProperties->begin();
         vector<Property*>::iterator toEnd = toProperties->end();
 
-        vector<Property*> * fromProperties = fromGroup.OrderedProperties;
+        vector<Property*> * fromProperties = fromGroup.GetOrderedProperties();
         vector<Property*>::iterator fromItr = fromProperties->begin();
         vector<Property*>::iterator fromEnd = fromProperties->end();
 
@@ -260,11 +262,11 @@ namespace Plato {
     }
 
     bool Connector::ConnectGroupsFanOut(GroupContainer& toGroup, GroupContainer& fromGroup) {
-        vector<Property*> * toProperties = toGroup.OrderedProperties;
+        vector<Property*> * toProperties = toGroup.GetOrderedProperties();
         vector<Property*>::iterator toItr = toProperties->begin();
         vector<Property*>::iterator toEnd = toProperties->end();
 
-        vector<Property*> * fromProperties = fromGroup.OrderedProperties;
+        vector<Property*> * fromProperties = fromGroup.GetOrderedProperties();
         vector<Property*>::iterator fromItr = fromProperties->begin();
         vector<Property*>::iterator fromEnd = fromProperties->end();
 
@@ -354,8 +356,7 @@ namespace Plato {
             return;
         }
 
-        Model & model = Model::Current();
-        model.PushCurrentConnector(*this);
+        Connector* previous = Model::PushCurrentConnector(*this);
 
         // Build the group trees for the To and From paths.
         if (BuildGroupTrees()) {
@@ -371,7 +372,7 @@ namespace Plato {
         ConnectGroupTrees();
 
         byebye:
-        model.PopCurrentConnector();
+        Model::PopCurrentConnector(previous);
     }
 
     bool Connector::CheckGroup(PathEnumeratorState* state, PathEnumerator* pathEnumerator) {
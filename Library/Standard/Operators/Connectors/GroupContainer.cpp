@@ -39,8 +39,9 @@ namespace Plato {
 
     GroupContainer::~GroupContainer() {
         Identity = NULL;
+        vector<Property*>* properties = GetOrderedProperties();
         vector<Property*>::iterator pitr;
-        for(pitr=OrderedProperties->begin();pitr!=OrderedProperties->end();++pitr) {
+        for(pitr=properties->begin();pitr!=properties->end();++pitr) {
             if((*pitr)->Flags.IsGroupContainer) {
                 delete *pitr;
             }
@@ -39,7 +39,7 @@ namespace Plato {
     bool GroupTreeEnumerator::MoveNext() {
         if (mIsReset) {
             mIsReset = false;
-            mEnumeratorList->push_back(new PropertyEnumerator(*(mContainer->OrderedProperties)));
+            mEnumeratorList->push_back(new PropertyEnumerator(*(mContainer->GetOrderedProperties())));
             if (mIsTerminalGroup) {
                 if (mContainer->GroupNumber == 0) {
                     Current = mContainer;
@@ -58,7 +58,7 @@ namespace Plato {
                         return true;
                     }
                 } else if (container != NULL) {
-                    mEnumeratorList->push_back(new PropertyEnumerator(*(container->OrderedProperties)));
+                    mEnumeratorList->push_back(new PropertyEnumerator(*(container->GetOrderedProperties())));
                 } else {
                     return true;
                 }
@@ -26,9 +26,35 @@
 #include "Restrictor.h"
 #include "Translator.h"
 #include "ConverterRestrictor.h"
+#include "ThreadLocalVariable.h"
+#include "Mutex.h"
+#include "ThreadPool.h"
+#include "Model.h"
 
 namespace Plato {
 
+    /// <summary>
+    /// Applies a converter to each tuple as its relator finds it.
+    /// </summary>
+    class ConverterTupleReceiver : public ProximityRelator::TupleReceiver {
+    public:
+        Converter* Owner;
+        ResolutionModesEnum ResolutionMode;
+        Container* Parent;
+
+        ConverterTupleReceiver(Converter& owner, ResolutionModesEnum resolutionMode, Container& parent) {
+            Owner = &owner;
+            ResolutionMode = resolutionMode;
+            Parent = &parent;
+        }
+        virtual bool Receive(vector<Property*>& elements) {
+            if (Parent->IsUnrestricted || ConverterRestrictor::IsAllowed(Owner->ResolutionMode, *Parent, elements)) {
+                Owner->Apply(ResolutionMode, *Parent, elements);
+            }
+            return true;
+        }
+    };
+
     const ClassTypeInfo* Converter::TypeInfo = NULL;
     const ClassTypeInfo::HashSet* Converter::PropertyTypes = NULL;
 
@@ -57,19 +83,23 @@ namespace Plato {
     }
 
     void Converter::Apply(ResolutionModesEnum resolutionMode, Container& parent) {
-        if (ElementRelator != NULL) {
-            vector<vector<Property*>*>* tuples = ElementRelator->FindMatches(parent);
-            if (tuples != NULL) {
-                vector<vector<Property*>*>::iterator itr;
-                for(itr=tuples->begin();itr!=tuples->end();++itr) {
-                    vector<Property*>* elements = *itr;
-                    if (parent.IsUnrestricted || ConverterRestrictor::IsAllowed(ResolutionMode, parent, *elements)) {
-                        Apply(resolutionMode, parent, *elements);
-                    }
-                    delete elements;
-                }
-                delete tuples;
-            }
+        if (ElementRelator == NULL || ElementRelator->Patterns == NULL) {
+            return;
+        }
+        ConverterTupleReceiver receiver(*this, resolutionMode, parent);
+        ThreadPool* pool = Model::Current().ConfigureThreadPool;
+        if (pool == NULL) {
+            // Tuples are applied as they are found rather than collected first.
+            ElementRelator->EnumerateMatches(parent, receiver);
+            return;
+        }
+        // Find the tuples with the configure threads, then apply them in the same order on this one.
+        vector<vector<Property*>*>* tuples = ElementRelator->FindMatches(parent, pool);
+        vector<vector<Property*>*>::iterator itr;
+        for (itr = tuples->begin(); itr != tuples->end(); ++itr) {
+            receiver.Receive(**itr);
+            delete *itr;
         }
+        delete tuples;
     }
 }
@@ -0,0 +1,33 @@
+#include "PlatoIncludes.h"
+#include "Point.h"
+#include "Size.h"
+#include "Bounds.h"
+#include "PointSpace.h"
+#include "BoxSpace.h"
+
+namespace Plato {
+
+    BoxSpace::BoxSpace(Point& lowerBound, Size& width) {
+        mBox = new Bounds(lowerBound, width);
+    }
+
+    BoxSpace::~BoxSpace() {
+        delete mBox;
+    }
+
+    bool BoxSpace::IsContained(const Point& point) {
+        const float* lower = mBox->LowerBound->Coordinates;
+        const float* width = mBox->Width->Sizes;
+        for (int i = 0; i < Point::NumberOfSpatialCoordinates; ++i) {
+            float c = point.Coordinates[i];
+            if (c < lower[i] || c > lower[i] + width[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Bounds* BoxSpace::BoundingBox() {
+        return new Bounds(*mBox);
+    }
+}
@@ -12,8 +12,14 @@
 #include "ResolutionModes.h"
 #include "Container.h"
 #include "Model.h"
+#include "Mutex.h"
+#include "ModelArena.h"
+#include "PathMemo.h"
+#include "SpatialIndex.h"
+#include "Symbol.h"
 #include "CoordinateOperations.h"
 #include "CoordinateNames.h"
+#include "PointBatch.h"
 #include "Geometry.h"
 #include "PipeGeometry.h"
 #include "UnivariateDistribution.h"
@@ -43,20 +49,26 @@ namespace Plato {
             Identifier& identifier, PropertyScopesEnum scope)
         : Property(creator, parent, identifier, scope) {
         Flags.IsContainer = true;
-        OrderedProperties = new vector<Property*>();
-        HashedProperties = new HashTable();
-        mCategorisedProperties = new HashMap();
+        mOrderedProperties = ModelArena::Create<vector<Property*> >();
+        HashedProperties = ModelArena::Create<HashTable>();
+        mCategorisedProperties = ModelArena::Create<HashMap>();
         ClassTypeInfo::HashSet::const_iterator itr;
         for(itr=propertyTypes.begin();itr!=propertyTypes.end();++itr) {
-            (*mCategorisedProperties)[*itr] = new vector<Property*>();
+            (*mCategorisedProperties)[*itr] = ModelArena::Create<vector<Property*> >();
         }
-        mCategoryCache = new HashMap();
+        mCategoryCache = ModelArena::Create<HashMap>();
+        mRemovedProperties = ModelArena::Create<AddressSet>();
+        Generation = PathMemo::NewGeneration();
         mProducerListener = NULL;
         mLastOrder = 0;
         mIsClone = false;
         mDoDelete = true;
+        mSpatialIndex = NULL;
+        mPositions = NULL;
+        mNextPosition = 0;
         IsUnrestricted = true;
         IsComposite = true;
+        DoEmulate = true;
         ConfigurePhase = ConfigurePhases::Unconfigured;
         // Give elements a default geometry - in case user forgets.
         ContainerGeometry = new PipeGeometry(UnivariateDistribution::UnboundedCapacity);
@@ -69,64 +81,92 @@ namespace Plato {
         if(mIsClone) return;
         Clear(mDoDelete);
         Destroy();
+        Generation = 0;
     }
 
     void Container::Destroy() {
-        delete OrderedProperties;
-        delete HashedProperties;
+        ModelArena::Destroy(mOrderedProperties);
+        ModelArena::Destroy(HashedProperties);
         HashMap::iterator itr;
         for(itr=mCategorisedProperties->begin();itr!=mCategorisedProperties->end();++itr) {
-            delete itr->second;
+            ModelArena::Destroy(itr->second);
             itr->second = NULL;
         }
-        delete mCategorisedProperties;
-        delete mCategoryCache;
+        ModelArena::Destroy(mCategorisedProperties);
+        ModelArena::Destroy(mCategoryCache);
+        ModelArena::Destroy(mRemovedProperties);
+        delete mSpatialIndex;
+        mSpatialIndex = NULL;
+        delete mPositions;
+        mPositions = NULL;
         delete ContainerGeometry;
     }
 
     void Container::CloneContents(Container& cloneContainer) const {
         cloneContainer.Destroy();      
-        cloneContainer.OrderedProperties = OrderedProperties;
+        Compact();
+        cloneContainer.mOrderedProperties = mOrderedProperties;
         cloneContainer.HashedProperties = HashedProperties;
         cloneContainer.mCategorisedProperties = mCategorisedProperties;
         cloneContainer.mCategoryCache = mCategoryCache;
+        cloneContainer.mRemovedProperties = mRemovedProperties;
         cloneContainer.mProducerListener = mProducerListener;
         cloneContainer.mLastOrder = mLastOrder;
+        cloneContainer.mSpatialIndex = mSpatialIndex;
         cloneContainer.mIsClone = true;
     }
   
     void Container::Clear(bool doDelete) {
         if(doDelete) {
+            vector<Property*>* properties = GetOrderedProperties();
             vector<Property*>::iterator pitr;
-            for(pitr=OrderedProperties->begin();pitr!=OrderedProperties->end();++pitr) {
+            for(pitr=properties->begin();pitr!=properties->end();++pitr) {
                 delete *pitr;
             }
         }
-        OrderedProperties->clear();
+        mOrderedProperties->clear();
         HashedProperties->clear();
         HashMap::iterator itr;
         for(itr=mCategorisedProperties->begin();itr!=mCategorisedProperties->end();++itr) {
             itr->second->clear();
         }
         mCategoryCache->clear();
+        mRemovedProperties->clear();
+        if (mSpatialIndex != NULL) {
+            mSpatialIndex->Clear();
+        }
         mLastOrder = 0;
+        Generation = PathMemo::NewGeneration();
     }
 
     void Container::Clear(const ClassTypeInfo& categoryType,bool doDelete) {
-        vector<Property*>* categoryVector = GetClosestCategory(categoryType);
-        if (categoryVector == NULL) {
-            return;
-        }
-        vector<Property*>::reverse_iterator itr;
-        int classID = categoryType.ClassID;
-        for(itr=categoryVector->rbegin();itr!=categoryVector->rend();itr++) {
-            Property* p = *itr;
-            if (classID==p->GetClassTypeInfo()->ClassID) {
-                p = Remove(*p->Identity);
-                if(doDelete && p!=NULL) {
-                    delete p;
+        vector<Property*> discarded;
+        {
+            ConfigureLock lock(*ContainerModel);
+            Compact();
+            vector<Property*>* categoryVector = GetClosestCategory(categoryType);
+            if (categoryVector == NULL) {
+                return;
+            }
+            vector<Property*>::reverse_iterator itr;
+            int classID = categoryType.ClassID;
+            for(itr=categoryVector->rbegin();itr!=categoryVector->rend();itr++) {
+                Property* p = *itr;
+                if (classID==p->GetClassTypeInfo()->ClassID) {
+                    p = Discard(*p->Identity);
+                    if(p!=NULL) {
+                        discarded.push_back(p);
+                    }
                 }
             }
+            Compact();
+        }
+        // Deleted unlocked, since a deleted container may clear its own contents.
+        if (doDelete) {
+            vector<Property*>::iterator itr;
+            for(itr=discarded.begin();itr!=discarded.end();++itr) {
+                delete *itr;
+            }
         }
     }
 #pragma endregion
@@ -173,7 +213,7 @@ namespace Plato {
             closestCategory = itr->second;
         } else {
             int minInheritanceCount = -1;
-            HashMap::const_iterator itr;
+            HashMap::iterator itr;
             closestCategory = NULL;
             for(itr=mCategorisedProperties->begin();itr!=mCategorisedProperties->end();++itr) {
                 const ClassTypeInfo* p = itr->first;
@@ -193,9 +233,33 @@ namespace Plato {
         return closestCategory;
     }
 
+    void Container::Compact() const {
+        if (mRemovedProperties->empty()) {
+            return;
+        }
+        CompactVector(*mOrderedProperties, *mRemovedProperties);
+        HashMap::iterator itr;
+        for(itr=mCategorisedProperties->begin();itr!=mCategorisedProperties->end();++itr) {
+            CompactVector(*itr->second, *mRemovedProperties);
+        }
+        mRemovedProperties->clear();
+    }
+
+    void Container::CompactVector(vector<Property*>& properties, AddressSet& removed) {
+        vector<Property*>::iterator itr;
+        vector<Property*>::iterator kept = properties.begin();
+        for(itr=properties.begin();itr!=properties.end();++itr) {
+            if (removed.find(*itr) == removed.end()) {
+                *kept++ = *itr;
+            }
+        }
+        properties.erase(kept, properties.end());
+    }
+
     int Container::BinarySearch(int order) const {
-        vector<Property*>::iterator pVector = OrderedProperties->begin();
-        int len = (int)(OrderedProperties->size());
+        vector<Property*>* properties = GetOrderedProperties();
+        vector<Property*>::iterator pVector = properties->begin();
+        int len = (int)(properties->size());
         int first = 0;
         int result,half,middle;
         Property *p;
@@ -247,8 +311,9 @@ namespace Plato {
     }
 
     Property* Container::GetProperty(int order) const {
-        vector<Property*>::iterator pVector = OrderedProperties->begin();
-        int len = (int)(OrderedProperties->size());
+        vector<Property*>* properties = GetOrderedProperties();
+        vector<Property*>::iterator pVector = properties->begin();
+        int len = (int)(properties->size());
         int first = 0;
         int result,half,middle;
         Property *p;
@@ -273,9 +338,25 @@ namespace Plato {
     void Container::SetGeometry(Geometry& geometry) {
         ContainerGeometry = &geometry;
         ContainerGeometry->GeometryContainer = this;
+        // Positions already fetched came from the previous geometry.
+        delete mPositions;
+        mPositions = NULL;
     }
 
     bool Container::Add(Property& prop) {
+        {
+            ConfigureLock lock(*ContainerModel);
+            if (!Insert(prop)) {
+                return false;
+            }
+        }
+        if(ContainerModel->IsListeningToContainers) {
+            ContainerModel->AddedProperty(*this, prop);
+        }
+        return true;
+    }
+
+    bool Container::Insert(Property& prop) {
         // Check property type is a member of the allowed categories.
         vector<Property*>* categoryVector = GetClosestCategory(*(prop.GetClassTypeInfo()));
         if (categoryVector == NULL) {
@@ -285,28 +366,48 @@ namespace Plato {
         HashTable::iterator itr = HashedProperties->find(prop.Identity);
         if(itr!=HashedProperties->end()) {
             // DEBUG: Overwriting existing: remove first with delete?
-            Remove(*itr->second->Identity);
+            RemoveLocked(*itr->second->Identity);
+        }
+        if (mRemovedProperties->find(&prop) != mRemovedProperties->end()) {
+            // Re-adding a removed property, or a new one at the address of a deleted one.
+            Compact();
         }
         (*HashedProperties)[prop.Identity] = &prop;
-        OrderedProperties->push_back(&prop);
+        mOrderedProperties->push_back(&prop);
         categoryVector->push_back(&prop);
         prop.Order = mLastOrder++;
-        if(ContainerModel->IsListeningToContainers) {
-            ContainerModel->AddedProperty(*this, prop);
+        if (prop.Identity->Position != NULL) {
+            if (mSpatialIndex == NULL) {
+                mSpatialIndex = new SpatialIndex();
+            }
+            mSpatialIndex->Insert(prop);
         }
+        Generation = PathMemo::NewGeneration();
         return true;
     }
 
     bool Container::Add(Container& container) {
         if (container.Identity->Position==NULL) {
             // Set default position of property based on parent container shape.
-            container.Identity->Position = ContainerGeometry->GetPoint(CoordinateOperations::New,NULL);
+            ConfigureLock lock(*ContainerModel);
+            if (mPositions == NULL) {
+                mPositions = new PointBatch(PositionBatchSize);
+                mNextPosition = 0;
+            }
+            if (mNextPosition == mPositions->Count) {
+                ContainerGeometry->GetPoints(CoordinateOperations::New,*mPositions);
+                mNextPosition = 0;
+            }
+            if (mNextPosition < mPositions->Count) {
+                container.Identity->Position = mPositions->GetPoint(mNextPosition++);
+            }
         }
         return Add((Property&)container);
     }
 
     bool Container::Add(Producer& producer) {
         if (Add((Property&)producer)) {
+            ConfigureLock lock(*ContainerModel);
             if (mProducerListener == NULL) {
                 mProducerListener = new ProducerListener(*this);
             }
@@ -321,21 +422,39 @@ namespace Plato {
     }
 
     Property* Container::Remove(const Identifier& ident) {
+        ConfigureLock lock(*ContainerModel);
+        return RemoveLocked(ident);
+    }
+
+    Property* Container::RemoveLocked(const Identifier& ident) {
+        Property* p = Discard(ident);
+        // Compact once removals reach half the vector, so each costs O(1) amortised,
+        // or at once if another configure thread may be reading the vectors.
+        if (ContainerModel->ConfigureMutex != NULL
+            || mRemovedProperties->size() * 2 > mOrderedProperties->size()) {
+            Compact();
+        }
+        return p;
+    }
+
+    void Container::PrepareConfigure() {
+        Compact();
+        vector<Property*>::iterator itr;
+        for(itr=mOrderedProperties->begin();itr!=mOrderedProperties->end();++itr) {
+            GetClosestCategory(*(*itr)->GetClassTypeInfo());
+        }
+    }
+
+    Property* Container::Discard(const Identifier& ident) {
         HashTable::iterator itr = HashedProperties->find(&ident);
         if(itr!=HashedProperties->end()) {
             Property* p = itr->second;
             HashedProperties->erase(&ident);
-            int index = BinarySearch(p->Order);
-            if (index>=0) {
-                OrderedProperties->erase(OrderedProperties->begin()+index);
-            }    
-            vector<Property*>* categoryVector = GetClosestCategory(*(p->GetClassTypeInfo()));
-            if (categoryVector != NULL) {
-                index = BinarySearch(p->Order,*categoryVector);
-                if (index>=0) {
-                    categoryVector->erase(categoryVector->begin()+index);
-                }
+            (*mRemovedProperties)[p] = true;
+            if (mSpatialIndex != NULL) {
+                mSpatialIndex->Erase(*p);
             }
+            Generation = PathMemo::NewGeneration();
             return p;
         }
         return NULL;
@@ -352,36 +471,39 @@ namespace Plato {
     Property* Container::DirectToProperty(const Identifier* identifier, const Property* source, 
             const Property* requester, PropertyModesEnum mode) {
         Property* p = NULL;
-        Identifier* directorName;
+        const Identifier* directorName;
         // Make sure we have a valid Director name and strip off TypeName and Position.
         if (identifier==NULL || identifier->Name->empty()) {
             // DEBUG: TO DO: Allow container to determine other names for input and output.
             if ((mode & PropertyModes::IsIO) != 0) {
-                directorName = new Identifier(*new string(((mode & PropertyModes::Input) != 0) 
-                    ? *Director::InputDirectorName : *Director::OutputDirectorName));
+                directorName = ((mode & PropertyModes::Input) != 0) 
+                    ? Director::InputDirectorName : Director::OutputDirectorName;
             } else {
-                directorName = new Identifier(*new string(*Director::DefaultDirectorName));
+                directorName = Director::DefaultDirectorName;
             }
         } else {
-            directorName = new Identifier(*new string(*(identifier->Name)));
+            directorName = NULL;
         }
         // If the named director exists, let it find the property.
-        Property* q = GetProperty(*directorName, requester, mode);
-        delete directorName;
+        Property* q;
+        if (directorName != NULL) {
+            q = GetProperty(*directorName, requester, mode);
+        } else {
+            Identifier name(*identifier->NameSymbol);
+            q = GetProperty(name, requester, mode);
+        }
         if(q!=NULL && q->Flags.IsDirector) {
             p = ((Director*)q)->Route(identifier, source, requester, mode);
         }
         // Director routing failed, so try fetching a simple property.
         if (p == NULL) {
-            Identifier* ident;
+            const Identifier* ident;
             if ((mode & PropertyModes::IsIO) != 0) {
-                ident = new Identifier(*new string(((mode & PropertyModes::Input) != 0) 
-                    ? *Director::InputName : *Director::OutputName));
+                ident = ((mode & PropertyModes::Input) != 0) ? Director::InputName : Director::OutputName;
             } else {
-                ident = new Identifier(*new string(*Director::DefaultName));
+                ident = Director::DefaultName;
             }
             p = GetProperty(*ident, requester, mode);
-            delete ident;
         }
         // If a container property was found, recurse until a non-container property is found.
         if (p != NULL) {
@@ -447,7 +569,11 @@ namespace Plato {
             ProducerPopulate(regexIdentifier, requester);
         }
         // DEBUG: Need a slice & dice call here for potential regex point.
+        // Containers whose categories are narrower than Property search their master table for it.
         vector<Property*>* properties = GetCategory(categoryType);
+        if (properties == NULL && &categoryType == Property::TypeInfo) {
+            properties = GetOrderedProperties();
+        }
         if(properties==NULL) return NULL;
         return new IdentifierEnumerator(*properties, *new IdentifierRegex(regexIdentifier), includeWhenMatches, requester);
     }
@@ -554,7 +680,7 @@ namespace Plato {
                     parentContainer = searchContainer;
                     return prop;
                 }
-                searchVector = searchContainer->OrderedProperties;
+                searchVector = searchContainer->GetOrderedProperties();
                 for(itr=searchVector->begin();itr!=searchVector->end();++itr) {
                     prop = *itr;
                     if (identifier.CompareTo(*prop->Identity)!=0) {
@@ -567,7 +693,7 @@ namespace Plato {
                 searchContainer = searchContainer->Parent;
             } else {
                 // Check child containers.
-                searchVector = searchContainer->OrderedProperties;
+                searchVector = searchContainer->GetOrderedProperties();
                 for(itr=searchVector->begin();itr!=searchVector->end();++itr) {
                     prop = *itr;
                     Property *p = prop->GetValue();
@@ -589,7 +715,7 @@ namespace Plato {
             bool includeWhenMatches, bool searchUp, Container*& parentContainer) {
         while (searchContainer != NULL) {
             vector<Property*>::iterator itr;
-            vector<Property*>& searchVector = *(searchContainer->OrderedProperties);
+            vector<Property*>& searchVector = *(searchContainer->GetOrderedProperties());
             for(itr=searchVector.begin();itr!=searchVector.end();++itr) {
                 Property* prop = *itr;
                 if (regex.Match(*prop->Identity)) {
@@ -46,7 +46,7 @@ namespace Plato {
         if (mIsReset) {
             mIsReset = false;
             if (mContainer != NULL) {
-                ContainerIterator* ci = new ContainerIterator(mContainer->OrderedProperties,mIsReverse);
+                ContainerIterator* ci = new ContainerIterator(mContainer->GetOrderedProperties(),mIsReverse);
                 mEnumeratorList->push_back(ci);
                 if (mIncludeContainers) {
                     Current = mContainer;
@@ -63,7 +63,7 @@ namespace Plato {
                 Current = ci->Current;
                 if(Current->Flags.IsContainer) {
                     Container* container =(Container*)Current;
-                    ContainerIterator* e = new ContainerIterator(container->OrderedProperties,mIsReverse);
+                    ContainerIterator* e = new ContainerIterator(container->GetOrderedProperties(),mIsReverse);
                     if (mIsWidthFirstDescent) {
                         mEnumeratorList->push_back(e);
                     } else {
@@ -2,6 +2,9 @@
 #include "Strings.h"
 #include "ClassTypeInfo.h"
 #include "ClassCatalogue.h"
+#include "ThreadLocalVariable.h"
+#include "Mutex.h"
+#include "LogWriter.h"
 #include "ErrorContext.h"
 #include "ErrorMessage.h"
 #include "Error.h"
@@ -33,6 +36,8 @@ namespace Plato {
         errorContext.Add(*em);
         if (echoToConsole||EchoFlag) {
             string& s = em->StatusReport();
+            // Keep the error after the trace messages before it.
+            LogWriter::Flush();
             cerr << s << "\n";
             delete &s;
         }
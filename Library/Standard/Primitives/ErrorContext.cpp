@@ -1,5 +1,6 @@
 #include "PlatoIncludes.h"
 #include "Numbers.h"
+#include "Mutex.h"
 #include "ErrorMessage.h"
 #include "ErrorContext.h"
 
@@ -23,16 +24,19 @@ namespace Plato {
     }
 
     int ErrorContext::Count() {
+        MutexLock lock(mLock);
         return (int)mErrorMessageStack->size();
     }
 
     void ErrorContext::Add(ErrorMessage& errorMessage) {
+        MutexLock lock(mLock);
         if ((int)mErrorMessageStack->size() < mStackSize) {
             mErrorMessageStack->push_back(&errorMessage);
         }
     }
 
     ErrorMessage* ErrorContext::CodeToMessage(int errorCode) {
+        MutexLock lock(mLock);
         vector<ErrorMessage*>::iterator itr;
         for(itr=mErrorMessageStack->begin();itr != mErrorMessageStack->end(); ++itr) {
             if ((*itr)->mErrorCode == errorCode) {
@@ -43,6 +47,7 @@ namespace Plato {
     }
 
     string& ErrorContext::StatusReport() {
+        MutexLock lock(mLock);
         string& errors = *new string("ErrorStack:{");
         vector<ErrorMessage*>::iterator itr;
         for(itr=mErrorMessageStack->begin(); itr != mErrorMessageStack->end();++itr) {
@@ -3,89 +3,98 @@
 #include "Numbers.h"
 #include "Point.h"
 #include "Identifier.h"
+#include "Mutex.h"
+#include "ModelArena.h"
+#include "Symbol.h"
 
 namespace Plato {
 
     int Identifier::mLastIdentifierNumber = 0;
+    Mutex Identifier::mNumberLock;
 
     Identifier::Identifier(const char* name, const Point* position, Property* prop) {
-        if (name != NULL) {
-            Name = new string(name);
-            NameHashCode = Strings::SuperFastHash(Name->data(),(int)Name->size());
-        } else {
-            Name = NULL;
-            NameHashCode = 0;
-        }
-        HashCode = NameHashCode;
         Position = position;
-        if (Position != NULL) {
-            HashCode ^= Position->HashCode;
-        } 
         PropertyPtr = prop;
+        SetSymbol(name == NULL ? NULL : &Symbol::Intern(name));
     }
 
     Identifier::Identifier(const string& name, const Point* position, Property* prop) {
-        Name = &name;
-        NameHashCode = Strings::SuperFastHash(Name->data(),(int)Name->size());
-        HashCode = NameHashCode;
         Position = position;
-        if (Position != NULL) {
-            HashCode ^= Position->HashCode;
-        } 
         PropertyPtr = prop;
+        SetSymbol(&Symbol::Intern(name));
+        if (&name != Name) {
+            delete &name;
+        }
     }
 
     Identifier::Identifier(char name) {
-        Name = new string(1,name);
-        NameHashCode = Strings::SuperFastHash(Name->data(),(int)Name->size());
-        HashCode = NameHashCode;
         Position = NULL;
         PropertyPtr = NULL;
+        SetSymbol(&Symbol::Intern(&name, 1));
     }
 
     Identifier::Identifier(const char* name) {
-        if (name != NULL) {
-            Name = new string(name);
-            NameHashCode = Strings::SuperFastHash(Name->data(),(int)Name->size());
-        } else {
-            Name = NULL;
-            NameHashCode = 0;
-        }
-        HashCode = NameHashCode;
         Position = NULL;
         PropertyPtr = NULL;
+        SetSymbol(name == NULL ? NULL : &Symbol::Intern(name));
     }
 
     Identifier::Identifier(const string& name) {
-        Name = &name;
-        NameHashCode = Strings::SuperFastHash(Name->data(),(int)Name->size());
-        HashCode = NameHashCode;
         Position = NULL;
         PropertyPtr = NULL;
+        SetSymbol(&Symbol::Intern(name));
+        if (&name != Name) {
+            delete &name;
+        }
+    }
+
+    Identifier::Identifier(const Symbol& name) {
+        Position = NULL;
+        PropertyPtr = NULL;
+        SetSymbol(&name);
     }
 
     Identifier::Identifier(const Identifier& ident) {
-        Name = new string(*ident.Name);
         const Point* p = ident.Position;
         Position = p==NULL ? NULL : new Point(*p);
         PropertyPtr = ident.PropertyPtr;
-        NameHashCode = ident.NameHashCode;
-        HashCode = ident.HashCode;
+        SetSymbol(ident.NameSymbol);
     }
 
     Identifier::~Identifier() {
-        delete Name;
         delete Position;
     }
 
+    void* Identifier::operator new(size_t size) {
+        return ModelArena::New(size);
+    }
+
+    void Identifier::operator delete(void* memory) {
+        ModelArena::Delete(memory);
+    }
+
     void Identifier::SetName(const string& name) {
-        delete Name;
-        Name = &name;
-        NameHashCode = Strings::SuperFastHash(Name->data(),(int)Name->size());
+        SetSymbol(&Symbol::Intern(name));
+        if (&name != Name) {
+            delete &name;
+        }
+    }
+
+    void Identifier::SetSymbol(const Symbol* symbol) {
+        NameSymbol = symbol;
+        if (symbol != NULL) {
+            Name = &symbol->Name;
+            NameHashCode = symbol->HashCode;
+            NameId = symbol->Id;
+        } else {
+            Name = NULL;
+            NameHashCode = 0;
+            NameId = -1;
+        }
         HashCode = NameHashCode;
         if (Position != NULL) {
             HashCode ^= Position->HashCode;
-        }     
+        }
     }
 
     void Identifier::SetPosition(const Point& position) {
@@ -114,7 +123,7 @@ namespace Plato {
     int Identifier::CompareTo(const Identifier& ident) const {
         int c;
         const string* name = ident.Name;
-        if (Name != NULL && name != NULL) {
+        if (Name != NULL && name != NULL && NameSymbol != ident.NameSymbol) {
             c = Name->compare(*name);
             if (c != 0) {
                 return c;
@@ -130,8 +139,17 @@ namespace Plato {
         return 0;
     }
 
+    int Identifier::ComparePositionTo(const Identifier& ident) const {
+        return Position->CompareTo(*ident.Position);
+    }
+
     string& Identifier::GetIdentifierNumber() {
-        return Numbers::ToString(mLastIdentifierNumber++);
+        int number;
+        {
+            MutexLock lock(mNumberLock);
+            number = mLastIdentifierNumber++;
+        }
+        return Numbers::ToString(number);
     }
 
     string& Identifier::GetIdentifierValue() {
@@ -6,6 +6,8 @@
 #include "PointSpace.h"
 #include "PointRegex.h"
 #include "Identifier.h"
+#include "Mutex.h"
+#include "Symbol.h"
 #include "IdentifierRegex.h"
 #include "PropertyScopes.h"
 #include "Property.h"
@@ -25,6 +27,7 @@ namespace Plato {
             mNameIsWild = Name->compare(*Regexes::WildPatternString)==0;
             mNameIsRegex = mNameIsWild || Regexes::IsRegex(*Name);
         }
+        SetNameSymbol();
         if (TypeName == NULL) {
             mRegexTypeName = NULL;
             mTypeNameIsWild = true;
@@ -49,6 +52,7 @@ namespace Plato {
             mNameIsWild = regexIdentifier.mNameIsWild;
             mNameIsRegex = regexIdentifier.mNameIsRegex;
         }
+        mNameSymbol = regexIdentifier.mNameSymbol;
         const PointRegex* p = regexIdentifier.Position;
         Position = p==NULL ? NULL : new PointRegex(*p);
         s = regexIdentifier.TypeName;
@@ -73,6 +77,11 @@ namespace Plato {
         delete mRegexTypeName;
     }
 
+    void IdentifierRegex::SetNameSymbol() {
+        const string* literal = mRegexName == NULL ? NULL : mRegexName->GetExactLiteral();
+        mNameSymbol = literal == NULL ? NULL : &Symbol::Intern(*literal);
+    }
+
     string& IdentifierRegex::StatusReport() const {
         string& result = *new string(Name==NULL ? "" : *Name);
         if (Position != NULL) {
@@ -91,6 +100,10 @@ namespace Plato {
                 if (!mNameIsWild) {
                     return false;
                 }
+            } else if (mNameSymbol != NULL) {
+                if (ident.NameSymbol != mNameSymbol) {
+                    return false;
+                }
             } else {
                 if(!mRegexName->Matches(*name)) {
                     return false;
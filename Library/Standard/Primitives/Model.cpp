@@ -12,32 +12,54 @@
 #include "PropertyScopes.h"
 #include "Property.h"
 #include "Error.h"
-#include "ErrorContext.h"
 #include "ThreadLocalVariable.h"
+#include "Mutex.h"
+#include "ErrorContext.h"
+#include "ThreadPool.h"
+#include "ModelArena.h"
 #include "ConfigurePhases.h"
 #include "ResolutionModes.h"
 #include "Container.h"
 #include "Path.h"
+#include "PathMemo.h"
 #include "Model.h"
 #include "Diagnostics.h"
 #include "Trace.h"
 #include "Debug.h"
+#include "RandomStream.h"
 #include "Connector.h"
 #include "Distributor.h"
 #include "Converter.h"
 #include "Restrictor.h"
+#include "SignalArena.h"
+#include "Pad.h"
+#include "InputPad.h"
+#include "OutputPad.h"
+#include "ConnectionGraph.h"
+#include "ChangeTracker.h"
+#include "ModelSnapshot.h"
+#include "Checkpointer.h"
+#include "Profiler.h"
+#include "Bundle.h"
+#include "Disposition.h"
+#include "AnalogueDIDs.h"
 
 namespace Plato {
 
     const ClassTypeInfo* Model::TypeInfo = NULL;
     const ClassTypeInfo::HashSet* Model::PropertyTypes = NULL;
     ThreadLocalVariable::Key Model::mThreadContextKey = NULL;
+    ThreadLocalVariable::Key Model::mConnectorKey = 0;
     int Model::mNumberOfModels = 0;
+    Mutex Model::mLibraryLock;
+    volatile long Model::mInterruptCount = 0;
 
     void Model::Initializer() {
+        // The key must exist before TypeInfo is set, since FindCurrent tests TypeInfo.
+        mThreadContextKey = ThreadLocalVariable::GetKey();
+        mConnectorKey = ThreadLocalVariable::GetKey();
         TypeInfo = new ClassTypeInfo("Model",3,1,NULL,Container::TypeInfo);
         PropertyTypes = Container::CreatePropertyTypes(Property::TypeInfo,NULL);
-        mThreadContextKey = ThreadLocalVariable::GetKey();
     }
 
     void Model::Finalizer() {
@@ -46,12 +68,30 @@ namespace Plato {
     }
 
     const ClassTypeInfo::HashSet& Model::InitLibrary() {
+        MutexLock lock(mLibraryLock);
         if(mNumberOfModels++==0) {
             InitializerCatalogue::Initialize();
+            signal(SIGINT,SignalHandler);
         }
         return *PropertyTypes;
     }
 
+    void* Model::operator new(size_t size) {
+        // Until its constructor makes the new model current, the objects it creates
+        // must not come from the arena of another model current on this thread.
+        {
+            MutexLock lock(mLibraryLock);
+            if (mNumberOfModels > 0) {
+                ThreadLocalVariable::SetVariableValue(mThreadContextKey,NULL);
+            }
+        }
+        return ::operator new(size);
+    }
+
+    void Model::operator delete(void* memory) {
+        ::operator delete(memory);
+    }
+
     Model::Model(const char* name, char* arguments[]) 
         : Container(InitLibrary(), NULL, NULL, *new Identifier(name,NULL,NULL), PropertyScopes::Public) {
         StopEvent = false;
@@ -59,18 +99,37 @@ namespace Plato {
         EpochTime = 0;
         ConfigurePhase = ConfigurePhases::Unconfigured;
         ResolutionMode = ResolutionModes::None;
-        CurrentConnector = NULL;
-        CurrentConnectorStack = new ConnectorStack();
         CurrentContainerStack = new ContainerStack();
+        UpdateThreadPool = NULL;
+        ConfigureThreadPool = NULL;
+        ConfigureMutex = NULL;
+        ModelSignals = new SignalArena();
+        ModelConnections = NULL;
+        ModelChanges = NULL;
+        ModelMemory = new ModelArena();
+        ResolutionMemo = NULL;
+        ModelCheckpoints = NULL;
+        ModelProfile = NULL;
+        ModelPathPrefix = NULL;
+        mIsConnectionsReleased = false;
         ModelErrorContext = new ErrorContext(ErrorContext::DefaultStackSize);
+        // The container constructor ran before this model became current.
+        ContainerModel = this;
         ThreadLocalVariable::SetVariableValue(mThreadContextKey,(ThreadLocalVariable::ValuePtr)this);
         ModelConfiguration = new Configuration(name, arguments);
+        if (ModelConfiguration->MemoisePaths) {
+            ResolutionMemo = new PathMemo();
+        }
 
-        if(mNumberOfModels==1) {
-            signal(SIGINT,SignalHandler);
-            if (ModelConfiguration->RunDiagnostics) {
-                Diagnostics::ConductTests();
-            }
+        bool isOnlyModel;
+        {
+            MutexLock lock(mLibraryLock);
+            isOnlyModel = mNumberOfModels == 1;
+        }
+        if (isOnlyModel && ModelConfiguration->RunDiagnostics) {
+            // Tests that build models of their own leave this one current when they delete them.
+            CurrentModelScope scope(*this);
+            Diagnostics::ConductTests();
         }
 
         if (ModelErrorContext->Count() > 0) {
@@ -78,9 +137,14 @@ namespace Plato {
             Trace::WriteLine(1, "Model.Model: there were startup errors:%s", message.c_str());
             delete &message;
         }
+        // The derived model's constructor builds the hierarchy from here on.
+        ModelMemory->IsActive = ModelConfiguration->UseModelArena;
     }
 
     Model::~Model() {
+        // The properties being deleted may refer to the current model, so make it this one.
+        Model* previous = FindCurrent();
+        ThreadLocalVariable::SetVariableValue(mThreadContextKey,(ThreadLocalVariable::ValuePtr)this);
         try {
             if (ModelErrorContext->Count() > 0) {
                 string& tmp1 = StatusReport();
@@ -96,10 +160,31 @@ namespace Plato {
                 Trace::WriteLine(1, "Model.Destructor: %s, exit code=%d.\n",tmp1.c_str(),exitCode);
                 delete &tmp1;
             }
+            delete UpdateThreadPool;
+            // The pool's threads have gone, and with them their references to the profile's counters.
+            delete ModelProfile;
+            ModelProfile = NULL;
+            // Finish writing the last checkpoint before the state it was taken from goes.
+            delete ModelCheckpoints;
+            ModelCheckpoints = NULL;
+            delete ModelChanges;
+            ModelChanges = NULL;
+            delete ModelConnections;
+            ModelConnections = NULL;
+            // Delete the model's properties while the signal arena their pads use still exists.
+            Clear(mDoDelete);
+            delete ResolutionMemo;
+            ResolutionMemo = NULL;
+            delete ModelSignals;
             delete CurrentContainerStack;
-            delete CurrentConnectorStack;
             delete ModelErrorContext;
+            delete ModelPathPrefix;
             delete ModelConfiguration;
+            // Everything allocated from the arena has been deleted by now.
+            delete ModelMemory;
+            ModelMemory = NULL;
+            ThreadLocalVariable::SetVariableValue(mThreadContextKey,(ThreadLocalVariable::ValuePtr)(previous == this ? NULL : previous));
+            MutexLock lock(mLibraryLock);
             if(--mNumberOfModels==0) {
                 signal(SIGINT,SIG_DFL);
                 InitializerCatalogue::Finalize();
@@ -112,29 +197,20 @@ namespace Plato {
     void Model::SignalHandler(int sig) {
         if(sig==SIGINT) {
             signal(SIGINT,SignalHandler);
-            // Interrupt model.
-            Model::Current().StopEvent;
+            // Interrupt every model, since the signal may be delivered to any thread.
+            ++mInterruptCount;
         }
     }
 
 #pragma region // General methods.
-    void Model::PushCurrentConnector(Connector& connector) {
-        CurrentConnectorStack->push(&connector);
-        CurrentConnector = &connector;
+    Connector* Model::PushCurrentConnector(Connector& connector) {
+        Connector* previous = GetCurrentConnector();
+        ThreadLocalVariable::SetVariableValue(mConnectorKey,(ThreadLocalVariable::ValuePtr)&connector);
+        return previous;
     }
 
-    void Model::PopCurrentConnector() {
-        if (CurrentConnectorStack->empty()) {
-            Debug::WriteLine(1, "Model.PopCurrentConnector, stack is empty.");
-            CurrentConnector = NULL;
-            return;
-        }
-        CurrentConnectorStack->pop();
-        if (CurrentConnectorStack->empty()) {
-            CurrentConnector = NULL;
-            return;
-        }
-        CurrentConnector = CurrentConnectorStack->top();
+    void Model::PopCurrentConnector(Connector* previous) {
+        ThreadLocalVariable::SetVariableValue(mConnectorKey,(ThreadLocalVariable::ValuePtr)previous);
     }
 
     void* Model::GetPropertyValue(string& name) {
@@ -151,66 +227,221 @@ namespace Plato {
         string* result = new string();
         *result += "Model(Identity=" + tmp + ")";
         delete &tmp;
+        if (ModelProfile != NULL) {
+            string& profile = ModelProfile->StatusReport();
+            *result += "\n" + profile;
+            delete &profile;
+        }
         return *result;
     }
+
+    RandomStream* Model::CreateRandomStream(const Property& prop) const {
+        uint32_t stream = 0;
+        for (const Property* p = &prop; p != NULL; p = p->Parent) {
+            stream = stream * 0x9E3779B1u + (uint32_t)p->Order + 1u;
+        }
+        return new RandomStream((uint32_t)ModelConfiguration->RandomSeed, stream, (uint32_t)EpochTime);
+    }
 #pragma endregion
 
 #pragma region // Model control methods.
     int Model::Save(string* archivePath) {
+        CurrentModelScope scope(*this);
         if (archivePath != NULL) {
             ModelConfiguration->ArchivePath = archivePath;
         }
-        int result = Archiver::Serialize(*(ModelConfiguration->ArchivePath), ModelConfiguration->BinarySerialize, (void*)this);
+        ModelSnapshot* snapshot = ModelSnapshot::Capture(*this, *ModelSignals, ModelConnections, EpochTime);
+        int result = Archiver::Serialize(*(ModelConfiguration->ArchivePath), ModelConfiguration->BinarySerialize, (void*)snapshot);
+        delete snapshot;
         if (result != 0) {
             return Error::Log(false, *ModelErrorContext, *GetClassTypeInfo(), "Save", 8, "Serializing model returned non-zero result: %d.", result);
         }
         return 0;
     }
 
-    Model* Model::Load(string& archivePath) {
+    int Model::Load(string* archivePath) {
+        CurrentModelScope scope(*this);
+        if (archivePath != NULL) {
+            ModelConfiguration->ArchivePath = archivePath;
+        }
+        ModelSnapshot* snapshot = NULL;
         try {
-            // Try to deserialise model.
-            void* obj = Archiver::Deserialize(archivePath);
-            return (Model*)obj;              
+            snapshot = (ModelSnapshot*)Archiver::Deserialize(*(ModelConfiguration->ArchivePath));
         } catch (...) {
             Trace::WriteLine(1, "Model.Load exception.");
         }
-        return NULL;
+        if (snapshot == NULL) {
+            return Error::Log(false, *ModelErrorContext, *GetClassTypeInfo(), "Load", 1, "Unable to read a model snapshot from: %s.",
+                ModelConfiguration->ArchivePath->c_str());
+        }
+
+        // Rebuild the distributed elements, as Configure would, then restore the connections in place of the other phases.
+        IsListeningToContainers = true;
+        ResolutionMode = ResolutionModes::Now;
+        ConfigurePhase = ConfigurePhases::DistributorsNow;
+        ApplyPhase(&Model::ApplyDistributors);
+        ResolutionMode = ResolutionModes::Final;
+        ConfigurePhase = ConfigurePhases::Configured;
+        IsListeningToContainers = false;
+        ModelMemory->IsActive = false;
+
+        int missing = snapshot->Restore(*this, *ModelSignals);
+        EpochTime = (long)snapshot->GetHeader().EpochTime;
+        int deltas = Checkpointer::Replay(*snapshot, *(ModelConfiguration->ArchivePath), *this, *ModelSignals, EpochTime);
+        if (deltas > 0) {
+            Trace::WriteLine(2, "Model.Load: replayed %d checkpoint deltas up to epoch %ld.", deltas, EpochTime);
+        }
+        delete snapshot;
+        if (missing > 0) {
+            return Error::Log(false, *ModelErrorContext, *GetClassTypeInfo(), "Load", 2,
+                "%d pads and connections in the snapshot do not match the model.", missing);
+        }
+        if (ModelConfiguration->FreezeConnections || ModelConfiguration->IncrementalUpdates) {
+            Freeze(ModelConfiguration->FreezeConnections);
+        }
+        if (ModelConfiguration->VectoriseDIDs) {
+            AnalogueKernel::Compile(*this);
+        }
+        return 0;
     }
 
     int Model::Run(long numberOfEpochs) {
+        CurrentModelScope scope(*this);
         try {
+            if (UpdateThreadPool == NULL && ModelConfiguration->UpdateThreads != 1) {
+                UpdateThreadPool = new ThreadPool(ModelConfiguration->UpdateThreads,
+                    mThreadContextKey, (ThreadLocalVariable::ValuePtr)this);
+            }
+            if (ModelCheckpoints == NULL && ModelConfiguration->CheckpointInterval > 0 && !ModelConfiguration->ArchivePath->empty()) {
+                ModelCheckpoints = new Checkpointer(*(ModelConfiguration->ArchivePath), ModelConfiguration->CheckpointDeltas);
+            }
+            if (ModelProfile == NULL && ModelConfiguration->ProfileUpdates) {
+                ModelProfile = new Profiler();
+            }
+            // Each Update is an epoch barrier: the output buffers are only swapped
+            // once every container has finished updating.
+            long interrupts = mInterruptCount;
             if (numberOfEpochs < 0) {
-                while (!StopEvent)  {
-                    ++EpochTime;
-                    Update();
+                while (!StopEvent && mInterruptCount == interrupts)  {
+                    RunEpoch();
+                    CheckpointEpoch();
                 }
             } else if (numberOfEpochs > 0) {
-                while (numberOfEpochs-- > 0 && !StopEvent) {
-                    ++EpochTime;
-                    Update();
+                while (numberOfEpochs-- > 0 && !StopEvent && mInterruptCount == interrupts) {
+                    RunEpoch();
+                    CheckpointEpoch();
                 }
             }
         } catch (...) {
             return Error::Log(false, *ModelErrorContext, *GetClassTypeInfo(), "Run", 11, "Exception.");
         }
+        if (ModelCheckpoints != NULL) {
+            int result = ModelCheckpoints->Flush();
+            if (result != 0) {
+                return Error::Log(false, *ModelErrorContext, *GetClassTypeInfo(), "Run", 12, "Writing a checkpoint returned non-zero result: %d.", result);
+            }
+        }
+        if (ModelProfile != NULL && !ModelConfiguration->ProfilePath->empty()) {
+            int result = ModelProfile->Write(*(ModelConfiguration->ProfilePath));
+            if (result != 0) {
+                return Error::Log(false, *ModelErrorContext, *GetClassTypeInfo(), "Run", 13, "Writing the profile to %s returned non-zero result: %d.",
+                    ModelConfiguration->ProfilePath->c_str(), result);
+            }
+        }
         return 0;
     }
 #pragma endregion
 
 #pragma region // Model emulation - update methods.
+    void Model::RunEpoch() {
+        if (ModelProfile != NULL) {
+            ModelProfile->BeginEpoch();
+        }
+        ModelSignals->Swap();
+        if (ModelChanges != NULL) {
+            ModelChanges->BeginEpoch();
+        }
+        ++EpochTime;
+        Update();
+        if (ModelProfile != NULL) {
+            ModelProfile->EndEpoch();
+        }
+    }
+
+    void Model::CheckpointEpoch() {
+        if (ModelCheckpoints == NULL || EpochTime % ModelConfiguration->CheckpointInterval != 0) {
+            return;
+        }
+        int result = ModelCheckpoints->Checkpoint(*this, *ModelSignals, ModelConnections, EpochTime);
+        if (result != 0) {
+            Error::Log(false, *ModelErrorContext, *GetClassTypeInfo(), "Run", 12, "Writing a checkpoint returned non-zero result: %d.", result);
+        }
+    }
+
     void Model::Update() {
-        Update(*OrderedProperties);
+        Update(*GetOrderedProperties());
     }
 
+    /// <summary>
+    /// A pool task that updates a range of containers.
+    /// </summary>
+    class ModelUpdateTask : public ThreadPool::Task {
+    public:
+        ModelUpdateTask(vector<Property*>& properties, size_t first, size_t last)
+            : mProperties(properties), mFirst(first), mLast(last) {
+        }
+        virtual void Execute() {
+            Model::Update(mProperties, mFirst, mLast);
+        }
+    private:
+        vector<Property*>& mProperties;
+        size_t mFirst;
+        size_t mLast;
+    };
+
     void Model::Update(vector<Property*>& properties) {
-        vector<Property*>::iterator itr;
-        for(itr=properties.begin();itr!=properties.end();++itr) {
-            Property* p = *itr;
+        size_t count = properties.size();
+        ThreadPool* pool = Current().UpdateThreadPool;
+        if (pool == NULL || count < 2) {
+            Update(properties, 0, count);
+            return;
+        }
+        // Use several ranges per thread so that threads which finish early can steal the rest.
+        size_t grain = count / (4 * pool->GetNumberOfThreads());
+        if (grain < 1) {
+            grain = 1;
+        }
+        ThreadPool::TaskGroup group;
+        for (size_t first = 0; first < count; first += grain) {
+            size_t last = first + grain < count ? first + grain : count;
+            pool->Submit(*new ModelUpdateTask(properties, first, last), group);
+        }
+        int failures = pool->Wait(group);
+        if (failures > 0) {
+            Error::Log(false, *Current().ModelErrorContext, *TypeInfo, "Update", 1, 
+                "Exception in %d parallel update tasks.", failures);
+        }
+    }
+
+    void Model::Update(vector<Property*>& properties, size_t first, size_t last) {
+        Model& model = Current();
+        const ChangeTracker* changes = model.ModelChanges;
+        Profiler* profile = model.ModelProfile;
+        for (size_t index = first; index < last; ++index) {
+            Property* p = properties[index];
             if (p->Flags.IsContainer) {
                 Container* c = (Container*)p;
                 if(c->DoEmulate) {
-                    c->Update();
+                    // Skip Dispositions whose inputs have not changed.
+                    if (changes != NULL && c->Flags.ClassKind == ClassKinds::Disposition 
+                        && !changes->IsDirty(((Disposition*)c)->GraphIndex)) {
+                        continue;
+                    }
+                    if (profile == NULL) {
+                        c->Update();
+                    } else {
+                        profile->Update(*c);
+                    }
                 }
             }
         }
@@ -219,36 +450,159 @@ namespace Plato {
 
 #pragma region // Model construction methods.
     int Model::Configure() {
-        if (ModelErrorContext->Count() > 0) return 1;
+        CurrentModelScope scope(*this);
+        if (ModelErrorContext->Count() > 0) {
+            ModelMemory->IsActive = false;
+            return 1;
+        }
 
         IsListeningToContainers = true;
+        if (ModelConfiguration->ConfigureThreads != 1) {
+            ConfigureThreadPool = new ThreadPool(ModelConfiguration->ConfigureThreads,
+                mThreadContextKey, (ThreadLocalVariable::ValuePtr)this);
+            ConfigureMutex = new Mutex();
+        }
 
+        // Each phase is a barrier: the next starts once every element has finished the last.
         ResolutionMode = ResolutionModes::Now;
         ConfigurePhase = ConfigurePhases::DistributorsNow;
-        ApplyDistributors(*this);
+        ApplyPhase(&Model::ApplyDistributors);
         ConfigurePhase = ConfigurePhases::ConnectorsNow;
-        ApplyConnectors(*this);
+        ApplyPhase(&Model::ApplyConnectors);
         ConfigurePhase = ConfigurePhases::ConvertersNow;
-        ApplyConverters(*this);
+        ApplyPhase(&Model::ApplyConverters);
 
         ResolutionMode = ResolutionModes::Final;
         ConfigurePhase = ConfigurePhases::ConnectorsFinal;
-        ApplyConnectors(*this);
+        ApplyPhase(&Model::ApplyConnectors);
         ConfigurePhase = ConfigurePhases::ConvertersFinal;
-        ApplyConverters(*this);
+        ApplyPhase(&Model::ApplyConverters);
 
+        delete ConfigureThreadPool;
+        ConfigureThreadPool = NULL;
+        delete ConfigureMutex;
+        ConfigureMutex = NULL;
         IsListeningToContainers = false;
+        // Objects created from now on may be deleted while the model runs.
+        ModelMemory->IsActive = false;
+
+        if (ModelErrorContext->Count() > 0) {
+            return 1;
+        }
+        if (ModelConfiguration->FreezeConnections || ModelConfiguration->IncrementalUpdates) {
+            Freeze(ModelConfiguration->FreezeConnections);
+        }
+        // The kernel reads the frozen graph when there is one.
+        if (ModelConfiguration->VectoriseDIDs) {
+            AnalogueKernel::Compile(*this);
+        }
+        return 0;
+    }
 
-        return (ModelErrorContext->Count() > 0) ? 1 : 0;
+    ConnectionGraph& Model::Freeze(bool releaseConnections) {
+        if (ModelConnections != NULL) {
+            if (mIsConnectionsReleased) {
+                return *ModelConnections;
+            }
+            delete ModelChanges;
+            ModelChanges = NULL;
+            delete ModelConnections;
+        }
+        ModelConnections = new ConnectionGraph(*this);
+        if (releaseConnections) {
+            vector<InputPad*>::iterator itr;
+            for (itr = ModelConnections->Pads.begin(); itr != ModelConnections->Pads.end(); ++itr) {
+                vector<InputConnection*>* connections = (*itr)->InputConnections;
+                vector<InputConnection*>::iterator citr;
+                for (citr = connections->begin(); citr != connections->end(); ++citr) {
+                    delete *citr;
+                }
+                vector<InputConnection*>().swap(*connections);
+            }
+            mIsConnectionsReleased = true;
+        }
+        if (ModelConfiguration->IncrementalUpdates) {
+            ModelChanges = new ChangeTracker(*ModelSignals, *ModelConnections, ModelConfiguration->ChangeEpsilon);
+        }
+        string& tmp = ModelConnections->StatusReport();
+        Trace::WriteLine(2, "Model.Freeze: %s", tmp.c_str());
+        delete &tmp;
+        return *ModelConnections;
     }
 
-    void Model::ApplyDistributors(Container& container) {
+    ConfigureLock::ConfigureLock(Model& model) {
+        mMutex = model.ConfigureMutex;
+        if (mMutex != NULL) {
+            mMutex->Lock();
+        }
+    }
+
+    ConfigureLock::~ConfigureLock() {
+        if (mMutex != NULL) {
+            mMutex->Unlock();
+        }
+    }
+
+    /// <summary>
+    /// A pool task that applies a configuration phase to one of the model's elements.
+    /// </summary>
+    class ModelConfigureTask : public ThreadPool::Task {
+    public:
+        ModelConfigureTask(Model& model, Model::PhaseMethod apply, Container& element)
+            : mModel(model), mApply(apply), mElement(element) {
+        }
+        virtual void Execute() {
+            (mModel.*mApply)(mElement, 0);
+        }
+    private:
+        Model& mModel;
+        Model::PhaseMethod mApply;
+        Container& mElement;
+    };
+
+    void Model::ApplyPhase(PhaseMethod apply) {
+        if (ConfigureThreadPool == NULL) {
+            (this->*apply)(*this, 0);
+            return;
+        }
+        PrepareContainers(*this);
+        vector<Property*>* properties = GetOrderedProperties();
+        size_t count = properties->size();
+        ThreadPool::TaskGroup group;
+        for (size_t index = 0; index < count; ++index) {
+            Property* p = (*properties)[index]->GetValue();
+            if (p->Flags.IsContainer && ((Container*)p)->IsComposite) {
+                ConfigureThreadPool->Submit(*new ModelConfigureTask(*this, apply, *(Container*)p), group);
+            }
+        }
+        int failures = ConfigureThreadPool->Wait(group);
+        if (failures > 0) {
+            Error::Log(false, *ModelErrorContext, *TypeInfo, "ApplyPhase", 1,
+                "Exception in %d parallel configure tasks.", failures);
+        }
+        // Now the elements added during the phase, and the model's own operators.
+        (this->*apply)(*this, count);
+    }
+
+    void Model::PrepareContainers(Container& container) {
+        container.PrepareConfigure();
+        vector<Property*>* properties = container.GetOrderedProperties();
+        vector<Property*>::iterator itr;
+        for(itr=properties->begin();itr!=properties->end();++itr) {
+            Property* p = (*itr)->GetValue();
+            if (p->Flags.IsContainer && ((Container*)p)->IsComposite) {
+                PrepareContainers(*(Container*)p);
+            }
+        }
+    }
+
+    void Model::ApplyDistributors(Container& container, size_t firstElement) {
         // Note, this method may add to a container in the recursion stack
         // so looping using int index's is used since this works when there are additions.
 
         // Descend to sub elements first - in declaration order.
-        vector<Property*>::size_type index = 0;
-        vector<Property*> * properties = container.OrderedProperties;
+        vector<Property*>::size_type index = firstElement;
+        vector<Property*> * properties = container.GetOrderedProperties();
         while(index<properties->size()) {
             Property* p = (*properties)[index++]->GetValue();
             if(p->Flags.IsContainer) {
@@ -275,10 +629,10 @@ namespace Plato {
         container.ConfigurePhase = ConfigurePhase;
     }
 
-    void Model::ApplyConnectors(Container& container) {
+    void Model::ApplyConnectors(Container& container, size_t firstElement) {
         // Descend to sub elements first - in declaration order.
-        vector<Property*>::size_type index = 0;
-        vector<Property*> * properties = container.OrderedProperties;
+        vector<Property*>::size_type index = firstElement;
+        vector<Property*> * properties = container.GetOrderedProperties();
         while(index<properties->size()) {
             Property* p = (*properties)[index++]->GetValue();
             if(p->Flags.IsContainer) {
@@ -305,10 +659,10 @@ namespace Plato {
         container.ConfigurePhase = ConfigurePhase;
     }
 
-    void Model::ApplyConverters(Container& container) {
+    void Model::ApplyConverters(Container& container, size_t firstElement) {
         // Descend to sub elements first - in declaration order.
-        vector<Property*>::size_type index = 0;
-        vector<Property*> * properties = container.OrderedProperties;
+        vector<Property*>::size_type index = firstElement;
+        vector<Property*> * properties = container.GetOrderedProperties();
         while(index<properties->size()) {
             Property* p = (*properties)[index++]->GetValue();
             if(p->Flags.IsContainer) {
@@ -335,23 +689,23 @@ namespace Plato {
         container.ConfigurePhase = ConfigurePhase;
     }
 
-    void Model::ApplyDistributorsAndConnectors(Container& container) {
+    void Model::ApplyDistributorsAndConnectors(Container& container, ResolutionModesEnum resolutionMode) {
         vector<Property*>::size_type index = 0;
-        vector<Property*> * properties = container.OrderedProperties;
+        vector<Property*> * properties = container.GetOrderedProperties();
         while(index<properties->size()) {
             Property* p = (*properties)[index++]->GetValue();
             switch(p->Flags.ClassKind) {
                 case ClassKinds::Distributor: {
                     Distributor* d = (Distributor*)p;
-                    if (container.IsUnrestricted || Restrictor::IsAllowed(*d, ResolutionMode, container)) {
-                        d->Apply(ResolutionMode, container);
+                    if (container.IsUnrestricted || Restrictor::IsAllowed(*d, resolutionMode, container)) {
+                        d->Apply(resolutionMode, container);
                     }
                 }
                 break;
                 case ClassKinds::Connector: {
                     Connector* c = (Connector*)p;
-                    if (container.IsUnrestricted || Restrictor::IsAllowed(*c, ResolutionMode, container)) {
-                        c->Apply(ResolutionMode, container);
+                    if (container.IsUnrestricted || Restrictor::IsAllowed(*c, resolutionMode, container)) {
+                        c->Apply(resolutionMode, container);
                     }
                 }
                 break;
@@ -359,7 +713,7 @@ namespace Plato {
                     if(p->Flags.IsContainer) {
                         Container* element = (Container*)p;
                         if (element->IsComposite) {
-                            ApplyDistributorsAndConnectors(*element);
+                            ApplyDistributorsAndConnectors(*element, resolutionMode);
                         }
                     }
             }
@@ -367,30 +721,30 @@ namespace Plato {
         container.ConfigurePhase = ConfigurePhase;
     }
 
-    void Model::ApplyAll(Container& container) {
+    void Model::ApplyAll(Container& container, ResolutionModesEnum resolutionMode) {
         vector<Property*>::size_type index = 0;
-        vector<Property*> * properties = container.OrderedProperties;
+        vector<Property*> * properties = container.GetOrderedProperties();
         while(index<properties->size()) {
             Property* p = (*properties)[index++]->GetValue();
             switch(p->Flags.ClassKind) {
                 case ClassKinds::Distributor: {
                         Distributor* d = (Distributor*)p;
-                        if (container.IsUnrestricted || Restrictor::IsAllowed(*d, ResolutionMode, container)) {
-                            d->Apply(ResolutionMode, container);
+                        if (container.IsUnrestricted || Restrictor::IsAllowed(*d, resolutionMode, container)) {
+                            d->Apply(resolutionMode, container);
                         }
                     }
                     break;
                 case ClassKinds::Connector: {
                         Connector* c = (Connector*)p;
-                        if (container.IsUnrestricted || Restrictor::IsAllowed(*c, ResolutionMode, container)) {
-                            c->Apply(ResolutionMode, container);
+                        if (container.IsUnrestricted || Restrictor::IsAllowed(*c, resolutionMode, container)) {
+                            c->Apply(resolutionMode, container);
                         }
                     }
                     break;
                 case ClassKinds::Converter: {
                         Converter* c = (Converter*)p;
-                        if (container.IsUnrestricted || Restrictor::IsAllowed(*c, ResolutionMode, container)) {
-                            c->Apply(ResolutionMode, container);
+                        if (container.IsUnrestricted || Restrictor::IsAllowed(*c, resolutionMode, container)) {
+                            c->Apply(resolutionMode, container);
                         }
                     }
                     break;
@@ -398,7 +752,7 @@ namespace Plato {
                     if(p->Flags.IsContainer) {
                         Container* element = (Container*)p;
                         if (element->IsComposite) {
-                            ApplyAll(*element);
+                            ApplyAll(*element, resolutionMode);
                         }
                     }
             }
@@ -409,7 +763,7 @@ namespace Plato {
     void Model::AddedProperty(Container& container, Property& prop) {
         Property* p = prop.GetValue();
         ConfigurePhasesEnum parentPhase;
-        ResolutionModesEnum tmpResolutionMode;
+        ResolutionModesEnum resolutionMode;
         Distributor* d;
         switch(ConfigurePhase) {
             case ConfigurePhases::DistributorsNow:
@@ -450,26 +804,26 @@ namespace Plato {
                     // If addition is before current position:
                     //   Do nows, and finals if in final mode.
                     // else Do nows if in final mode (or Dynamic mode?).
-                    tmpResolutionMode = ResolutionMode;
+                    // The mode is kept locally, since other threads may be configuring other elements.
+                    resolutionMode = ResolutionMode;
                     if (parentPhase < ConfigurePhase) {
                         // Addition was after current position.
                         if (ResolutionMode == ResolutionModes::Now) {
                             return;
                         }
-                        ResolutionMode = ResolutionModes::Now;
+                        resolutionMode = ResolutionModes::Now;
                     }
                     if(p->Flags.ClassKind==ClassKinds::Connector) {
                         Connector* c = (Connector*)p;                        
-                        if (container.IsUnrestricted || Restrictor::IsAllowed(*c, ResolutionMode, container)) {
-                            c->Apply(ResolutionMode, container);
+                        if (container.IsUnrestricted || Restrictor::IsAllowed(*c, resolutionMode, container)) {
+                            c->Apply(resolutionMode, container);
                         }
                     } else if(p->Flags.IsContainer) {
                         Container* element = (Container*)p;
                         if (element->IsComposite) {
-                            ApplyDistributorsAndConnectors(*element);
+                            ApplyDistributorsAndConnectors(*element, resolutionMode);
                         }
                     }
-                    ResolutionMode = tmpResolutionMode;
                 }
                 break;
 
@@ -490,31 +844,30 @@ namespace Plato {
                     // If addition is before current position:
                     //   Do nows, and finals if in final mode.
                     // else Do nows if in final mode (or Dynamic mode?).
-                    tmpResolutionMode = ResolutionMode;
+                    resolutionMode = ResolutionMode;
                     if (parentPhase < ConfigurePhase) {
                         // Addition was after current position.
                         if (ResolutionMode == ResolutionModes::Now) {
                             return;
                         }
-                        ResolutionMode = ResolutionModes::Now;
+                        resolutionMode = ResolutionModes::Now;
                     }
                     if(p->Flags.ClassKind==ClassKinds::Connector) {
                         Connector* c = (Connector*)p;                        
-                        if (container.IsUnrestricted || Restrictor::IsAllowed(*c, ResolutionMode, container)) {
-                            c->Apply(ResolutionMode, container);
+                        if (container.IsUnrestricted || Restrictor::IsAllowed(*c, resolutionMode, container)) {
+                            c->Apply(resolutionMode, container);
                         }
                     } else if(p->Flags.ClassKind==ClassKinds::Converter) {
                         Converter* v = (Converter*)p;                            
-                        if (container.IsUnrestricted || Restrictor::IsAllowed(*v, ResolutionMode, container)) {
-                            v->Apply(ResolutionMode, container);
+                        if (container.IsUnrestricted || Restrictor::IsAllowed(*v, resolutionMode, container)) {
+                            v->Apply(resolutionMode, container);
                         }
                     } else if(p->Flags.IsContainer) {
                         Container* element = (Container*)p; 
                         if (element->IsComposite) {
-                            ApplyAll(*element);
+                            ApplyAll(*element, resolutionMode);
                         }
                     }
-                    ResolutionMode = tmpResolutionMode;
                 }
                 break;
         }
@@ -10,12 +10,14 @@
 #include "PropertyScopes.h"
 #include "Property.h"
 #include "ThreadLocalVariable.h"
+#include "Mutex.h"
 #include "ConfigurePhases.h"
 #include "ResolutionModes.h"
 #include "Container.h"
 #include "Path.h"
 #include "PathNode.h"
 #include "PathEnumerator.h"
+#include "PathProgram.h"
 #include "Model.h"
 #include "Error.h"
 
@@ -32,7 +34,6 @@ namespace Plato {
     const PathNode* Path::Wild = NULL;
     const PathNode* Path::Start = NULL;
     const PathNode* Path::End = NULL;
-    string* Path::mPathPrefix = NULL;
     Path::HashMap* Path::mStandardPathNodes = NULL;
  
     void Path::Initializer() {
@@ -76,6 +77,7 @@ namespace Plato {
 #pragma region // Constructors.
     Path::Path(Container* creator, PathNode& pn) {
         Creator = creator;
+        mProgram = NULL;
         if (pn.Parent == NULL || pn.NodeKind!=PathNodeKinds::Normal) {
             HeadPathNode = pn.GetWritable();
         } else {
@@ -87,6 +89,7 @@ namespace Plato {
 
     Path::Path(const Path& path) {
         Creator = path.Creator;
+        mProgram = NULL;
         if (path.HeadPathNode != NULL) {
             HeadPathNode = new PathNode(*(path.HeadPathNode));
             PathNode* n = HeadPathNode;
@@ -100,6 +103,7 @@ namespace Plato {
     }
 
     Path::~Path() {
+        delete mProgram;
         delete HeadPathNode;
     }
 #pragma endregion
@@ -115,15 +119,16 @@ namespace Plato {
     }
 
     string* Path::GetPathPrefix() {
-        if (mPathPrefix == NULL) {
-            const Configuration* configuration = Model::Current().ModelConfiguration;
+        Model& model = Model::Current();
+        if (model.ModelPathPrefix == NULL) {
+            const Configuration* configuration = model.ModelConfiguration;
             if (configuration->PathPrefix == NULL) {
-                Error::Log(true, *Model::Current().ModelErrorContext, *TypeInfo, "PathPrefix", 4, "PathPrefix was NULL.");
+                Error::Log(true, *model.ModelErrorContext, *TypeInfo, "PathPrefix", 4, "PathPrefix was NULL.");
             } else {
-                mPathPrefix = &EnvironmentVariables::ExpandString(*configuration,*(configuration->PathPrefix));
+                model.ModelPathPrefix = &EnvironmentVariables::ExpandString(*configuration,*(configuration->PathPrefix));
             }
         }
-        return mPathPrefix;
+        return model.ModelPathPrefix;
     }
 #pragma endregion
 
@@ -141,44 +146,8 @@ namespace Plato {
 
     Property* Path::GetProperty(Container* currentContainer, const Property* requester, PropertyModesEnum mode, 
                 PathNode*& pathNode, Container*& contextContainer) const {
-        PathNode* n = HeadPathNode;
-        Property* p = currentContainer;
-        contextContainer = NULL;
-        while (n != NULL) {
-            p = n->GetProperty(currentContainer, requester, mode, contextContainer);
-            n->NodeProperty = p;
-            if (p == NULL) {
-                // Branch search failed, check if multivalued.
-                if(contextContainer!=NULL) {
-                    p = currentContainer;
-                    break;
-                }
-                // Not multivalued, so return Head pathNode and NULL.
-                n = HeadPathNode;
-                break;
-            }
-            Property* v = p->GetValue();
-            if(v->Flags.IsContainer) {
-                Container* container = (Container*)v;
-                if (n->Next == NULL) {
-                    // Check for implicit Directors.
-                    if ((mode & PropertyModes::Directing) != 0) {
-                        Property* q = container->DirectToProperty(NULL, requester, requester, mode);
-                        if (q != NULL) {
-                            contextContainer = q->Parent;
-                            p = q;
-                        }
-                    }
-                    break;
-                }
-                currentContainer = container;
-                n = n->Next;
-            } else {
-                break;
-            }
-        }
-        pathNode = n;
-        return p;
+        const PathProgram& program = PathProgram::GetCurrent(*this, mProgram);
+        return program.Execute(currentContainer, requester, mode, pathNode, contextContainer);
     }
 
     Property* Path::GetProperty(Container* currentContainer, const Property* requester, PropertyModesEnum mode) const {
@@ -17,20 +17,31 @@
 
 namespace Plato {
 
-    PathEnumeratorState::PathEnumeratorState(Container* container, PathNode* pathNode, bool skipEnumerator, 
-            const Property* requester, PropertyModesEnum mode, GroupContainer* pathGroupTree, int countRemaining, bool doDelete) {
-        CurrentContainer = container;
-        PathGroupTree = pathGroupTree;
-        CurrentPathNode = pathNode;
-        CountRemaining = countRemaining;
-        DoDelete = doDelete;
-        NodeEnumerator = (skipEnumerator ? NULL : pathNode->GetEnumerator(container, requester, mode));
+    PathEnumeratorState::PathEnumeratorState() {
+        CurrentContainer = NULL;
+        PathGroupTree = NULL;
+        CurrentPathNode = NULL;
+        CountRemaining = -1;
+        NodeEnumerator = NULL;
     }
 
     PathEnumeratorState::~PathEnumeratorState() {
         delete NodeEnumerator;
-        if(DoDelete && CurrentPathNode!=NULL) {
-            delete CurrentPathNode->Head();
+    }
+
+    void PathEnumeratorState::Set(Container* container, PathNode* pathNode, const Property* requester, 
+            PropertyModesEnum mode, GroupContainer* pathGroupTree) {
+        CurrentContainer = container;
+        PathGroupTree = pathGroupTree;
+        CurrentPathNode = pathNode;
+        CountRemaining = -1;
+        if (pathNode->NodeKind==PathNodeKinds::Any) {
+            return;
+        }
+        if (NodeEnumerator == NULL) {
+            NodeEnumerator = pathNode->GetEnumerator(container, requester, mode);
+        } else {
+            NodeEnumerator->Reset(*pathNode, container);
         }
     }
 
@@ -42,7 +53,10 @@ namespace Plato {
         mMode = mode;
         mIsWidthFirstDescent = isWidthFirstDescent;
         mGroupHandler = groupHandler;
-        PathEnumeratorStateList = new vector<PathEnumeratorState*>();
+        mStatesCapacity = 16;
+        mStates = new PathEnumeratorState*[mStatesCapacity];
+        mStatesFront = 0;
+        mStatesCount = 0;
         PathGroupTree = NULL;
         mIsReset = true;
         Current = NULL;
@@ -50,14 +64,24 @@ namespace Plato {
 
     PathEnumerator::~PathEnumerator() {
         Reset();
+        vector<PathEnumeratorState*>::iterator itr;
+        for (itr = mFreeStates.begin(); itr != mFreeStates.end(); ++itr) {
+            delete *itr;
+        }
+        delete[] mStates;
+        vector<PathNode*>::iterator nitr;
+        for (nitr = mWildPathNodes.begin(); nitr != mWildPathNodes.end(); ++nitr) {
+            // Unlink from the path before deleting, since a node deletes its Next.
+            (*nitr)->Next = NULL;
+            (*nitr)->Parent = NULL;
+            delete *nitr;
+        }
         delete mPath;
-        delete PathEnumeratorStateList;
     }
 
     PathEnumeratorState* PathEnumerator::CurrentState() {
-        vector<PathEnumeratorState*>::size_type count = PathEnumeratorStateList->size();
-        if (count > 0) {
-            return (*PathEnumeratorStateList)[mIsWidthFirstDescent ? 0 : count - 1];
+        if (mStatesCount > 0) {
+            return mStates[(mStatesFront + (mIsWidthFirstDescent ? 0 : mStatesCount - 1)) & (mStatesCapacity - 1)];
         }
         return NULL;
     }
@@ -67,11 +91,84 @@ namespace Plato {
         Current = NULL;
         delete PathGroupTree;
         PathGroupTree = NULL;
-        vector<PathEnumeratorState*>::iterator itr = PathEnumeratorStateList->begin();
-        for(itr = PathEnumeratorStateList->begin();itr!=PathEnumeratorStateList->end();++itr) {
-            delete *itr;
+        while (mStatesCount != 0) {
+            FreeState(*PopCurrentState());
+        }
+        mStatesFront = 0;
+    }
+
+    PathEnumeratorState& PathEnumerator::NewState(Container* container, PathNode* pathNode, GroupContainer* pathGroupTree) {
+        PathEnumeratorState* state;
+        if (mFreeStates.empty()) {
+            state = new PathEnumeratorState();
+        } else {
+            state = mFreeStates.back();
+            mFreeStates.pop_back();
+        }
+        state->Set(container, pathNode, mRequester, mMode, pathGroupTree);
+        return *state;
+    }
+
+    void PathEnumerator::FreeState(PathEnumeratorState& state) {
+        if (state.NodeEnumerator != NULL) {
+            // Release any filter container now, rather than when the state is reused.
+            state.NodeEnumerator->Reset();
+        }
+        mFreeStates.push_back(&state);
+    }
+
+    void PathEnumerator::PushFrontState(PathEnumeratorState& state) {
+        if (mStatesCount == mStatesCapacity) {
+            GrowStates();
+        }
+        mStatesFront = (mStatesFront - 1) & (mStatesCapacity - 1);
+        mStates[mStatesFront] = &state;
+        ++mStatesCount;
+    }
+
+    void PathEnumerator::PushBackState(PathEnumeratorState& state) {
+        if (mStatesCount == mStatesCapacity) {
+            GrowStates();
         }
-        PathEnumeratorStateList->clear();
+        mStates[(mStatesFront + mStatesCount) & (mStatesCapacity - 1)] = &state;
+        ++mStatesCount;
+    }
+
+    PathEnumeratorState* PathEnumerator::PopCurrentState() {
+        PathEnumeratorState* state = CurrentState();
+        if (state != NULL) {
+            if (mIsWidthFirstDescent) {
+                mStatesFront = (mStatesFront + 1) & (mStatesCapacity - 1);
+            }
+            --mStatesCount;
+        }
+        return state;
+    }
+
+    void PathEnumerator::GrowStates() {
+        PathEnumeratorState** states = new PathEnumeratorState*[mStatesCapacity * 2];
+        for (int i = 0; i < mStatesCount; i++) {
+            states[i] = mStates[(mStatesFront + i) & (mStatesCapacity - 1)];
+        }
+        delete[] mStates;
+        mStates = states;
+        mStatesFront = 0;
+        mStatesCapacity *= 2;
+    }
+
+    PathNode* PathEnumerator::GetWildPathNode(PathNode& anyPathNode) {
+        vector<PathNode*>::iterator itr;
+        for (itr = mWildPathNodes.begin(); itr != mWildPathNodes.end(); ++itr) {
+            if ((*itr)->Next == &anyPathNode) {
+                return *itr;
+            }
+        }
+        PathNode* wildPathNode = new PathNode(*Path::Wild);
+        wildPathNode->ParentPath = anyPathNode.ParentPath;
+        wildPathNode->Parent = anyPathNode.Parent;
+        wildPathNode->Next = &anyPathNode;
+        mWildPathNodes.push_back(wildPathNode);
+        return wildPathNode;
     }
 
     bool PathEnumerator::MoveNext() {
@@ -116,45 +213,37 @@ namespace Plato {
                 return true;
             }
             // Prime the stack.
-            PathEnumeratorStateList->push_back(new PathEnumeratorState(container, hn, hn->NodeKind==PathNodeKinds::Any,mRequester,mMode,groupTree,-1,false));
+            PushBackState(NewState(container, hn, groupTree));
         }
 
-        vector<PathEnumeratorState*>::size_type count;
-        while ((count=PathEnumeratorStateList->size()) != 0) {
-            PathEnumeratorState* state = (*PathEnumeratorStateList)[mIsWidthFirstDescent ? 0 : count - 1];
+        while (mStatesCount != 0) {
+            PathEnumeratorState* state = CurrentState();
             if (state->CurrentPathNode->NodeKind==PathNodeKinds::Any) {
-                // Set up two new path node chains:
-                // A/AnyPattern/B ==> {tmpCut = A/B, tmpWild = A/WildPattern/AnyPattern/B}.
-                PathNode* cn = state->CurrentPathNode;
+                // Continue along two path node chains:
+                // A/AnyPattern/B ==> {cut = A/B, wild = A/WildPattern/AnyPattern/B}.
+                // Neither chain is copied: the cut state resumes at B, and the wild state
+                // at a Wild node whose Next is the Any node itself.
+                PathNode* pAny = state->CurrentPathNode;
                 Container* container = state->CurrentContainer;
-                PathEnumeratorStateList->erase(PathEnumeratorStateList->begin()+(mIsWidthFirstDescent ? 0 : count - 1));
+                GroupContainer* groupTree = state->PathGroupTree;
+                FreeState(*PopCurrentState());
 
-                PathNode* tmpCut = new PathNode(*(cn->Head()));
-                PathNode* tmpWild = new PathNode(*tmpCut);
-                // Remove Any node from tmpCut.
-                int anyIndex = cn->Index();
-                PathNode* pAny = (*tmpCut)[anyIndex];
+                // Need to make cut top of stack, then wild, depending on mIsWidthFirstDescent.
                 PathNode* pCut = pAny->Next;
-                pAny->Remove();
-                delete pAny;
-                // Insert Wild node into tmpWild.
-                pAny = (*tmpWild)[anyIndex];
-                PathNode* pWild = new PathNode(*Path::Wild);
-                pAny->Insert(*pWild);
-
-                // Need to make tmpCut top of stack, then tmpWild, depending on mIsWidthFirstDescent.
-                GroupContainer* groupTree = state->PathGroupTree;
-                PathEnumeratorState* wildState = new PathEnumeratorState(container, pWild, false, mRequester, mMode, groupTree,-1,true);
-                PathEnumeratorState* cutState = new PathEnumeratorState(container, pCut, false, mRequester, mMode, groupTree,-1,true);
-                delete state;
+                PathEnumeratorState* wildState = &NewState(container, GetWildPathNode(*pAny), groupTree);
+                PathEnumeratorState* cutState = pCut == NULL ? NULL : &NewState(container, pCut, groupTree);
                 if (mIsWidthFirstDescent) {
                     state = wildState;
-                    PathEnumeratorStateList->insert(PathEnumeratorStateList->begin(),cutState);
-                    PathEnumeratorStateList->insert(PathEnumeratorStateList->begin(),state);
+                    if (cutState != NULL) {
+                        PushFrontState(*cutState);
+                    }
+                    PushFrontState(*state);
                 } else {
-                    state = cutState;
-                    PathEnumeratorStateList->push_back(wildState);
-                    PathEnumeratorStateList->push_back(state);
+                    state = cutState == NULL ? wildState : cutState;
+                    PushBackState(*wildState);
+                    if (cutState != NULL) {
+                        PushBackState(*cutState);
+                    }
                 }
             }
 
@@ -188,13 +277,13 @@ namespace Plato {
                                 groupTree = groupTree->AddGroup(prop,currentNode->GroupNumber);
                             }
                             // Add child path node to stack.
-                            state = new PathEnumeratorState(container, pn, false, mRequester, mMode, groupTree,-1,false);
+                            state = &NewState(container, pn, groupTree);
                             if (mIsWidthFirstDescent && !pn->GroupBoundary) {
                                 // Force non boundary nodes to be next one resolved.
-                                PathEnumeratorStateList->insert(PathEnumeratorStateList->begin(), state);
+                                PushFrontState(*state);
                             } else {
                                 // Add boundary nodes to end of stack and all nodes when depth first descent.
-                                PathEnumeratorStateList->push_back(state);
+                                PushBackState(*state);
                             }
                             continue;
                         }
@@ -211,12 +300,9 @@ namespace Plato {
                 }
             }
 
-            // Remove current state from stack and delete.
-            count = PathEnumeratorStateList->size();
-            if (count != 0) {
-                PathEnumeratorStateList->erase(PathEnumeratorStateList->begin()+(mIsWidthFirstDescent ? 0 : --count));
-            }
-            delete state;
+            // Remove current state from stack and recycle.
+            PopCurrentState();
+            FreeState(*state);
         }
         return false;
     }
@@ -0,0 +1,124 @@
+#include "PlatoIncludes.h"
+#include "Strings.h"
+#include "Numbers.h"
+#include "Mutex.h"
+#include "ClassTypeInfo.h"
+#include "Identifier.h"
+#include "PropertyScopes.h"
+#include "PropertyModes.h"
+#include "ConfigurePhases.h"
+#include "ResolutionModes.h"
+#include "Property.h"
+#include "Container.h"
+#include "PathNode.h"
+#include "PathMemo.h"
+
+namespace Plato {
+
+    Atomic::Value PathMemo::mLastGeneration = 0;
+
+#pragma region // PathResolution.
+    void PathResolution::AddDependency(Container& hop) {
+        Dependency d;
+        d.Hop = &hop;
+        d.Generation = hop.Generation;
+        Dependencies.push_back(d);
+    }
+
+    void PathResolution::AddNodeValue(PathNode& node, Property* value) {
+        NodeValue v;
+        v.Node = &node;
+        v.Value = value;
+        NodeValues.push_back(v);
+    }
+
+    bool PathResolution::IsValid() const {
+        vector<Dependency>::const_iterator itr;
+        for (itr = Dependencies.begin(); itr != Dependencies.end(); ++itr) {
+            if (itr->Hop->Generation != itr->Generation) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Property* PathResolution::Replay(PathNode*& pathNode, Container*& contextContainer) const {
+        vector<NodeValue>::const_iterator itr;
+        for (itr = NodeValues.begin(); itr != NodeValues.end(); ++itr) {
+            itr->Node->NodeProperty = itr->Value;
+        }
+        pathNode = ResultNode;
+        contextContainer = ResultContext;
+        return Result;
+    }
+#pragma endregion
+
+#pragma region // PathMemo.
+    size_t PathMemo::KeyTraits::Hash(const Key& key) {
+        size_t h = ((size_t)key.Start >> 4) ^ ((size_t)key.ProgramId * 0x9e3779b1u) ^ ((size_t)key.Mode << 24);
+        return h ^ (h >> 15);
+    }
+
+    PathMemo::PathMemo() {
+        mHits = 0;
+        mMisses = 0;
+    }
+
+    PathMemo::~PathMemo() {
+        Clear();
+    }
+
+    bool PathMemo::Find(const Key& key, Property*& result, PathNode*& pathNode, Container*& contextContainer) {
+        MutexLock lock(mLock);
+        HashTable::iterator itr = mResolutions.find(key);
+        if (itr != mResolutions.end() && itr->second->IsValid()) {
+            ++mHits;
+            result = itr->second->Replay(pathNode, contextContainer);
+            return true;
+        }
+        ++mMisses;
+        return false;
+    }
+
+    void PathMemo::Store(const Key& key, PathResolution& resolution) {
+        MutexLock lock(mLock);
+        if ((int)mResolutions.size() >= Capacity) {
+            DeleteResolutions();
+        }
+        PathResolution*& entry = mResolutions[key];
+        delete entry;
+        entry = &resolution;
+    }
+
+    void PathMemo::Clear() {
+        MutexLock lock(mLock);
+        DeleteResolutions();
+    }
+
+    void PathMemo::DeleteResolutions() {
+        HashTable::iterator itr;
+        for (itr = mResolutions.begin(); itr != mResolutions.end(); ++itr) {
+            delete itr->second;
+        }
+        mResolutions.clear();
+    }
+
+    int PathMemo::Count() {
+        MutexLock lock(mLock);
+        return (int)mResolutions.size();
+    }
+
+    string& PathMemo::StatusReport() {
+        MutexLock lock(mLock);
+        string& result = *new string("PathMemo(Count=");
+        string& count = Numbers::ToString((int)mResolutions.size());
+        string& hits = Numbers::ToString(mHits);
+        string& misses = Numbers::ToString(mMisses);
+        result += count + ",Hits=" + hits + ",Misses=" + misses + ")";
+        delete &misses;
+        delete &hits;
+        delete &count;
+        return result;
+    }
+#pragma endregion
+}
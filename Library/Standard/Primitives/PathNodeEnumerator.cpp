@@ -23,7 +23,7 @@ namespace Plato {
 
     PathNodeEnumerator::PathNodeEnumerator(PathNode& currentPathNode, Container* nodeCurrentContainer, 
             const Property* requester, PropertyModesEnum mode) {
-        mPathNode = new PathNode(currentPathNode);
+        mPathNode = &currentPathNode;
         mNodeCurrentContainer = nodeCurrentContainer;
         mRequester = requester;
         mMode = mode;
@@ -33,7 +33,6 @@ namespace Plato {
     }
 
     PathNodeEnumerator::~PathNodeEnumerator() {
-        delete mPathNode;
         delete mNodeEnumerator;
         delete mFilterContainer;
     }
@@ -42,10 +41,7 @@ namespace Plato {
         Current = NULL;
         NodeGroupFilter = NULL;
         mWorkingContainer = NULL;
-        if(mNodeEnumerator!=NULL) {
-            delete mNodeEnumerator;
-            mNodeEnumerator = NULL;
-        }
+        mIsNodeEnumerating = false;
         if(mFilterContainer!=NULL) {
             delete mFilterContainer;
             mFilterContainer = NULL;
@@ -53,6 +49,21 @@ namespace Plato {
         mIsReset = true;
     }
 
+    void PathNodeEnumerator::Reset(PathNode& currentPathNode, Container* nodeCurrentContainer) {
+        mPathNode = &currentPathNode;
+        mNodeCurrentContainer = nodeCurrentContainer;
+        Reset();
+    }
+
+    void PathNodeEnumerator::StartNodeEnumerator(Container& container) {
+        if (mNodeEnumerator == NULL) {
+            mNodeEnumerator = new ScopeEnumerator(container,mRequester);
+        } else {
+            mNodeEnumerator->Reset(container);
+        }
+        mIsNodeEnumerating = true;
+    }
+
     bool PathNodeEnumerator::MoveNext() {
         // Working out what is next item from path node:
         // 0) Move to required container: (e.g. Owner, Parent, etc.), see NodeKind.
@@ -62,7 +73,7 @@ namespace Plato {
         // 4) Return values via enumerator.
         while (mIsReset) {
             mIsReset = false;
-            mNodeEnumerator = NULL;
+            mIsNodeEnumerating = false;
             // Check if this node refers to a single container or many.
             switch(mPathNode->NodeKind) {
                 case PathNodeKinds::Wild:
@@ -71,7 +82,7 @@ namespace Plato {
                     if (mWorkingContainer == NULL) {
                         return false;
                     }
-                    mNodeEnumerator = new ScopeEnumerator(*mWorkingContainer,mRequester);
+                    StartNodeEnumerator(*mWorkingContainer);
                     break;
                 case PathNodeKinds::Regex:
                     mWorkingContainer = mNodeCurrentContainer;
@@ -100,7 +111,7 @@ namespace Plato {
                             NodeGroupFilter = (GroupFilter*)mFilterContainer;
                         }
                         mFilterContainer->AccessContents();
-                        mNodeEnumerator = new ScopeEnumerator(*mFilterContainer,mRequester);
+                        StartNodeEnumerator(*mFilterContainer);
                     }
                     break;
                 default: // Node refers to a single object.
@@ -109,7 +120,7 @@ namespace Plato {
             }
         }
 
-        if (mNodeEnumerator != NULL && mNodeEnumerator->MoveNext()) {
+        if (mIsNodeEnumerating && mNodeEnumerator->MoveNext()) {
             Current = mNodeEnumerator->Current;
         } else {
             Current = NULL;
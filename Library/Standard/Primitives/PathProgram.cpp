@@ -0,0 +1,223 @@
+#include "PlatoIncludes.h"
+#include "Strings.h"
+#include "Mutex.h"
+#include "ClassTypeInfo.h"
+#include "Identifier.h"
+#include "PropertyScopes.h"
+#include "PropertyModes.h"
+#include "ConfigurePhases.h"
+#include "ResolutionModes.h"
+#include "Property.h"
+#include "ThreadLocalVariable.h"
+#include "Container.h"
+#include "Path.h"
+#include "PathNode.h"
+#include "PathMemo.h"
+#include "PathProgram.h"
+#include "Model.h"
+
+namespace Plato {
+
+    Atomic::Value PathProgram::mLastId = 0;
+    Mutex PathProgram::mCompileLock;
+
+#pragma region // Constructors.
+    PathProgram::PathProgram(const Path& path, PathProgram* previous) : Id(Atomic::Increment(&mLastId)) {
+        mPrevious = previous;
+        PathNode* n;
+        for (n = path.HeadPathNode; n != NULL; n = n->Next) {
+            Instruction instruction;
+            instruction.Opcode = GetOpcode(*n);
+            instruction.Node = n;
+            mInstructions.push_back(instruction);
+        }
+    }
+
+    PathProgram::~PathProgram() {
+        delete mPrevious;
+    }
+#pragma endregion
+
+#pragma region // Methods.
+    const PathProgram& PathProgram::GetCurrent(const Path& path, PathProgram*& program) {
+        PathProgram* current = program;
+        if (current != NULL && current->IsCurrent(path)) {
+            return *current;
+        }
+        MutexLock lock(mCompileLock);
+        // Another thread may have compiled it first.
+        current = program;
+        if (current == NULL || !current->IsCurrent(path)) {
+            current = new PathProgram(path, current);
+            program = current;
+        }
+        return *current;
+    }
+
+    bool PathProgram::IsCurrent(const Path& path) const {
+        PathNode* n = path.HeadPathNode;
+        vector<Instruction>::const_iterator itr;
+        for (itr = mInstructions.begin(); itr != mInstructions.end(); ++itr) {
+            if (n != itr->Node) {
+                return false;
+            }
+            n = n->Next;
+        }
+        return n == NULL;
+    }
+
+    Property* PathProgram::Execute(Container* currentContainer, const Property* requester, PropertyModesEnum mode,
+            PathNode*& pathNode, Container*& contextContainer) const {
+        PathMemo* memo = NULL;
+        if (requester == NULL && (mode & PropertyModes::Producing) == 0 && currentContainer != NULL) {
+            Model* model = Model::FindCurrent();
+            if (model != NULL) {
+                memo = model->ResolutionMemo;
+            }
+        }
+        if (memo == NULL) {
+            return Run(currentContainer, requester, mode, pathNode, contextContainer, NULL);
+        }
+        PathMemo::Key key(currentContainer, Id, (int)mode);
+        Property* p;
+        if (memo->Find(key, p, pathNode, contextContainer)) {
+            return p;
+        }
+        PathResolution* resolution = new PathResolution();
+        p = Run(currentContainer, requester, mode, pathNode, contextContainer, resolution);
+        if (p != NULL && resolution->IsMemoisable) {
+            resolution->Result = p;
+            resolution->ResultNode = pathNode;
+            resolution->ResultContext = contextContainer;
+            memo->Store(key, *resolution);
+        } else {
+            delete resolution;
+        }
+        return p;
+    }
+
+    Property* PathProgram::Run(Container* currentContainer, const Property* requester, PropertyModesEnum mode,
+            PathNode*& pathNode, Container*& contextContainer, PathResolution* resolution) const {
+        Property* p = currentContainer;
+        PathNode* n = NULL;
+        contextContainer = NULL;
+        size_t count = mInstructions.size();
+        for (size_t index = 0; index < count; ++index) {
+            const Instruction& instruction = mInstructions[index];
+            n = instruction.Node;
+            switch (instruction.Opcode) {
+                case PathOpcodes::Child:
+                    contextContainer = currentContainer;
+                    p = NULL;
+                    if (currentContainer != NULL) {
+                        if (resolution != NULL) {
+                            resolution->AddDependency(*currentContainer);
+                        }
+                        p = currentContainer->GetProperty(*n->Identity, requester, mode);
+                    }
+                    break;
+                case PathOpcodes::Root:
+                    p = contextContainer = &(Model::Current());
+                    break;
+                case PathOpcodes::Current:
+                    p = contextContainer = currentContainer;
+                    break;
+                case PathOpcodes::Parent:
+                    contextContainer = currentContainer == NULL ? NULL : currentContainer->Parent;
+                    if (contextContainer != NULL && resolution != NULL) {
+                        // Moving the current container changes the generation of its old parent.
+                        resolution->AddDependency(*contextContainer);
+                    }
+                    p = contextContainer;
+                    break;
+                case PathOpcodes::Owner:
+                    p = contextContainer = n->ParentPath->Creator;
+                    break;
+                case PathOpcodes::Director:
+                    contextContainer = currentContainer;
+                    p = NULL;
+                    if (currentContainer != NULL) {
+                        p = currentContainer->DirectToProperty(n->Identity, requester, requester, mode);
+                    }
+                    if (resolution != NULL) {
+                        resolution->IsMemoisable = false;
+                    }
+                    break;
+                case PathOpcodes::Search:
+                    p = NULL;
+                    break;
+                case PathOpcodes::Branch:
+                    contextContainer = currentContainer;
+                    p = NULL;
+                    break;
+            }
+            n->NodeProperty = p;
+            if (resolution != NULL) {
+                resolution->AddNodeValue(*n, p);
+            }
+            if (p == NULL) {
+                // Branch search failed, check if multivalued.
+                if (contextContainer != NULL) {
+                    p = currentContainer;
+                    break;
+                }
+                // Not multivalued, so return Head pathNode and NULL.
+                n = mInstructions[0].Node;
+                break;
+            }
+            if (p->Flags.IsProxied && resolution != NULL) {
+                resolution->IsMemoisable = false;
+            }
+            Property* v = p->GetValue();
+            if (v->Flags.IsContainer) {
+                Container* container = (Container*)v;
+                if (index + 1 == count) {
+                    // Check for implicit Directors.
+                    if ((mode & PropertyModes::Directing) != 0) {
+                        if (resolution != NULL) {
+                            resolution->AddDependency(*container);
+                        }
+                        Property* q = container->DirectToProperty(NULL, requester, requester, mode);
+                        if (q != NULL) {
+                            contextContainer = q->Parent;
+                            p = q;
+                            if (resolution != NULL) {
+                                resolution->IsMemoisable = false;
+                            }
+                        }
+                    }
+                    break;
+                }
+                currentContainer = container;
+            } else {
+                break;
+            }
+        }
+        pathNode = n;
+        return p;
+    }
+
+    PathOpcodesEnum PathProgram::GetOpcode(const PathNode& node) {
+        switch (node.NodeKind) {
+            case PathNodeKinds::Normal:
+                return PathOpcodes::Child;
+            case PathNodeKinds::Absolute:
+            case PathNodeKinds::Start:
+            case PathNodeKinds::End:
+                return PathOpcodes::Root;
+            case PathNodeKinds::Relative:
+                return PathOpcodes::Current;
+            case PathNodeKinds::Parent:
+                return PathOpcodes::Parent;
+            case PathNodeKinds::Owner:
+                return PathOpcodes::Owner;
+            case PathNodeKinds::Director:
+                return PathOpcodes::Director;
+            case PathNodeKinds::Search:
+                return PathOpcodes::Search;
+            default:
+                return PathOpcodes::Branch;
+        }
+    }
+#pragma endregion
+}
@@ -22,7 +22,7 @@ namespace Plato {
         Coordinates[1] = y;
         Coordinates[2] = z;
         Coordinates[3] = overlayID;
-        HashCode = *((size_t*)&x) ^ *((size_t*)&y) ^ *((size_t*)&z) ^ *((size_t*)&overlayID);
+        UpdateHashCode();
         Status = PointStatus::Normal;
     }
 
@@ -32,12 +32,13 @@ namespace Plato {
         Coordinates[1] = y;
         Coordinates[2] = z;
         Coordinates[3] = overlayID;
-        HashCode = *((size_t*)&x) ^ *((size_t*)&y) ^ *((size_t*)&z) ^ *((size_t*)&overlayID);
+        UpdateHashCode();
     }
 
     Point::Point(const string& position) {
         int coordinateIndex = 0;
         int len = (int)position.size();
+        Status = PointStatus::Normal;
         HashCode = 0;
         string::size_type findIndex = position.find(PositionSeparator);
         if(findIndex!=string::npos) {
@@ -72,7 +73,6 @@ namespace Plato {
                         }
                     }
                     val = Numbers::ToFloat(part);
-                    HashCode ^= *((size_t*)&val);
                 } else {
                     val = 0.0f;
                 }
@@ -82,6 +82,9 @@ namespace Plato {
         while (coordinateIndex < NumberOfCoordinates) { 
             Coordinates[coordinateIndex++] = 0.0f; 
         }
+        if (Status == PointStatus::Normal) {
+            UpdateHashCode();
+        }
     }
 
     Point::Point(const Point& point) {
@@ -93,9 +96,24 @@ namespace Plato {
         HashCode = point.HashCode;
     }
 
+    Point& Point::operator=(const Point& point) {
+        int n = NumberOfCoordinates;
+        while(n-- > 0) {
+            Coordinates[n] = point.Coordinates[n];
+        }
+        Status = point.Status;
+        HashCode = point.HashCode;
+        return *this;
+    }
+
     void Point::UpdateHashCode() {
-        HashCode = *((size_t*)Coordinates+1) ^ *((size_t*)Coordinates+2) 
-            ^ *((size_t*)Coordinates+3) ^ *((size_t*)Coordinates+4);
+        // Hash the bits of each float, which are narrower than size_t on 64 bit platforms.
+        HashCode = 0;
+        for (int i = 0; i < NumberOfCoordinates; ++i) {
+            uint32_t bits;
+            memcpy(&bits, &Coordinates[i], sizeof(bits));
+            HashCode = HashCode * 31 ^ bits;
+        }
     }
 
     string& Point::StatusReport() const {
@@ -0,0 +1,49 @@
+#include "PlatoIncludes.h"
+#include "CoordinateNames.h"
+#include "Point.h"
+#include "PointBatch.h"
+
+namespace Plato {
+
+#pragma region // Constructors.
+    PointBatch::PointBatch(int capacity) : Capacity(capacity > 0 ? capacity : 1) {
+        Count = 0;
+        mValues = new float[Capacity * Point::NumberOfCoordinates];
+        for (int i = 0; i < Point::NumberOfCoordinates; ++i) {
+            Coordinates[i] = mValues + i * Capacity;
+        }
+    }
+
+    PointBatch::PointBatch(int capacity, float* values) : Capacity(capacity > 0 ? capacity : 1) {
+        Count = 0;
+        mValues = NULL;
+        for (int i = 0; i < Point::NumberOfCoordinates; ++i) {
+            Coordinates[i] = values + i * Capacity;
+        }
+    }
+
+    PointBatch::~PointBatch() {
+        delete[] mValues;
+    }
+#pragma endregion
+
+#pragma region // Methods.
+    void PointBatch::SetCoordinate(CoordinateNamesEnum coordinate, int first, float value) {
+        if (first < Capacity) {
+            fill(Coordinates[coordinate] + first, Coordinates[coordinate] + Capacity, value);
+        }
+    }
+
+    void PointBatch::ScaleCoordinate(CoordinateNamesEnum coordinate, int first, float factor) {
+        float* values = Coordinates[coordinate];
+        for (int index = first; index < Count; ++index) {
+            values[index] *= factor;
+        }
+    }
+
+    Point* PointBatch::GetPoint(int index) const {
+        return new Point(Coordinates[CoordinateNames::X][index], Coordinates[CoordinateNames::Y][index],
+            Coordinates[CoordinateNames::Z][index], Coordinates[CoordinateNames::OverLayID][index]);
+    }
+#pragma endregion
+}
@@ -9,6 +9,8 @@
 #include "Container.h"
 #include "Path.h"
 #include "PathNode.h"
+#include "Mutex.h"
+#include "ModelArena.h"
 
 namespace Plato {
 
@@ -46,6 +48,14 @@ namespace Plato {
         delete Identity;
     }
 
+    void* Property::operator new(size_t size) {
+        return ModelArena::New(size);
+    }
+
+    void Property::operator delete(void* memory) {
+        ModelArena::Delete(memory);
+    }
+
     Property* Property::GetProxy() {
         return this;
     }
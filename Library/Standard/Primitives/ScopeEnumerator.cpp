@@ -23,36 +23,39 @@ namespace Plato {
 
     void ScopeEnumerator::Reset() {
         Current = NULL;
-        mNextPosition = mSourceContainer->OrderedProperties->begin();
-        mEndPosition = mSourceContainer->OrderedProperties->end();
+        mNextPosition = mSourceContainer->GetOrderedProperties()->begin();
+        mEndPosition = mSourceContainer->GetOrderedProperties()->end();
    }
 
+    void ScopeEnumerator::Reset(Container& container) {
+        mSourceContainer = &container;
+        Reset();
+    }
+
     bool ScopeEnumerator::MoveNext() {
         while (mNextPosition!=mEndPosition) {
             Current = *mNextPosition++;
-            if (mRequester == NULL) {
-                return true;
-            }
-            if (Current != NULL) {
-                // Check scope of item.
-                if (Current==mRequester) {
-                    PropertyScopesEnum scope = Current->Scope;
-                    if (scope != PropertyScopes::External && scope != PropertyScopes::Unrelated) {
-                        return true;
-                    }
-                } else if (Current->Parent==mRequester->Parent) {
-                    PropertyScopesEnum scope = Current->Scope;
-                    if (scope != PropertyScopes::Unrelated && scope != PropertyScopes::Self) {
-                        return true;
-                    }
-                } else if (Current->InScope(mRequester, false)) {
-                    return true;
-                }
-            } else {
+            if (Current == NULL || IsInScope(*Current, mRequester)) {
                 return true;
             }
         }
         Current = NULL;
         return false;
     }
+
+    bool ScopeEnumerator::IsInScope(const Property& item, const Property* requester) {
+        if (requester == NULL) {
+            return true;
+        }
+        // Check scope of item.
+        if (&item==requester) {
+            PropertyScopesEnum scope = item.Scope;
+            return scope != PropertyScopes::External && scope != PropertyScopes::Unrelated;
+        }
+        if (item.Parent==requester->Parent) {
+            PropertyScopesEnum scope = item.Scope;
+            return scope != PropertyScopes::Unrelated && scope != PropertyScopes::Self;
+        }
+        return item.InScope(requester, false);
+    }
 }
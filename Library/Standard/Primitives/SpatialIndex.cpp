@@ -0,0 +1,266 @@
+#include "PlatoIncludes.h"
+#include "Strings.h"
+#include "ClassTypeInfo.h"
+#include "Identifier.h"
+#include "PropertyModes.h"
+#include "PropertyScopes.h"
+#include "ConfigurePhases.h"
+#include "Property.h"
+#include "Point.h"
+#include "SpatialIndex.h"
+
+namespace Plato {
+
+    size_t SpatialIndex::CellTraits::Hash(const Cell& cell) {
+        size_t h = (size_t)cell.X * 0x9e3779b1u ^ (size_t)cell.Y * 0x85ebca77u ^ (size_t)cell.Z * 0xc2b2ae3du;
+        return h ^ (h >> 15);
+    }
+
+#pragma region // Constructors.
+    SpatialIndex::SpatialIndex(float cellSize) {
+        mCellSize = cellSize > 0.0f ? cellSize : 1.0f;
+        mCount = 0;
+        mIsExtentStale = false;
+        for (int i = 0; i < Point::NumberOfSpatialCoordinates; ++i) {
+            mLower[i] = mUpper[i] = 0.0f;
+        }
+    }
+
+    SpatialIndex::~SpatialIndex() {
+        Clear();
+    }
+#pragma endregion
+
+#pragma region // Methods.
+    bool SpatialIndex::Insert(Property& prop) {
+        const Point* position = prop.Identity->Position;
+        if (position == NULL) {
+            return false;
+        }
+        const float* c = position->Coordinates;
+        vector<Property*>*& cell = mCells[GetCell(c)];
+        if (cell == NULL) {
+            cell = new vector<Property*>();
+        }
+        cell->push_back(&prop);
+        for (int i = 0; i < Point::NumberOfSpatialCoordinates; ++i) {
+            if (mCount == 0 || c[i] < mLower[i]) {
+                mLower[i] = c[i];
+            }
+            if (mCount == 0 || c[i] > mUpper[i]) {
+                mUpper[i] = c[i];
+            }
+        }
+        ++mCount;
+        return true;
+    }
+
+    bool SpatialIndex::Erase(const Property& prop) {
+        const Point* position = prop.Identity->Position;
+        HashTable::iterator itr = mCells.end();
+        vector<Property*>::iterator pitr;
+        if (position != NULL) {
+            itr = mCells.find(GetCell(position->Coordinates));
+            if (itr != mCells.end()) {
+                pitr = find(itr->second->begin(), itr->second->end(), &prop);
+                if (pitr == itr->second->end()) {
+                    itr = mCells.end();
+                }
+            }
+        }
+        if (itr == mCells.end()) {
+            // The position may have been changed since the property was filed.
+            for (itr = mCells.begin(); itr != mCells.end(); ++itr) {
+                pitr = find(itr->second->begin(), itr->second->end(), &prop);
+                if (pitr != itr->second->end()) {
+                    break;
+                }
+            }
+            if (itr == mCells.end()) {
+                return false;
+            }
+        }
+        vector<Property*>& cell = *itr->second;
+        *pitr = cell.back();
+        cell.pop_back();
+        if (cell.empty()) {
+            delete &cell;
+            Cell key = itr->first;
+            mCells.erase(key);
+        }
+        --mCount;
+        // The extent still bounds the remaining properties, so shrinking it can wait for GetExtent.
+        if (mCount == 0) {
+            mIsExtentStale = false;
+        } else if (position != NULL) {
+            const float* c = position->Coordinates;
+            for (int i = 0; i < Point::NumberOfSpatialCoordinates; ++i) {
+                if (c[i] <= mLower[i] || c[i] >= mUpper[i]) {
+                    mIsExtentStale = true;
+                    break;
+                }
+            }
+        } else {
+            mIsExtentStale = true;
+        }
+        return true;
+    }
+
+    void SpatialIndex::Clear() {
+        HashTable::iterator itr;
+        for (itr = mCells.begin(); itr != mCells.end(); ++itr) {
+            delete itr->second;
+        }
+        mCells.clear();
+        mCount = 0;
+        mIsExtentStale = false;
+    }
+
+    int SpatialIndex::FindInBox(const Point& lower, const Point& upper, vector<Property*>& results) const {
+        return Find(lower.Coordinates, upper.Coordinates, NULL, -1.0f, results);
+    }
+
+    int SpatialIndex::FindInSphere(const Point& centre, float radius, vector<Property*>& results) const {
+        if (radius < 0.0f) {
+            return 0;
+        }
+        float lower[3];
+        float upper[3];
+        for (int i = 0; i < Point::NumberOfSpatialCoordinates; ++i) {
+            lower[i] = centre.Coordinates[i] - radius;
+            upper[i] = centre.Coordinates[i] + radius;
+        }
+        return Find(lower, upper, centre.Coordinates, radius, results);
+    }
+
+    bool SpatialIndex::GetExtent(Point& lower, Point& upper) const {
+        if (mCount == 0) {
+            return false;
+        }
+        if (mIsExtentStale) {
+            UpdateExtent();
+        }
+        for (int i = 0; i < Point::NumberOfSpatialCoordinates; ++i) {
+            lower.Coordinates[i] = mLower[i];
+            upper.Coordinates[i] = mUpper[i];
+        }
+        lower.UpdateHashCode();
+        upper.UpdateHashCode();
+        return true;
+    }
+
+    int SpatialIndex::Find(const float* lower, const float* upper, const float* centre, float radius,
+            vector<Property*>& results) const {
+        if (mCount == 0) {
+            return 0;
+        }
+        // FlatHashMap has no const lookups.
+        HashTable& cells = const_cast<HashTable&>(mCells);
+        Cell first = GetCell(lower);
+        Cell last = GetCell(upper);
+        if (first.X > last.X || first.Y > last.Y || first.Z > last.Z) {
+            return 0;
+        }
+        double spanned = (double)(last.X - first.X + 1) * (double)(last.Y - first.Y + 1) * (double)(last.Z - first.Z + 1);
+        vector<vector<Property*>*> candidates;
+        HashTable::iterator itr;
+        if (spanned > (double)cells.size()) {
+            // A large region: visit the occupied cells instead of the cells spanned.
+            for (itr = cells.begin(); itr != cells.end(); ++itr) {
+                const Cell& cell = itr->first;
+                if (cell.X >= first.X && cell.X <= last.X && cell.Y >= first.Y && cell.Y <= last.Y
+                        && cell.Z >= first.Z && cell.Z <= last.Z) {
+                    candidates.push_back(itr->second);
+                }
+            }
+        } else {
+            Cell cell;
+            for (cell.X = first.X; cell.X <= last.X; ++cell.X) {
+                for (cell.Y = first.Y; cell.Y <= last.Y; ++cell.Y) {
+                    for (cell.Z = first.Z; cell.Z <= last.Z; ++cell.Z) {
+                        itr = cells.find(cell);
+                        if (itr != cells.end()) {
+                            candidates.push_back(itr->second);
+                        }
+                    }
+                }
+            }
+        }
+        float radiusSquared = radius * radius;
+        vector<vector<Property*>*>::iterator citr;
+        vector<Property*>::iterator pitr;
+        for (citr = candidates.begin(); citr != candidates.end(); ++citr) {
+            for (pitr = (*citr)->begin(); pitr != (*citr)->end(); ++pitr) {
+                const Point* position = (*pitr)->Identity->Position;
+                if (position == NULL) {
+                    continue;
+                }
+                const float* c = position->Coordinates;
+                bool isInside = true;
+                float distanceSquared = 0.0f;
+                for (int i = 0; i < Point::NumberOfSpatialCoordinates; ++i) {
+                    if (c[i] < lower[i] || c[i] > upper[i]) {
+                        isInside = false;
+                        break;
+                    }
+                    if (centre != NULL) {
+                        float d = c[i] - centre[i];
+                        distanceSquared += d * d;
+                    }
+                }
+                if (isInside && (centre == NULL || distanceSquared <= radiusSquared)) {
+                    results.push_back(*pitr);
+                }
+            }
+        }
+        return (int)candidates.size();
+    }
+
+    SpatialIndex::Cell SpatialIndex::GetCell(const float* coordinates) const {
+        Cell cell;
+        cell.X = ToCell(coordinates[0]);
+        cell.Y = ToCell(coordinates[1]);
+        cell.Z = ToCell(coordinates[2]);
+        return cell;
+    }
+
+    int SpatialIndex::ToCell(float coordinate) const {
+        double c = floor((double)coordinate / mCellSize);
+        const double limit = (double)(1 << 30);
+        if (c > limit) {
+            return 1 << 30;
+        }
+        if (c < -limit) {
+            return -(1 << 30);
+        }
+        return (int)c;
+    }
+
+    void SpatialIndex::UpdateExtent() const {
+        bool isFirst = true;
+        // FlatHashMap has no const iterators.
+        HashTable& cells = const_cast<HashTable&>(mCells);
+        HashTable::iterator itr;
+        vector<Property*>::iterator pitr;
+        for (itr = cells.begin(); itr != cells.end(); ++itr) {
+            for (pitr = itr->second->begin(); pitr != itr->second->end(); ++pitr) {
+                const Point* position = (*pitr)->Identity->Position;
+                if (position == NULL) {
+                    continue;
+                }
+                const float* c = position->Coordinates;
+                for (int i = 0; i < Point::NumberOfSpatialCoordinates; ++i) {
+                    if (isFirst || c[i] < mLower[i]) {
+                        mLower[i] = c[i];
+                    }
+                    if (isFirst || c[i] > mUpper[i]) {
+                        mUpper[i] = c[i];
+                    }
+                }
+                isFirst = false;
+            }
+        }
+        mIsExtentStale = false;
+    }
+#pragma endregion
+}
@@ -0,0 +1,103 @@
+#include "PlatoIncludes.h"
+#include "Strings.h"
+#include "Mutex.h"
+#include "Symbol.h"
+
+namespace Plato {
+
+    vector<Symbol*>* Symbol::mBuckets = NULL;
+    int Symbol::mCount = 0;
+    Mutex Symbol::mLock;
+
+    void Symbol::Initializer() {
+        MutexLock lock(mLock);
+        if (mBuckets == NULL) {
+            mBuckets = new vector<Symbol*>(1024, (Symbol*)NULL);
+        }
+    }
+
+    void Symbol::Finalizer() {
+        MutexLock lock(mLock);
+        if (mBuckets == NULL) {
+            return;
+        }
+        vector<Symbol*>::iterator itr;
+        for (itr = mBuckets->begin(); itr != mBuckets->end(); ++itr) {
+            Symbol* s = *itr;
+            while (s != NULL) {
+                Symbol* next = s->mNext;
+                delete s;
+                s = next;
+            }
+        }
+        delete mBuckets;
+        mBuckets = NULL;
+        mCount = 0;
+    }
+
+    Symbol::Symbol(const char* name, size_t length, uint32_t nameHash, int id)
+        : Name(name, length), HashCode(MixId(id)), Id(id) {
+        mNameHash = nameHash;
+        mNext = NULL;
+    }
+
+    size_t Symbol::MixId(int id) {
+        // The MurmurHash3 finalizer, a bijection on 32 bits.
+        uint32_t h = (uint32_t)id;
+        h ^= h >> 16;
+        h *= 0x85ebca6b;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35;
+        h ^= h >> 16;
+        return (size_t)h;
+    }
+
+    const Symbol& Symbol::Intern(const char* name, size_t length) {
+        uint32_t nameHash = Strings::SuperFastHash(name, (int)length);
+        MutexLock lock(mLock);
+        // Identifiers may be created before the library is initialized.
+        if (mBuckets == NULL) {
+            mBuckets = new vector<Symbol*>(1024, (Symbol*)NULL);
+        }
+        size_t mask = mBuckets->size() - 1;
+        Symbol* s;
+        for (s = (*mBuckets)[nameHash & mask]; s != NULL; s = s->mNext) {
+            if (s->mNameHash == nameHash && s->Name.size() == length
+                    && memcmp(s->Name.data(), name, length) == 0) {
+                return *s;
+            }
+        }
+        if (mCount >= (int)mBuckets->size()) {
+            Grow();
+            mask = mBuckets->size() - 1;
+        }
+        s = new Symbol(name, length, nameHash, mCount++);
+        Symbol*& head = (*mBuckets)[nameHash & mask];
+        s->mNext = head;
+        head = s;
+        return *s;
+    }
+
+    int Symbol::Count() {
+        MutexLock lock(mLock);
+        return mCount;
+    }
+
+    void Symbol::Grow() {
+        vector<Symbol*>* buckets = new vector<Symbol*>(mBuckets->size() * 2, (Symbol*)NULL);
+        size_t mask = buckets->size() - 1;
+        vector<Symbol*>::iterator itr;
+        for (itr = mBuckets->begin(); itr != mBuckets->end(); ++itr) {
+            Symbol* s = *itr;
+            while (s != NULL) {
+                Symbol* next = s->mNext;
+                Symbol*& head = (*buckets)[s->mNameHash & mask];
+                s->mNext = head;
+                head = s;
+                s = next;
+            }
+        }
+        delete mBuckets;
+        mBuckets = buckets;
+    }
+}
@@ -70,7 +70,7 @@ namespace Plato {
         if (position != NULL 
                 // && position->Status==PointStatus::Unbounded // DEBUG: Fix.
             ) {
-            Connector* currentConnector = Model::Current().CurrentConnector;
+            Connector* currentConnector = Model::GetCurrentConnector();
             int count = currentConnector==NULL ? 0 : currentConnector->GetAppendCount(container, regexIdentifier);
             count = count;
             // DEBUG: TO DO: Provide default generic implementation.
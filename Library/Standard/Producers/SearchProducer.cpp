@@ -72,7 +72,7 @@ namespace Plato {
         // 4) Add if doesn't, else move to next.
         const PointRegex* position = regexIdentifier.Position;
         if (position != NULL && position->Status==PointRegexStatus::Unbounded) {
-            Connector* currentConnector = Model::Current().CurrentConnector;
+            Connector* currentConnector = Model::GetCurrentConnector();
             int count = (currentConnector == NULL) ? 0 : currentConnector->GetAppendCount(container, regexIdentifier);
             count = count;
             // DEBUG: TO DO: Provide default generic implementation.
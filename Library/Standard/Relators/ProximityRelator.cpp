@@ -8,12 +8,340 @@
 #include "Identifier.h"
 #include "IdentifierRegex.h"
 #include "Property.h"
+#include "ThreadLocalVariable.h"
+#include "Mutex.h"
+#include "ThreadPool.h"
 #include "Container.h"
 #include "Relator.h"
 #include "ProximityRelator.h"
 
 namespace Plato {
 
+#pragma region // ProximityTupleSet class.
+    /// <summary>
+    /// A hash set of tuples of element-order indexes, used to drop duplicate symmetric tuples.
+    /// </summary>
+    class ProximityTupleSet {
+    private:
+        /// <summary>
+        /// A tuple held in one of the blocks.
+        /// </summary>
+        struct Key {
+            const int* Orders;
+            int Arity;
+        };
+        struct KeyTraits {
+            inline static size_t Hash(const Key& key) {
+                return (size_t)Strings::SuperFastHash((const char*)key.Orders, key.Arity * (int)sizeof(int)); }
+            inline static bool Equals(const Key& a, const Key& b) {
+                return memcmp(a.Orders, b.Orders, a.Arity * sizeof(int)) == 0; }
+        };
+        /// <summary>
+        /// The number of tuples stored per block.
+        /// </summary>
+        static const int BlockTuples = 1024;
+
+        FlatHashMap<Key, bool, KeyTraits> mTuples;
+        /// <summary>
+        /// The tuples' storage, which never moves.
+        /// </summary>
+        vector<int*> mBlocks;
+        int mBlockUsed;
+        int mArity;
+
+    public:
+        ProximityTupleSet(int arity) {
+            mArity = arity;
+            mBlockUsed = BlockTuples;
+        }
+        ~ProximityTupleSet() {
+            vector<int*>::iterator itr;
+            for (itr = mBlocks.begin(); itr != mBlocks.end(); ++itr) {
+                delete[] *itr;
+            }
+        }
+        /// <summary>
+        /// Adds a tuple.
+        /// </summary>
+        /// <returns>Returns false if the tuple was already in the set.</returns>
+        bool Insert(const int* orders) {
+            if (mBlockUsed == BlockTuples) {
+                mBlocks.push_back(new int[BlockTuples * mArity]);
+                mBlockUsed = 0;
+            }
+            // Copy the tuple in first, and take it back out if it was already there.
+            int* copy = mBlocks.back() + mBlockUsed * mArity;
+            memcpy(copy, orders, mArity * sizeof(int));
+            Key key;
+            key.Orders = copy;
+            key.Arity = mArity;
+            size_t count = mTuples.size();
+            mTuples[key] = true;
+            if (mTuples.size() == count) {
+                return false;
+            }
+            ++mBlockUsed;
+            return true;
+        }
+    };
+#pragma endregion
+
+#pragma region // ProximityJoin class.
+    /// <summary>
+    /// The candidate index built by ProximityRelator::EnumerateMatches, and the join over it.
+    /// </summary>
+    class ProximityJoin {
+    public:
+        /// <summary>
+        /// The state of one enumeration over a range of the first pattern's candidates.
+        /// </summary>
+        class Cursor {
+        public:
+            /// <summary>
+            /// The range of the first pattern's candidates to start tuples from.
+            /// </summary>
+            size_t FirstBegin;
+            size_t FirstEnd;
+            /// <summary>
+            /// The element-order indexes of the tuple being built.
+            /// </summary>
+            vector<int> Tuple;
+            /// <summary>
+            /// The tuple reported, sorted if the relator is symmetric.
+            /// </summary>
+            vector<int> Reported;
+            /// <summary>
+            /// Bitset of the elements in Tuple.
+            /// </summary>
+            vector<uint32_t> Used;
+            vector<Property*> Elements;
+            ProximityRelator::TupleReceiver* Receiver;
+            /// <summary>
+            /// The symmetric tuples already reported, or NULL if not symmetric.
+            /// </summary>
+            ProximityTupleSet* Seen;
+
+            Cursor(const ProximityJoin& join, size_t firstBegin, size_t firstEnd, ProximityRelator::TupleReceiver& receiver)
+                    : Tuple(join.Arity), Reported(join.Arity), Used((join.Elements.size() + 31) / 32, 0), Elements(join.Arity) {
+                FirstBegin = firstBegin;
+                FirstEnd = firstEnd;
+                Receiver = &receiver;
+                Seen = join.IsSymmetric ? new ProximityTupleSet(join.Arity) : NULL;
+            }
+            ~Cursor() {
+                delete Seen;
+            }
+        };
+
+        ProximityRelator* Relator;
+        int Arity;
+        bool IsSymmetric;
+        /// <summary>
+        /// The container's elements, indexed by element order.
+        /// </summary>
+        vector<Property*> Elements;
+        /// <summary>
+        /// The ascending element orders matching each pattern.
+        /// </summary>
+        /// <remarks>
+        /// When the relator is symmetric, the patterns are reordered so that those with the same
+        /// candidates are adjacent, which does not change the tuples reported.
+        /// </remarks>
+        vector<vector<int> > Candidates;
+        /// <summary>
+        /// For each pattern, whether its EOI must exceed the previous pattern's,
+        /// which is so when the relator is symmetric and both patterns have the same candidates.
+        /// </summary>
+        vector<bool> IsAscending;
+
+        ProximityJoin(ProximityRelator& relator, Container& container);
+
+        /// <summary>
+        /// Extends the cursor's tuple at a depth with each unused candidate.
+        /// </summary>
+        /// <returns>Returns false if the receiver stopped the enumeration.</returns>
+        bool Descend(int depth, Cursor& cursor) const;
+
+        /// <summary>
+        /// Checks and reports a complete tuple.
+        /// </summary>
+        /// <returns>Returns false if the receiver stopped the enumeration.</returns>
+        bool Report(Cursor& cursor) const;
+    };
+
+    ProximityJoin::ProximityJoin(ProximityRelator& relator, Container& container)
+            : Candidates(relator.GetArity()), IsAscending(relator.GetArity(), false) {
+        Relator = &relator;
+        Arity = relator.GetArity();
+        IsSymmetric = relator.IsSymmetric;
+        vector<Property*>* properties = container.GetOrderedProperties();
+        Elements.assign(properties->begin(), properties->end());
+        int count = (int)Elements.size();
+        size_t words = (count + 31) / 32;
+        // Match each distinct pattern once, recording the matches as a bitset.
+        vector<vector<uint32_t> > bitsets(Arity);
+        vector<string*> texts(Arity);
+        for (int patternIndex = 0; patternIndex < Arity; ++patternIndex) {
+            IdentifierRegex* pattern = (*relator.Patterns)[patternIndex];
+            texts[patternIndex] = &pattern->StatusReport();
+            int same = -1;
+            for (int k = 0; k < patternIndex; ++k) {
+                if (texts[k]->compare(*texts[patternIndex]) == 0) {
+                    same = k;
+                    break;
+                }
+            }
+            vector<uint32_t>& bits = bitsets[patternIndex];
+            if (same >= 0) {
+                bits = bitsets[same];
+            } else {
+                bits.assign(words, 0);
+                for (int elementOrder = 0; elementOrder < count; ++elementOrder) {
+                    Property* element = Elements[elementOrder];
+                    if (element != NULL && pattern->Match(*element->Identity)) {
+                        bits[elementOrder >> 5] |= (uint32_t)1 << (elementOrder & 31);
+                    }
+                }
+            }
+        }
+        for (int k = 0; k < Arity; ++k) {
+            delete texts[k];
+        }
+        // Group the patterns with the same candidates together.
+        vector<int> order;
+        for (int patternIndex = 0; patternIndex < Arity; ++patternIndex) {
+            if (!IsSymmetric) {
+                order.push_back(patternIndex);
+                continue;
+            }
+            bool isPlaced = false;
+            for (size_t k = 0; k < order.size() && !isPlaced; ++k) {
+                isPlaced = order[k] == patternIndex;
+            }
+            for (int k = patternIndex; k < Arity && !isPlaced; ++k) {
+                if (bitsets[k] == bitsets[patternIndex]) {
+                    order.push_back(k);
+                }
+            }
+        }
+        for (int position = 0; position < Arity; ++position) {
+            const vector<uint32_t>& bits = bitsets[order[position]];
+            vector<int>& candidates = Candidates[position];
+            for (int elementOrder = 0; elementOrder < count; ++elementOrder) {
+                if ((bits[elementOrder >> 5] >> (elementOrder & 31)) & 1) {
+                    candidates.push_back(elementOrder);
+                }
+            }
+            IsAscending[position] = IsSymmetric && position > 0 && bits == bitsets[order[position - 1]];
+        }
+    }
+
+    bool ProximityJoin::Descend(int depth, Cursor& cursor) const {
+        const vector<int>& candidates = Candidates[depth];
+        vector<int>::const_iterator itr = candidates.begin();
+        vector<int>::const_iterator end = candidates.end();
+        if (depth == 0) {
+            end = itr + cursor.FirstEnd;
+            itr += cursor.FirstBegin;
+        } else if (IsAscending[depth]) {
+            itr = upper_bound(itr, end, cursor.Tuple[depth - 1]);
+        }
+        bool isLast = depth + 1 == Arity;
+        for (; itr != end; ++itr) {
+            int elementOrder = *itr;
+            uint32_t& word = cursor.Used[elementOrder >> 5];
+            uint32_t bit = (uint32_t)1 << (elementOrder & 31);
+            if ((word & bit) != 0) {
+                continue;
+            }
+            cursor.Tuple[depth] = elementOrder;
+            if (isLast) {
+                if (!Report(cursor)) {
+                    return false;
+                }
+            } else {
+                word |= bit;
+                bool isMore = Descend(depth + 1, cursor);
+                word &= ~bit;
+                if (!isMore) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool ProximityJoin::Report(Cursor& cursor) const {
+        vector<int>& reported = cursor.Reported;
+        reported = cursor.Tuple;
+        if (IsSymmetric) {
+            sort(reported.begin(), reported.end());
+            if (!cursor.Seen->Insert(&reported[0])) {
+                return true;
+            }
+        }
+        vector<Property*>& elements = cursor.Elements;
+        for (int j = 0; j < Arity; ++j) {
+            elements[j] = Elements[reported[j]];
+        }
+        if (!Relator->ValidRelation(elements)) {
+            return true;
+        }
+        return cursor.Receiver->Receive(elements);
+    }
+#pragma endregion
+
+#pragma region // Tuple collection.
+    /// <summary>
+    /// Collects tuples, with their element-order indexes, for FindMatches.
+    /// </summary>
+    class ProximityTupleCollector : public ProximityRelator::TupleReceiver {
+    public:
+        vector<vector<Property*>*> Tuples;
+        /// <summary>
+        /// The reported element-order indexes of each tuple, concatenated.
+        /// </summary>
+        vector<int> Orders;
+        /// <summary>
+        /// The cursor whose tuples are collected.
+        /// </summary>
+        ProximityJoin::Cursor* Source;
+
+        ProximityTupleCollector() {
+            Source = NULL;
+        }
+        virtual bool Receive(vector<Property*>& elements) {
+            Tuples.push_back(new vector<Property*>(elements));
+            Orders.insert(Orders.end(), Source->Reported.begin(), Source->Reported.end());
+            return true;
+        }
+    };
+
+    /// <summary>
+    /// Collects the tuples starting from a range of the first pattern's candidates.
+    /// </summary>
+    class ProximityJoinTask : public ThreadPool::Task {
+    public:
+        const ProximityJoin* Join;
+        size_t FirstBegin;
+        size_t FirstEnd;
+        ProximityTupleCollector* Collector;
+
+        ProximityJoinTask(const ProximityJoin& join, size_t firstBegin, size_t firstEnd, ProximityTupleCollector& collector) {
+            Join = &join;
+            FirstBegin = firstBegin;
+            FirstEnd = firstEnd;
+            Collector = &collector;
+        }
+        virtual void Execute() {
+            ProximityJoin::Cursor cursor(*Join, FirstBegin, FirstEnd, *Collector);
+            Collector->Source = &cursor;
+            Join->Descend(0, cursor);
+            Collector->Source = NULL;
+        }
+    };
+#pragma endregion
+
     ProximityRelator::ProximityRelator(vector<IdentifierRegex*>* patterns) {
         IsSymmetric = false;
         Parent = NULL;
@@ -92,128 +420,60 @@ namespace Plato {
         return ~first;
     }
 
-    vector<vector<Property*>*>* ProximityRelator::FindMatches(Container& container) {
+    void ProximityRelator::EnumerateMatches(Container& container, TupleReceiver& receiver) {
+        Parent = &container;
+        if (GetArity() == 0) {
+            return;
+        }
+        ProximityJoin join(*this, container);
+        ProximityJoin::Cursor cursor(join, 0, join.Candidates[0].size(), receiver);
+        join.Descend(0, cursor);
+    }
+
+    vector<vector<Property*>*>* ProximityRelator::FindMatches(Container& container, ThreadPool* pool) {
         if (Patterns == NULL) {
             return NULL;
         }
-        vector<vector<int>*>& tuples = *new vector<vector<int>*>();
         Parent = &container;
-        int elementOrder;
+        vector<vector<Property*>*>& elementTuples = *new vector<vector<Property*>*>();
         int arity = GetArity();
-        vector<vector<int>*>& patternMatches = *new vector<vector<int>*>(arity);
-        for (int patternIndex = 0; patternIndex < arity; ++patternIndex) {
-            patternMatches[patternIndex] = new vector<int>();
-        }
-        vector<Property*>& orderToElement = *new vector<Property*>(container.Count());
-        vector<Property*>::iterator itr;
-        vector<Property*>* properties = container.OrderedProperties; 
-        elementOrder = 0;
-        for(itr=properties->begin();itr!=properties->end();++itr) {
-            Property* element = *itr;
-            if (element != NULL) {
-                Identifier* ident = element->Identity;
-                for (int patternIndex = 0; patternIndex < arity; ++patternIndex) {
-                    if ((*Patterns)[patternIndex]->Match(*ident)) {
-                        patternMatches[patternIndex]->push_back(elementOrder);
-                    }
-                }
+        if (arity == 0) {
+            return &elementTuples;
+        }
+        ProximityJoin join(*this, container);
+        size_t firstCount = join.Candidates[0].size();
+        int chunks = pool == NULL ? 1 : 4 * pool->GetNumberOfThreads();
+        if ((size_t)chunks > firstCount) {
+            chunks = firstCount == 0 ? 1 : (int)firstCount;
+        }
+        vector<ProximityTupleCollector> collectors(chunks);
+        if (chunks == 1) {
+            ProximityJoin::Cursor cursor(join, 0, firstCount, collectors[0]);
+            collectors[0].Source = &cursor;
+            join.Descend(0, cursor);
+        } else {
+            ThreadPool::TaskGroup group;
+            for (int chunk = 0; chunk < chunks; ++chunk) {
+                pool->Submit(*new ProximityJoinTask(join, firstCount * chunk / chunks, 
+                    firstCount * (chunk + 1) / chunks, collectors[chunk]), group);
             }
-            orderToElement[elementOrder++] = element;
-        }
-
-        // Generate tuples from pattern matches.
-        // If IsSymmetric, order of elements in tuple is not significant.
-        // Element can only appear once in tuple.
-        vector<int>& tuple = *new vector<int>(arity);
-        vector<int>& trace = *new vector<int>(arity);
-        for (int k = 0; k < arity; k++) {
-            tuple[k] = 0;
-            trace[k] = 0;
-        }
-        bool isSymmetric = IsSymmetric;
-        int upperIndex = arity - 1;
-        int traceIndex = 0;
-        int tupleIndex;
-        vector<int>& elements = *(patternMatches[traceIndex]);
-        for(;;) {
-            int elementIndex = trace[traceIndex];
-            if (elementIndex >= (int)elements.size()) {
-                if (traceIndex == 0) {
-                    // Finished finding tuples.
-                    break;
-                } else {
-                    // Backtrack to parent.
-                    --traceIndex;
-                    ++(trace[traceIndex]);
-                    elements = *(patternMatches[traceIndex]);
-                }
-            } else {
-                elementOrder = elements[elementIndex];
-                // Quicky check not already in tuple.
-                bool notUnique = false;
-                for (int j = 0; j < traceIndex; ++j) {
-                    if (tuple[j] == elementOrder) {
-                        notUnique = true;
-                        break;
-                    }
-                }
-                if (notUnique) {
-                    // Skip to next element;
-                    ++(trace[traceIndex]);
+            pool->Wait(group);
+        }
+        // Concatenate the chunks in order, dropping symmetric tuples found from more than one chunk.
+        ProximityTupleSet* seen = (IsSymmetric && chunks > 1) ? new ProximityTupleSet(arity) : NULL;
+        for (int chunk = 0; chunk < chunks; ++chunk) {
+            ProximityTupleCollector& collector = collectors[chunk];
+            size_t count = collector.Tuples.size();
+            for (size_t i = 0; i < count; ++i) {
+                vector<Property*>* tuple = collector.Tuples[i];
+                if (seen == NULL || seen->Insert(&collector.Orders[i * arity])) {
+                    elementTuples.push_back(tuple);
                 } else {
-                    tuple[traceIndex] = elementOrder;
-                    if (traceIndex == upperIndex) {
-                        // Add a new tuple.
-                        vector<int>& tmp = *new vector<int>(tuple);
-                        if (isSymmetric) {
-                            sort(tmp.begin(),tmp.end());
-                        }
-                        tupleIndex = BinarySearch(tmp,tuples);
-                        if (tupleIndex<0) {
-                            tuples.insert(tuples.begin()+ ~tupleIndex,&tmp);
-                        } else {
-                            delete &tmp;
-                        }
-                        // Move to next element;
-                        ++(trace[traceIndex]);
-                    } else {
-                        // Move to next dimension.
-                        ++traceIndex;
-                        elements = *(patternMatches[traceIndex]);
-                        trace[traceIndex] = 0;
-                    }
+                    delete tuple;
                 }
             }
         }
-        delete &tuple;
-        delete &trace;
-
-        // Use orderToElement to produce a List of Property[]'s.
-        // Call Valid to check each tuple satisfies relator.
-        vector<vector<Property*>*>& elementTuples = *new vector<vector<Property*>*>(tuples.size());
-        vector<vector<int>*>::iterator tup;
-        for(tup=tuples.begin();tup!=tuples.end();++tup) {
-            tuple = *(*tup);
-            vector<Property*>& tmp = *new vector<Property*>(arity);
-            for (int j = 0; j < arity; ++j) {
-                tmp[j] = orderToElement[tuple[j]];
-            }
-            if (ValidRelation(tmp)) {
-                elementTuples.push_back(&tmp);
-            } else {
-                delete &tmp;
-            }
-            delete &tuple;
-        }
-        // Tidy up.
-        delete &orderToElement;
-        delete &tuples;
-        vector<vector<int>*>::iterator pat;
-        for(pat=patternMatches.begin();pat!=patternMatches.end();++pat) {
-            delete *pat;
-        }
-        delete &patternMatches;
-
+        delete seen;
         return &elementTuples;
     }
 
@@ -21,6 +21,7 @@ namespace Plato {
 
     void Restrictor::Finalizer() {
         delete TypeInfo;
+        TypeInfo = NULL;
     }
 
     Restrictor::Restrictor(Container* creator, Container* parent, Identifier& elementName, PropertyScopesEnum scope,
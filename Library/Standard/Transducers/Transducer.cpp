@@ -12,6 +12,8 @@
 #include "Transducer.h"
 #include "Relator.h"
 #include "ConnectorRelator.h"
+#include "Mutex.h"
+#include "SignalArena.h"
 #include "Pad.h"
 #include "InputPad.h"
 #include "OutputPad.h"
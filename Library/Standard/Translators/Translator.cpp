@@ -22,6 +22,7 @@ namespace Plato {
 
     void Translator::Finalizer() {
         delete TypeInfo;
+        TypeInfo = NULL;
     }
 
     Translator::Translator(Container* creator, Container* parent, Identifier& elementName, PropertyScopesEnum scope) 
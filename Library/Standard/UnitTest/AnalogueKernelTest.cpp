@@ -0,0 +1,173 @@
+#include "PlatoIncludes.h"
+#include "PlatoStandard.h"
+#include "AnalogueDIDs.h"
+
+#include "AnalogueKernelTest.h"
+
+namespace Plato {
+
+    /// <summary>
+    /// A model of AndDIDs and OrDIDs of several arities reading a set of source pads.
+    /// </summary>
+    /// <remarks>
+    /// Each operation and arity has a different number of DIDs, none a whole number of vectors,
+    /// and one batch spans more than one AnalogueKernel::ChunkSize.
+    /// </remarks>
+    class AnalogueKernelTestModel : public Model {
+    public:
+        static const int NumberOfSources = 11;
+        vector<OutputPad*> Sources;
+        vector<AnalogueDID*> DIDs;
+        vector<OutputPad*> Outputs;
+        AnalogueKernelTestModel(char* arguments[]);
+        /// <summary>
+        /// Sets the sources, and clears the outputs, in both buffers.
+        /// </summary>
+        void Reset();
+    };
+
+    AnalogueKernelTestModel::AnalogueKernelTestModel(char* arguments[])
+        : Model("AnalogueKernelTest", arguments) {
+        const int arities[] = { 1, 2, 3, 5, 8 };
+        const int counts[] = { 1, 3, 5, 7, 9, 13 };
+        for (int index = 0; index < NumberOfSources; ++index) {
+            OutputPad* source = new OutputPad(this, *this, Identifier::Generate("S"), PropertyScopes::Public);
+            Add(*source);
+            Sources.push_back(source);
+        }
+        int group = 0;
+        for (int operation = 0; operation < 2; ++operation) {
+            for (int a = 0; a < 5; ++a, ++group) {
+                int count = a == 1 && operation == 0 ? AnalogueKernel::ChunkSize + 3 : counts[group % 6];
+                for (int lane = 0; lane < count; ++lane) {
+                    AnalogueDID* did = operation == 0 ? (AnalogueDID*)new AndDID(this, this) : (AnalogueDID*)new OrDID(this, this);
+                    Add(*(Container*)did);
+                    // Split the inputs of the wider DIDs over two pads.
+                    int arity = arities[a];
+                    InputPad* input = NULL;
+                    for (int k = 0; k < arity; ++k) {
+                        if (k == 0 || k == 4) {
+                            input = new InputPad(did, *did, Identifier::Generate("I"), PropertyScopes::Public);
+                            did->Add(*input);
+                        }
+                        input->Add(*Sources[(lane * 7 + k * 3 + group) % NumberOfSources], *(Connector*)this);
+                    }
+                    OutputPad* output = new OutputPad(did, *did, Identifier::Generate("O"), PropertyScopes::Public);
+                    did->Add(*output);
+                    DIDs.push_back(did);
+                    Outputs.push_back(output);
+                }
+            }
+        }
+    }
+
+    void AnalogueKernelTestModel::Reset() {
+        for (int index = 0; index < NumberOfSources; ++index) {
+            // Values up to 0.95, so that the OrDIDs saturate and the AndDIDs do not vanish.
+            float value = 0.05f + 0.09f * index;
+            ModelSignals->Current[Sources[index]->SignalIndex] = value;
+            ModelSignals->Next[Sources[index]->SignalIndex] = value;
+        }
+        vector<OutputPad*>::iterator itr;
+        for (itr = Outputs.begin(); itr != Outputs.end(); ++itr) {
+            ModelSignals->Current[(*itr)->SignalIndex] = -1.0f;
+            ModelSignals->Next[(*itr)->SignalIndex] = -1.0f;
+        }
+    }
+
+    int AnalogueKernelTest::ConductUnitTest(string& message) {
+        message = "";
+        int failureCount = 0;
+        bool passed = false;
+
+#pragma region // Test of AnalogueKernel against AnalogueDID::Update.
+        message += "AnalogueKernel: ";
+        for(;;) {
+            try {
+                char* arguments[] = { (char*)"AnalogueKernelTest", (char*)"--VectoriseDIDs=false", NULL };
+                AnalogueKernelTestModel* model = new AnalogueKernelTestModel(arguments);
+                int configured = model->Configure();
+                bool isScalar = model->DIDs[0]->DoEmulate;
+                model->Reset();
+                model->Run(1);
+                size_t count = model->Outputs.size();
+                vector<float> expected(count);
+                for (size_t index = 0; index < count; ++index) {
+                    expected[index] = model->ModelSignals->Next[model->Outputs[index]->SignalIndex];
+                }
+
+                AnalogueKernel* kernel = AnalogueKernel::Compile(*model);
+                bool isCompiled = kernel != NULL && !model->DIDs[0]->DoEmulate && !model->DIDs[count - 1]->DoEmulate;
+                model->Reset();
+                model->Run(1);
+                int mismatches = 0;
+                for (size_t index = 0; index < count; ++index) {
+                    float value = model->ModelSignals->Next[model->Outputs[index]->SignalIndex];
+                    if (fabs(value - expected[index]) > 1e-6f || expected[index] < 0.0f) {
+                        ++mismatches;
+                    }
+                }
+                // Deleting the kernel hands the DIDs back to Model::Update.
+                delete model->Container::Remove(*kernel->Identity);
+                bool isReleased = model->DIDs[0]->DoEmulate;
+                delete model;
+
+                if (configured != 0 || !isScalar || !isCompiled) {
+                    message += "Compiling the DIDs: Failed.";
+                    break;
+                }
+                if (mismatches != 0) {
+                    message += "Kernel output matches scalar output: Failed.";
+                    break;
+                }
+                if (!isReleased) {
+                    message += "Deleting the kernel: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of Configuration::VectoriseDIDs.
+        message += "VectoriseDIDs: ";
+        passed = false;
+        for(;;) {
+            try {
+                char* arguments[] = { (char*)"AnalogueKernelTest", NULL };
+                AnalogueKernelTestModel* model = new AnalogueKernelTestModel(arguments);
+                int configured = model->Configure();
+                // Configure compiles the kernel by default, so every DID with inputs is taken over.
+                bool isCompiled = true;
+                vector<AnalogueDID*>::iterator itr;
+                for (itr = model->DIDs.begin(); itr != model->DIDs.end(); ++itr) {
+                    isCompiled &= !(*itr)->DoEmulate;
+                }
+                model->Reset();
+                model->Run(2);
+                bool isWritten = model->ModelSignals->Next[model->Outputs[0]->SignalIndex] >= 0.0f;
+                delete model;
+
+                if (configured != 0 || !isCompiled || !isWritten) {
+                    message += "Compiled by Configure: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+        return failureCount;
+    }
+}
@@ -1,64 +1,130 @@
 #include "PlatoIncludes.h"
 #include "Numbers.h"
+#include "Strings.h"
+#include "ClassTypeInfo.h"
+#include "Identifier.h"
+#include "PropertyModes.h"
+#include "PropertyScopes.h"
+#include "ConfigurePhases.h"
+#include "Property.h"
+#include "Container.h"
+#include "ResolutionModes.h"
+#include "Path.h"
+#include "PathNode.h"
+#include "PointSpace.h"
+#include "PointRegex.h"
+#include "PathOperators.h"
+#include "Connector.h"
+#include "Mutex.h"
+#include "SignalArena.h"
+#include "Pad.h"
+#include "InputPad.h"
+#include "OutputPad.h"
+#include "ModelSnapshot.h"
 #include "Archiver.h"
+#include "Checkpointer.h"
 #include "ArchiverTest.h"
 
 namespace Plato {
 
-    ArchiverTest::ArchieTestClass::ArchieTestClass(int a, string& b) : mB(b) {
-        mA = a;
-    }
+    class ArchiverTestContainer : public Container {
+    public:
+        ArchiverTestContainer(Identifier& identifier);
+    };
 
-    ArchiverTest::ArchieTestClass::~ArchieTestClass() {
-        delete &mB;
+    ArchiverTestContainer::ArchiverTestContainer(Identifier& identifier)
+        : Container(*Container::PropertyTypes,NULL,NULL,identifier,PropertyScopes::Public) {
     }
 
-    string& ArchiverTest::ArchieTestClass::StatusReport() {
-        string& num = Numbers::ToString(mA);
-        string& result = *new string("(" + num + "," + mB + ")");
-        delete &num;
-        return result;
+    Container* ArchiverTest::BuildHierarchy(OutputPad* outputs[2], InputPad*& input, Connector*& connector) {
+        Container* root = new ArchiverTestContainer(*new Identifier("ArchiverTest"));
+        Container* from = new ArchiverTestContainer(*new Identifier("from"));
+        Container* to = new ArchiverTestContainer(*new Identifier("to"));
+        root->Add(*from);
+        root->Add(*to);
+        outputs[0] = new OutputPad(*from, "o0");
+        outputs[1] = new OutputPad(*from, "o1");
+        from->Add(*outputs[0]);
+        from->Add(*outputs[1]);
+        input = new InputPad(to, *to, *new Identifier("i"), PropertyScopes::Public);
+        to->Add(*input);
+        connector = new Connector(*new Path(NULL, *Path::Relative / "to" / "i"),
+            *new Path(NULL, *Path::Relative / "from" / "o0"), ConnectorPatterns::FanIn);
+        root->Add(*connector);
+        return root;
     }
 
     int ArchiverTest::ConductUnitTest(string& message) {
 
         message = "";
         int failureCount = 0;
-#if 0 // DEBUG: Remove when archiver working.
         bool passed = false;
 
 #pragma region // Test of Archiver Serialise and Deserialise.
         message += "Serialise and Deserialise: ";
         try {
-            ArchieTestClass* s = NULL;
-            ArchieTestClass* d = NULL;
+            const string path = "ArchiverTest.snapshot";
+            OutputPad* outputs[2];
+            InputPad* input;
+            Connector* connector;
+            Container* saved = BuildHierarchy(outputs, input, connector);
+            Container* restored = NULL;
+            ModelSnapshot* s = NULL;
+            ModelSnapshot* d = NULL;
+            ModelSnapshot* r = NULL;
             for(;;) {
-                string& abc = *new string("ABC");
-                s = new ArchieTestClass(123,abc);
-                string path = "/tmp/archietest.xml";
+                SignalArena& signals = *outputs[0]->Signals;
+                signals.Current[outputs[0]->SignalIndex] = 0.25f;
+                signals.Current[outputs[1]->SignalIndex] = 0.75f;
+                signals.Next[outputs[1]->SignalIndex] = 0.5f;
+                input->Add(*outputs[1], *connector);
+                input->Add(*outputs[0], *connector);
 
-                void* pVoid = (void*)s;
-                int result = Archiver::Serialize(path,false,pVoid);
+                s = ModelSnapshot::Capture(*saved, signals, NULL, 7);
+                int result = Archiver::Serialize(path,true,(void*)s);
                 if(result!=0) {
-                    message += "Serializing test object: Failed.";
+                    message += "Serializing test snapshot: Failed.";
+                    break;
+                }
+                if (Archiver::Serialize(path,false,(void*)s)==0) {
+                    message += "Serializing unsupported text format: Failed.";
+                    break;
+                }
+                d = (ModelSnapshot*)Archiver::Deserialize(path);
+                if (d == NULL || !d->IsMapped()) {
+                    message += "Deserializing and mapping test snapshot: Failed.";
+                    break;
+                }
+                r = ModelSnapshot::Read(path);
+                if (r == NULL || r->IsMapped() || r->Size() != d->Size() || memcmp(&r->GetHeader(), &d->GetHeader(), d->Size()) != 0) {
+                    message += "Reading test snapshot as mapped: Failed.";
                     break;
                 }
-                pVoid = Archiver::Deserialize(path);
-                if (pVoid==NULL) {
-                    message += "Deserializing test object: Failed.";
+                const ModelSnapshot::Header& header = d->GetHeader();
+                if (d->Size() != s->Size() || memcmp(&header, &s->GetHeader(), s->Size()) != 0
+                        || header.PropertyCount != 7 || header.PadCount != 1 || header.EdgeCount != 2
+                        || header.SignalCount != 2 || header.EpochTime != 7 || string(d->GetName(d->GetProperty(0))) != "ArchiverTest") {
+                    message += "Content of deserialised test snapshot differs: Failed.";
                     break;
                 }
-                d = (ArchieTestClass*)(pVoid);
-                if (d == NULL) {
-                    message += "Converting type of deserialised test object: Failed.";
+                if (ModelSnapshot::IsValid((const char*)&header, d->Size() - 8)) {
+                    message += "Truncated snapshot accepted: Failed.";
                     break;
                 }
-                if (d->mA != s->mA || d->mB.compare(s->mB)!=0) {
-                    string& ds = d->StatusReport();
-                    string& ss = s->StatusReport();
-                    message += "Content of deserialised test object differs: " + ds + "!=" + ss + ".";
-                    delete &ds;
-                    delete &ss;
+
+                // Restore onto a second copy of the hierarchy, whose pads are not connected.
+                restored = BuildHierarchy(outputs, input, connector);
+                signals.Current[outputs[0]->SignalIndex] = 0.0f;
+                signals.Current[outputs[1]->SignalIndex] = 0.0f;
+                signals.Next[outputs[1]->SignalIndex] = 0.0f;
+                int missing = d->Restore(*restored, signals);
+                float values[2];
+                if (missing != 0 || input->GatherInputs(values) != 2 || values[0] != 0.75f || values[1] != 0.25f
+                        || signals.Next[outputs[1]->SignalIndex] != 0.5f
+                        || (*input->InputConnections)[0]->OriginatingConnector != connector) {
+                    string& tmp = Numbers::ToString(missing);
+                    message += "Restoring test snapshot, " + tmp + " missing: Failed.";
+                    delete &tmp;
                     break;
                 }
                 passed = true;
@@ -66,12 +132,74 @@ namespace Plato {
             }
             delete s;
             delete d;
+            delete r;
+            delete saved;
+            delete restored;
+            remove(path.c_str());
         } catch (...) {
             message += "Archiver exception: Failed.";
         }
 
         failureCount += passed ? 0 : 1;
-#endif
+#pragma endregion
+
+#pragma region // Test of Checkpointer base and delta replay.
+        message += "Checkpoint and Replay: ";
+        passed = false;
+        try {
+            const string path = "ArchiverTest.checkpoint";
+            OutputPad* outputs[2];
+            InputPad* input;
+            Connector* connector;
+            Container* saved = BuildHierarchy(outputs, input, connector);
+            Container* restored = NULL;
+            Checkpointer* checkpoints = new Checkpointer(path, 4);
+            ModelSnapshot* base = NULL;
+            for(;;) {
+                SignalArena& signals = *outputs[0]->Signals;
+                signals.Current[outputs[0]->SignalIndex] = 0.25f;
+                signals.Current[outputs[1]->SignalIndex] = 0.75f;
+                // A base, then two deltas and a checkpoint with nothing changed, which writes nothing.
+                int result = checkpoints->Checkpoint(*saved, signals, NULL, 1);
+                result += checkpoints->Flush();
+                signals.Current[outputs[1]->SignalIndex] = 0.5f;
+                result += checkpoints->Checkpoint(*saved, signals, NULL, 2);
+                result += checkpoints->Flush();
+                signals.Next[outputs[0]->SignalIndex] = 1.0f;
+                result += checkpoints->Checkpoint(*saved, signals, NULL, 3);
+                result += checkpoints->Flush();
+                result += checkpoints->Checkpoint(*saved, signals, NULL, 4);
+                result += checkpoints->Flush();
+                if (result != 0) {
+                    message += "Writing checkpoints: Failed.";
+                    break;
+                }
+
+                restored = BuildHierarchy(outputs, input, connector);
+                base = ModelSnapshot::Read(path);
+                long epochTime = 0;
+                if (base == NULL || base->GetHeader().EpochTime != 1 || base->Restore(*restored, signals) != 0
+                        || Checkpointer::Replay(*base, path, *restored, signals, epochTime) != 2 || epochTime != 3
+                        || signals.Current[outputs[0]->SignalIndex] != 0.25f || signals.Current[outputs[1]->SignalIndex] != 0.5f
+                        || signals.Next[outputs[0]->SignalIndex] != 1.0f) {
+                    message += "Replaying checkpoints: Failed.";
+                    break;
+                }
+                passed = true;
+                break;
+            }
+            delete checkpoints;
+            delete base;
+            delete saved;
+            delete restored;
+            remove(path.c_str());
+            remove((path + ".1").c_str());
+            remove((path + ".2").c_str());
+        } catch (...) {
+            message += "Checkpointer exception: Failed.";
+        }
+
+        failureCount += passed ? 0 : 1;
 #pragma endregion
 
         return failureCount;
@@ -0,0 +1,133 @@
+#include "PlatoIncludes.h"
+#include "PlatoStandard.h"
+#include "AnalogueDIDs.h"
+
+#include "ChangeTrackerTest.h"
+
+namespace Plato {
+
+    /// <summary>
+    /// A model of two layers of DIDs, the first reading a set of source pads and the second reading the first.
+    /// </summary>
+    class ChangeTrackerTestModel : public Model {
+    public:
+        static const int NumberOfSources = 5;
+        static const int NumberOfDIDs = 40;
+        vector<OutputPad*> Sources;
+        vector<OutputPad*> Outputs;
+        ChangeTrackerTestModel(char* arguments[]);
+        /// <summary>
+        /// Sets a source in both buffers, as an external input would.
+        /// </summary>
+        void SetSource(int index, float value);
+        /// <summary>
+        /// Runs the given number of epochs, appending every output after each one.
+        /// </summary>
+        void Run(int epochs, vector<float>& outputs);
+    };
+
+    ChangeTrackerTestModel::ChangeTrackerTestModel(char* arguments[])
+        : Model("ChangeTrackerTest", arguments) {
+        for (int index = 0; index < NumberOfSources; ++index) {
+            OutputPad* source = new OutputPad(this, *this, Identifier::Generate("S"), PropertyScopes::Public);
+            Add(*source);
+            Sources.push_back(source);
+        }
+        for (int index = 0; index < NumberOfDIDs; ++index) {
+            AnalogueDID* did = index % 2 == 0 ? (AnalogueDID*)new OrDID(this, this) : (AnalogueDID*)new AndDID(this, this);
+            Add(*(Container*)did);
+            for (int k = 0; k < 2; ++k) {
+                InputPad* input = new InputPad(did, *did, Identifier::Generate("I"), PropertyScopes::Public);
+                did->Add(*input);
+                OutputPad* from = index < NumberOfDIDs / 2
+                    ? Sources[(index + k) % NumberOfSources] : Outputs[(index + k) % (NumberOfDIDs / 2)];
+                input->Add(*from, *(Connector*)this);
+            }
+            OutputPad* output = new OutputPad(did, *did, Identifier::Generate("O"), PropertyScopes::Public);
+            did->Add(*output);
+            Outputs.push_back(output);
+        }
+    }
+
+    void ChangeTrackerTestModel::SetSource(int index, float value) {
+        ModelSignals->Current[Sources[index]->SignalIndex] = value;
+        ModelSignals->Next[Sources[index]->SignalIndex] = value;
+    }
+
+    void ChangeTrackerTestModel::Run(int epochs, vector<float>& outputs) {
+        for (int epoch = 0; epoch < epochs; ++epoch) {
+            Model::Run(1);
+            vector<OutputPad*>::iterator itr;
+            for (itr = Outputs.begin(); itr != Outputs.end(); ++itr) {
+                outputs.push_back(ModelSignals->Next[(*itr)->SignalIndex]);
+            }
+        }
+    }
+
+    int ChangeTrackerTest::ConductUnitTest(string& message) {
+        message = "";
+        int failureCount = 0;
+        bool passed = false;
+
+#pragma region // Test of incremental updates against full updates.
+        message += "IncrementalUpdates: ";
+        for(;;) {
+            try {
+                // The full update is the reference; the incremental ones are run with and without the kernel.
+                char* full[] = { (char*)"ChangeTrackerTest", (char*)"--VectoriseDIDs=false", NULL };
+                char* incremental[] = { (char*)"ChangeTrackerTest", (char*)"--IncrementalUpdates=true", (char*)"--VectoriseDIDs=false", NULL };
+                char* vectorised[] = { (char*)"ChangeTrackerTest", (char*)"--IncrementalUpdates=true", NULL };
+                char** arguments[] = { full, incremental, vectorised };
+                vector<float> outputs[3];
+                int configured = 0;
+                bool isTracked = true;
+                bool isSkipped = true;
+                bool isMarked = true;
+                for (int run = 0; run < 3; ++run) {
+                    ChangeTrackerTestModel* model = new ChangeTrackerTestModel(arguments[run]);
+                    configured |= model->Configure();
+                    for (int index = 0; index < ChangeTrackerTestModel::NumberOfSources; ++index) {
+                        model->SetSource(index, 0.2f + 0.1f * index);
+                    }
+                    // Let the second layer settle, then change one source and let it settle again.
+                    model->Run(4, outputs[run]);
+                    int quietCount = model->ModelChanges != NULL ? model->ModelChanges->DirtyCount() : -1;
+                    model->SetSource(0, 0.9f);
+                    model->Run(1, outputs[run]);
+                    int changedCount = model->ModelChanges != NULL ? model->ModelChanges->DirtyCount() : -1;
+                    model->Run(3, outputs[run]);
+                    if (run == 1) {
+                        isTracked = model->ModelChanges != NULL;
+                        // Once settled nothing is dirty, and a changed source only marks some of the DIDs.
+                        isSkipped = quietCount == 0;
+                        isMarked = model->ModelChanges != NULL && model->ModelChanges->DirtyCount() < ChangeTrackerTestModel::NumberOfDIDs
+                            && changedCount >= 0 && changedCount < ChangeTrackerTestModel::NumberOfDIDs;
+                    }
+                    delete model;
+                }
+
+                if (configured != 0 || !isTracked) {
+                    message += "Tracking changes: Failed.";
+                    break;
+                }
+                if (!isSkipped || !isMarked) {
+                    message += "Skipping unchanged DIDs: Failed.";
+                    break;
+                }
+                if (outputs[1] != outputs[0] || outputs[2] != outputs[0]) {
+                    message += "Incremental output matches full output: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+        return failureCount;
+    }
+}
@@ -0,0 +1,178 @@
+#include "PlatoIncludes.h"
+#include "PlatoStandard.h"
+#include "AnalogueDIDs.h"
+
+#include "ConnectionGraphTest.h"
+
+namespace Plato {
+
+    /// <summary>
+    /// A model of source pads feeding DIDs with between zero and three inputs each.
+    /// </summary>
+    class ConnectionGraphTestModel : public Model {
+    public:
+        vector<OutputPad*> Sources;
+        vector<InputPad*> Inputs;
+        ConnectionGraphTestModel(char* arguments[]);
+        /// <summary>
+        /// Gathers the inputs of every pad, and their source slots, into one list.
+        /// </summary>
+        void Gather(vector<float>& values, vector<int>& signals);
+    };
+
+    ConnectionGraphTestModel::ConnectionGraphTestModel(char* arguments[])
+        : Model("ConnectionGraphTest", arguments) {
+        for (int index = 0; index < 4; ++index) {
+            OutputPad* source = new OutputPad(this, *this, Identifier::Generate("S"), PropertyScopes::Public);
+            Add(*source);
+            Sources.push_back(source);
+        }
+        for (int index = 0; index < 8; ++index) {
+            AnalogueDID* did = index % 2 == 0 ? (AnalogueDID*)new AndDID(this, this) : (AnalogueDID*)new OrDID(this, this);
+            Add(*(Container*)did);
+            InputPad* input = new InputPad(did, *did, Identifier::Generate("I"), PropertyScopes::Public);
+            did->Add(*input);
+            for (int from = 0; from < index % 4; ++from) {
+                input->Add(*Sources[(index + from) % 4], *(Connector*)this);
+            }
+            Inputs.push_back(input);
+            OutputPad* output = new OutputPad(did, *did, Identifier::Generate("O"), PropertyScopes::Public);
+            did->Add(*output);
+        }
+    }
+
+    void ConnectionGraphTestModel::Gather(vector<float>& values, vector<int>& signals) {
+        float buffer[8];
+        int slots[8];
+        values.clear();
+        signals.clear();
+        vector<InputPad*>::iterator itr;
+        for (itr = Inputs.begin(); itr != Inputs.end(); ++itr) {
+            int count = (*itr)->GatherInputs(buffer);
+            values.insert(values.end(), buffer, buffer + count);
+            count = (*itr)->GetInputSignals(slots);
+            signals.insert(signals.end(), slots, slots + count);
+            // Mark the end of each pad's inputs.
+            values.push_back(-1.0f);
+            signals.push_back(-1);
+        }
+    }
+
+    int ConnectionGraphTest::ConductUnitTest(string& message) {
+        message = "";
+        int failureCount = 0;
+        bool passed = false;
+
+#pragma region // Test of SignalArena.
+        message += "SignalArena: ";
+        for(;;) {
+            try {
+                SignalArena* arena = new SignalArena(SignalArena::BlockSize);
+                bool isOrdered = true;
+                for (int index = 0; index < 40; ++index) {
+                    isOrdered &= arena->Allocate() == index;
+                    arena->Current[index] = (float)index;
+                    arena->Next[index] = (float)-index;
+                }
+                // Growing the arrays keeps the values, the alignment and whole blocks.
+                bool isKept = arena->Current[17] == 17.0f && arena->Next[39] == -39.0f;
+                bool isAligned = ((size_t)arena->Current & (SignalArena::Alignment - 1)) == 0
+                    && ((size_t)arena->Next & (SignalArena::Alignment - 1)) == 0
+                    && arena->Capacity() % SignalArena::BlockSize == 0 && arena->Capacity() >= 40;
+                // A released slot is reused and zeroed, and releasing the last slot shrinks the count.
+                arena->Release(7);
+                int reused = arena->Allocate();
+                bool isReused = reused == 7 && arena->Current[7] == 0.0f && arena->Next[7] == 0.0f;
+                arena->Release(39);
+                bool isShrunk = arena->Count() == 39 && arena->Allocate() == 39;
+                arena->Current[0] = 1.0f;
+                arena->Next[0] = 2.0f;
+                arena->Swap();
+                bool isSwapped = arena->Current[0] == 2.0f && arena->Next[0] == 1.0f;
+                delete arena;
+
+                if (!isOrdered || !isKept || !isAligned) {
+                    message += "Allocation: Failed.";
+                    break;
+                }
+                if (!isReused || !isShrunk || !isSwapped) {
+                    message += "Release and swap: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of ConnectionGraph.
+        message += "ConnectionGraph: ";
+        passed = false;
+        for(;;) {
+            try {
+                char* arguments[] = { (char*)"ConnectionGraphTest", NULL };
+                ConnectionGraphTestModel* model = new ConnectionGraphTestModel(arguments);
+                int configured = model->Configure();
+                for (int index = 0; index < 4; ++index) {
+                    model->ModelSignals->Current[model->Sources[index]->SignalIndex] = 0.1f * (index + 1);
+                }
+                vector<float> values;
+                vector<int> signals;
+                model->Gather(values, signals);
+
+                // The graph holds every input pad, including the one without inputs, in declaration order.
+                ConnectionGraph& graph = model->Freeze(false);
+                bool isCompiled = graph.PadCount() == 8 && graph.EdgeCount() == 12;
+                for (int index = 0; index < 8; ++index) {
+                    isCompiled &= model->Inputs[index]->GraphIndex == index && graph.InputCount(index) == index % 4;
+                }
+                vector<float> frozenValues;
+                vector<int> frozenSignals;
+                model->Gather(frozenValues, frozenSignals);
+                bool isFrozenSame = frozenValues == values && frozenSignals == signals;
+
+                // A connection added after a freeze is picked up by the next freeze.
+                model->Inputs[0]->Add(*model->Sources[3], *(Connector*)model);
+                model->Freeze(false);
+                bool isRefrozen = model->ModelConnections->EdgeCount() == 13 && model->Inputs[0]->GetInputCount() == 1;
+                model->Gather(values, signals);
+
+                // Releasing the connections leaves the graph as the only copy of the wiring.
+                model->Freeze(true);
+                model->Gather(frozenValues, frozenSignals);
+                bool isReleasedSame = frozenValues == values && frozenSignals == signals
+                    && model->Inputs[3]->InputConnections->empty();
+                bool isAddRefused = !model->Inputs[1]->Add(*model->Sources[0], *(Connector*)model)
+                    && model->Inputs[1]->GetInputCount() == 1;
+                delete model;
+
+                if (configured != 0 || !isCompiled) {
+                    message += "Compiling the graph: Failed.";
+                    break;
+                }
+                if (!isFrozenSame || !isRefrozen || !isReleasedSame) {
+                    message += "Gathering inputs before and after freezing: Failed.";
+                    break;
+                }
+                if (!isAddRefused) {
+                    message += "Adding to a released pad: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+        return failureCount;
+    }
+}
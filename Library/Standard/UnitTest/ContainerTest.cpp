@@ -9,6 +9,24 @@
 #include "Property.h"
 #include "Container.h"
 #include "Alias.h"
+#include "IdentifierEnumerator.h"
+#include "Point.h"
+#include "SpatialIndex.h"
+#include "Arguments.h"
+#include "Filter.h"
+#include "NeighbourhoodFilter.h"
+#include "Size.h"
+#include "Bounds.h"
+#include "PointSpace.h"
+#include "BoxSpace.h"
+#include "PointRegex.h"
+#include "PointFilter.h"
+#include "CoordinateNames.h"
+#include "CoordinateOperations.h"
+#include "PointBatch.h"
+#include "Geometry.h"
+#include "PipeGeometry.h"
+#include "UnivariateDistribution.h"
 
 #include "ContainerTest.h"
 
@@ -17,6 +35,7 @@ namespace Plato {
     class ContainerTestContainer : public Container {
         public:
             ContainerTestContainer(Identifier& identifier);
+            ContainerTestContainer(const ClassTypeInfo::HashSet& propertyTypes, Identifier& identifier);
         };
 
 
@@ -24,6 +43,10 @@ namespace Plato {
         : Container(*Container::PropertyTypes,NULL,NULL,identifier,PropertyScopes::Public) {
     }
 
+    ContainerTestContainer::ContainerTestContainer(const ClassTypeInfo::HashSet& propertyTypes, Identifier& identifier)
+        : Container(propertyTypes,NULL,NULL,identifier,PropertyScopes::Public) {
+    }
+
     int ContainerTest::ConductUnitTest(string& message) {
         message = "";
         int failureCount = 0;
@@ -45,9 +68,10 @@ namespace Plato {
                     ct->Add(*a);
                 }
 
-                vector<Property*>::iterator itr = ct->OrderedProperties->begin();
+                vector<Property*>* properties = ct->GetOrderedProperties();
+                vector<Property*>::iterator itr = properties->begin();
                 string testResult = "(";
-                for(itr=ct->OrderedProperties->begin();itr!=ct->OrderedProperties->end();++itr) {
+                for(itr=properties->begin();itr!=properties->end();++itr) {
                     string & tmp = (*itr)->Identity->StatusReport();
                     testResult += " " + tmp;
                     delete &tmp;
@@ -73,6 +97,287 @@ namespace Plato {
 
         failureCount += passed ? 0 : 1;
 #pragma endregion
+
+#pragma region // Test of Container removal.
+        message += "Remove: ";
+        passed = false;
+        for(;;) {
+            try {
+                const char* testItems[] = { "r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7", NULL };
+                const char* removeItems[] = { "r6", "r1", "r2", NULL };
+                string testAnswer = "( r0 r3 r4 r5 r7)";
+
+                ContainerTestContainer* ct = new ContainerTestContainer(*new Identifier("UnitTestContainer"));
+
+                int i=0;
+                const char* s;
+                while((s=testItems[i++])!=NULL) {
+                    Alias* a = new Alias(ct,(Container*)NULL,*new Identifier(s),PropertyScopes::Public);
+                    ct->Add(*a);
+                }
+                i=0;
+                while((s=removeItems[i++])!=NULL) {
+                    Identifier ident(s);
+                    delete ct->Remove(ident);
+                }
+                // Removed orders are gone, and those either side of them are still found.
+                bool isFound = ct->GetProperty(1)==NULL && ct->GetProperty(2)==NULL && ct->GetProperty(6)==NULL
+                    && ct->GetProperty(0)!=NULL && ct->GetProperty(3)!=NULL && ct->GetProperty(7)!=NULL
+                    && ct->Count()==5;
+
+                vector<Property*>* properties = ct->GetOrderedProperties();
+                vector<Property*>::iterator itr;
+                string testResult = "(";
+                for(itr=properties->begin();itr!=properties->end();++itr) {
+                    string & tmp = (*itr)->Identity->StatusReport();
+                    testResult += " " + tmp;
+                    delete &tmp;
+                }
+                testResult += ")";
+                bool result = testAnswer.compare(testResult)==0 && ct->BinarySearch(5)==3;
+
+                delete ct;
+
+                if (!isFound) {
+                    message += "Lookup by order after removal: Failed.";
+                    break;
+                }
+                if (!result) {
+                    message += "Removal test: <" + testAnswer + "> != <" + testResult + ">: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of the spatial index.
+        message += "SpatialIndex: ";
+        passed = false;
+        for(;;) {
+            try {
+                ContainerTestContainer* ct = new ContainerTestContainer(*new Identifier("UnitTestContainer"));
+                Alias* centre = NULL;
+                char name[16];
+                for (int x = 0; x < 5; ++x) {
+                    for (int y = 0; y < 5; ++y) {
+                        sprintf(name, "s%d%d", x, y);
+                        Alias* a = new Alias(ct,(Container*)NULL,*new Identifier(name,new Point((float)x,(float)y)),PropertyScopes::Public);
+                        ct->Add(*a);
+                        if (x == 2 && y == 2) {
+                            centre = a;
+                        }
+                    }
+                }
+                // One layer round the centre of a 5x5 lattice holds 8 neighbours, and two layers the rest.
+                NeighbourhoodFilter* layers = new NeighbourhoodFilter(*new FilterArguments(NULL,NULL,ct,centre,
+                    PropertyModes::Traversing,new NeighbourhoodFilterArguments(1)));
+                layers->AccessContents();
+                int oneLayer = layers->Count();
+                Identifier removed("s11",new Point(1.0f,1.0f));
+                delete ct->Remove(removed);
+                layers->Flags.Refresh = true;
+                layers->AccessContents();
+                int oneLayerAfterRemoval = layers->Count();
+                // A fifth of the diagonal of the 4x4 extent is just over a unit: the 4 nearest neighbours.
+                NeighbourhoodFilter* distance = new NeighbourhoodFilter(*new FilterArguments(NULL,NULL,ct,centre,
+                    PropertyModes::Traversing,new NeighbourhoodFilterArguments(20.0f)));
+                distance->AccessContents();
+                int nearest = distance->Count();
+                bool isIndexed = ct->GetSpatialIndex() != NULL && ct->GetSpatialIndex()->Count() == 24;
+                delete layers->Arguments->AdditionalArguments;
+                delete distance->Arguments->AdditionalArguments;
+                delete layers;
+                delete distance;
+                delete ct;
+
+                if (oneLayer != 8 || oneLayerAfterRemoval != 7 || nearest != 4 || !isIndexed) {
+                    message += "Neighbourhood queries: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of PointFilter over the spatial index.
+        message += "PointFilter: ";
+        passed = false;
+        for(;;) {
+            try {
+                ContainerTestContainer* ct = new ContainerTestContainer(*new Identifier("UnitTestContainer"));
+                char name[16];
+                for (int x = 0; x < 20; ++x) {
+                    for (int y = 0; y < 20; ++y) {
+                        sprintf(name, "p%d_%d", x, y);
+                        Alias* a = new Alias(ct,(Container*)NULL,*new Identifier(name,new Point((float)x,(float)y)),PropertyScopes::Public);
+                        ct->Add(*a);
+                    }
+                }
+                // A box of 4 by 3 lattice points, upper faces included.
+                BoxSpace* space = new BoxSpace(*new Point(2.0f,3.0f), *new Size(3.0f,2.0f,0.0f,0.0f));
+                PointFilter* inside = new PointFilter(*new FilterArguments(NULL,NULL,ct,NULL,
+                    PropertyModes::Traversing,new PointFilterArguments(*new PointRegex(*space),true)));
+                inside->AccessContents();
+                int matches = inside->Count();
+                PointFilter* outside = new PointFilter(*new FilterArguments(NULL,NULL,ct,NULL,
+                    PropertyModes::Traversing,new PointFilterArguments(*new PointRegex(*space),false)));
+                outside->AccessContents();
+                int misses = outside->Count();
+
+                // The bounded query searches only the cells of the box, the unbounded one every occupied cell.
+                const SpatialIndex* index = ct->GetSpatialIndex();
+                Bounds* box = space->BoundingBox();
+                Point upper(box->LowerBound->Coordinates[0] + box->Width->Sizes[0],
+                    box->LowerBound->Coordinates[1] + box->Width->Sizes[1]);
+                vector<Property*> found;
+                int boxCells = index->FindInBox(*box->LowerBound, upper, found);
+                Point lowest;
+                Point highest;
+                index->GetExtent(lowest, highest);
+                found.clear();
+                int allCells = index->FindInBox(lowest, highest, found);
+                delete box;
+
+                // Removing the last column leaves the extent to be shrunk by the next GetExtent.
+                for (int y = 0; y < 20; ++y) {
+                    sprintf(name, "p19_%d", y);
+                    Identifier removed(name,new Point(19.0f,(float)y));
+                    delete ct->Remove(removed);
+                }
+                index->GetExtent(lowest, highest);
+                bool isShrunk = highest.Coordinates[0] == 18.0f && highest.Coordinates[1] == 19.0f
+                    && lowest.Coordinates[0] == 0.0f && index->Count() == 380;
+
+                delete inside->Arguments->AdditionalArguments;
+                delete outside->Arguments->AdditionalArguments;
+                delete inside;
+                delete outside;
+                delete space;
+                delete ct;
+
+                if (matches != 12 || misses != 388) {
+                    message += "Matching a box: Failed.";
+                    break;
+                }
+                if (boxCells != 12 || allCells != 400) {
+                    message += "Cells searched: Failed.";
+                    break;
+                }
+                if (!isShrunk) {
+                    message += "Extent after removal: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of default positions.
+        message += "Positions: ";
+        passed = false;
+        for(;;) {
+            try {
+                // More containers than one batch of positions, each positioned as by a fresh geometry.
+                const int count = Container::PositionBatchSize * 2 + 3;
+                PipeGeometry* geometry = new PipeGeometry(UnivariateDistribution::UnboundedCapacity);
+                PointBatch* expected = new PointBatch(count);
+                geometry->GetPoints(CoordinateOperations::New, *expected);
+                ContainerTestContainer* ct = new ContainerTestContainer(*new Identifier("UnitTestContainer"));
+                bool isPositioned = expected->Count == count;
+                char name[16];
+                for (int index = 0; index < count && isPositioned; ++index) {
+                    sprintf(name, "c%d", index);
+                    ContainerTestContainer* child = new ContainerTestContainer(*new Identifier(name));
+                    ct->Add(*child);
+                    const Point* position = child->Identity->Position;
+                    isPositioned = position != NULL;
+                    for (int i = 0; i < Point::NumberOfCoordinates && isPositioned; ++i) {
+                        isPositioned = position->Coordinates[i] == expected->Coordinates[i][index];
+                    }
+                }
+                delete ct;
+                delete expected;
+                delete geometry;
+
+                if (!isPositioned) {
+                    message += "Positions from the geometry: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of regex lookup in a container with narrower categories.
+        message += "GetProperties: ";
+        passed = false;
+        for(;;) {
+            try {
+                const char* testItems[] = { "a1", "b1", "a2", "a3", "b2", NULL };
+                ClassTypeInfo::HashSet* aliasTypes = Container::CreatePropertyTypes(Alias::TypeInfo,NULL);
+                ContainerTestContainer* ct = new ContainerTestContainer(*aliasTypes,*new Identifier("UnitTestContainer"));
+                int i=0;
+                const char* s;
+                while((s=testItems[i++])!=NULL) {
+                    Alias* a = new Alias(ct,(Container*)NULL,*new Identifier(s),PropertyScopes::Public);
+                    ct->Add(*a);
+                }
+                // The container has no Property category, so the lookup falls back to its master table.
+                IdentifierRegex regex(new string("a."));
+                IdentifierEnumerator* e = ct->GetProperties(regex,*Property::TypeInfo,true,NULL,PropertyModes::Traversing);
+                int matches = 0;
+                while (e != NULL && e->MoveNext()) {
+                    ++matches;
+                }
+                IdentifierEnumerator* excluded = ct->GetProperties(regex,*Property::TypeInfo,false,NULL,PropertyModes::Traversing);
+                int misses = 0;
+                while (excluded != NULL && excluded->MoveNext()) {
+                    ++misses;
+                }
+                delete e;
+                delete excluded;
+                delete ct;
+                delete aliasTypes;
+
+                if (matches != 3 || misses != 2) {
+                    message += "Regex lookup by Property: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
         return failureCount;
     }
 }
@@ -0,0 +1,136 @@
+#include "PlatoIncludes.h"
+#include "Numbers.h"
+#include "UnivariateDistribution.h"
+#include "UnivariateDistributionEnumerator.h"
+#include "UniformUnivariateDistribution.h"
+#include "NormalUnivariateDistribution.h"
+
+#include "DistributionTest.h"
+
+namespace Plato {
+
+    /// <summary>
+    /// Counts the values filled from first that differ from the distribution's indexer.
+    /// </summary>
+    /// <param name="distribution">The distribution to fill.</param>
+    /// <param name="first">The index of the first value.</param>
+    /// <param name="count">The number of values to fill.</param>
+    /// <param name="tolerance">The largest difference allowed, relative to the larger of one and the value.</param>
+    /// <param name="values">A buffer with room for count values.</param>
+    /// <returns>Returns the number of mismatches, plus one if the wrong number of values is filled.</returns>
+    static int DistributionTestCompare(UnivariateDistribution& distribution, int first, int count, float tolerance, float* values) {
+        int available = first < 0 ? 0 : distribution.Capacity() - first;
+        int expected = count < available ? count : available;
+        int filled = distribution.Fill(first, count, values);
+        int mismatches = filled == (expected > 0 ? expected : 0) ? 0 : 1;
+        for (int index = 0; index < filled; ++index) {
+            float scalar = distribution[first + index];
+            float scale = fabs(scalar) > 1.0f ? fabs(scalar) : 1.0f;
+            mismatches += fabs(values[index] - scalar) <= tolerance * scale ? 0 : 1;
+        }
+        return mismatches;
+    }
+
+    /// <summary>
+    /// Compares the whole of a distribution, and runs that start at each lane of a vector
+    /// and that reach the end, so both the vector loop and the scalar tail are covered.
+    /// </summary>
+    static int DistributionTestCompare(UnivariateDistribution& distribution, float tolerance, vector<float>& values) {
+        int capacity = distribution.Capacity();
+        int mismatches = DistributionTestCompare(distribution, 0, capacity, tolerance, &values[0]);
+        const int runs[] = { 1, 3, 4, 5, 8, 13 };
+        for (int r = 0; r < 6; ++r) {
+            for (int first = 0; first < 4; ++first) {
+                mismatches += DistributionTestCompare(distribution, first, runs[r], tolerance, &values[0]);
+                mismatches += DistributionTestCompare(distribution, capacity - runs[r] + first, runs[r], tolerance, &values[0]);
+            }
+        }
+        // Nothing is filled before the start or past the end.
+        mismatches += distribution.Fill(-1, 4, &values[0]) == 0 ? 0 : 1;
+        mismatches += distribution.Fill(capacity, 4, &values[0]) == 0 ? 0 : 1;
+        return mismatches;
+    }
+
+    /// <summary>
+    /// Gets the capacities to test: every one up to 257, then powers of two either side, up to 100001.
+    /// </summary>
+    static void DistributionTestCapacities(vector<int>& capacities) {
+        for (int capacity = 1; capacity <= 257; ++capacity) {
+            capacities.push_back(capacity);
+        }
+        for (int power = 1024; power <= 65536; power *= 4) {
+            capacities.push_back(power - 1);
+            capacities.push_back(power);
+            capacities.push_back(power + 1);
+        }
+        capacities.push_back(100001);
+    }
+
+    int DistributionTest::ConductUnitTest(string& message) {
+        message = "";
+        int failureCount = 0;
+        bool passed = false;
+        vector<int> capacities;
+        DistributionTestCapacities(capacities);
+        int numberOfCapacities = (int)capacities.size();
+        vector<float> values(capacities.back());
+
+#pragma region // Test of UniformUnivariateDistribution::Fill.
+        message += "Uniform: ";
+        for(;;) {
+            try {
+                int mismatches = 0;
+                for (int c = 0; c < numberOfCapacities; ++c) {
+                    UniformUnivariateDistribution* distribution = new UniformUnivariateDistribution(capacities[c]);
+                    // The vector and scalar divisions are both correctly rounded, so must agree exactly.
+                    mismatches += DistributionTestCompare(*distribution, 0.0f, values);
+                    delete distribution;
+                }
+
+                if (mismatches != 0) {
+                    message += "Fill matches the indexer: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of NormalUnivariateDistribution::Fill.
+        message += "Normal: ";
+        passed = false;
+        for(;;) {
+            try {
+                int mismatches = 0;
+                for (int c = 0; c < numberOfCapacities; ++c) {
+                    int capacity = capacities[c];
+                    NormalUnivariateDistribution* distribution = new NormalUnivariateDistribution(capacity,
+                        NormalUnivariateDistribution::DefaultMean, NormalUnivariateDistribution::NormalisedSigma(capacity));
+                    // The vector logarithm is a polynomial approximation, so allow a few units in the last place.
+                    mismatches += DistributionTestCompare(*distribution, 1e-5f, values);
+                    delete distribution;
+                }
+
+                if (mismatches != 0) {
+                    message += "Fill matches the indexer: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+        return failureCount;
+    }
+}
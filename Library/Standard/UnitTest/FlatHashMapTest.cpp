@@ -0,0 +1,159 @@
+#include "PlatoIncludes.h"
+#include "Strings.h"
+#include "Numbers.h"
+#include "Identifier.h"
+#include <random>
+
+#include "FlatHashMapTest.h"
+
+namespace Plato {
+
+    typedef FlatHashMap<Identifier::ConstIdentifierPtr, int, IdentifierPtrTraits> FlatHashMapTestMap;
+    typedef hash_map<Identifier::ConstIdentifierPtr, int, IdentifierHashArgs> FlatHashMapTestHashMap;
+
+    /// <summary>
+    /// Creates count identifiers named prefix0, prefix1, etc.
+    /// </summary>
+    static void FlatHashMapTestKeys(const char* prefix, int count, vector<Identifier*>& keys) {
+        for (int index = 0; index < count; ++index) {
+            string& name = Numbers::ToString(index);
+            name.insert(0, prefix);
+            keys.push_back(new Identifier(name));
+        }
+    }
+
+    static void FlatHashMapTestDelete(vector<Identifier*>& keys) {
+        vector<Identifier*>::iterator itr;
+        for (itr = keys.begin(); itr != keys.end(); ++itr) {
+            delete *itr;
+        }
+        keys.clear();
+    }
+
+    int FlatHashMapTest::ConductUnitTest(string& message) {
+        message = "";
+        int failureCount = 0;
+        bool passed = false;
+
+#pragma region // Test of FlatHashMap.
+        message += "FlatHashMap: ";
+        vector<Identifier*> keys;
+        vector<Identifier*> probes;
+        FlatHashMapTestMap* map = new FlatHashMapTestMap();
+        for(;;) {
+            try {
+                const int count = 1000;
+                FlatHashMapTestKeys("key", count, keys);
+                // Equal names in distinct identifiers must find the same entries.
+                FlatHashMapTestKeys("key", count, probes);
+                for (int index = 0; index < count; ++index) {
+                    (*map)[keys[index]] = index;
+                }
+                if ((int)map->size() != count) {
+                    message += "Insertion test: Failed.";
+                    break;
+                }
+                int misses = 0;
+                for (int index = 0; index < count; ++index) {
+                    FlatHashMapTestMap::iterator itr = map->find(probes[index]);
+                    if (itr == map->end() || itr->second != index) {
+                        ++misses;
+                    }
+                }
+                Identifier absent("absent");
+                if (misses > 0 || map->find(&absent) != map->end()) {
+                    message += "Find test: Failed.";
+                    break;
+                }
+                // Erase the even keys, which shifts back the entries displaced by them.
+                for (int index = 0; index < count; index += 2) {
+                    if (map->erase(probes[index]) != 1) {
+                        ++misses;
+                    }
+                }
+                for (int index = 0; index < count; ++index) {
+                    bool isFound = map->find(probes[index]) != map->end();
+                    if (isFound != (index % 2 == 1)) {
+                        ++misses;
+                    }
+                }
+                int iterated = 0;
+                FlatHashMapTestMap::iterator itr;
+                for (itr = map->begin(); itr != map->end(); ++itr) {
+                    ++iterated;
+                }
+                if (misses > 0 || iterated != count / 2 || (int)map->size() != count / 2) {
+                    message += "Erase test: Failed.";
+                    break;
+                }
+                map->clear();
+                if (!map->empty() || map->find(probes[1]) != map->end()) {
+                    message += "Clear test: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+        delete map;
+        FlatHashMapTestDelete(probes);
+        FlatHashMapTestDelete(keys);
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+        return failureCount;
+    }
+
+    int FlatHashMapTest::ConductBenchmark(string& message, int count, int rounds, double& hashMapTime, double& flatMapTime) {
+        vector<Identifier*> keys;
+        vector<Identifier*> probes;
+        FlatHashMapTestKeys("Identifier", count, keys);
+        FlatHashMapTestKeys("Identifier", count, probes);
+        // Look the keys up in a scattered order, as path resolution does, but the same order every run.
+        mt19937 engine(count);
+        shuffle(probes.begin(), probes.end(), engine);
+        FlatHashMapTestHashMap* hashMap = new FlatHashMapTestHashMap();
+        FlatHashMapTestMap* flatMap = new FlatHashMapTestMap();
+        for (int index = 0; index < count; ++index) {
+            (*hashMap)[keys[index]] = index;
+            (*flatMap)[keys[index]] = index;
+        }
+        int misses = 0;
+        clock_t start = clock();
+        for (int round = 0; round < rounds; ++round) {
+            for (int index = 0; index < count; ++index) {
+                if (hashMap->find(probes[index]) == hashMap->end()) {
+                    ++misses;
+                }
+            }
+        }
+        clock_t middle = clock();
+        for (int round = 0; round < rounds; ++round) {
+            for (int index = 0; index < count; ++index) {
+                if (flatMap->find(probes[index]) == flatMap->end()) {
+                    ++misses;
+                }
+            }
+        }
+        clock_t finish = clock();
+        double lookups = (double)count * rounds;
+        hashMapTime = 1e9 * (middle - start) / CLOCKS_PER_SEC / lookups;
+        flatMapTime = 1e9 * (finish - middle) / CLOCKS_PER_SEC / lookups;
+        string& keyCount = Numbers::ToString(count);
+        string& hashMapNs = Numbers::ToString((float)hashMapTime);
+        string& flatMapNs = Numbers::ToString((float)flatMapTime);
+        message = "FlatHashMap benchmark: " + keyCount + " keys, hash_map " + hashMapNs 
+            + " ns/lookup, FlatHashMap " + flatMapNs + " ns/lookup.";
+        delete &flatMapNs;
+        delete &hashMapNs;
+        delete &keyCount;
+        delete flatMap;
+        delete hashMap;
+        FlatHashMapTestDelete(probes);
+        FlatHashMapTestDelete(keys);
+        return misses;
+    }
+}
@@ -0,0 +1,261 @@
+#include "PlatoIncludes.h"
+#include "ThreadLocalVariable.h"
+#include "Mutex.h"
+#include "ThreadPool.h"
+#include "LogWriter.h"
+
+#include "LogWriterTest.h"
+
+namespace Plato {
+
+    static void LogWriterTestWrite(const char* format, ...) {
+        va_list arguments;
+        va_start(arguments, format);
+        LogWriter::Write(format, arguments);
+        va_end(arguments);
+    }
+
+    /// <summary>
+    /// A stream buffer collecting what is written to it.
+    /// </summary>
+    class LogWriterTestBuffer : public streambuf {
+    public:
+        string Text;
+    protected:
+        virtual int overflow(int c) {
+            if (c != EOF) {
+                Text += (char)c;
+            }
+            return c;
+        }
+        virtual streamsize xsputn(const char* s, streamsize n) {
+            Text.append(s, (size_t)n);
+            return n;
+        }
+    };
+
+    /// <summary>
+    /// Collects what the writer writes to cerr while a function adds messages, until they are all written.
+    /// </summary>
+    /// <param name="prefix">The start of the lines wanted.</param>
+    /// <param name="writeMessages">The function, passed state, whose result is set in result.</param>
+    /// <returns>Returns the lines written that start with the prefix.</returns>
+    static vector<string> LogWriterTestCapture(const string& prefix, long (*writeMessages)(void*), void* state, long& result) {
+        LogWriter::Flush();
+        LogWriterTestBuffer captured;
+        streambuf* previous = cerr.rdbuf(&captured);
+        result = writeMessages(state);
+        LogWriter::Flush();
+        cerr.rdbuf(previous);
+        vector<string> lines;
+        size_t start = 0;
+        size_t end;
+        while ((end = captured.Text.find('\n', start)) != string::npos) {
+            if (captured.Text.compare(start, prefix.size(), prefix) == 0) {
+                lines.push_back(captured.Text.substr(start, end - start));
+            }
+            start = end + 1;
+        }
+        return lines;
+    }
+
+    /// <summary>
+    /// The formats of the truncation tests, which must outlive the messages.
+    /// </summary>
+    struct LogWriterTestFormats {
+        string LongString;
+        string ManyArguments;
+        string LongFormat;
+    };
+
+    static long LogWriterTestFormatMessages(void* state) {
+        LogWriterTestFormats& formats = *(LogWriterTestFormats*)state;
+        LogWriterTestWrite("LogWriterTest format %s|%*d|%-4s|%ld|%5.2f|%x|100%%", "abc", 6, 42, "de", (long)-1234567, 3.14159, 255);
+        LogWriterTestWrite("LogWriterTest string %s", formats.LongString.c_str());
+        LogWriterTestWrite(formats.ManyArguments.c_str(), 0L, 1L, 2L, 3L, 4L, 5L, 6L, 7L, 8L, 9L, 10L, 11L, 12L, 13L, 14L, 15L,
+            16L, 17L, 18L, 19L, 20L, 21L, 22L, 23L, 24L, 25L, 26L, 27L, 28L, 29L, 30L, 31L, 32L, 33L, 34L, 35L, 36L, 37L, 38L, 39L);
+        LogWriterTestWrite(formats.LongFormat.c_str());
+        return 0;
+    }
+
+    static long LogWriterTestFloodMessages(void*) {
+        long dropCount = LogWriter::GetDropCount();
+        // Adding is much quicker than writing, so the ring fills well before this many.
+        for (int index = 0; index < 64 * LogWriter::RingSize && LogWriter::GetDropCount() == dropCount; ++index) {
+            LogWriterTestWrite("LogWriterTest flood %d", index);
+        }
+        return LogWriter::GetDropCount() - dropCount;
+    }
+
+    /// <summary>
+    /// Writes a message, then lets the other tasks start, so that every worker writes some.
+    /// </summary>
+    class LogWriterTestTask : public ThreadPool::Task {
+    public:
+        LogWriterTestTask(int index, Atomic::Value& started, int count) : mIndex(index), mStarted(started), mCount(count) {
+        }
+        virtual void Execute() {
+            LogWriterTestWrite("LogWriterTest task %d", mIndex);
+            Atomic::Increment(&mStarted);
+            for (int yield = 0; yield < 1000 && mStarted < mCount; ++yield) {
+                Atomic::YieldThread();
+            }
+        }
+    private:
+        int mIndex;
+        Atomic::Value& mStarted;
+        int mCount;
+    };
+
+    /// <summary>
+    /// The numbers of rings before, during and after running the tasks of the ring release test.
+    /// </summary>
+    struct LogWriterTestRings {
+        int Before;
+        int During;
+        int After;
+    };
+
+    static long LogWriterTestPoolMessages(void* state) {
+        LogWriterTestRings& rings = *(LogWriterTestRings*)state;
+        LogWriterTestWrite("LogWriterTest rings");
+        LogWriter::Flush();
+        rings.Before = LogWriter::GetRingCount();
+        const int count = 12;
+        Atomic::Value started = 0;
+        ThreadLocalVariable::Key key = ThreadLocalVariable::GetKey();
+        ThreadPool* pool = new ThreadPool(4, key, NULL);
+        ThreadPool::TaskGroup group;
+        for (int index = 0; index < count; ++index) {
+            pool->Submit(*new LogWriterTestTask(index, started, count), group);
+        }
+        int failures = pool->Wait(group);
+        rings.During = LogWriter::GetRingCount();
+        // The workers release their rings as they end, and the writer frees each
+        // in the first pass after it has written the ring's messages.
+        delete pool;
+        ThreadLocalVariable::FreeKey(key);
+        rings.After = rings.During;
+        for (int pass = 0; pass < 10 && rings.After > rings.Before; ++pass) {
+            LogWriterTestWrite("LogWriterTest rings");
+            LogWriter::Flush();
+            rings.After = LogWriter::GetRingCount();
+        }
+        return failures;
+    }
+
+    int LogWriterTest::ConductUnitTest(string& message) {
+        message = "";
+        int failureCount = 0;
+        bool passed = false;
+
+#pragma region // Test of formatting captured arguments.
+        message += "Format: ";
+        for(;;) {
+            try {
+                LogWriterTestFormats formats;
+                formats.LongString = string(LogWriter::RecordSize + 50, 'x');
+                formats.ManyArguments = "LogWriterTest many";
+                for (int index = 0; index < 40; ++index) {
+                    formats.ManyArguments += " %ld";
+                }
+                formats.LongFormat = "LogWriterTest cut " + string(LogWriter::MessageSize + 100, 'y');
+                long result = 0;
+                vector<string> lines = LogWriterTestCapture("LogWriterTest ", LogWriterTestFormatMessages, &formats, result);
+
+                char expected[LogWriter::MessageSize + 1];
+                sprintf(expected, "LogWriterTest format %s|%*d|%-4s|%ld|%5.2f|%x|100%%", "abc", 6, 42, "de", (long)-1234567, 3.14159, 255);
+                bool isFormatted = lines.size() == 4 && lines[0] == expected;
+                // A string longer than a record holds is cut and marked.
+                string prefix = "LogWriterTest string xxxxxxxxxx";
+                bool isStringCut = lines.size() == 4 && lines[1].compare(0, prefix.size(), prefix) == 0
+                    && lines[1].size() < prefix.size() + formats.LongString.size()
+                    && lines[1].compare(lines[1].size() - 3, 3, "...") == 0;
+                // Arguments that do not fit are shown as "...", after those that do.
+                prefix = "LogWriterTest many 0 1 2 3 4 5 6 7 8 9 10";
+                bool isArgumentsCut = lines.size() == 4 && lines[2].compare(0, prefix.size(), prefix) == 0
+                    && lines[2].find(" 39") == string::npos && lines[2].compare(lines[2].size() - 3, 3, "...") == 0;
+                bool isMessageCut = lines.size() == 4 && (int)lines[3].size() == LogWriter::MessageSize
+                    && lines[3] == formats.LongFormat.substr(0, LogWriter::MessageSize);
+
+                if (!isFormatted) {
+                    message += "Formats match sprintf: Failed.";
+                    break;
+                }
+                if (!isStringCut || !isArgumentsCut) {
+                    message += "Arguments cut to a record: Failed.";
+                    break;
+                }
+                if (!isMessageCut) {
+                    message += "Message cut to MessageSize: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of a full ring.
+        message += "Drops: ";
+        passed = false;
+        for(;;) {
+            try {
+                long dropped = 0;
+                // The ring is full when a message is dropped, so the writer reports the drops along with it.
+                vector<string> lines = LogWriterTestCapture("LogWriter: ", LogWriterTestFloodMessages, NULL, dropped);
+
+                if (dropped <= 0) {
+                    message += "Full ring increments the drop count: Failed.";
+                    break;
+                }
+                if (lines.empty()) {
+                    message += "Drops reported: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of releasing the rings of threads that end.
+        message += "ReleaseRing: ";
+        passed = false;
+        for(;;) {
+            try {
+                LogWriterTestRings rings;
+                long failures = 0;
+                LogWriterTestCapture("LogWriterTest ", LogWriterTestPoolMessages, &rings, failures);
+
+                if (failures != 0 || rings.During <= rings.Before) {
+                    message += "Workers write: Failed.";
+                    break;
+                }
+                if (rings.After != rings.Before) {
+                    message += "Rings freed after the workers end: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+        return failureCount;
+    }
+}
@@ -0,0 +1,161 @@
+#include "PlatoIncludes.h"
+#include "PlatoStandard.h"
+
+#include "ModelArenaTest.h"
+
+namespace Plato {
+
+    /// <summary>
+    /// An empty model, for its arena.
+    /// </summary>
+    class ModelArenaTestModel : public Model {
+    public:
+        ModelArenaTestModel(char* arguments[]) : Model("ModelArenaTest", arguments) {
+        }
+    };
+
+    int ModelArenaTest::ConductUnitTest(string& message) {
+        message = "";
+        int failureCount = 0;
+        bool passed = false;
+
+#pragma region // Test of allocation while the arena is active and inactive.
+        message += "Allocation: ";
+        for(;;) {
+            try {
+                char* arguments[] = { (char*)"ModelArenaTest", NULL };
+                ModelArenaTestModel* model = new ModelArenaTestModel(arguments);
+                ModelArena& arena = *model->ModelMemory;
+                // The arena is active once the model's constructor has run.
+                bool isActive = arena.IsActive;
+                size_t used = arena.UsedBytes();
+                void* first = ModelArena::New(1);
+                void* second = ModelArena::New(ModelArena::Alignment + 1);
+                bool isCarved = arena.UsedBytes() == used + 5 * ModelArena::Alignment
+                    && (char*)second - (char*)first == 2 * ModelArena::Alignment
+                    && ((size_t)first & (ModelArena::Alignment - 1)) == 0;
+                // Deleting arena memory keeps it until the model goes.
+                ModelArena::Delete(first);
+                ModelArena::Delete(second);
+                used = arena.UsedBytes();
+                // Objects with their own operator new use the arena too, and delete only runs their destructors.
+                Identifier* identifier = new Identifier("ModelArenaTest");
+                bool isIdentifierCarved = arena.UsedBytes() > used;
+                delete identifier;
+                used = arena.UsedBytes();
+                bool isKept = arena.ReservedBytes() >= used;
+
+                // Objects larger than a quarter of a block get a block of their own.
+                size_t reserved = arena.ReservedBytes();
+                void* large = ModelArena::New(ModelArena::MaximumBlockSize);
+                bool isLarge = arena.ReservedBytes() >= reserved + ModelArena::MaximumBlockSize;
+                ModelArena::Delete(large);
+
+                // An inactive arena leaves allocation to the heap.
+                arena.IsActive = false;
+                used = arena.UsedBytes();
+                void* heap = ModelArena::New(64);
+                Identifier* heapIdentifier = new Identifier("ModelArenaTest");
+                bool isHeap = arena.UsedBytes() == used && heap != NULL;
+                delete heapIdentifier;
+                ModelArena::Delete(heap);
+                arena.IsActive = true;
+
+                // Configure deactivates the arena.
+                int configured = model->Configure();
+                bool isInactive = !arena.IsActive;
+                delete model;
+
+                if (!isActive || !isCarved || !isIdentifierCarved || !isKept || !isLarge) {
+                    message += "Allocation from an active arena: Failed.";
+                    break;
+                }
+                if (!isHeap) {
+                    message += "Allocation from an inactive arena: Failed.";
+                    break;
+                }
+                if (configured != 0 || !isInactive) {
+                    message += "Deactivation by Configure: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of two models' arenas.
+        message += "Models: ";
+        passed = false;
+        for(;;) {
+            try {
+                char* arguments[] = { (char*)"ModelArenaTest", NULL };
+                char* heapArguments[] = { (char*)"ModelArenaTest", (char*)"--UseModelArena=false", NULL };
+                ModelArenaTestModel* first = new ModelArenaTestModel(arguments);
+                ModelArenaTestModel* second = new ModelArenaTestModel(arguments);
+                ModelArenaTestModel* heap = new ModelArenaTestModel(heapArguments);
+                size_t firstUsed = first->ModelMemory->UsedBytes();
+                size_t secondUsed = second->ModelMemory->UsedBytes();
+                // Allocations go to the current model's arena.
+                Identifier* fromFirst;
+                Identifier* fromSecond;
+                {
+                    CurrentModelScope scope(*first);
+                    fromFirst = new Identifier("First");
+                }
+                {
+                    CurrentModelScope scope(*second);
+                    fromSecond = new Identifier("Second");
+                }
+                bool isSeparate = first->ModelMemory->UsedBytes() > firstUsed
+                    && second->ModelMemory->UsedBytes() > secondUsed;
+                // Deleting uses the arena the object came from, whichever model is current.
+                firstUsed = first->ModelMemory->UsedBytes();
+                {
+                    CurrentModelScope scope(*second);
+                    delete fromFirst;
+                }
+                {
+                    CurrentModelScope scope(*heap);
+                    delete fromSecond;
+                    void* memory = ModelArena::New(64);
+                    ModelArena::Delete(memory);
+                }
+                bool isOwned = first->ModelMemory->UsedBytes() == firstUsed;
+                bool isHeap = !heap->ModelMemory->IsActive && heap->ModelMemory->UsedBytes() == 0;
+                // Deleting a model releases its arena without touching the others'.
+                delete second;
+                {
+                    CurrentModelScope scope(*first);
+                    fromFirst = new Identifier("First");
+                    delete fromFirst;
+                }
+                delete first;
+                delete heap;
+
+                if (!isSeparate || !isOwned) {
+                    message += "An arena for each model: Failed.";
+                    break;
+                }
+                if (!isHeap) {
+                    message += "Models without an arena: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+        return failureCount;
+    }
+}
@@ -0,0 +1,552 @@
+#include "PlatoIncludes.h"
+#include "PlatoStandard.h"
+#include "AnalogueDIDs.h"
+
+#include "ModelTest.h"
+
+namespace Plato {
+
+    /// <summary>
+    /// A public region.
+    /// </summary>
+    class ModelTestRegion : public Region {
+    public:
+        ModelTestRegion(Container* parent, Identifier& name) : Region(parent, name, PropertyScopes::Public) {
+        }
+    };
+
+    /// <summary>
+    /// A model of regions, each holding a layer of OrDIDs read by a layer of AndDIDs and a Connector between them.
+    /// </summary>
+    /// <remarks>
+    /// Every name is fixed, so that two instances built in turn have the same property tree.
+    /// With crossRegions, each region but the last also has a Connector from its In layer, named by
+    /// an absolute path, to the Out layer of the next region, reached through its parent.
+    /// </remarks>
+    class ModelTestModel : public Model {
+    public:
+        static const int NumberOfRegions = 8;
+        static const int Width = 6;
+        OutputPad* Source;
+        /// <summary>
+        /// The outputs of the AndDIDs, in the order they were built.
+        /// </summary>
+        vector<OutputPad*> Outputs;
+        /// <summary>
+        /// Every output pad of the model, the Source first.
+        /// </summary>
+        vector<OutputPad*> Pads;
+        ModelTestModel(char* arguments[], bool crossRegions = false);
+        /// <summary>
+        /// Builds a name from a prefix and a number.
+        /// </summary>
+        static Identifier& Name(const char* prefix, int index);
+        /// <summary>
+        /// Describes the property tree below a container, one line per property,
+        /// with the sources of each input pad given by their ascending positions in the description.
+        /// </summary>
+        void Describe(Container& container, int depth, string& description, FlatHashMap<const Property*, int, PropertyAddressTraits>& ordinals);
+        /// <summary>
+        /// Describes the whole model, including its connections.
+        /// </summary>
+        string& Describe();
+        /// <summary>
+        /// Runs the given number of epochs, appending the value of every pad after each one.
+        /// </summary>
+        void Run(int epochs, vector<float>& outputs);
+    };
+
+    ModelTestModel::ModelTestModel(char* arguments[], bool crossRegions)
+        : Model("ModelTest", arguments) {
+        Source = new OutputPad(this, *this, *new Identifier("Source"), PropertyScopes::Public);
+        Add(*Source);
+        Pads.push_back(Source);
+        for (int r = 0; r < NumberOfRegions; ++r) {
+            Region* region = new ModelTestRegion(this, Name("r", r));
+            Add(*region);
+            Region* in = new ModelTestRegion(region, *new Identifier("In"));
+            region->Add(*in);
+            Region* out = new ModelTestRegion(region, *new Identifier("Out"));
+            region->Add(*out);
+            // Resolved by Configure in every region at once when there are configure threads.
+            Connector* connector = new Connector(*new Path(NULL, *Path::Relative / "Out" / "d.*" / "i"),
+                *new Path(NULL, *Path::Relative / "In" / "s.*" / "o"), ConnectorPatterns::FanIn);
+            connector->Identity->SetName(*new string("c"));
+            region->Add(*connector);
+            if (crossRegions && r + 1 < NumberOfRegions) {
+                // Adds to the pads of a region that another configure task is connecting.
+                Connector* cross = new Connector(*new Path(NULL, *Path::Relative / ".." / Name("r", r + 1) / "Out" / "d.*" / "i"),
+                    *new Path(NULL, *Path::Absolute / Name("r", r) / "In" / "s.*" / "o"), ConnectorPatterns::FanIn);
+                cross->Identity->SetName(*new string("x"));
+                region->Add(*cross);
+            }
+            vector<OutputPad*> sources;
+            for (int k = 0; k < Width; ++k) {
+                OrDID* s = new OrDID(in, in, Name("s", k));
+                in->Add(*(Container*)s);
+                InputPad* input = new InputPad(s, *s, *new Identifier("i"), PropertyScopes::Public);
+                s->Add(*input);
+                input->Add(*Source, *connector);
+                OutputPad* output = new OutputPad(s, *s, *new Identifier("o"), PropertyScopes::Public);
+                s->Add(*output);
+                sources.push_back(output);
+                Pads.push_back(output);
+            }
+            for (int k = 0; k < Width; ++k) {
+                AndDID* d = new AndDID(out, out, Name("d", k));
+                out->Add(*(Container*)d);
+                InputPad* input = new InputPad(d, *d, *new Identifier("i"), PropertyScopes::Public);
+                d->Add(*input);
+                for (int from = 0; from <= (k + r) % Width; ++from) {
+                    input->Add(*sources[from], *connector);
+                }
+                OutputPad* output = new OutputPad(d, *d, *new Identifier("o"), PropertyScopes::Public);
+                d->Add(*output);
+                Outputs.push_back(output);
+                Pads.push_back(output);
+            }
+        }
+    }
+
+    Identifier& ModelTestModel::Name(const char* prefix, int index) {
+        string& name = Numbers::ToString(index);
+        name.insert(0, prefix);
+        return *new Identifier(name);
+    }
+
+    void ModelTestModel::Describe(Container& container, int depth, string& description, FlatHashMap<const Property*, int, PropertyAddressTraits>& ordinals) {
+        vector<Property*>* properties = container.GetOrderedProperties();
+        vector<Property*>::iterator itr;
+        for (itr = properties->begin(); itr != properties->end(); ++itr) {
+            Property* p = (*itr)->GetValue();
+            string& name = p->Identity->StatusReport();
+            description.append(depth, ' ');
+            description += *p->GetClassTypeInfo()->ClassName + " " + name;
+            delete &name;
+            ordinals[p] = (int)ordinals.size();
+            if (p->GetClassTypeInfo() == InputPad::TypeInfo) {
+                // Sorted, since connectors configured in parallel may add to a pad in either order.
+                vector<int> sources;
+                vector<InputConnection*>::iterator citr;
+                for (citr = ((InputPad*)p)->InputConnections->begin(); citr != ((InputPad*)p)->InputConnections->end(); ++citr) {
+                    // The sources precede their readers, since every In region precedes its Out region.
+                    FlatHashMap<const Property*, int, PropertyAddressTraits>::iterator found = ordinals.find((*citr)->SourceOutputPad);
+                    sources.push_back(found == ordinals.end() ? -1 : found->second);
+                }
+                sort(sources.begin(), sources.end());
+                vector<int>::iterator sitr;
+                for (sitr = sources.begin(); sitr != sources.end(); ++sitr) {
+                    string& ordinal = Numbers::ToString(*sitr);
+                    description += " <" + ordinal;
+                    delete &ordinal;
+                }
+            }
+            description += "\n";
+            if (p->Flags.IsContainer) {
+                Describe(*(Container*)p, depth + 1, description, ordinals);
+            }
+        }
+    }
+
+    string& ModelTestModel::Describe() {
+        string& description = *new string();
+        FlatHashMap<const Property*, int, PropertyAddressTraits> ordinals;
+        Describe(*this, 0, description, ordinals);
+        return description;
+    }
+
+    void ModelTestModel::Run(int epochs, vector<float>& outputs) {
+        for (int epoch = 0; epoch < epochs; ++epoch) {
+            Model::Run(1);
+            vector<OutputPad*>::iterator itr;
+            for (itr = Pads.begin(); itr != Pads.end(); ++itr) {
+                outputs.push_back(ModelSignals->Next[(*itr)->SignalIndex]);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Builds, configures and runs a ModelTestModel, keeping its description and outputs.
+    /// </summary>
+    class ModelTestTask : public ThreadPool::Task {
+    public:
+        int Configured;
+        int Errors;
+        long Epochs;
+        string* Description;
+        vector<float> Outputs;
+        ModelTestTask() {
+            Configured = 0;
+            Errors = 0;
+            Epochs = 0;
+            Description = NULL;
+        }
+        virtual ~ModelTestTask() {
+            delete Description;
+        }
+        virtual void Execute() {
+            char* arguments[] = { (char*)"ModelTest", (char*)"--VectoriseDIDs=false", NULL };
+            ModelTestModel* model = new ModelTestModel(arguments);
+            Configured = model->Configure();
+            Errors = model->ModelErrorContext->Count();
+            Description = &model->Describe();
+            model->ModelSignals->Current[model->Source->SignalIndex] = 0.7f;
+            model->ModelSignals->Next[model->Source->SignalIndex] = 0.7f;
+            model->Run(3, Outputs);
+            Epochs = model->EpochTime;
+            delete model;
+        }
+    };
+
+    /// <summary>
+    /// Executes a ModelTestTask for a pool, which deletes the runner but not the task.
+    /// </summary>
+    class ModelTestTaskRunner : public ThreadPool::Task {
+    public:
+        ModelTestTaskRunner(ModelTestTask& task) : mTask(task) {
+        }
+        virtual void Execute() {
+            mTask.Execute();
+        }
+    private:
+        ModelTestTask& mTask;
+    };
+
+    /// <summary>
+    /// Connects a pad many times over, as connectors configuring different elements might.
+    /// </summary>
+    class ModelTestPadTask : public ThreadPool::Task {
+    public:
+        static const int Connections = 100000;
+        ModelTestPadTask(ModelTestModel& model, InputPad& input, Connector& connector)
+            : mModel(model), mInput(input), mConnector(connector) {
+        }
+        virtual void Execute() {
+            CurrentModelScope scope(mModel);
+            for (int index = 0; index < Connections; ++index) {
+                mInput.Add(*mModel.Source, mConnector);
+            }
+        }
+    private:
+        ModelTestModel& mModel;
+        InputPad& mInput;
+        Connector& mConnector;
+    };
+
+    int ModelTest::ConductUnitTest(string& message) {
+        message = "";
+        int failureCount = 0;
+        bool passed = false;
+
+#pragma region // Test of Configuration::ConfigureThreads.
+        message += "ConfigureThreads: ";
+        for(;;) {
+            try {
+                // The AnalogueKernel is compiled after the threads have gone, and has a generated name, so leave it out.
+                char* serial[] = { (char*)"ModelTest", (char*)"--VectoriseDIDs=false", NULL };
+                char* parallel[] = { (char*)"ModelTest", (char*)"--VectoriseDIDs=false", (char*)"--ConfigureThreads=4", NULL };
+                char** arguments[] = { serial, parallel };
+                string* descriptions[2];
+                vector<float> outputs[2];
+                int configured = 0;
+                int errors = 0;
+                for (int run = 0; run < 2; ++run) {
+                    ModelTestModel* model = new ModelTestModel(arguments[run]);
+                    configured |= model->Configure();
+                    errors += model->ModelErrorContext->Count();
+                    descriptions[run] = &model->Describe();
+                    model->ModelSignals->Current[model->Source->SignalIndex] = 0.7f;
+                    model->ModelSignals->Next[model->Source->SignalIndex] = 0.7f;
+                    model->Run(3, outputs[run]);
+                    delete model;
+                }
+                bool isSameTree = *descriptions[0] == *descriptions[1] && !descriptions[0]->empty();
+                delete descriptions[0];
+                delete descriptions[1];
+
+                if (configured != 0 || errors != 0) {
+                    message += "Configuring with and without threads: Failed.";
+                    break;
+                }
+                if (!isSameTree) {
+                    message += "Same properties and connections: Failed.";
+                    break;
+                }
+                if (outputs[1] != outputs[0] || outputs[0].empty()) {
+                    message += "Same outputs: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of Configuration::ConfigureThreads with connectors between regions.
+        message += "Cross-region connectors: ";
+        passed = false;
+        for(;;) {
+            try {
+                char* serial[] = { (char*)"ModelTest", (char*)"--VectoriseDIDs=false", NULL };
+                char* parallel[] = { (char*)"ModelTest", (char*)"--VectoriseDIDs=false", (char*)"--ConfigureThreads=4", NULL };
+                char** arguments[] = { serial, parallel, serial };
+                bool crossRegions[] = { true, true, false };
+                string* descriptions[3];
+                vector<float> outputs[3];
+                int configured = 0;
+                int errors = 0;
+                for (int run = 0; run < 3; ++run) {
+                    ModelTestModel* model = new ModelTestModel(arguments[run], crossRegions[run]);
+                    configured |= model->Configure();
+                    errors += model->ModelErrorContext->Count();
+                    descriptions[run] = &model->Describe();
+                    model->ModelSignals->Current[model->Source->SignalIndex] = 0.7f;
+                    model->ModelSignals->Next[model->Source->SignalIndex] = 0.7f;
+                    model->Run(3, outputs[run]);
+                    delete model;
+                }
+                bool isSameTree = *descriptions[0] == *descriptions[1] && *descriptions[0] != *descriptions[2];
+                for (int run = 0; run < 3; ++run) {
+                    delete descriptions[run];
+                }
+
+                // The cross connectors' paths, as resolved from the first region.
+                ModelTestModel* model = new ModelTestModel(serial, true);
+                Container* first = (Container*)model->GetProperty(ModelTestModel::Name("r", 0));
+                Path* paths[] = { new Path(NULL, *Path::Relative / ".." / ModelTestModel::Name("r", 1) / "Out" / "d.*" / "i"),
+                    new Path(NULL, *Path::Absolute / ModelTestModel::Name("r", 0) / "In" / "s.*" / "o") };
+                bool isCrossPath = true;
+                for (int index = 0; index < 2; ++index) {
+                    int found = 0;
+                    PathEnumerator enumerator(*paths[index], first, NULL, PropertyModes::Traversing, false, NULL);
+                    while (enumerator.MoveNext()) {
+                        ++found;
+                    }
+                    isCrossPath &= found == ModelTestModel::Width;
+                    delete paths[index];
+                }
+
+                // Tasks connecting one pad at once, with the lock the configure threads use.
+                InputPad* shared = (InputPad*)model->Outputs[ModelTestModel::Width]->Parent->GetProperty(*new Identifier("i"));
+                Connector* connector = (Connector*)first->GetProperty(*new Identifier("x"));
+                int before = shared->GetInputCount();
+                const int count = 4;
+                model->ConfigureMutex = new Mutex();
+                ThreadLocalVariable::Key key = ThreadLocalVariable::GetKey();
+                ThreadPool* pool = new ThreadPool(count, key, NULL);
+                ThreadPool::TaskGroup group;
+                for (int index = 0; index < count; ++index) {
+                    pool->Submit(*new ModelTestPadTask(*model, *shared, *connector), group);
+                }
+                int failures = pool->Wait(group);
+                delete pool;
+                ThreadLocalVariable::FreeKey(key);
+                delete model->ConfigureMutex;
+                model->ConfigureMutex = NULL;
+                bool isEveryConnection = failures == 0 && shared->GetInputCount() - before == count * ModelTestPadTask::Connections;
+                delete model;
+
+                if (configured != 0 || errors != 0) {
+                    message += "Configuring with and without threads: Failed.";
+                    break;
+                }
+                if (!isCrossPath) {
+                    message += "Paths to the next region: Failed.";
+                    break;
+                }
+                if (!isSameTree) {
+                    message += "Same properties and connections: Failed.";
+                    break;
+                }
+                if (outputs[1] != outputs[0] || outputs[0].empty()) {
+                    message += "Same outputs: Failed.";
+                    break;
+                }
+                if (!isEveryConnection) {
+                    message += "Connecting a pad on several threads: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of Configuration::UpdateThreads.
+        message += "UpdateThreads: ";
+        passed = false;
+        for(;;) {
+            try {
+                // Model::Update and the AnalogueKernel each share the epoch between the update threads.
+                const char* incremental[] = { "--IncrementalUpdates=false", "--IncrementalUpdates=true" };
+                const char* vectorise[] = { "--VectoriseDIDs=false", "--VectoriseDIDs=true" };
+                const char* threads[] = { "--UpdateThreads=1", "--UpdateThreads=4" };
+                const float sources[] = { 0.7f, 0.7f, 0.2f, 0.9f, 0.9f, 0.4f };
+                const int epochs = sizeof(sources) / sizeof(sources[0]);
+                bool isSame = true;
+                bool isComplete = true;
+                int errors = 0;
+                for (int combination = 0; combination < 4; ++combination) {
+                    vector<float> outputs[2];
+                    for (int run = 0; run < 2; ++run) {
+                        char* arguments[] = { (char*)"ModelTest", (char*)incremental[combination / 2],
+                            (char*)vectorise[combination % 2], (char*)threads[run], NULL };
+                        ModelTestModel* model = new ModelTestModel(arguments);
+                        errors += model->Configure();
+                        for (int epoch = 0; epoch < epochs; ++epoch) {
+                            model->ModelSignals->Current[model->Source->SignalIndex] = sources[epoch];
+                            model->ModelSignals->Next[model->Source->SignalIndex] = sources[epoch];
+                            model->Run(1, outputs[run]);
+                        }
+                        errors += model->ModelErrorContext->Count();
+                        isComplete &= model->EpochTime == epochs
+                            && outputs[run].size() == epochs * model->Pads.size();
+                        delete model;
+                    }
+                    isSame &= outputs[1] == outputs[0];
+                }
+
+                if (errors != 0 || !isComplete) {
+                    message += "Running with and without threads: Failed.";
+                    break;
+                }
+                if (!isSame) {
+                    message += "Same outputs: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of regex paths through Regions.
+        message += "Region regex paths: ";
+        passed = false;
+        for(;;) {
+            try {
+                // Regions have no Property category, so their regex lookups search every element.
+                char* arguments[] = { (char*)"ModelTest", (char*)"--VectoriseDIDs=false", NULL };
+                ModelTestModel* model = new ModelTestModel(arguments);
+                Container* region = (Container*)model->GetProperty(ModelTestModel::Name("r", 0));
+                Path* paths[] = { new Path(NULL, *Path::Relative / "Out" / "d.*" / "o"),
+                    new Path(NULL, *Path::Relative / "In" / "s.*" / "[io]"),
+                    new Path(NULL, *Path::Relative / ".*" / "s[0-2]" / "o") };
+                const int expected[] = { ModelTestModel::Width, 2 * ModelTestModel::Width, 3 };
+                bool isFound = true;
+                for (int index = 0; index < 3; ++index) {
+                    int found = 0;
+                    PathEnumerator enumerator(*paths[index], region, NULL, PropertyModes::Traversing, false, NULL);
+                    while (enumerator.MoveNext()) {
+                        found += enumerator.Current->Flags.IsInputPad || enumerator.Current->Flags.IsOutputPad ? 1 : 0;
+                    }
+                    isFound &= found == expected[index];
+                    delete paths[index];
+                }
+                delete model;
+
+                if (!isFound) {
+                    message += "Matching pads below a Region: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of models built and run concurrently on separate threads.
+        message += "Concurrent models: ";
+        passed = false;
+        for(;;) {
+            try {
+                ModelTestTask serial;
+                serial.Execute();
+                const int count = 4;
+                ModelTestTask* tasks[count];
+                ThreadLocalVariable::Key key = ThreadLocalVariable::GetKey();
+                ThreadPool* pool = new ThreadPool(count, key, NULL);
+                ThreadPool::TaskGroup group;
+                for (int index = 0; index < count; ++index) {
+                    tasks[index] = new ModelTestTask();
+                }
+                for (int index = 0; index < count; ++index) {
+                    pool->Submit(*new ModelTestTaskRunner(*tasks[index]), group);
+                }
+                int failures = pool->Wait(group);
+                delete pool;
+                ThreadLocalVariable::FreeKey(key);
+                bool isSame = serial.Configured == 0 && serial.Errors == 0 && serial.Epochs == 3;
+                for (int index = 0; index < count; ++index) {
+                    isSame &= tasks[index]->Configured == 0 && tasks[index]->Errors == 0
+                        && tasks[index]->Description != NULL && *tasks[index]->Description == *serial.Description
+                        && tasks[index]->Outputs == serial.Outputs;
+                    delete tasks[index];
+                }
+
+                if (failures != 0) {
+                    message += "Running on each thread: Failed.";
+                    break;
+                }
+                if (!isSame) {
+                    message += "Same properties, connections and outputs as a serial run: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of running a model after Ctrl-C.
+        message += "Interrupt: ";
+        passed = false;
+        for(;;) {
+            try {
+                // The models' handler counts the interrupt, which only stops the runs in progress.
+                raise(SIGINT);
+                ModelTestTask task;
+                task.Execute();
+
+                if (task.Epochs != 3) {
+                    message += "Running after an interrupt: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+        return failureCount;
+    }
+}
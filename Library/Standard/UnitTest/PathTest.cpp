@@ -135,8 +135,54 @@ namespace Plato {
                 break;
             }
             delete props;
+
+            // Test Any paths in width-first order, reusing the enumerator.
+            props = new string("(");
+            try {
+                Path* p = new Path(NULL,*Path::Relative / Path::Any / "b2.");
+                PathEnumerator* pie = new PathEnumerator(*p,d,NULL,PropertyModes::Traversing,true,NULL);
+                for (int pass=0;pass<2;pass++) {
+                    pie->Reset();
+                    *props = "(";
+                    while (pie->MoveNext()) {
+                        Property* a = pie->Current;
+                        *props += " " + *(a->Identity->Name);
+                    }
+                    *props +=")";
+                }
+                delete pie;
+                delete p;
+                if (props->compare(testAnyResult)!=0) {
+                    message +="Path Any width-first results differ: "+testAnyResult+" and "+*props+": Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Path any width-first: Failed.";
+                break;
+            }
+            delete props;
             delete &testAnyResult;
 
+            // Test that repeated resolutions see changes to the containers passed through.
+            try {
+                Path* p = new Path(NULL,*Path::Relative / "a2");
+                Property* a2 = d->GetProperty(*p->GetTailIdentity());
+                bool isResolved = p->GetProperty(d,NULL,PropertyModes::Traversing)==a2
+                    && p->GetProperty(d,NULL,PropertyModes::Traversing)==a2;
+                d->Remove(*a2->Identity);
+                bool isRemoved = p->GetProperty(d,NULL,PropertyModes::Traversing)!=a2;
+                d->Add(*a2);
+                bool isReadded = p->GetProperty(d,NULL,PropertyModes::Traversing)==a2;
+                delete p;
+                if (!isResolved || !isRemoved || !isReadded) {
+                    message += "Path resolution after container changes: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Path resolution: Failed.";
+                break;
+            }
+
             // Test of filters.
             // TO DO.
 
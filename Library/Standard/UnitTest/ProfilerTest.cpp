@@ -0,0 +1,181 @@
+#include "PlatoIncludes.h"
+#include "PlatoStandard.h"
+#include "AnalogueDIDs.h"
+
+#include "ProfilerTest.h"
+
+namespace Plato {
+
+    /// <summary>
+    /// A public region.
+    /// </summary>
+    class ProfilerTestRegion : public Region {
+    public:
+        ProfilerTestRegion(Container* parent, Identifier& name) : Region(parent, name, PropertyScopes::Public) {
+        }
+    };
+
+    /// <summary>
+    /// An OrDID that allocates a model object each time it is updated.
+    /// </summary>
+    class ProfilerTestDID : public OrDID {
+    public:
+        ProfilerTestDID(Container* parent, Identifier& name) : OrDID(parent, parent, name) {
+        }
+        virtual void Update() {
+            OrDID::Update();
+            ModelArena::Delete(ModelArena::New(sizeof(float)));
+        }
+    };
+
+    /// <summary>
+    /// A model of a region holding a layer of ProfilerTestDIDs read by a layer of AndDIDs.
+    /// </summary>
+    class ProfilerTestModel : public Model {
+    public:
+        static const int Width = 5;
+        static const int Dispositions = 2 * Width;
+        OutputPad* Source;
+        ProfilerTestModel(char* arguments[]);
+    };
+
+    ProfilerTestModel::ProfilerTestModel(char* arguments[])
+        : Model("ProfilerTest", arguments) {
+        Source = new OutputPad(this, *this, *new Identifier("Source"), PropertyScopes::Public);
+        Add(*Source);
+        Region* region = new ProfilerTestRegion(this, *new Identifier("r"));
+        Add(*region);
+        Connector* connector = new Connector(*new Path(NULL, *Path::Relative / "d.*" / "i"),
+            *new Path(NULL, *Path::Relative / "s.*" / "o"), ConnectorPatterns::FanIn);
+        region->Add(*connector);
+        vector<OutputPad*> sources;
+        for (int k = 0; k < Width; ++k) {
+            string& name = Numbers::ToString(k);
+            OrDID* s = new ProfilerTestDID(region, *new Identifier(*new string("s" + name)));
+            region->Add(*(Container*)s);
+            InputPad* input = new InputPad(s, *s, *new Identifier("i"), PropertyScopes::Public);
+            s->Add(*input);
+            input->Add(*Source, *connector);
+            OutputPad* output = new OutputPad(s, *s, *new Identifier("o"), PropertyScopes::Public);
+            s->Add(*output);
+            sources.push_back(output);
+
+            AndDID* d = new AndDID(region, region, *new Identifier(*new string("d" + name)));
+            region->Add(*(Container*)d);
+            input = new InputPad(d, *d, *new Identifier("i"), PropertyScopes::Public);
+            d->Add(*input);
+            for (int from = 0; from < (int)sources.size(); ++from) {
+                input->Add(*sources[from], *connector);
+            }
+            output = new OutputPad(d, *d, *new Identifier("o"), PropertyScopes::Public);
+            d->Add(*output);
+            delete &name;
+        }
+    }
+
+    int ProfilerTest::ConductUnitTest(string& message) {
+        message = "";
+        int failureCount = 0;
+        bool passed = false;
+
+#pragma region // Test of the counts of a profiled run.
+        message += "Counts: ";
+        for(;;) {
+            try {
+                const string path = "ProfilerTest.json";
+                const int epochs = 5;
+                // The counts of the update threads are merged.
+                char* serial[] = { (char*)"ProfilerTest", (char*)"--VectoriseDIDs=false", (char*)"--ProfileUpdates=true",
+                    (char*)"--ProfilePath=ProfilerTest.json", NULL };
+                char* parallel[] = { (char*)"ProfilerTest", (char*)"--VectoriseDIDs=false", (char*)"--ProfileUpdates=true",
+                    (char*)"--ProfilePath=ProfilerTest.json", (char*)"--UpdateThreads=4", NULL };
+                char** arguments[] = { serial, parallel };
+                bool isRun = true;
+                bool isCounted = true;
+                bool isHistogram = true;
+                bool isAllocated = true;
+                bool isWritten = true;
+                for (int run = 0; run < 2; ++run) {
+                    remove(path.c_str());
+                    ProfilerTestModel* model = new ProfilerTestModel(arguments[run]);
+                    isRun &= model->Configure() == 0 && model->Run(epochs) == 0 && model->EpochTime == epochs;
+                    Profiler* profile = model->ModelProfile;
+                    if (profile == NULL) {
+                        isRun = false;
+                        delete model;
+                        break;
+                    }
+
+                    // Every Disposition is updated once an epoch, by the Region holding them.
+                    // The OrDIDs and AndDIDs are both counted as AnalogueDIDs, their class type.
+                    Profiler::TypeCounters dids;
+                    Profiler::TypeCounters regions;
+                    isCounted &= profile->GetCounters(*AnalogueDID::TypeInfo, dids) && profile->GetCounters(*Region::TypeInfo, regions)
+                        && dids.Updates == (uint64_t)(ProfilerTestModel::Dispositions * epochs)
+                        && regions.Updates == (uint64_t)epochs
+                        && dids.SelfTicks <= dids.Ticks && regions.SelfTicks <= regions.Ticks;
+
+                    uint64_t histogramCount = 0;
+                    for (int bucket = 0; bucket < Profiler::HistogramSize; ++bucket) {
+                        histogramCount += profile->GetHistogramCount(bucket);
+                    }
+                    isHistogram &= profile->GetEpochCount() == (uint64_t)epochs && histogramCount == (uint64_t)epochs;
+
+                    // Each ProfilerTestDID allocates once an update, which also counts against the Region.
+                    isAllocated &= dids.Allocations == (uint64_t)(ProfilerTestModel::Width * epochs)
+                        && regions.Allocations == dids.Allocations;
+                    delete model;
+
+                    // Run writes the profile once it has finished.
+                    ifstream file(path.c_str());
+                    string json;
+                    char c;
+                    while (file.get(c)) {
+                        json += c;
+                    }
+                    file.close();
+                    size_t line = json.find("{\"class\": \"AnalogueDID\"");
+                    string didLine = line == string::npos ? string() : json.substr(line, json.find('\n', line) - line);
+                    string& updates = Strings::Format("\"updates\": %d,", ProfilerTestModel::Dispositions * epochs);
+                    string& count = Strings::Format("\"epochs\": %d,", epochs);
+                    isWritten &= json.size() > 2 && json[0] == '{' && json[json.size() - 2] == '}'
+                        && didLine.find(updates) != string::npos && json.find(count) != string::npos
+                        && json.find("\"epochHistogram\": [") != string::npos;
+                    delete &updates;
+                    delete &count;
+                }
+                remove(path.c_str());
+
+                if (!isRun) {
+                    message += "Running with ProfileUpdates: Failed.";
+                    break;
+                }
+                if (!isCounted) {
+                    message += "Updates of each Disposition class: Failed.";
+                    break;
+                }
+                if (!isHistogram) {
+                    message += "Epoch histogram total: Failed.";
+                    break;
+                }
+                if (!isAllocated) {
+                    message += "Allocations while updating: Failed.";
+                    break;
+                }
+                if (!isWritten) {
+                    message += "Writing the profile in JSON: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+        return failureCount;
+    }
+}
@@ -0,0 +1,169 @@
+#include "PlatoIncludes.h"
+#include "PlatoStandard.h"
+
+#include "ProximityRelatorTest.h"
+
+namespace Plato {
+
+    /// <summary>
+    /// A model holding aliases named a0 to a19 and b0 to b9.
+    /// </summary>
+    class ProximityRelatorTestModel : public Model {
+    public:
+        ProximityRelatorTestModel(char* arguments[]);
+    };
+
+    ProximityRelatorTestModel::ProximityRelatorTestModel(char* arguments[])
+        : Model("ProximityRelatorTest", arguments) {
+        char name[8];
+        for (int index = 0; index < 30; ++index) {
+            sprintf(name, index < 20 ? "a%d" : "b%d", index < 20 ? index : index - 20);
+            Add(*new Alias(this,(Container*)NULL,*new Identifier(name),PropertyScopes::Public));
+        }
+    }
+
+    /// <summary>
+    /// A relator between two patterns that only holds for elements whose names end in different digits.
+    /// </summary>
+    class ProximityRelatorTestRelator : public ProximityRelator {
+    public:
+        ProximityRelatorTestRelator(const char* first, const char* second, bool isSymmetric)
+            : ProximityRelator(new vector<IdentifierRegex*>()) {
+            Patterns->push_back(new IdentifierRegex(new string(first)));
+            Patterns->push_back(new IdentifierRegex(new string(second)));
+            IsSymmetric = isSymmetric;
+        }
+        virtual bool ValidRelation(vector<Property*>& elements) {
+            const string& first = *elements[0]->Identity->Name;
+            const string& second = *elements[1]->Identity->Name;
+            return first[first.size() - 1] != second[second.size() - 1];
+        }
+    };
+
+    /// <summary>
+    /// Collects the tuples passed on by EnumerateMatches.
+    /// </summary>
+    class ProximityRelatorTestReceiver : public ProximityRelator::TupleReceiver {
+    public:
+        vector<vector<Property*> > Tuples;
+        virtual bool Receive(vector<Property*>& elements) {
+            Tuples.push_back(elements);
+            return true;
+        }
+    };
+
+    /// <summary>
+    /// Copies and deletes the tuples returned by FindMatches.
+    /// </summary>
+    static void ProximityRelatorTestTake(vector<vector<Property*>*>* found, vector<vector<Property*> >& tuples) {
+        tuples.clear();
+        vector<vector<Property*>*>::iterator itr;
+        for (itr = found->begin(); itr != found->end(); ++itr) {
+            tuples.push_back(**itr);
+            delete *itr;
+        }
+        delete found;
+    }
+
+    /// <summary>
+    /// Counts the tuples the relator should find, by testing every ordered pair of distinct elements.
+    /// Symmetric relators count each unordered pair once.
+    /// </summary>
+    static size_t ProximityRelatorTestCount(ProximityRelator& relator, vector<Property*>& elements) {
+        size_t count = 0;
+        vector<Property*> tuple(2);
+        for (size_t i = 0; i < elements.size(); ++i) {
+            for (size_t j = relator.IsSymmetric ? i + 1 : 0; j < elements.size(); ++j) {
+                if (i == j) {
+                    continue;
+                }
+                tuple[0] = elements[i];
+                tuple[1] = elements[j];
+                bool isMatch = relator.MatchAndValidRelation(tuple);
+                if (!isMatch && relator.IsSymmetric) {
+                    tuple[0] = elements[j];
+                    tuple[1] = elements[i];
+                    isMatch = relator.MatchAndValidRelation(tuple);
+                }
+                count += isMatch ? 1 : 0;
+            }
+        }
+        return count;
+    }
+
+    /// <summary>
+    /// Returns true if no two tuples hold the same elements, in any order.
+    /// </summary>
+    static bool ProximityRelatorTestIsUnique(vector<vector<Property*> >& tuples) {
+        vector<vector<Property*> > sorted(tuples);
+        vector<vector<Property*> >::iterator itr;
+        for (itr = sorted.begin(); itr != sorted.end(); ++itr) {
+            sort(itr->begin(), itr->end());
+        }
+        sort(sorted.begin(), sorted.end());
+        return adjacent_find(sorted.begin(), sorted.end()) == sorted.end();
+    }
+
+    int ProximityRelatorTest::ConductUnitTest(string& message) {
+        message = "";
+        int failureCount = 0;
+        bool passed = false;
+        ThreadLocalVariable::Key key = ThreadLocalVariable::GetKey();
+
+#pragma region // Test of FindMatches on a thread pool against a serial search.
+        message += "FindMatches: ";
+        for(;;) {
+            try {
+                char* arguments[] = { (char*)"ProximityRelatorTest", NULL };
+                ProximityRelatorTestModel* container = new ProximityRelatorTestModel(arguments);
+                vector<Property*>* elements = container->GetOrderedProperties();
+                ThreadPool* pool = new ThreadPool(4, key, NULL);
+                // The second pattern's candidates are a subset of the first's, so under symmetry the pool's
+                // chunks find some pairs twice, once from each end.
+                ProximityRelatorTestRelator* relators[] = {
+                    new ProximityRelatorTestRelator("a.*", "b.*", false),
+                    new ProximityRelatorTestRelator("a.*", "a1.*", false),
+                    new ProximityRelatorTestRelator("a.*", "a1.*", true),
+                    new ProximityRelatorTestRelator("a.*", "a.*", true)
+                };
+                bool isSame = true;
+                bool isUnique = true;
+                bool isComplete = true;
+                for (int index = 0; index < 4; ++index) {
+                    ProximityRelator& relator = *relators[index];
+                    vector<vector<Property*> > serial;
+                    vector<vector<Property*> > pooled;
+                    ProximityRelatorTestTake(relator.FindMatches(*container), serial);
+                    ProximityRelatorTestTake(relator.FindMatches(*container, pool), pooled);
+                    ProximityRelatorTestReceiver receiver;
+                    relator.EnumerateMatches(*container, receiver);
+                    isSame &= serial == pooled && serial == receiver.Tuples;
+                    isUnique &= !relator.IsSymmetric || ProximityRelatorTestIsUnique(pooled);
+                    isComplete &= pooled.size() == ProximityRelatorTestCount(relator, *elements) && !pooled.empty();
+                    delete relators[index];
+                }
+                delete pool;
+                delete container;
+
+                if (!isSame) {
+                    message += "Pooled tuples match serial tuples in order: Failed.";
+                    break;
+                }
+                if (!isUnique || !isComplete) {
+                    message += "Every valid tuple found once: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+        ThreadLocalVariable::FreeKey(key);
+        return failureCount;
+    }
+}
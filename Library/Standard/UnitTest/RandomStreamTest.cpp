@@ -0,0 +1,266 @@
+#include "PlatoIncludes.h"
+#include "PlatoStandard.h"
+
+#include "RandomStreamTest.h"
+
+namespace Plato {
+
+    /// <summary>
+    /// A model holding aliases named a and b, to own random distributions.
+    /// </summary>
+    class RandomStreamTestModel : public Model {
+    public:
+        Property* A;
+        Property* B;
+        RandomStreamTestModel(char* arguments[]);
+    };
+
+    RandomStreamTestModel::RandomStreamTestModel(char* arguments[])
+        : Model("RandomStreamTest", arguments) {
+        A = new Alias(this,(Container*)NULL,*new Identifier("a"),PropertyScopes::Public);
+        Add(*A);
+        B = new Alias(this,(Container*)NULL,*new Identifier("b"),PropertyScopes::Public);
+        Add(*B);
+    }
+
+    /// <summary>
+    /// Compares a bulk fill of a stream with drawing the same values one at a time.
+    /// </summary>
+    /// <param name="position">The position to seek to before drawing.</param>
+    /// <param name="skip">The number of values drawn one at a time before the fill, to part fill the buffered block.</param>
+    /// <param name="count">The number of values to fill.</param>
+    /// <returns>Returns true if the values, and the positions after drawing them, match.</returns>
+    static bool RandomStreamTestCompare(uint64_t position, int skip, int count) {
+        RandomStream bulk(7, 11, 13);
+        RandomStream scalar(7, 11, 13);
+        bulk.Seek(position);
+        scalar.Seek(position);
+        for (int index = 0; index < skip; ++index) {
+            bulk.NextUInt();
+            scalar.NextUInt();
+        }
+        vector<float> floats(count + 1);
+        vector<uint32_t> integers(count + 1);
+        bulk.Fill(&floats[0], count);
+        bulk.Seek(position + skip);
+        bulk.Fill(&integers[0], count);
+        bool isSame = bulk.GetPosition() == position + skip + count;
+        for (int index = 0; index < count; ++index) {
+            isSame &= floats[index] == scalar.NextFloat();
+        }
+        scalar.Seek(position + skip);
+        for (int index = 0; index < count; ++index) {
+            isSame &= integers[index] == scalar.NextUInt();
+        }
+        // Both streams carry on from the same place.
+        return isSame && bulk.NextUInt() == scalar.NextUInt();
+    }
+
+    int RandomStreamTest::ConductUnitTest(string& message) {
+        message = "";
+        int failureCount = 0;
+        bool passed = false;
+
+#pragma region // Test of RandomStream::Generate.
+        message += "Philox4x32-10: ";
+        for(;;) {
+            try {
+                // The known answers published with the Random123 library.
+                const uint32_t keys[3][2] = {
+                    { 0x00000000, 0x00000000 },
+                    { 0xffffffff, 0xffffffff },
+                    { 0xa4093822, 0x299f31d0 } };
+                const uint32_t counters[3][4] = {
+                    { 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+                    { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff },
+                    { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 } };
+                const uint32_t answers[3][4] = {
+                    { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 },
+                    { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd },
+                    { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } };
+                int mismatches = 0;
+                for (int test = 0; test < 3; ++test) {
+                    uint32_t result[RandomStream::BlockSize];
+                    RandomStream::Generate(keys[test], counters[test], result);
+                    for (int index = 0; index < RandomStream::BlockSize; ++index) {
+                        mismatches += result[index] == answers[test][index] ? 0 : 1;
+                    }
+                }
+
+                if (mismatches != 0) {
+                    message += "Known answers: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of RandomStream::Fill against NextFloat and NextUInt.
+        message += "Fill: ";
+        passed = false;
+        for(;;) {
+            try {
+                const int counts[] = { 0, 1, 2, 3, 4, 5, 7, 8, 15, 16, 17, 31, 63, 64, 65, 127, 1000, 4099 };
+                const int numberOfCounts = sizeof(counts) / sizeof(counts[0]);
+                bool isSame = true;
+                for (int c = 0; c < numberOfCounts; ++c) {
+                    for (int skip = 0; skip < RandomStream::BlockSize; ++skip) {
+                        isSame &= RandomStreamTestCompare(0, skip, counts[c]);
+                        isSame &= RandomStreamTestCompare(4097, skip, counts[c]);
+                    }
+                }
+                // Runs across the carry from the low to the high block counter word,
+                // which the four block groups of the bulk fill must not straddle.
+                uint64_t carry = (uint64_t)0xFFFFFFFF * RandomStream::BlockSize;
+                bool isCarried = true;
+                for (uint64_t offset = 1; offset <= 13; offset += 3) {
+                    isCarried &= RandomStreamTestCompare(carry - offset * RandomStream::BlockSize, 0, 100);
+                    isCarried &= RandomStreamTestCompare(carry - offset, 1, 100);
+                }
+
+                if (!isSame) {
+                    message += "Bulk values match scalar values: Failed.";
+                    break;
+                }
+                if (!isCarried) {
+                    message += "Bulk values across the counter carry: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of RandomStream keys and epochs.
+        message += "Streams: ";
+        passed = false;
+        for(;;) {
+            try {
+                RandomStream first(1, 2, 3);
+                RandomStream seed(9, 2, 3);
+                RandomStream stream(1, 9, 3);
+                RandomStream epoch(1, 2, 9);
+                bool isDistinct = true;
+                vector<uint32_t> values(16);
+                first.Fill(&values[0], 16);
+                for (int index = 0; index < 16; ++index) {
+                    uint32_t value = values[index];
+                    isDistinct &= value != seed.NextUInt() && value != stream.NextUInt() && value != epoch.NextUInt();
+                }
+                // Setting the epoch restarts the stream in that epoch.
+                first.SetEpoch(9);
+                epoch.Seek(0);
+                bool isEpoch = first.NextUInt() == epoch.NextUInt() && first.GetPosition() == 1;
+                bool isRanged = true;
+                for (int index = 0; index < 1000; ++index) {
+                    float f = first.NextFloat();
+                    double d = first.NextDouble();
+                    int n = first.Next(7);
+                    isRanged &= f >= 0.0f && f < 1.0f && d >= 0.0 && d < 1.0 && n >= 0 && n < 7;
+                }
+
+                if (!isDistinct || !isEpoch) {
+                    message += "Seeds, stream numbers and epochs give different values: Failed.";
+                    break;
+                }
+                if (!isRanged) {
+                    message += "Value ranges: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of RandomDistribution and Model::CreateRandomStream.
+        message += "RandomDistribution: ";
+        passed = false;
+        for(;;) {
+            try {
+                char* arguments[] = { (char*)"RandomStreamTest", NULL };
+                RandomStreamTestModel* model = new RandomStreamTestModel(arguments);
+                const int capacity = 50;
+                RandomDistribution* a = new RandomDistribution(*model->A, capacity, capacity, capacity);
+                RandomDistribution* again = new RandomDistribution(*model->A, capacity, capacity, capacity);
+                RandomDistribution* b = new RandomDistribution(*model->B, capacity, capacity, capacity);
+                Distribution* copy = a->Clone();
+                UnivariateDistribution* ax = a->CreateUnivariateDistribution(CoordinateNames::X);
+                UnivariateDistribution* ay = a->CreateUnivariateDistribution(CoordinateNames::Y);
+                UnivariateDistribution* againX = again->CreateUnivariateDistribution(CoordinateNames::X);
+                UnivariateDistribution* copyX = copy->CreateUnivariateDistribution(CoordinateNames::X);
+                UnivariateDistribution* bx = b->CreateUnivariateDistribution(CoordinateNames::X);
+                // The X coordinate draws from the start of the owner's stream.
+                RandomStream* stream = model->CreateRandomStream(*model->A);
+                RandomUnivariateDistribution* expected = new RandomUnivariateDistribution(capacity, *stream);
+                bool isOrdered = true;
+                bool isSame = true;
+                int differentY = 0;
+                int differentB = 0;
+                float values[capacity];
+                int filled = ax->Fill(0, capacity, values);
+                for (int index = 0; index < capacity; ++index) {
+                    float value = (*ax)[index];
+                    isOrdered &= value >= 0.0f && value <= UnivariateDistribution::MaximumX
+                        && (index == 0 || value > (*ax)[index - 1]);
+                    isSame &= value == values[index] && value == (*againX)[index]
+                        && value == (*copyX)[index] && value == (*expected)[index];
+                    differentY += value != (*ay)[index] ? 1 : 0;
+                    differentB += value != (*bx)[index] ? 1 : 0;
+                }
+                delete expected;
+                delete stream;
+                delete bx;
+                delete copyX;
+                delete againX;
+                delete ay;
+                delete ax;
+                delete copy;
+                delete b;
+                delete again;
+                delete a;
+                delete model;
+
+                if (filled != capacity || !isOrdered) {
+                    message += "Sorted values in range: Failed.";
+                    break;
+                }
+                if (!isSame) {
+                    message += "Same values from the same owner: Failed.";
+                    break;
+                }
+                if (differentY == 0 || differentB == 0) {
+                    message += "Different values for other coordinates and owners: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+        return failureCount;
+    }
+}
@@ -38,6 +38,49 @@ namespace Plato {
                     message += "IsRegex('abcde'): Failed.";
                     break;
                 }
+                CompiledRegex& first = Regexes::Acquire("^ab+c$",6);
+                CompiledRegex& second = Regexes::Acquire("^ab+c$",6);
+                bool isShared = &first == &second;
+                Regexes::Release(second);
+                Regexes::Release(first);
+                if(!isShared) {
+                    message += "Acquire('^ab+c$') twice: Failed.";
+                    break;
+                }
+                char pattern[32];
+                for (int i = 0; i <= Regexes::CacheCapacity; ++i) {
+                    sprintf(pattern, "^x%d$", i);
+                    RegexMatcher rm(pattern);
+                    rm.Matches("x1");
+                }
+                if(Regexes::CacheCount() > Regexes::CacheCapacity) {
+                    message += "Cache eviction: Failed.";
+                    break;
+                }
+                // Patterns matched without the regex package must agree with it.
+                const char* cases[][3] = {
+                    {"in","input","1"}, {"in","out","0"}, {"^in","input","1"}, {"^in","pin","0"},
+                    {"put$","input","1"}, {"put$","puts","0"}, {"^in$","in","1"}, {"^in$","input","0"},
+                    {"^(in|out)$","out","1"}, {"^(?:in|out)$","outer","0"}, {"a|b","xbx","1"}, {"a\\.b","a.b","1"},
+                    {"a\\.b","axb","0"}, {".*x.*","axb","1"}, {"^.*$","","1"}, {".+","","0"}, {"^$","","1"}
+                };
+                bool isAgreed = true;
+                for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+                    RegexMatcher rm(cases[i][0]);
+                    if (rm.Matches(cases[i][1]) != (cases[i][2][0] == '1')) {
+                        message += "Matches('" + string(cases[i][1]) + "','" + cases[i][0] + "'): Failed.";
+                        isAgreed = false;
+                        break;
+                    }
+                }
+                if(!isAgreed) {
+                    break;
+                }
+                RegexMatcher exact("^in$");
+                if(exact.GetExactLiteral() == NULL || exact.GetExactLiteral()->compare("in") != 0) {
+                    message += "GetExactLiteral('^in$'): Failed.";
+                    break;
+                }
                 passed = true;
                 break;
             }
@@ -0,0 +1,134 @@
+#include "PlatoIncludes.h"
+#include "PlatoStandard.h"
+
+#include "SymbolTest.h"
+
+namespace Plato {
+
+    int SymbolTest::ConductUnitTest(string& message) {
+        message = "";
+        int failureCount = 0;
+        bool passed = false;
+
+#pragma region // Test of interning.
+        message += "Intern: ";
+        for(;;) {
+            try {
+                const int numberOfNames = 3000;
+                int count = Symbol::Count();
+                // Enough new names to grow the table while they are interned.
+                vector<const Symbol*> symbols;
+                for (int index = 0; index < numberOfNames; ++index) {
+                    string& name = Numbers::ToString(index);
+                    name.insert(0, "SymbolTest");
+                    symbols.push_back(&Symbol::Intern(name));
+                    delete &name;
+                }
+                bool isCounted = Symbol::Count() == count + numberOfNames;
+                // Interning again, from each kind of name, gives back the same symbols.
+                bool isShared = true;
+                for (int index = 0; index < numberOfNames; ++index) {
+                    string& name = Numbers::ToString(index);
+                    name.insert(0, "SymbolTest");
+                    string padded = name + "#";
+                    isShared &= &Symbol::Intern(name) == symbols[index]
+                        && &Symbol::Intern(name.c_str()) == symbols[index]
+                        && &Symbol::Intern(padded.data(), name.size()) == symbols[index]
+                        && symbols[index]->Name == name;
+                    delete &name;
+                }
+                isShared &= Symbol::Count() == count + numberOfNames;
+                // Distinct names have distinct ids and hash codes.
+                vector<int> ids;
+                vector<size_t> hashCodes;
+                for (int index = 0; index < numberOfNames; ++index) {
+                    ids.push_back(symbols[index]->Id);
+                    hashCodes.push_back(symbols[index]->HashCode);
+                }
+                sort(ids.begin(), ids.end());
+                sort(hashCodes.begin(), hashCodes.end());
+                bool isUnique = unique(ids.begin(), ids.end()) == ids.end() && unique(hashCodes.begin(), hashCodes.end()) == hashCodes.end()
+                    && &Symbol::Intern("") != &Symbol::Intern("SymbolTest");
+
+                if (!isCounted || !isShared) {
+                    message += "Equal names share a symbol: Failed.";
+                    break;
+                }
+                if (!isUnique) {
+                    message += "Distinct names have distinct symbols: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of Identifier comparisons.
+        message += "Identifier: ";
+        passed = false;
+        for(;;) {
+            try {
+                // Equal and unequal names, each with and without positions, including NULL terms.
+                vector<Identifier*> identifiers;
+                const char* names[] = { "a", "b", "SymbolTest", "a" };
+                for (int n = 0; n < 4; ++n) {
+                    identifiers.push_back(new Identifier(names[n]));
+                    identifiers.push_back(new Identifier(names[n], new Point(1.0f, 2.0f)));
+                    identifiers.push_back(new Identifier(*new string(names[n]), new Point(1.0f, 3.0f)));
+                }
+                identifiers.push_back(new Identifier((const char*)NULL, new Point(1.0f, 2.0f)));
+                identifiers.push_back(new Identifier(Symbol::Intern("SymbolTest")));
+                bool isConsistent = true;
+                bool isHashed = true;
+                bool isAntisymmetric = true;
+                size_t count = identifiers.size();
+                for (size_t x = 0; x < count; ++x) {
+                    for (size_t y = 0; y < count; ++y) {
+                        const Identifier& ix = *identifiers[x];
+                        const Identifier& iy = *identifiers[y];
+                        int key = ix.CompareKeyTo(iy);
+                        // CompareKeyTo orders by symbol rather than alphabetically, but agrees on equality.
+                        isConsistent &= (key == 0) == (ix.CompareTo(iy) == 0);
+                        isAntisymmetric &= (key < 0) == (iy.CompareKeyTo(ix) > 0);
+                        // Identifiers with the same name and position hash alike.
+                        if (ix.Name != NULL && iy.Name != NULL && ix.Position != NULL && iy.Position != NULL
+                                && key == 0 && ix.Position->CoordinatesEquals(*iy.Position)) {
+                            isHashed &= ix.HashCode == iy.HashCode;
+                        }
+                        if (ix.Name != NULL && iy.Name != NULL && *ix.Name == *iy.Name) {
+                            isHashed &= ix.NameSymbol == iy.NameSymbol && ix.NameHashCode == iy.NameHashCode;
+                        }
+                    }
+                }
+                vector<Identifier*>::iterator itr;
+                for (itr = identifiers.begin(); itr != identifiers.end(); ++itr) {
+                    delete *itr;
+                }
+
+                if (!isConsistent || !isAntisymmetric) {
+                    message += "CompareKeyTo agrees with CompareTo: Failed.";
+                    break;
+                }
+                if (!isHashed) {
+                    message += "Equal identifiers share symbols and hash codes: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+        return failureCount;
+    }
+}
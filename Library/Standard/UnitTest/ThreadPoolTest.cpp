@@ -0,0 +1,200 @@
+#include "PlatoIncludes.h"
+#include "ThreadLocalVariable.h"
+#include "Mutex.h"
+#include "ThreadPool.h"
+
+#include "ThreadPoolTest.h"
+
+namespace Plato {
+
+    /// <summary>
+    /// Counts its executions, and those that saw the pool's context value, and optionally throws.
+    /// </summary>
+    class ThreadPoolTestTask : public ThreadPool::Task {
+    public:
+        ThreadPoolTestTask(Atomic::Value& count, Atomic::Value& inContext, ThreadLocalVariable::Key key, bool doThrow)
+            : mCount(count), mInContext(inContext), mKey(key), mDoThrow(doThrow) {
+        }
+        virtual void Execute() {
+            Atomic::Increment(&mCount);
+            if (ThreadLocalVariable::GetVariableValue(mKey) == (ThreadLocalVariable::ValuePtr)&mCount) {
+                Atomic::Increment(&mInContext);
+            }
+            if (mDoThrow) {
+                throw 1;
+            }
+        }
+    private:
+        Atomic::Value& mCount;
+        Atomic::Value& mInContext;
+        ThreadLocalVariable::Key mKey;
+        bool mDoThrow;
+    };
+
+    /// <summary>
+    /// Submits a group of leaf tasks from inside the pool and waits for them.
+    /// </summary>
+    class ThreadPoolTestForkTask : public ThreadPool::Task {
+    public:
+        ThreadPoolTestForkTask(ThreadPool& pool, Atomic::Value& count, Atomic::Value& inContext, ThreadLocalVariable::Key key, int width)
+            : mPool(pool), mCount(count), mInContext(inContext), mKey(key), mWidth(width) {
+        }
+        virtual void Execute() {
+            ThreadPool::TaskGroup group;
+            for (int index = 0; index < mWidth; ++index) {
+                mPool.Submit(*new ThreadPoolTestTask(mCount, mInContext, mKey, false), group);
+            }
+            if (mPool.Wait(group) != 0) {
+                throw 1;
+            }
+        }
+    private:
+        ThreadPool& mPool;
+        Atomic::Value& mCount;
+        Atomic::Value& mInContext;
+        ThreadLocalVariable::Key mKey;
+        int mWidth;
+    };
+
+    int ThreadPoolTest::ConductUnitTest(string& message) {
+        message = "";
+        int failureCount = 0;
+        bool passed = false;
+        ThreadLocalVariable::Key key = ThreadLocalVariable::GetKey();
+
+#pragma region // Test of a task group.
+        message += "TaskGroup: ";
+        for(;;) {
+            try {
+                const int numberOfTasks = 1000;
+                Atomic::Value count = 0;
+                Atomic::Value inContext = 0;
+                ThreadPool* pool = new ThreadPool(4, key, (ThreadLocalVariable::ValuePtr)&count);
+                // The submitting thread takes part in the work, so give it the context too.
+                ThreadLocalVariable::SetVariableValue(key, (ThreadLocalVariable::ValuePtr)&count);
+                ThreadPool::TaskGroup group;
+                for (int index = 0; index < numberOfTasks; ++index) {
+                    pool->Submit(*new ThreadPoolTestTask(count, inContext, key, false), group);
+                }
+                int failures = pool->Wait(group);
+                bool isComplete = group.Pending == 0;
+                delete pool;
+                ThreadLocalVariable::SetVariableValue(key, NULL);
+
+                if (failures != 0 || !isComplete || count != numberOfTasks || inContext != numberOfTasks) {
+                    message += "Execution of every task: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of failing tasks.
+        message += "Failures: ";
+        passed = false;
+        for(;;) {
+            try {
+                Atomic::Value count = 0;
+                Atomic::Value inContext = 0;
+                ThreadPool* pool = new ThreadPool(3, key, NULL);
+                ThreadPool::TaskGroup group;
+                // Every third task throws, and the others still run.
+                for (int index = 0; index < 30; ++index) {
+                    pool->Submit(*new ThreadPoolTestTask(count, inContext, key, index % 3 == 0), group);
+                }
+                int failures = pool->Wait(group);
+                // A group is reusable once waited on.
+                ThreadPool::TaskGroup second;
+                pool->Submit(*new ThreadPoolTestTask(count, inContext, key, false), second);
+                int secondFailures = pool->Wait(second);
+                delete pool;
+
+                if (failures != 10 || secondFailures != 0 || count != 31) {
+                    message += "Failures counted by Wait: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of nested groups.
+        message += "Nested: ";
+        passed = false;
+        for(;;) {
+            try {
+                Atomic::Value count = 0;
+                Atomic::Value inContext = 0;
+                ThreadPool* pool = new ThreadPool(4, key, NULL);
+                ThreadPool::TaskGroup group;
+                // Tasks waiting on their own groups help execute queued tasks rather than block the pool.
+                for (int index = 0; index < 16; ++index) {
+                    pool->Submit(*new ThreadPoolTestForkTask(*pool, count, inContext, key, 20), group);
+                }
+                int failures = pool->Wait(group);
+                delete pool;
+
+                if (failures != 0 || count != 16 * 20) {
+                    message += "Fork join within the pool: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+
+#pragma region // Test of destruction.
+        message += "Destruction: ";
+        passed = false;
+        for(;;) {
+            try {
+                Atomic::Value count = 0;
+                Atomic::Value inContext = 0;
+                // Idle workers are still stealing when the pool is deleted, with or without work done.
+                for (int round = 0; round < 20; ++round) {
+                    ThreadPool* pool = new ThreadPool(1 + round % 5, key, NULL);
+                    if (round % 2 == 1) {
+                        ThreadPool::TaskGroup group;
+                        pool->Submit(*new ThreadPoolTestTask(count, inContext, key, false), group);
+                        pool->Wait(group);
+                    }
+                    delete pool;
+                }
+
+                if (count != 10) {
+                    message += "Deleting idle pools: Failed.";
+                    break;
+                }
+            } catch (...) {
+                message += "Exception: Failed.";
+                break;
+            }
+            passed = true;
+            break;
+        }
+
+        failureCount += passed ? 0 : 1;
+#pragma endregion
+        ThreadLocalVariable::FreeKey(key);
+        return failureCount;
+    }
+}
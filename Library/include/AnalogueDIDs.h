@@ -2,6 +2,25 @@
 
 namespace Plato { 
 
+    class AnalogueKernel;
+
+    namespace AnalogueOperations {
+        /// <summary>
+        /// The reduction an analogue disposition applies to its input signals.
+        /// </summary>
+        enum Enum {
+            /// <summary>
+            /// The product of the inputs.
+            /// </summary>
+            And,
+            /// <summary>
+            /// The sum of the inputs, saturating at one.
+            /// </summary>
+            Or
+        };
+    }
+    typedef AnalogueOperations::Enum AnalogueOperationsEnum;
+
     /// <summary>
     /// An input pad for an And did.
     /// </summary>
@@ -64,10 +83,121 @@ namespace Plato {
         virtual Property* PropertyFactory(Identifier& identifier, const Property* requester);
     };
 
+    /// <summary>
+    /// Base class for dispositions that reduce their input signals to a single output value.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The inputs are the connections into the DID's input pads and input bundles.
+    /// The result is written to every output pad of the DID and its output bundles.
+    /// A DID with no input connections outputs zero.
+    /// </para>
+    /// <para>
+    /// Update evaluates a single DID. Once a model is configured, an AnalogueKernel
+    /// takes over the evaluation of all its analogue DIDs as vectorised batches,
+    /// unless Configuration::VectoriseDIDs is turned off.
+    /// </para>
+    /// </remarks>
+    class AnalogueDID : public Disposition {
+#pragma region // Class variables.
+    public:
+        /// <summary>
+        /// Class type information.
+        /// </summary>
+        static const ClassTypeInfo* TypeInfo;
+        /// <summary>
+        /// Gets the class type info for the dynamic class instance type.
+        /// </summary>
+        virtual const ClassTypeInfo* GetClassTypeInfo() const { return TypeInfo; }
+#pragma endregion
+
+#pragma region // Instance variables.
+    public:
+        /// <summary>
+        /// The reduction applied to the inputs.
+        /// </summary>
+        const AnalogueOperationsEnum Operation;
+    private:
+        friend class AnalogueKernel;
+        /// <summary>
+        /// The kernel evaluating this DID, or NULL when it updates itself.
+        /// </summary>
+        AnalogueKernel* mKernel;
+        /// <summary>
+        /// The DID's batch and lane within mKernel.
+        /// </summary>
+        int mKernelBatch;
+        int mKernelLane;
+#pragma endregion
+
+#pragma region // Constructors.
+    public:
+        /// <summary>
+        /// Create a new analogue DID.
+        /// </summary>
+        /// <param name="operation">The reduction to apply to the inputs.</param>
+        /// <param name="creator">The element that created this element.</param>
+        /// <param name="parent">The hierarchical parent of this element.</param>
+        /// <param name="elementName">The name of the element.</param>
+        /// <param name="scope">The scope of the element.</param>
+        AnalogueDID(AnalogueOperationsEnum operation, Container* creator, Container* parent,
+            Identifier& elementName, PropertyScopesEnum scope);
+        /// <summary>
+        /// Deallocate object, detaching it from its kernel.
+        /// </summary>
+        virtual ~AnalogueDID();
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Reduces the current input signals and sets the outputs for the next epoch.
+        /// </summary>
+        virtual void Update();
+        /// <summary>
+        /// Fetches the input pads of the DID and its input bundles in declaration order.
+        /// </summary>
+        /// <param name="pads">Receives the pads.</param>
+        void GetInputPads(vector<InputPad*>& pads);
+        /// <summary>
+        /// Fetches the output pads of the DID and its output bundles in declaration order.
+        /// </summary>
+        /// <param name="pads">Receives the pads.</param>
+        void GetOutputPads(vector<OutputPad*>& pads);
+        /// <summary>
+        /// Applies an operation to a list of values.
+        /// </summary>
+        /// <param name="operation">The reduction to apply.</param>
+        /// <param name="values">The values to reduce.</param>
+        /// <param name="count">The number of values.</param>
+        /// <returns>Returns the reduced value, or zero when count is zero.</returns>
+        static float Reduce(AnalogueOperationsEnum operation, const float* values, int count);
+    private:
+        /// <summary>
+        /// Collects the input or output pads of a container and its bundles.
+        /// </summary>
+        static void GetPads(Container& container, vector<Pad*>& pads, bool isInput);
+#pragma endregion
+
+    private:
+        friend class InitializerCatalogue;
+        /// <summary>
+        /// The class initializer.
+        /// </summary>
+        static void Initializer();
+        /// <summary>
+        /// The class finalizer.
+        /// </summary>
+        static void Finalizer();
+    };
+
     /// <summary>
     /// Causally ANDs it's inputs together.
     /// </summary>
-    class AndDID : public Disposition {
+    /// <remarks>
+    /// The output is the product of the inputs.
+    /// </remarks>
+    class AndDID : public AnalogueDID {
     public:
         /// <summary>
         /// Create a new AndDID.
@@ -80,11 +210,6 @@ namespace Plato {
             Identifier& elementName = Identifier::Generate("AndDID"), 
             PropertyScopesEnum scope = PropertyScopes::Public);
 
-        /// <summary>
-        ///
-        /// </summary>
-        virtual void Update();
-
         /// <summary>
         ///
         /// </summary>
@@ -97,7 +222,10 @@ namespace Plato {
     /// <summary>
     /// Causally ORs it's inputs together.
     /// </summary>
-    class OrDID : public Disposition {
+    /// <remarks>
+    /// The output is the sum of the inputs, saturating at one.
+    /// </remarks>
+    class OrDID : public AnalogueDID {
     public:
         /// <summary>
         /// Create a new OrDID.
@@ -109,9 +237,131 @@ namespace Plato {
         OrDID(Container* creator = NULL, Container* parent = NULL,
             Identifier& elementName = Identifier::Generate("OrDID"), 
             PropertyScopesEnum scope = PropertyScopes::Public);
+    };
+
+    /// <summary>
+    /// Evaluates a model's analogue DIDs in batches over the signal arrays.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Compile groups the DIDs by operation and arity, the number of input connections.
+    /// Each batch stores its input slots input-major, so the k'th inputs of all the
+    /// batch's DIDs are adjacent and one vector instruction combines several DIDs.
+    /// SSE and AVX are used when the compiler targets them, otherwise a scalar loop.
+    /// </para>
+    /// <para>
+    /// The kernel is added to the model as an emulated container and the compiled DIDs
+    /// have DoEmulate cleared, so Model::Update calls the kernel in place of the DIDs.
+    /// Deleting the kernel hands the DIDs back to Model::Update.
+    /// </para>
+    /// <para>
+    /// The batches are a snapshot of the connections. Model::Configure and Model::Load compile
+    /// a kernel once they have finished when Configuration::VectoriseDIDs is set; otherwise call
+    /// Compile after Model::Configure (and Model::Freeze if used), and again if connections change.
+    /// </para>
+    /// </remarks>
+    class AnalogueKernel : public Container {
+    public:
         /// <summary>
-        ///
+        /// The number of DIDs evaluated together in one pass of the staging buffers.
+        /// </summary>
+        static const int ChunkSize = 256;
+
+    private:
+        friend class AnalogueDID;
+        /// <summary>
+        /// The DIDs sharing an operation and arity.
+        /// </summary>
+        class Batch {
+        public:
+            /// <summary>
+            /// The reduction applied by the batch's DIDs.
+            /// </summary>
+            AnalogueOperationsEnum Operation;
+            /// <summary>
+            /// The number of inputs of each DID.
+            /// </summary>
+            int Arity;
+            /// <summary>
+            /// The DIDs in lane order, NULL once deleted.
+            /// </summary>
+            vector<AnalogueDID*> DIDs;
+            /// <summary>
+            /// Input slots, input-major: input k of lane i is at k*Count()+i.
+            /// </summary>
+            vector<int> Inputs;
+            /// <summary>
+            /// The start of each lane's output slots, with a final entry equal to the output count.
+            /// </summary>
+            vector<int> OutputOffsets;
+            /// <summary>
+            /// The output slots of the lanes.
+            /// </summary>
+            vector<int> Outputs;
+            inline int Count() const { return (int)DIDs.size(); }
+        };
+
+#pragma region // Instance variables.
+    private:
+        /// <summary>
+        /// The batches, in order of first appearance.
         /// </summary>
+        vector<Batch*> mBatches;
+        /// <summary>
+        /// The number of DIDs compiled.
+        /// </summary>
+        int mCount;
+#pragma endregion
+
+#pragma region // Constructors.
+    private:
+        /// <summary>
+        /// Create an empty kernel.
+        /// </summary>
+        /// <param name="model">The model whose DIDs the kernel will evaluate.</param>
+        AnalogueKernel(Model& model);
+    public:
+        /// <summary>
+        /// Deallocate the kernel and hand its DIDs back to Model::Update.
+        /// </summary>
+        virtual ~AnalogueKernel();
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Compiles the analogue DIDs of a model into a kernel and adds it to the model.
+        /// </summary>
+        /// <param name="model">The configured model.</param>
+        /// <returns>Returns the kernel, owned by the model, or NULL if the model has no DIDs with inputs to compile.</returns>
+        static AnalogueKernel* Compile(Model& model);
+        /// <summary>
+        /// Evaluates all the batches for the current epoch.
+        /// </summary>
+        /// <remarks>
+        /// Large batches are split into chunks across the model's UpdateThreadPool when it has one.
+        /// </remarks>
         virtual void Update();
+        /// <summary>
+        /// Evaluates a range of a batch's lanes.
+        /// </summary>
+        /// <param name="batch">The batch index.</param>
+        /// <param name="first">The first lane.</param>
+        /// <param name="last">One past the last lane.</param>
+        void Evaluate(int batch, int first, int last);
+        /// <summary>
+        /// Produces a summary of the kernel's batches.
+        /// </summary>
+        string& StatusReport() const;
+    private:
+        /// <summary>
+        /// Adds the analogue DIDs of a container hierarchy to the kernel's batches.
+        /// </summary>
+        void Compile(Container& container, hash_map<size_t,int>& batchIds);
+        /// <summary>
+        /// Removes a deleted DID from its batch.
+        /// </summary>
+        void Detach(AnalogueDID& did);
+#pragma endregion
     };
 }
@@ -5,6 +5,10 @@ namespace Plato {
     /// <summary>
     /// Handles serialising objects to and from the Hierarchy.
     /// </summary>
+    /// <remarks>
+    /// The objects archived are ModelSnapshots, in their binary format.
+    /// A text format has not been implemented.
+    /// </remarks>
     class Archiver {
     public:
         /// <summary>
@@ -12,7 +16,7 @@ namespace Plato {
         /// </summary>
         /// <remarks>Automatically determines whether archive is in binary or xml text format.</remarks>
         /// <param name="archivePath">The relative path and file name of serialized object to fetch.</param>
-        /// <returns>Returns the deserialized object, if successful, otherwise NULL.</returns>
+        /// <returns>Returns the deserialized ModelSnapshot, mapped from the file where possible, if successful, otherwise NULL.</returns>
         static void* Deserialize(const string& archivePath);
 
         /// <summary>
@@ -20,8 +24,8 @@ namespace Plato {
         /// </summary>
         /// <param name="archivePath">The relative path and file name to save object to.</param>
         /// <param name="inBinary">If true, object is saved to destination file in binary format, otherwise text.</param>
-        /// <param name="obj">The object to serialise.</param>
-        /// <returns>Returns zero if successful, otherwise an error code.</returns>
+        /// <param name="obj">The ModelSnapshot to serialise.</param>
+        /// <returns>Returns zero if successful, otherwise an error code: 3 if a text archive was requested.</returns>
         static int Serialize(const string& archivePath, bool inBinary, void* obj);
     };
 }
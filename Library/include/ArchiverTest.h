@@ -1,45 +1,31 @@
 #pragma once
 
 namespace Plato {
+
+    class Container;
+    class Connector;
+    class OutputPad;
+    class InputPad;
+
     /// <summary>
     /// Unit testing class for Archiver.
     /// </summary>
     class ArchiverTest {
     public:
-        /// <summary>
-        /// A serializable test class.
-        /// </summary>
-        class ArchieTestClass {
-        public:
-            /// <summary>
-            ///
-            /// </summary>
-            int mA;
-            /// <summary>
-            ///
-            /// </summary>
-            string& mB;
-            /// <summary>
-            ///
-            /// </summary>
-            /// <param name="a"></param>
-            /// <param name="b"></param>
-            ArchieTestClass(int a, string& b);
-            /// <summary>
-            /// </summary>
-            ~ArchieTestClass();
-            /// <summary>
-            ///
-            /// </summary>
-            /// <returns></returns>
-            virtual string& StatusReport();
-        };
-
         /// <summary>
         ///  The Unit Testing method.
         /// </summary>
         /// <param name="message">Diagnostic message.</param>
         /// <returns>Returns the number of failures, or zero on success.</returns>
         static int ConductUnitTest(string& message);
+    private:
+        /// <summary>
+        /// Builds a small hierarchy: an element with two output pads, another with an input pad, and a connector.
+        /// </summary>
+        /// <param name="outputs">Out parameter for the two output pads.</param>
+        /// <param name="input">Out parameter for the input pad.</param>
+        /// <param name="connector">Out parameter for the connector.</param>
+        /// <returns>Returns the root of the new hierarchy.</returns>
+        static Container* BuildHierarchy(OutputPad* outputs[2], InputPad*& input, Connector*& connector);
     };
 }
@@ -0,0 +1,46 @@
+#pragma once
+
+namespace Plato {
+
+    class Point;
+    class Size;
+    class Bounds;
+
+    /// <summary>
+    /// A point space holding the points whose spatial coordinates fall within an axis aligned box.
+    /// </summary>
+    /// <remarks>The overlay ID of a point is not constrained.</remarks>
+    class BoxSpace : public PointSpace {
+    private:
+        /// <summary>
+        /// The box, including its upper faces.
+        /// </summary>
+        Bounds* mBox;
+
+    public:
+        /// <summary>
+        /// Constructs a box space from its lower corner and width.
+        /// </summary>
+        /// <param name="lowerBound">The lower corner of the box, which the space takes ownership of.</param>
+        /// <param name="width">The width of the box along each axis, which the space takes ownership of.</param>
+        BoxSpace(Point& lowerBound, Size& width);
+
+        /// <summary>
+        /// Deallocate object.
+        /// </summary>
+        virtual ~BoxSpace();
+
+        /// <summary>
+        /// Determines whether the point lies within the box.
+        /// </summary>
+        /// <param name="point">The point to check for membership.</param>
+        /// <returns>Returns true if each spatial coordinate lies within the box.</returns>
+        virtual bool IsContained(const Point& point);
+
+        /// <summary>
+        /// The box that bounds the space, which is the space itself.
+        /// </summary>
+        /// <returns>Returns a copy of the box, which the caller deletes.</returns>
+        virtual Bounds* BoundingBox();
+    };
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+namespace Plato {
+
+    class SignalArena;
+    class ConnectionGraph;
+
+    /// <summary>
+    /// Tracks which Dispositions have inputs that changed in the previous epoch.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// At the start of each epoch, once the signals are swapped, the Current signal of every
+    /// OutputPad is compared with the value last published to its readers. A pad that has moved
+    /// by more than Epsilon is republished, and the Dispositions reading it, found through the
+    /// ConnectionGraph's dependents, are marked dirty for that epoch. Comparing after the swap,
+    /// rather than after the update, also picks up signals written between epochs, e.g. by a
+    /// model driving its source pads. Comparing against the last published
+    /// value, rather than the previous epoch's, lets slow drifts accumulate until they matter.
+    /// </para>
+    /// <para>
+    /// Dispositions that are skipped do not write their outputs, so at the start of each epoch
+    /// the Current signals are copied into Next, carrying unchanged outputs over the swap.
+    /// </para>
+    /// <para>
+    /// Dispositions outside the graph, i.e. those without inputs or that are not input safe,
+    /// are always dirty. Every compiled Disposition is dirty in the first epoch.
+    /// </para>
+    /// </remarks>
+    class ChangeTracker {
+#pragma region // Instance variables.
+    public:
+        /// <summary>
+        /// The smallest change in an output that marks its readers dirty.
+        /// </summary>
+        float Epsilon;
+    private:
+        /// <summary>
+        /// The signals and connections being tracked.
+        /// </summary>
+        SignalArena& mSignals;
+        const ConnectionGraph& mGraph;
+        /// <summary>
+        /// The value of each signal slot last seen by its readers.
+        /// </summary>
+        vector<float> mPublished;
+        /// <summary>
+        /// The dirty flags for the current epoch and the one being prepared, by Disposition graph index.
+        /// </summary>
+        vector<unsigned char> mDirty;
+        vector<unsigned char> mNextDirty;
+        /// <summary>
+        /// The number of flags set in mDirty.
+        /// </summary>
+        int mDirtyCount;
+#pragma endregion
+
+#pragma region // Constructors.
+    public:
+        /// <summary>
+        /// Creates a tracker with every Disposition dirty.
+        /// </summary>
+        /// <param name="signals">The model's signal arena.</param>
+        /// <param name="graph">The model's compiled connections.</param>
+        /// <param name="epsilon">The smallest change that marks readers dirty.</param>
+        ChangeTracker(SignalArena& signals, const ConnectionGraph& graph, float epsilon);
+    private:
+        ChangeTracker(const ChangeTracker&);
+        ChangeTracker& operator=(const ChangeTracker&);
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Indicates whether a Disposition needs updating this epoch.
+        /// </summary>
+        /// <param name="graphIndex">The Disposition's GraphIndex.</param>
+        inline bool IsDirty(int graphIndex) const { return graphIndex < 0 || mDirty[graphIndex] != 0; }
+        /// <summary>
+        /// Gets the number of compiled Dispositions to be updated this epoch.
+        /// </summary>
+        inline int DirtyCount() const { return mDirtyCount; }
+        /// <summary>
+        /// Marks every Disposition dirty for the next epoch.
+        /// </summary>
+        void MarkAll();
+        /// <summary>
+        /// Publishes the changed signals and prepares for an epoch, called after the signals are swapped.
+        /// </summary>
+        void BeginEpoch();
+#pragma endregion
+
+#pragma region // Private methods.
+    private:
+        /// <summary>
+        /// Publishes the Current signals that have changed, marking their readers dirty.
+        /// </summary>
+        void Publish();
+#pragma endregion
+    };
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+namespace Plato {
+
+    class Property;
+    class Container;
+    class SignalArena;
+    class ConnectionGraph;
+    class ModelSnapshot;
+
+    /// <summary>
+    /// Writes periodic checkpoints of a running model on a background thread.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// A checkpoint is either a base, a full ModelSnapshot written to the checkpoint path,
+    /// or a delta holding only the output pad signals changed since the previous checkpoint,
+    /// written to the path followed by "." and the delta's sequence number.
+    /// A new base is taken at the first checkpoint, after a property has been added to or removed
+    /// from any container, after a failed write and after every given number of deltas,
+    /// when the deltas of the previous base are removed.
+    /// </para>
+    /// <para>
+    /// The signals are compared a page at a time with a copy of their values at the previous
+    /// checkpoint, in the order of the base's signal table, and a delta holds the pages that differ.
+    /// The changed words are XORed with their previous values and the zero runs this leaves
+    /// are compressed on the writer thread. Each file is written under a temporary name and
+    /// renamed, so a crash leaves either a whole checkpoint or none.
+    /// </para>
+    /// <para>
+    /// Checkpoint takes the base snapshot or collects the changed pages in memory and returns.
+    /// It never waits for the writer: if the previous checkpoint is still being written it skips,
+    /// and the next delta covers both intervals.
+    /// </para>
+    /// </remarks>
+    class Checkpointer {
+    public:
+        /// <summary>
+        /// The format version of a delta.
+        /// </summary>
+        static const uint32_t Version = 1;
+        /// <summary>
+        /// The number of 32 bit words compared and written together, two per signal.
+        /// </summary>
+        static const int PageSize = 1024;
+
+        /// <summary>
+        /// The start of a delta file, followed by PageCount pages.
+        /// </summary>
+        struct DeltaHeader {
+            char Magic[8];
+            uint32_t Version;
+            uint32_t ByteOrder;
+            int64_t BaseEpochTime;
+            int64_t EpochTime;
+            uint32_t Sequence;
+            uint32_t SignalCount;
+            uint32_t PageCount;
+            uint32_t WordCount;
+        };
+        /// <summary>
+        /// The start of a page of a delta, followed by WordCount encoded words.
+        /// </summary>
+        /// <remarks>
+        /// The encoded words are runs, each a word holding the number of unchanged words in the
+        /// upper 16 bits and the number of changed words n in the lower, followed by n XORed words.
+        /// </remarks>
+        struct PageHeader {
+            uint32_t Page;
+            uint32_t WordCount;
+        };
+
+#pragma region // Instance variables.
+    private:
+        /// <summary>
+        /// The path of the base, which the deltas' paths extend.
+        /// </summary>
+        string mPath;
+        /// <summary>
+        /// The number of deltas written between bases.
+        /// </summary>
+        int mDeltasPerBase;
+        /// <summary>
+        /// The epoch time of the base the deltas apply to.
+        /// </summary>
+        int64_t mBaseEpochTime;
+        /// <summary>
+        /// The sequence number of the last delta taken since the base.
+        /// </summary>
+        uint32_t mSequence;
+        /// <summary>
+        /// The PathMemo generation when the base was taken, to tell when properties were added or removed.
+        /// </summary>
+        long mGeneration;
+        /// <summary>
+        /// Set when the next checkpoint must be a base.
+        /// </summary>
+        bool mNeedsBase;
+        /// <summary>
+        /// The signal slot of each of the base's signal records, or -1 where none matches.
+        /// </summary>
+        vector<int> mSlots;
+        /// <summary>
+        /// The signal words at the last checkpoint: each signal's current then next value.
+        /// </summary>
+        vector<uint32_t> mShadow;
+
+        /// <summary>
+        /// The checkpoint handed to the writer: a base, or a delta's changed pages.
+        /// </summary>
+        ModelSnapshot* mPendingBase;
+        DeltaHeader mPendingHeader;
+        vector<uint32_t> mPendingPages;
+        vector<uint32_t> mPendingWords;
+        /// <summary>
+        /// The result of the last write, zero if successful, otherwise an error code.
+        /// </summary>
+        int mWriteResult;
+        /// <summary>
+        /// Set while the writer owns the pending checkpoint.
+        /// </summary>
+        bool mIsWriting;
+        /// <summary>
+        /// Signals the writer to exit.
+        /// </summary>
+        bool mIsStopping;
+        /// <summary>
+        /// Guards the pending checkpoint and flags.
+        /// </summary>
+        Mutex mLock;
+        /// <summary>
+        /// Wakes the writer when a checkpoint is pending, and Flush when it has been written.
+        /// </summary>
+        Condition mCondition;
+#ifdef WIN32
+        typedef HANDLE ThreadHandle;
+#else
+        typedef pthread_t ThreadHandle;
+#endif
+        /// <summary>
+        /// The writer thread.
+        /// </summary>
+        ThreadHandle mThread;
+#pragma endregion
+
+#pragma region // Constructors.
+    public:
+        /// <summary>
+        /// Creates a checkpointer and starts its writer thread.
+        /// </summary>
+        /// <param name="path">The path of the base checkpoint.</param>
+        /// <param name="deltasPerBase">The number of deltas written before another base is taken.</param>
+        Checkpointer(const string& path, int deltasPerBase);
+        /// <summary>
+        /// Waits for the pending checkpoint to be written and stops the writer thread.
+        /// </summary>
+        ~Checkpointer();
+    private:
+        Checkpointer(const Checkpointer&);
+        Checkpointer& operator=(const Checkpointer&);
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Takes a checkpoint of a hierarchy, to be written in the background.
+        /// </summary>
+        /// <remarks>Call between epochs, from the thread running the model.</remarks>
+        /// <param name="root">The root of the hierarchy, normally the model.</param>
+        /// <param name="signals">The signals of the hierarchy's output pads.</param>
+        /// <param name="graph">The compiled connections, used for pads whose connections were released, or NULL.</param>
+        /// <param name="epochTime">The number of epochs the model has run for.</param>
+        /// <returns>Returns the result of the previous checkpoint's write: zero if successful, otherwise an error code.</returns>
+        int Checkpoint(Container& root, const SignalArena& signals, const ConnectionGraph* graph, long epochTime);
+
+        /// <summary>
+        /// Waits until the pending checkpoint has been written.
+        /// </summary>
+        /// <returns>Returns zero if the last checkpoint was written successfully, otherwise an error code.</returns>
+        int Flush();
+
+        /// <summary>
+        /// Applies the deltas of a base checkpoint, in sequence, to a hierarchy the base has been restored onto.
+        /// </summary>
+        /// <remarks>
+        /// Replay stops at the first delta that is missing, incomplete or belongs to another base.
+        /// </remarks>
+        /// <param name="base">The base checkpoint.</param>
+        /// <param name="path">The path the base was read from.</param>
+        /// <param name="root">The root of the hierarchy.</param>
+        /// <param name="signals">The signals of the hierarchy's output pads.</param>
+        /// <param name="epochTime">Out parameter for the epoch time of the last delta applied, unchanged if none.</param>
+        /// <returns>Returns the number of deltas applied.</returns>
+        static int Replay(const ModelSnapshot& base, const string& path, Container& root, SignalArena& signals, long& epochTime);
+    private:
+        /// <summary>
+        /// Takes a base, which replaces the copy of the signals the deltas are compared with.
+        /// </summary>
+        void TakeBase(Container& root, const SignalArena& signals, const ConnectionGraph* graph, long epochTime);
+        /// <summary>
+        /// Collects the pages changed since the last checkpoint into the pending delta.
+        /// </summary>
+        /// <returns>Returns false if no page changed.</returns>
+        bool TakeDelta(const SignalArena& signals, long epochTime);
+        /// <summary>
+        /// Writes the pending checkpoint.
+        /// </summary>
+        /// <returns>Returns zero if successful, otherwise an error code.</returns>
+        int WritePending();
+        /// <summary>
+        /// The writer thread main loop.
+        /// </summary>
+        void WriterLoop();
+#ifdef WIN32
+        static DWORD WINAPI WriterStart(LPVOID arg);
+#else
+        static void* WriterStart(void* arg);
+#endif
+#pragma endregion
+    };
+}
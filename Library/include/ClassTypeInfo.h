@@ -146,6 +146,23 @@ namespace Plato {
         static HashMap& CreateHashMap(const ClassTypeInfo* first,...);
     };
 
+    /// <summary>
+    /// Traits class for FlatHashMap tables keyed by ClassTypeInfo*.
+    /// </summary>
+    class ClassTypeInfoPtrTraits {
+    public:
+        /// <summary>
+        /// Returns the TypeCode for the class.
+        /// </summary>
+        inline static size_t Hash(const ClassTypeInfo::ConstClassTypeInfoPtr& key) { return key->TypeCode; }
+        /// <summary>
+        /// Tests whether two class infos are for the same class, i.e. have the same unique TypeCode.
+        /// </summary>
+        inline static bool Equals(const ClassTypeInfo::ConstClassTypeInfoPtr& xKey, const ClassTypeInfo::ConstClassTypeInfoPtr& yKey) {
+            return xKey == yKey || xKey->TypeCode == yKey->TypeCode;
+        }
+    };
+
     /// <summary>
     /// Traits class for ClassTypeInfo* hash_compare.
     /// </summary>
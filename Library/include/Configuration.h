@@ -4,6 +4,7 @@ namespace Plato {
 
     class Configuration;
     class CommandLine;
+    class Mutex;
 
 #pragma region // VariableAccessor class.
     /// <summary>
@@ -101,6 +102,20 @@ namespace Plato {
         /// If isString=false, return ptr value will be the address of the variable.
         /// </returns>
         static const void* BoolAccessor(const void* varAdrs,const void* valuePtr,bool isSetting,bool isString);
+        /// <summary>
+        /// An accessor function for float variables.
+        /// </summary>
+        /// <param name="varAdrs">The address of the variable to access.</param>
+        /// <param name="valuePtr">A pointer to the new value, if setting.</param>
+        /// <param name="isSetting">Indicates when the variable is being set.</param>
+        /// <param name="isString">Indicates that the input value is a string,
+        /// or the return value should be a string.</param>
+        /// <returns>
+        /// Returns a pointer to the variable value. 
+        /// If isString=true, return ptr value will be to a new string, which the caller owns.
+        /// If isString=false, return ptr value will be the address of the variable.
+        /// </returns>
+        static const void* FloatAccessor(const void* varAdrs,const void* valuePtr,bool isSetting,bool isString);
     };
 #pragma endregion
 
@@ -144,10 +159,15 @@ namespace Plato {
         /// <summary>
         /// Set to a non-zero value for debug info.
         /// </summary>
+        /// <remarks>
+        /// Shared by every model in the process: it is reset when the library is initialized,
+        /// and set by the options of each model that gives it.
+        /// </remarks>
         static int DebugLevel;
         /// <summary>
         /// Set to a non-zero value for trace info.
         /// </summary>
+        /// <remarks>Shared by every model in the process, as DebugLevel.</remarks>
         static int TraceLevel;
         /// <summary>
         /// When set to true, serialization is in binary format, otherwise XML.
@@ -162,6 +182,76 @@ namespace Plato {
         /// </summary>
         long EpochCount;
         /// <summary>
+        /// The number of threads used to update the model each epoch.
+        /// A value of 1 updates serially, 0 uses one thread per processor.
+        /// </summary>
+        int UpdateThreads;
+        /// <summary>
+        /// The number of threads used to configure the model's elements.
+        /// A value of 1 configures serially, 0 uses one thread per processor.
+        /// </summary>
+        /// <remarks>
+        /// Each element of the model is configured by one thread, so the elements' operators
+        /// must only change their own element's subtree. See Model::ApplyPhase.
+        /// </remarks>
+        int ConfigureThreads;
+        /// <summary>
+        /// When true, Configure compiles the pad connections into a ConnectionGraph
+        /// and releases the per-connection objects.
+        /// </summary>
+        bool FreezeConnections;
+        /// <summary>
+        /// When true, only Dispositions whose inputs changed in the previous epoch are updated.
+        /// </summary>
+        bool IncrementalUpdates;
+        /// <summary>
+        /// The smallest change in an output that causes the Dispositions reading it to be updated,
+        /// when IncrementalUpdates is set.
+        /// </summary>
+        float ChangeEpsilon;
+        /// <summary>
+        /// When true, Configure and Load compile the model's AndDIDs and OrDIDs into an AnalogueKernel,
+        /// which evaluates them in batches in place of their own Update.
+        /// </summary>
+        /// <remarks>
+        /// The kernel reads the connections as they are when it is compiled, so a model that adds
+        /// connections to its DIDs after configuring should turn this off, or compile a new kernel.
+        /// </remarks>
+        bool VectoriseDIDs;
+        /// <summary>
+        /// When true, the properties built during construction and configuration are allocated
+        /// from the model's ModelArena and released together when the model is destroyed.
+        /// </summary>
+        bool UseModelArena;
+        /// <summary>
+        /// When true, Path::GetProperty reuses earlier resolutions of a path from the same container
+        /// while the containers it passed through are unchanged.
+        /// </summary>
+        bool MemoisePaths;
+        /// <summary>
+        /// The seed of the model's random streams, see Model::CreateRandomStream.
+        /// </summary>
+        int RandomSeed;
+        /// <summary>
+        /// The number of epochs between checkpoints written to the ArchivePath while the model runs,
+        /// or 0 for none. See Checkpointer.
+        /// </summary>
+        long CheckpointInterval;
+        /// <summary>
+        /// The number of checkpoints holding only the changed signals written between full checkpoints.
+        /// </summary>
+        int CheckpointDeltas;
+        /// <summary>
+        /// When true, Run counts and times the updates of each class of container and the length of each epoch.
+        /// See Profiler and Model::StatusReport.
+        /// </summary>
+        bool ProfileUpdates;
+        /// <summary>
+        /// The local path to write the profile to in JSON at the end of each Run, when ProfileUpdates is set,
+        /// or empty for none.
+        /// </summary>
+        const string* ProfilePath;
+        /// <summary>
         /// The local path to the serialised state data to restore/save model from/to.
         /// </summary>
         const string* ArchivePath;
@@ -205,6 +295,10 @@ namespace Plato {
         /// </summary>
         static string* mDirectoryPtr;
         /// <summary>
+        /// Guards the lazy setting of mFullPathPtr and mDirectoryPtr by models on different threads.
+        /// </summary>
+        static Mutex mPathLock;
+        /// <summary>
         /// Maps variable name to a VariableAccessor for accessing property variable.
         /// </summary>
         static HashMap* mVariableAccessorHashMap;
@@ -0,0 +1,156 @@
+#pragma once
+
+namespace Plato {
+
+    class Container;
+    class Connector;
+    class InputPad;
+    class Disposition;
+
+    /// <summary>
+    /// A compiled, read only form of a model's pad connections.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The graph is a compressed sparse row adjacency of InputPad to OutputPad edges.
+    /// Every InputPad in the model is numbered in depth-first declaration order
+    /// and its edges occupy the range [Offsets[pad], Offsets[pad+1]) of the
+    /// SourceSignals and ConnectorIds arrays.
+    /// </para>
+    /// <para>
+    /// SourceSignals holds the SignalArena slot of each edge's source OutputPad, so the
+    /// inputs of consecutive pads are gathered with one linear sweep of the edge arrays.
+    /// ConnectorIds indexes the Connectors table, giving the Connector that made each edge.
+    /// </para>
+    /// <para>
+    /// The reverse edges are kept too: the Dispositions owning each input pad are numbered,
+    /// and [DependentOffsets[slot], DependentOffsets[slot+1]) of Dependents lists the
+    /// Dispositions reading a signal slot. Only input safe Dispositions are numbered,
+    /// since the others must be updated whether or not their inputs change.
+    /// </para>
+    /// <para>
+    /// The graph is built by Model::Freeze once configuration has completed.
+    /// Connections added afterwards are not seen until the model is frozen again.
+    /// </para>
+    /// </remarks>
+    class ConnectionGraph {
+#pragma region // Instance variables.
+    public:
+        /// <summary>
+        /// The input pads in graph order, indexed by InputPad::GraphIndex.
+        /// Entries are set to NULL when their pad is deleted.
+        /// </summary>
+        vector<InputPad*> Pads;
+        /// <summary>
+        /// The start of each pad's edges, with a final entry equal to the edge count.
+        /// </summary>
+        vector<int> Offsets;
+        /// <summary>
+        /// The SignalArena slot of each edge's source OutputPad.
+        /// </summary>
+        vector<int> SourceSignals;
+        /// <summary>
+        /// The index into Connectors of the Connector that created each edge.
+        /// </summary>
+        vector<int> ConnectorIds;
+        /// <summary>
+        /// The distinct connectors referenced by ConnectorIds.
+        /// </summary>
+        vector<Connector*> Connectors;
+        /// <summary>
+        /// The input safe Dispositions with input connections, indexed by Disposition::GraphIndex.
+        /// Entries are set to NULL when their Disposition is deleted.
+        /// </summary>
+        vector<Disposition*> Dispositions;
+        /// <summary>
+        /// The start of each signal slot's dependents, with a final entry equal to the dependent count.
+        /// </summary>
+        vector<int> DependentOffsets;
+        /// <summary>
+        /// The graph index of each Disposition reading a slot.
+        /// </summary>
+        vector<int> Dependents;
+#pragma endregion
+
+#pragma region // Constructors.
+    public:
+        /// <summary>
+        /// Compiles the connections of all the input pads in a container hierarchy.
+        /// </summary>
+        /// <param name="root">The root of the hierarchy, normally the model.</param>
+        ConnectionGraph(Container& root);
+        /// <summary>
+        /// Releases the graph and detaches its pads.
+        /// </summary>
+        ~ConnectionGraph();
+#pragma endregion
+
+#pragma region // Accessors.
+    public:
+        /// <summary>
+        /// Gets the number of input pads in the graph.
+        /// </summary>
+        inline int PadCount() const { return (int)Pads.size(); }
+        /// <summary>
+        /// Gets the number of edges in the graph.
+        /// </summary>
+        inline int EdgeCount() const { return (int)SourceSignals.size(); }
+        /// <summary>
+        /// Gets the number of connections into a pad.
+        /// </summary>
+        /// <param name="pad">The graph index of the pad.</param>
+        inline int InputCount(int pad) const { return Offsets[pad+1] - Offsets[pad]; }
+        /// <summary>
+        /// Gets the source signal slots of the connections into a pad.
+        /// </summary>
+        /// <param name="pad">The graph index of the pad.</param>
+        inline const int* Sources(int pad) const { return SourceSignals.empty() ? NULL : &SourceSignals[0] + Offsets[pad]; }
+        /// <summary>
+        /// Gets the number of Dispositions in the graph.
+        /// </summary>
+        inline int DispositionCount() const { return (int)Dispositions.size(); }
+        /// <summary>
+        /// Gets the number of Dispositions reading a signal slot.
+        /// </summary>
+        /// <param name="slot">The SignalArena slot.</param>
+        inline int DependentCount(int slot) const {
+            return slot + 1 < (int)DependentOffsets.size() ? DependentOffsets[slot+1] - DependentOffsets[slot] : 0;
+        }
+        /// <summary>
+        /// Gets the graph indexes of the Dispositions reading a signal slot.
+        /// </summary>
+        /// <param name="slot">The SignalArena slot.</param>
+        inline const int* DependentsOf(int slot) const { return Dependents.empty() ? NULL : &Dependents[0] + DependentOffsets[slot]; }
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Copies the current values of a pad's inputs.
+        /// </summary>
+        /// <param name="pad">The graph index of the pad.</param>
+        /// <param name="signals">The signal values to read, normally SignalArena::Current.</param>
+        /// <param name="values">Receives InputCount(pad) values.</param>
+        /// <returns>Returns the number of values copied.</returns>
+        int Gather(int pad, const float* signals, float* values) const;
+        /// <summary>
+        /// Produces a summary of the graph's size.
+        /// </summary>
+        string& StatusReport() const;
+    private:
+        /// <summary>
+        /// Numbers the input pads of a container and appends their edges.
+        /// </summary>
+        /// <param name="container">The container to compile.</param>
+        /// <param name="connectorIds">Maps connectors to their index in Connectors.</param>
+        /// <param name="owner">The input safe Disposition enclosing the container, or NULL.</param>
+        /// <param name="edgeOwners">Receives the graph index of each edge's Disposition, or -1.</param>
+        void Compile(Container& container, hash_map<size_t,int>& connectorIds, 
+            Disposition* owner, vector<int>& edgeOwners);
+        /// <summary>
+        /// Builds the slot to Disposition dependents from the edge owners.
+        /// </summary>
+        void CompileDependents(const vector<int>& edgeOwners);
+#pragma endregion
+    };
+}
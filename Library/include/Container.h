@@ -13,6 +13,8 @@ namespace Plato {
     class Producer;
     class Restrictor;
     class Model;
+    class SpatialIndex;
+    class PointBatch;
 
     /// <summary>
     /// The Container base class is used to model an object with a collection of properties
@@ -37,8 +39,9 @@ namespace Plato {
     /// </remarks>
     class Container : public Property {
     public:
-        typedef hash_map <ClassTypeInfo::ConstClassTypeInfoPtr, vector<Property*>*, ClassTypeInfoHashArgs> HashMap;
-        typedef hash_map <Identifier::ConstIdentifierPtr, Property*, IdentifierHashArgs> HashTable;
+        typedef FlatHashMap<ClassTypeInfo::ConstClassTypeInfoPtr, vector<Property*>*, ClassTypeInfoPtrTraits> HashMap;
+        typedef FlatHashMap<Identifier::ConstIdentifierPtr, Property*, IdentifierPtrTraits> HashTable;
+        typedef FlatHashMap<const Property*, bool, PropertyAddressTraits> AddressSet;
 #pragma region // Class variables.
     public:
         /// <summary>
@@ -57,6 +60,10 @@ namespace Plato {
         /// This is used to initialise the CategorisedProperties table.
         /// </remarks>
         static const ClassTypeInfo::HashSet* PropertyTypes;
+        /// <summary>
+        /// The number of default positions fetched from the geometry at once when containers are added.
+        /// </summary>
+        static const int PositionBatchSize = 32;
 #pragma endregion
 
 #pragma region // Instance variables.
@@ -88,14 +95,25 @@ namespace Plato {
         /// </summary>
         Model* ContainerModel;
         /// <summary>
-        /// The properties in the order they were added.
-        /// </summary>
-        vector<Property*>* OrderedProperties;
-        /// <summary>
         /// The properties stored in a hash table for fast lookup.
         /// </summary>
         HashTable* HashedProperties;
+        /// <summary>
+        /// A stamp renewed whenever a property is added or removed, unique across all containers.
+        /// </summary>
+        /// <remarks>Lets PathMemo tell when a memoised path resolution may have changed.</remarks>
+        long Generation;
     protected:
+        /// <summary>
+        /// The properties in the order they were added.
+        /// </summary>
+        /// <remarks>
+        /// This and the other property tables are made with ModelArena::Create
+        /// and released with ModelArena::Destroy.
+        /// It may hold properties that have been removed, and possibly deleted, until
+        /// Compact is called, so it should be read through GetOrderedProperties.
+        /// </remarks>
+        vector<Property*>* mOrderedProperties;
         /// <summary>
         /// <para>The Categorised Table structured by property type.</para>
         /// This is modelled as a hashtable of OrderedLists:
@@ -107,6 +125,10 @@ namespace Plato {
         /// </summary>
         HashMap* mCategoryCache;
         /// <summary>
+        /// The properties removed since the ordered and category vectors were last compacted.
+        /// </summary>
+        AddressSet* mRemovedProperties;
+        /// <summary>
         /// An optional producer listener that creates new properties on demand.
         /// </summary>
         ProducerListener* mProducerListener;
@@ -122,6 +144,18 @@ namespace Plato {
         /// Indicates that contents should be deleted when destroyed.
         /// </summary>
         bool mDoDelete;
+        /// <summary>
+        /// The positioned properties filed by their spatial coordinates, or NULL until the first is added.
+        /// </summary>
+        SpatialIndex* mSpatialIndex;
+        /// <summary>
+        /// Default positions fetched from the geometry a batch at a time, or NULL until the first is needed.
+        /// </summary>
+        PointBatch* mPositions;
+        /// <summary>
+        /// The index in mPositions of the next default position to hand out.
+        /// </summary>
+        int mNextPosition;
 #pragma endregion
 
 #pragma region // Constructors.
@@ -160,7 +194,7 @@ namespace Plato {
         /// Shallow copies this containers contents into clone container.
         /// </summary>
         /// <remarks>
-        /// The container's tables and vectors are copied by reference.
+        /// The container's tables and vectors are compacted, then copied by reference.
         /// The clone should only be used for reading, otherwise LastOrder will be out of step.
         /// The container's base Property values are not cloned.
         /// </remarks>
@@ -240,7 +274,21 @@ namespace Plato {
         /// <summary>
         /// Gets the number of properties in the table.
         /// </summary>
-        inline int Count() const { return (int)(OrderedProperties->size()); }
+        inline int Count() const { return (int)(mOrderedProperties->size() - mRemovedProperties->size()); }
+
+        /// <summary>
+        /// Gets the properties in the order they were added.
+        /// </summary>
+        /// <returns>Returns the ordered list of properties.</returns>
+        inline vector<Property*>* GetOrderedProperties() const { 
+            if (!mRemovedProperties->empty()) Compact();
+            return mOrderedProperties; }
+
+        /// <summary>
+        /// Gets the index of the properties whose identifiers have a position.
+        /// </summary>
+        /// <returns>Returns the index, or NULL if no positioned property has been added.</returns>
+        inline const SpatialIndex* GetSpatialIndex() const { return mSpatialIndex; }
 
         /// <summary>
         /// Gets the number of properties in the table of the specified category type.
@@ -255,6 +303,7 @@ namespace Plato {
         /// <param name="categoryType">The type of objects to fetch, or NULL to return master table.</param>
         /// <returns>Returns an OrderedList of the objects, or NULL if none of that type.</returns>
         inline vector<Property*>* GetCategory(const ClassTypeInfo& categoryType) const { 
+            if (!mRemovedProperties->empty()) Compact();
             HashMap::iterator itr = mCategorisedProperties->find(&categoryType);
             return itr==mCategorisedProperties->end() ? NULL : itr->second; }
 
@@ -265,11 +314,22 @@ namespace Plato {
         /// </summary>
         /// <remarks>
         /// Searches for type match with the lowest inheritance count.
+        /// The cache may grow, so while the configure threads run this must be called
+        /// with the ConfigureLock held, as Add does.
         /// </remarks>
         /// <param name="type">The type to check for category membership.</param>
         /// <returns>Returns the category list that the type validated against, or NULL if not allowed.</returns>
         vector<Property*>* GetClosestCategory(const ClassTypeInfo& type);
 
+        /// <summary>
+        /// Drops removed properties from the ordered and category vectors.
+        /// </summary>
+        /// <remarks>
+        /// Remove only records the property, so removing many properties costs a single
+        /// pass over the vectors. The accessors call this on demand.
+        /// </remarks>
+        void Compact() const;
+
         /// <summary>
         /// Searches the ordered list of properties for one with the given order.
         /// </summary>
@@ -290,6 +350,14 @@ namespace Plato {
         /// or if not found it returns the bitwise complement of the closest index.
         /// </returns>
         int BinarySearch(int order, const vector<Property*> & searchVector) const;
+    private:
+        /// <summary>
+        /// Drops the removed properties from a vector, keeping the order of the rest.
+        /// </summary>
+        /// <param name="properties">The vector to compact.</param>
+        /// <param name="removed">The properties to drop.</param>
+        static void CompactVector(vector<Property*>& properties, AddressSet& removed);
+    public:
 
         /// <summary>
         /// Uses a binary search to find the property with the given name.
@@ -315,6 +383,11 @@ namespace Plato {
         /// <summary>
         /// Add a property to this container and set its default position.
         /// </summary>
+        /// <remarks>
+        /// The container is changed under the model's ConfigureLock, so the configure threads
+        /// may add to the same container. The lock is released before the model is told of the
+        /// addition, since configuring the new property may add more.
+        /// </remarks>
         /// <param name="prop">The property to add.</param>
         /// <returns>Returns true if added.</returns>
         virtual bool Add(Property& prop);
@@ -345,9 +418,43 @@ namespace Plato {
         /// <summary>
         /// Removes the property from the container's properties.
         /// </summary>
+        /// <remarks>
+        /// The property is dropped from the hash table at once, and from the ordered and
+        /// category vectors when they are next compacted, so removal is amortised O(1).
+        /// While the configure threads run the vectors are compacted at once instead,
+        /// under the ConfigureLock, so that readers never compact them.
+        /// </remarks>
         /// <param name="ident">The identifier of the object to remove.</param>
         /// <returns>Returns the property that was removed, or NULL if not found.</returns>
         Property* Remove(const Identifier& ident);
+
+        /// <summary>
+        /// Compacts the container and caches the category of each type of property it holds.
+        /// </summary>
+        /// <remarks>
+        /// Called on each container before a parallel configure phase, so that the phase's
+        /// readers find nothing to compact and its additions seldom extend the category cache.
+        /// </remarks>
+        void PrepareConfigure();
+    private:
+        /// <summary>
+        /// Adds the property to the tables, with the ConfigureLock held.
+        /// </summary>
+        /// <param name="prop">The property to add.</param>
+        /// <returns>Returns true if added.</returns>
+        bool Insert(Property& prop);
+        /// <summary>
+        /// Removes the property, with the ConfigureLock held.
+        /// </summary>
+        /// <param name="ident">The identifier of the object to remove.</param>
+        /// <returns>Returns the property that was removed, or NULL if not found.</returns>
+        Property* RemoveLocked(const Identifier& ident);
+        /// <summary>
+        /// Removes the property from the hash table and records it for compaction.
+        /// </summary>
+        /// <param name="ident">The identifier of the object to remove.</param>
+        /// <returns>Returns the property that was removed, or NULL if not found.</returns>
+        Property* Discard(const Identifier& ident);
 #pragma endregion
 
 #pragma region // Access methods.
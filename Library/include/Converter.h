@@ -69,6 +69,11 @@ namespace Plato {
         /// <summary>
         /// Apply the converter to all matching element tuples found in the parent container.
         /// </summary>
+        /// <remarks>
+        /// When the model has a ConfigureThreadPool the tuples are found by ProximityRelator::FindMatches
+        /// on the pool, so the relator's ValidRelation must be safe to call concurrently.
+        /// The tuples are applied in the same order either way, on the calling thread.
+        /// </remarks>
         /// <param name="resolutionMode">Indicates the current resolution mode.</param>
         /// <param name="parent">The container of elements to check for application of this converter.</param>
         virtual void Apply(ResolutionModesEnum resolutionMode, Container& parent);
@@ -85,6 +90,7 @@ namespace Plato {
         virtual void Apply(ResolutionModesEnum resolutionMode, Container& parent, vector<Property*> & elements);
 
     private:
+        friend class ConverterTupleReceiver;
         friend class InitializerCatalogue;
         /// <summary>
         /// The class initializer.
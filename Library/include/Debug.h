@@ -9,7 +9,8 @@ namespace Plato {
         /// Send output to console depending on debug level.
         /// A message will only be displayed if DebugLevel >= level.
         /// </summary>
-        /// <remarks>The new line string "\n" is appended to the output.</remarks>
+        /// <remarks>The new line string "\n" is appended to the output.
+        /// The message is formatted and written in the background, see LogWriter.</remarks>
         /// <param name="level">The debug importance of this message,
         /// 0 = high importance, 10 = low importance.</param>
         /// <param name="format">The format string, i.e. message body.</param>
@@ -19,34 +19,35 @@ namespace Plato {
 
 #pragma region // Fields.
     public:
+        // The names below are interned identifiers, so routing lookups allocate nothing.
         /// <summary>
         /// The path name to use for routing non-terminal input paths.
         /// </summary>
-        static const string* InputName;
+        static const Identifier* InputName;
         /// <summary>
         /// The path name to use for routing non-terminal output paths.
         /// </summary>
-        static const string* OutputName;
+        static const Identifier* OutputName;
         /// <summary>
         /// The path name to use for routing
         /// non-terminal paths when neither input or output.
         /// </summary>
-        static const string* DefaultName;
+        static const Identifier* DefaultName;
         /// <summary>
         /// The path name of the default director to use for routing
         /// non-terminal input paths.
         /// </summary>
-        static const string* InputDirectorName;
+        static const Identifier* InputDirectorName;
         /// <summary>
         /// The path name of the default director to use for routing
         /// non-terminal output paths.
         /// </summary>
-        static const string* OutputDirectorName;
+        static const Identifier* OutputDirectorName;
         /// <summary>
         /// The path name of the default director to use for routing
         /// non-terminal paths when neither input or output.
         /// </summary>
-        static const string* DefaultDirectorName;
+        static const Identifier* DefaultDirectorName;
 #pragma endregion
 
         /// <summary>
@@ -56,6 +56,14 @@ namespace Plato {
         /// </summary>
         bool IsInputSafe;
 
+        /// <summary>
+        /// The index of this DID in the model's ConnectionGraph, or -1 if it has not been compiled.
+        /// </summary>
+        /// <remarks>
+        /// Only input safe DIDs with input connections are compiled.
+        /// </remarks>
+        int GraphIndex;
+
 #pragma region // Constructors.
     public:
         /// <summary>
@@ -70,7 +78,7 @@ namespace Plato {
             PropertyScopesEnum scope = PropertyScopes::Public);
 
         /// <summary>
-        /// Deallocate object.
+        /// Deallocate object, removing it from the model's ConnectionGraph.
         /// </summary>
         virtual ~Disposition();
 #pragma endregion
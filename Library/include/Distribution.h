@@ -104,5 +104,14 @@ namespace Plato {
         /// set to NULL for whole space.</param>
         /// <returns>Returns the required coordinate value as a float.</returns>
         virtual float GetCoordinate(CoordinateOperationsEnum operation, CoordinateNamesEnum coordinate, const PointSpace& pointSpace);
+
+        /// <summary>
+        /// Creates the univariate distribution of one coordinate, for geometries that generate
+        /// points a coordinate at a time.
+        /// </summary>
+        /// <remarks>This default implementation returns a uniform distribution.</remarks>
+        /// <param name="coordinate">The coordinate.</param>
+        /// <returns>Returns a new distribution, which the caller deletes.</returns>
+        virtual UnivariateDistribution* CreateUnivariateDistribution(CoordinateNamesEnum coordinate) const;
     };
 }
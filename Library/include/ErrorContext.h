@@ -32,6 +32,11 @@ namespace Plato {
         /// </summary>
         vector<ErrorMessage*>* mErrorMessageStack;
 
+        /// <summary>
+        /// Serialises access from the model's threads.
+        /// </summary>
+        Mutex mLock;
+
     public:
         /// <summary>
         /// Creates a new error context for tracking error messages and exit code.
@@ -172,6 +172,17 @@ namespace Plato {
         /// <param name="filter">The filter to append to this filter.</param>
         void Append(Filter* filter);
 
+    protected:
+        /// <summary>
+        /// Adds the properties found in the source, in the order they were added to it,
+        /// skipping any out of the requester's scope.
+        /// </summary>
+        /// <remarks>
+        /// Used by filters that query the source's SpatialIndex, whose results are unordered.
+        /// </remarks>
+        /// <param name="found">The properties found, which are sorted in place.</param>
+        void AddFound(vector<Property*>& found);
+
     private:
         friend class InitializerCatalogue;
         /// <summary>
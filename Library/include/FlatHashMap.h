@@ -0,0 +1,253 @@
+#pragma once
+
+namespace Plato {
+
+    /// <summary>
+    /// An open addressing hash map using Robin Hood linear probing.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Entries are stored inline in one array of slots, each holding the key, the value and
+    /// the key's hash, so a lookup touches consecutive memory and only compares keys whose
+    /// cached hashes match. On insertion an entry displaces any resident entry that is nearer
+    /// its home slot, which keeps probe sequences short and lets a failed lookup stop as soon
+    /// as it passes entries nearer home than itself. Erasure shifts the following entries back
+    /// instead of leaving tombstones.
+    /// </para>
+    /// <para>
+    /// Traits supplies <c>static size_t Hash(const K&amp;)</c> and
+    /// <c>static bool Equals(const K&amp;, const K&amp;)</c>.
+    /// The interface follows the subset of hash_map used by the library:
+    /// iterators expose first and second, and are invalidated by any insertion or erasure.
+    /// </para>
+    /// </remarks>
+    template<class K, class V, class Traits>
+    class FlatHashMap {
+    public:
+        /// <summary>
+        /// A slot in the table.
+        /// </summary>
+        struct Entry {
+            K first;
+            V second;
+            /// <summary>
+            /// The key's hash with the top bit set, or zero when the slot is empty.
+            /// </summary>
+            size_t Hash;
+        };
+
+        /// <summary>
+        /// Iterates over the occupied slots.
+        /// </summary>
+        class iterator {
+        public:
+            inline iterator() : mEntry(NULL), mEnd(NULL) {}
+            inline iterator(Entry* entry, Entry* end) : mEntry(entry), mEnd(end) { Skip(); }
+            inline Entry& operator*() const { return *mEntry; }
+            inline Entry* operator->() const { return mEntry; }
+            inline iterator& operator++() { ++mEntry; Skip(); return *this; }
+            inline bool operator==(const iterator& other) const { return mEntry == other.mEntry; }
+            inline bool operator!=(const iterator& other) const { return mEntry != other.mEntry; }
+        private:
+            inline void Skip() { while (mEntry != mEnd && mEntry->Hash == 0) ++mEntry; }
+            Entry* mEntry;
+            Entry* mEnd;
+        };
+
+    private:
+        /// <summary>
+        /// Marks a stored hash as occupied.
+        /// </summary>
+        static const size_t OccupiedBit = ((size_t)1) << (sizeof(size_t) * 8 - 1);
+        /// <summary>
+        /// The capacity allocated by the first insertion.
+        /// </summary>
+        static const size_t MinimumCapacity = 8;
+
+#pragma region // Instance variables.
+    private:
+        /// <summary>
+        /// The slots, a power of two in number, or NULL before the first insertion.
+        /// </summary>
+        Entry* mEntries;
+        /// <summary>
+        /// The number of slots less one.
+        /// </summary>
+        size_t mMask;
+        /// <summary>
+        /// The number of occupied slots.
+        /// </summary>
+        size_t mCount;
+#pragma endregion
+
+#pragma region // Constructors.
+    public:
+        /// <summary>
+        /// Creates an empty map. No memory is allocated until the first insertion.
+        /// </summary>
+        inline FlatHashMap() : mEntries(NULL), mMask(0), mCount(0) {}
+        /// <summary>
+        /// Releases the slots.
+        /// </summary>
+        inline ~FlatHashMap() { delete[] mEntries; }
+    private:
+        FlatHashMap(const FlatHashMap&);
+        FlatHashMap& operator=(const FlatHashMap&);
+#pragma endregion
+
+#pragma region // Accessors.
+    public:
+        inline size_t size() const { return mCount; }
+        inline bool empty() const { return mCount == 0; }
+        /// <summary>
+        /// Gets the number of slots.
+        /// </summary>
+        inline size_t capacity() const { return mEntries == NULL ? 0 : mMask + 1; }
+        inline iterator begin() { return mEntries == NULL ? iterator() : iterator(mEntries, mEntries + mMask + 1); }
+        inline iterator end() { return mEntries == NULL ? iterator() : iterator(mEntries + mMask + 1, mEntries + mMask + 1); }
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Finds the entry for a key.
+        /// </summary>
+        /// <returns>Returns an iterator to the entry, or end() if there is none.</returns>
+        iterator find(const K& key) {
+            Entry* e = Find(key, Traits::Hash(key) | OccupiedBit);
+            return e == NULL ? end() : iterator(e, mEntries + mMask + 1);
+        }
+
+        /// <summary>
+        /// Fetches the value for a key, inserting a default value if the key is absent.
+        /// </summary>
+        V& operator[](const K& key) {
+            size_t hash = Traits::Hash(key) | OccupiedBit;
+            Entry* e = Find(key, hash);
+            if (e == NULL) {
+                e = Insert(key, V(), hash);
+            }
+            return e->second;
+        }
+
+        /// <summary>
+        /// Removes the entry for a key.
+        /// </summary>
+        /// <returns>Returns the number of entries removed, zero or one.</returns>
+        size_t erase(const K& key) {
+            Entry* e = Find(key, Traits::Hash(key) | OccupiedBit);
+            if (e == NULL) {
+                return 0;
+            }
+            // Shift the following displaced entries back one slot.
+            size_t index = (size_t)(e - mEntries);
+            for (;;) {
+                size_t next = (index + 1) & mMask;
+                Entry& n = mEntries[next];
+                if (n.Hash == 0 || ((next - n.Hash) & mMask) == 0) {
+                    break;
+                }
+                mEntries[index] = n;
+                index = next;
+            }
+            mEntries[index].Hash = 0;
+            mEntries[index].first = K();
+            mEntries[index].second = V();
+            --mCount;
+            return 1;
+        }
+
+        /// <summary>
+        /// Removes every entry, keeping the slots for reuse.
+        /// </summary>
+        void clear() {
+            if (mEntries != NULL) {
+                for (size_t index = 0; index <= mMask; ++index) {
+                    mEntries[index] = Entry();
+                }
+            }
+            mCount = 0;
+        }
+
+    private:
+        /// <summary>
+        /// Finds the slot holding a key.
+        /// </summary>
+        /// <param name="hash">The key's hash with OccupiedBit set.</param>
+        inline Entry* Find(const K& key, size_t hash) const {
+            if (mEntries == NULL) {
+                return NULL;
+            }
+            size_t index = hash & mMask;
+            for (size_t distance = 0; ; ++distance) {
+                Entry& e = mEntries[index];
+                if (e.Hash == hash && Traits::Equals(e.first, key)) {
+                    return &e;
+                }
+                // Stop at an empty slot or an entry nearer its home than we are to ours.
+                if (e.Hash == 0 || ((index - e.Hash) & mMask) < distance) {
+                    return NULL;
+                }
+                index = (index + 1) & mMask;
+            }
+        }
+
+        /// <summary>
+        /// Inserts a key known to be absent.
+        /// </summary>
+        /// <returns>Returns the slot now holding the key.</returns>
+        Entry* Insert(const K& key, const V& value, size_t hash) {
+            // Keep the load factor below 3/4.
+            if (mEntries == NULL || (mCount + 1) * 4 > (mMask + 1) * 3) {
+                Grow();
+            }
+            Entry entry;
+            entry.first = key;
+            entry.second = value;
+            entry.Hash = hash;
+            Entry* result = NULL;
+            size_t index = hash & mMask;
+            size_t distance = 0;
+            for (;;) {
+                Entry& e = mEntries[index];
+                if (e.Hash == 0) {
+                    e = entry;
+                    ++mCount;
+                    return result == NULL ? &e : result;
+                }
+                // Take the slot of a richer resident and carry it on.
+                size_t residentDistance = (index - e.Hash) & mMask;
+                if (residentDistance < distance) {
+                    Entry tmp = e;
+                    e = entry;
+                    entry = tmp;
+                    distance = residentDistance;
+                    if (result == NULL) {
+                        result = &e;
+                    }
+                }
+                index = (index + 1) & mMask;
+                ++distance;
+            }
+        }
+
+        /// <summary>
+        /// Doubles the number of slots and reinserts the entries.
+        /// </summary>
+        void Grow() {
+            Entry* old = mEntries;
+            size_t oldCapacity = capacity();
+            size_t newCapacity = oldCapacity == 0 ? MinimumCapacity : oldCapacity * 2;
+            mEntries = new Entry[newCapacity]();
+            mMask = newCapacity - 1;
+            mCount = 0;
+            for (size_t index = 0; index < oldCapacity; ++index) {
+                if (old[index].Hash != 0) {
+                    Insert(old[index].first, old[index].second, old[index].Hash);
+                }
+            }
+            delete[] old;
+        }
+#pragma endregion
+    };
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+namespace Plato {
+
+    /// <summary>
+    /// Unit testing class for FlatHashMap.
+    /// </summary>
+    class FlatHashMapTest {
+    public:
+        /// <summary>
+        ///  The Unit Testing method.
+        /// </summary>
+        /// <param name="message">Diagnostic message.</param>
+        /// <returns>Returns the number of failures, or zero on success.</returns>
+        static int ConductUnitTest(string& message);
+        /// <summary>
+        /// Times Identifier lookups in a FlatHashMap against the hash_map it replaced.
+        /// </summary>
+        /// <remarks>
+        /// This is not run with the diagnostics, since it takes a noticeable time, but by BenchmarkModel.
+        /// The keys are looked up in a shuffled order that is the same for every run with the same count.
+        /// </remarks>
+        /// <param name="message">Receives the timings.</param>
+        /// <param name="count">The number of keys in each map.</param>
+        /// <param name="rounds">The number of times every key is looked up.</param>
+        /// <param name="hashMapTime">Receives the nanoseconds per lookup in the hash_map.</param>
+        /// <param name="flatMapTime">Receives the nanoseconds per lookup in the FlatHashMap.</param>
+        /// <returns>Returns the number of failed lookups, which should be zero.</returns>
+        static int ConductBenchmark(string& message, int count, int rounds, double& hashMapTime, double& flatMapTime);
+    };
+}
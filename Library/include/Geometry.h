@@ -9,6 +9,7 @@ namespace Plato {
     class Distribution;
     class Container;
     class PointEnumerator;
+    class PointBatch;
 
     /// <summary>
     /// Geometry base class for modelling the boundary/shape/structure of an element.
@@ -118,6 +119,15 @@ namespace Plato {
         /// </summary>
         virtual ~Geometry();
 
+        /// <summary>
+        /// Allocates geometries from the current model's ModelArena while it is active.
+        /// </summary>
+        static void* operator new(size_t size);
+        /// <summary>
+        /// Releases memory allocated by operator new.
+        /// </summary>
+        static void operator delete(void* memory);
+
         /// <summary>
         /// Getter for the upper value of the coordinates.
         /// </summary>
@@ -154,6 +164,18 @@ namespace Plato {
         /// set to NULL for whole space.</param>
         /// <returns>Returns a point according to a shapes coordinate system.</returns>
         virtual Point* GetPoint(CoordinateOperationsEnum operation, const PointSpace* pointSpace);
+        /// <summary>
+        /// Fills a batch with points according to the specified operation on a shape's
+        /// point distribution.
+        /// </summary>
+        /// <remarks>
+        /// This default implementation calls GetPoint for each point. Geometries that generate
+        /// their points from univariate distributions override it to fill whole coordinate arrays at once.
+        /// </remarks>
+        /// <param name="operation">The operation to perform.</param>
+        /// <param name="batch">The batch to fill, up to its capacity.</param>
+        /// <returns>Returns the number of points filled, which is less than the capacity once the geometry is full.</returns>
+        virtual int GetPoints(CoordinateOperationsEnum operation, PointBatch& batch);
 
         /// <summary>
         /// Retrieves a coordinate value according to the specified operation on a shape's
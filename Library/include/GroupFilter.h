@@ -50,7 +50,7 @@ namespace Plato {
 
         /// <summary>
         /// Re-order the elements in the group as necessary so that
-        /// Container.OrderedProperties returns the required order.
+        /// Container.GetOrderedProperties returns the required order.
         /// </summary>
         /// <remarks>
         /// <para>
@@ -4,6 +4,8 @@ namespace Plato {
 
     class Property;
     class Point;
+    class Symbol;
+    class Mutex;
 
 // IdentifierHashArgs & IdentifierHashCompare are used to deal with STL hash differences between MS STL and SGI STL.
 #ifdef WIN32 
@@ -23,7 +25,13 @@ namespace Plato {
     /// Each term is independent. The optional terms may be NULL.
     /// </summary>
     /// <remarks>
+    /// <para>
     /// A property may optionally be associated with the identifier.
+    /// </para>
+    /// <para>
+    /// Names are interned, so identifiers with equal names share one Symbol
+    /// and are matched by comparing symbols rather than strings.
+    /// </para>
     /// </remarks>
     class Identifier {
     public:
@@ -34,6 +42,10 @@ namespace Plato {
         /// A counter used to generate unique identifiers on demand.
         /// </summary>
         static int mLastIdentifierNumber;
+        /// <summary>
+        /// Serialises the generation of identifier numbers.
+        /// </summary>
+        static Mutex mNumberLock;
 #pragma endregion
 
 #pragma region // Instance variables.
@@ -44,10 +56,15 @@ namespace Plato {
         Property* PropertyPtr;
 
         /// <summary>
-        /// The identifier's name.
+        /// The identifier's name, owned by NameSymbol.
         /// </summary>
         const string* Name;
 
+        /// <summary>
+        /// The interned symbol for Name, or NULL if Name is NULL.
+        /// </summary>
+        const Symbol* NameSymbol;
+
         /// <summary>
         /// The Position value stored as a point.
         /// </summary>
@@ -58,6 +75,11 @@ namespace Plato {
         /// </summary>
         size_t NameHashCode;
 
+        /// <summary>
+        /// Cache of NameSymbol's Id, or -1 if there is no name.
+        /// </summary>
+        int NameId;
+
         /// <summary>
         /// Cache of the identifier's hash code.
         /// </summary>
@@ -70,7 +92,7 @@ namespace Plato {
         /// Construct a new identifier for a property.
         /// </summary>
         /// <remarks>
-        /// A Name string is constructed from name,
+        /// Name is interned from name,
         /// whereas Position is copied by reference.
         /// </remarks>
         /// <param name="name">The property's name.</param>
@@ -81,7 +103,10 @@ namespace Plato {
         /// <summary>
         /// Construct a new identifier for a property.
         /// </summary>
-        /// <remarks>The identifier takes ownership of the parameter objects.</remarks>
+        /// <remarks>
+        /// The identifier takes ownership of the parameter objects.
+        /// The name is interned and deleted.
+        /// </remarks>
         /// <param name="name">The property's name.</param>
         /// <param name="position">The property's position value.</param>
         /// <param name="prop">The property to associate with this identifier.</param>
@@ -98,7 +123,7 @@ namespace Plato {
         /// Construct a new identifier.
         /// </summary>
         /// <remarks>
-        /// A Name string is constructed from name.
+        /// Name is interned from name.
         /// </remarks>
         /// <param name="name">The property's name.</param>
         Identifier(const char* name);
@@ -106,10 +131,17 @@ namespace Plato {
         /// <summary>
         /// Construct a new identifier for a property.
         /// </summary>
-        /// <remarks>The identifier takes ownership of the name string.</remarks>
+        /// <remarks>The identifier takes ownership of the name string, which is interned and deleted.</remarks>
         /// <param name="name">The property's name.</param>
         Identifier(const string& name);
 
+        /// <summary>
+        /// Construct a new identifier from an interned name.
+        /// </summary>
+        /// <remarks>This allocates nothing, so is suited to identifiers made for a lookup.</remarks>
+        /// <param name="name">The property's name.</param>
+        Identifier(const Symbol& name);
+
         /// <summary>
         /// Copy constructor for an Identifier.
         /// </summary>
@@ -122,6 +154,15 @@ namespace Plato {
         /// Deallocates resources.
         /// </summary>
         ~Identifier();
+
+        /// <summary>
+        /// Allocates identifiers from the current model's ModelArena while it is active.
+        /// </summary>
+        static void* operator new(size_t size);
+        /// <summary>
+        /// Releases memory allocated by operator new.
+        /// </summary>
+        static void operator delete(void* memory);
 #pragma endregion
 
 #pragma region // Accessors.
@@ -129,6 +170,7 @@ namespace Plato {
         /// <summary>
         /// Accessor for the identifier's Name.
         /// </summary>
+        /// <remarks>The identifier takes ownership of the name string, which is interned and deleted.</remarks>
         void SetName(const string& name);
 
         /// <summary>
@@ -163,6 +205,33 @@ namespace Plato {
         /// <returns>Returns &lt; 0, if this &lt; obj; 0 if this == obj; &gt; 0, if this &gt; obj. </returns>
         int CompareTo(const Identifier& ident) const;
 
+        /// <summary>
+        /// Compares this identifier to another for hashing purposes.
+        /// </summary>
+        /// <remarks>
+        /// Names are compared by symbol Id, so the order is consistent but not alphabetical.
+        /// As with CompareTo, a NULL term is ignored.
+        /// </remarks>
+        /// <param name="ident">The identifier to compare this with.</param>
+        /// <returns>Returns 0 if the identifiers match, otherwise &lt; 0 or &gt; 0.</returns>
+        inline int CompareKeyTo(const Identifier& ident) const {
+            if (NameSymbol != ident.NameSymbol && NameSymbol != NULL && ident.NameSymbol != NULL) {
+                return NameId < ident.NameId ? -1 : 1;
+            }
+            return (Position == NULL || ident.Position == NULL) ? 0 : ComparePositionTo(ident);
+        }
+    private:
+        /// <summary>
+        /// Sets the name terms and the hash code from an interned name.
+        /// </summary>
+        /// <param name="symbol">The interned name, or NULL.</param>
+        void SetSymbol(const Symbol* symbol);
+        /// <summary>
+        /// Compares the non NULL positions of this and another identifier.
+        /// </summary>
+        int ComparePositionTo(const Identifier& ident) const;
+    public:
+
 #pragma region // DEBUG: These methods show be phased out for ones that use Points and Container.LastOrderID.
         /// <summary>
         /// Auto generates a new unique number for creating identifier names.
@@ -187,6 +256,23 @@ namespace Plato {
 #pragma endregion
     };
 
+    /// <summary>
+    /// Traits class for FlatHashMap tables keyed by Identifier*.
+    /// </summary>
+    class IdentifierPtrTraits {
+    public:
+        /// <summary>
+        /// Fetches the hash code for the Identifier.
+        /// </summary>
+        inline static size_t Hash(const Identifier::ConstIdentifierPtr& key) { return key->HashCode; }
+        /// <summary>
+        /// Tests whether two identifiers match, comparing names by symbol.
+        /// </summary>
+        inline static bool Equals(const Identifier::ConstIdentifierPtr& xKey, const Identifier::ConstIdentifierPtr& yKey) {
+            return xKey == yKey || xKey->CompareKeyTo(*yKey) == 0;
+        }
+    };
+
     /// <summary>
     /// Traits class for Identifier* hash_compare.
     /// </summary>
@@ -210,8 +296,9 @@ namespace Plato {
         /// <summary>
         /// Less comparator for Identifiers, used for ordering purposes.
         /// </summary>
+        /// <remarks>Names are matched by symbol, not by string comparison.</remarks>
         inline bool operator()(const Identifier::ConstIdentifierPtr &xKey, const Identifier::ConstIdentifierPtr & yKey) const {
-		    return IdentifierHashCompare(xKey->CompareTo(*yKey),0);
+		    return IdentifierHashCompare(xKey->CompareKeyTo(*yKey),0);
 		}
     };
 }
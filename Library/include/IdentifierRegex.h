@@ -5,6 +5,7 @@ namespace Plato {
     class PointRegex;
     class RegexMatcher;
     class Identifier;
+    class Symbol;
 
     /// <summary>
     /// This class holds intermediary precompiled identifier Regex terms
@@ -43,6 +44,11 @@ namespace Plato {
         /// </summary>
         bool mNameIsRegex;
         /// <summary>
+        /// When Name is an exact literal such as "^in$", the interned name it matches,
+        /// so Match can compare symbols instead of text. Otherwise NULL.
+        /// </summary>
+        const Symbol* mNameSymbol;
+        /// <summary>
         /// Indicates whether TypeName is the wild pattern.
         /// </summary>
         bool mTypeNameIsWild;
@@ -93,6 +99,13 @@ namespace Plato {
         /// <returns>Returns true if the identifier matches.</returns>
         bool Match(const Identifier& ident) const;
 
+    private:
+        /// <summary>
+        /// Sets mNameSymbol from the compiled Name.
+        /// </summary>
+        void SetNameSymbol();
+    public:
+
         /// <summary>
         /// Determines whether the given regex identifier would match this regex identifier pattern.
         /// </summary>
@@ -57,6 +57,11 @@ namespace Plato {
         /// </summary>
         vector<InputConnection*>* InputConnections;
 
+        /// <summary>
+        /// The index of this pad in the model's ConnectionGraph, or -1 if the pad has not been compiled.
+        /// </summary>
+        int GraphIndex;
+
         /// <summary>
         /// Create a new input pad.
         /// </summary>
@@ -76,9 +81,37 @@ namespace Plato {
         /// </summary>
         /// <param name="outputPad">The source of the new connection.</param>
         /// <param name="connector">The originating Connector for this connection.</param>
+        /// <remarks>
+        /// A pad compiled into the model's ConnectionGraph by a Freeze that released the connections
+        /// cannot take new connections.
+        /// </remarks>
         /// <returns>Returns true if connection added successfully.</returns>
         bool Add(OutputPad& outputPad, Connector& connector);
 
+        /// <summary>
+        /// Gets the number of connections into this pad.
+        /// </summary>
+        /// <returns>Returns the number of input connections.</returns>
+        int GetInputCount() const;
+
+        /// <summary>
+        /// Copies the current values of the pad's input connections.
+        /// </summary>
+        /// <remarks>
+        /// When the model is frozen the values are gathered through the ConnectionGraph,
+        /// otherwise the InputConnections are followed to their OutputPads.
+        /// </remarks>
+        /// <param name="values">Receives GetInputCount() values.</param>
+        /// <returns>Returns the number of values copied.</returns>
+        int GatherInputs(float* values) const;
+
+        /// <summary>
+        /// Copies the SignalArena slots of the OutputPads connected to this pad.
+        /// </summary>
+        /// <param name="signals">Receives GetInputCount() slot indexes.</param>
+        /// <returns>Returns the number of slots copied.</returns>
+        int GetInputSignals(int* signals) const;
+
     private:
         friend class InitializerCatalogue;
         /// <summary>
@@ -4,7 +4,8 @@ namespace Plato {
 
     class Geometry;
     class Distribution;
-    class DistributionEnumerator;
+    class UnivariateDistribution;
+    class PointBatch;
     class Bounds;
     class Scale;
     class Point;
@@ -18,24 +19,20 @@ namespace Plato {
     class LayerGeometry : public Geometry {
     private:
         /// <summary>
-        /// The point X axis distribution for this shape instance.
+        /// The point X axis distribution for this shape instance, created when the first point is allocated.
         /// </summary>
-        Distribution* mDX;
+        UnivariateDistribution* mDX;
 
         /// <summary>
-        /// Used to allocate new points in conjunction with mEY, <see cref="Plato::PipeGeometry::GetPoint"/>.
+        /// The point Y axis distribution for this shape instance, created when the first point is allocated.
         /// </summary>
-        DistributionEnumerator* mEX;
+        UnivariateDistribution* mDY;
 
         /// <summary>
-        /// The point Y axis distribution for this shape instance.
+        /// The X and Y indices of the next new point, <see cref="Plato::LayerGeometry::GetPoints"/>.
         /// </summary>
-        Distribution* mDY;
-
-        /// <summary>
-        /// Used to allocate new points in conjunction with mEX, <see cref="Plato::PipeGeometry::GetPoint"/>.
-        /// </summary>
-        DistributionEnumerator* mEY;
+        int mNextColumn;
+        int mNextRow;
 
     public:
         /// <summary>
@@ -59,6 +56,11 @@ namespace Plato {
         /// <param name="capacityY">The maximum number of points in the Y dimension this layer can contain.</param>
         LayerGeometry(int capacityX, int capacityY);
 
+        /// <summary>
+        /// Release resources.
+        /// </summary>
+        ~LayerGeometry();
+
         /// <summary>
         /// Initialises and resets the pipe and new point allocator.
         /// </summary>
@@ -77,5 +79,14 @@ namespace Plato {
         /// <returns>Returns a point derived from Point according to a shapes
         /// coordinate system.</returns>
         virtual Point* GetPoint(CoordinateOperationsEnum operation, const PointSpace& pointSpace);
+
+        /// <summary>
+        /// Fills a batch with the next new points, generating each coordinate array in one pass
+        /// over the univariate distributions.
+        /// </summary>
+        /// <param name="operation">The operation to perform: only New is batched.</param>
+        /// <param name="batch">The batch to fill, up to its capacity.</param>
+        /// <returns>Returns the number of points filled, which is less than the capacity once the layer is full.</returns>
+        virtual int GetPoints(CoordinateOperationsEnum operation, PointBatch& batch);
     };
 }
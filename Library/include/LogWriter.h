@@ -0,0 +1,163 @@
+#pragma once
+
+namespace Plato {
+
+    /// <summary>
+    /// Writes the Trace, Debug and Error console messages from a background thread.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each thread that writes a message gets its own ring of fixed size records, which only it
+    /// writes and only the writer thread reads, so adding a message takes no lock.
+    /// A record holds the format pointer and a copy of the arguments the format refers to,
+    /// strings included, and the writer thread formats the messages, orders them by when they
+    /// were added and writes them to cerr. Formats must therefore be string literals or
+    /// otherwise outlive the message, as they are throughout the library.
+    /// </para>
+    /// <para>
+    /// A message is cut at MessageSize characters, and arguments that do not fit in a record are
+    /// shown as "...". When a thread's ring is full the message is dropped rather than waiting,
+    /// and the writer reports the number dropped.
+    /// Until the class is initialised, and after it is finalised, messages are written directly.
+    /// </para>
+    /// <para>
+    /// A thread that ends while the writer is running should call ReleaseRing, as the ThreadPool
+    /// workers do, so that its ring is freed once its messages are written.
+    /// </para>
+    /// </remarks>
+    class LogWriter {
+    public:
+        /// <summary>
+        /// The largest number of characters in a message written.
+        /// </summary>
+        static const int MessageSize = 512;
+        /// <summary>
+        /// The size in bytes of a record, including its captured arguments.
+        /// </summary>
+        static const int RecordSize = 256;
+        /// <summary>
+        /// The number of records in each thread's ring.
+        /// </summary>
+        static const int RingSize = 2048;
+
+        struct Ring;
+
+#pragma region // Class variables.
+    private:
+        /// <summary>
+        /// The thread local key holding each thread's ring.
+        /// </summary>
+        static ThreadLocalVariable::Key mRingKey;
+        /// <summary>
+        /// The rings of every thread that has written a message, guarded by mRingsLock.
+        /// </summary>
+        static vector<Ring*>* mRings;
+        static Mutex* mRingsLock;
+        /// <summary>
+        /// The number of threads in Write, Flush or ReleaseRing that saw the writer running,
+        /// which Finalizer waits for before freeing the rings.
+        /// </summary>
+        static Atomic::Value mUserCount;
+        /// <summary>
+        /// The order of the next message, across all threads.
+        /// </summary>
+        static Atomic::Value mSequence;
+        /// <summary>
+        /// The number of messages dropped because a ring was full.
+        /// </summary>
+        static Atomic::Value mDropCount;
+        /// <summary>
+        /// Set while the writer thread is running.
+        /// </summary>
+        static volatile bool mIsRunning;
+        /// <summary>
+        /// Signals the writer thread to write the remaining messages and exit.
+        /// </summary>
+        static volatile bool mIsStopping;
+#ifdef WIN32
+        typedef HANDLE ThreadHandle;
+#else
+        typedef pthread_t ThreadHandle;
+#endif
+        /// <summary>
+        /// The writer thread.
+        /// </summary>
+        static ThreadHandle mThread;
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Adds a message to be formatted and written by the writer thread.
+        /// </summary>
+        /// <remarks>The new line string "\n" is appended to the output.</remarks>
+        /// <param name="format">The format string, which must outlive the message.</param>
+        /// <param name="arguments">The message arguments.</param>
+        static void Write(const char* format, va_list arguments);
+
+        /// <summary>
+        /// Waits until the messages added so far have been written.
+        /// </summary>
+        static void Flush();
+
+        /// <summary>
+        /// Gets the number of messages dropped because a thread's ring was full.
+        /// </summary>
+        inline static long GetDropCount() { return mDropCount; }
+
+        /// <summary>
+        /// Gets the number of threads' rings held, including released rings not yet written out.
+        /// </summary>
+        static int GetRingCount();
+
+        /// <summary>
+        /// Releases the calling thread's ring, which is freed once its messages have been written.
+        /// </summary>
+        /// <remarks>Call before a thread ends. A later message from the thread gets a new ring.</remarks>
+        static void ReleaseRing();
+
+        /// <summary>
+        /// Formats a message into a buffer, at most size - 1 characters and a terminating null.
+        /// </summary>
+        /// <returns>Returns the number of characters written.</returns>
+        static int Format(char* buffer, int size, const char* format, va_list arguments);
+
+        /// <summary>
+        /// The class initializer, which starts the writer thread.
+        /// </summary>
+        static void Initializer();
+        /// <summary>
+        /// The class finalizer, which writes the remaining messages and stops the writer thread.
+        /// </summary>
+        static void Finalizer();
+    private:
+        /// <summary>
+        /// Marks the calling thread as using the rings, returning false if the writer is not running.
+        /// </summary>
+        /// <remarks>Call EndUse when done, whatever the result.</remarks>
+        static bool BeginUse();
+        /// <summary>
+        /// Marks the calling thread as done with the rings.
+        /// </summary>
+        inline static void EndUse() { Atomic::Decrement(&mUserCount); }
+        /// <summary>
+        /// Gets the calling thread's ring, creating it on first use.
+        /// </summary>
+        static Ring& GetRing();
+        /// <summary>
+        /// Frees the released rings that are empty, then formats and writes the messages in the rings.
+        /// </summary>
+        /// <returns>Returns the number of messages written.</returns>
+        static int Drain();
+        /// <summary>
+        /// The writer thread main loop.
+        /// </summary>
+        static void WriterLoop();
+#ifdef WIN32
+        static DWORD WINAPI WriterStart(LPVOID arg);
+#else
+        static void* WriterStart(void* arg);
+#endif
+#pragma endregion
+    };
+}
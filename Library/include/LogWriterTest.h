@@ -0,0 +1,17 @@
+#pragma once
+
+namespace Plato {
+
+    /// <summary>
+    /// Unit testing class for LogWriter.
+    /// </summary>
+    class LogWriterTest {
+    public:
+        /// <summary>
+        ///  The Unit Testing method.
+        /// </summary>
+        /// <param name="message">Diagnostic message.</param>
+        /// <returns>Returns the number of failures, or zero on success.</returns>
+        static int ConductUnitTest(string& message);
+    };
+}
@@ -9,6 +9,16 @@ namespace Plato {
     class Container;
     class Model;
     class Connector;
+    class ThreadPool;
+    class SignalArena;
+    class ConnectionGraph;
+    class ChangeTracker;
+    class ModelArena;
+    class PathMemo;
+    class RandomStream;
+    class Checkpointer;
+    class Profiler;
+    class Mutex;
 
     /// <summary>
     /// This is the base class for Models.
@@ -28,13 +38,15 @@ namespace Plato {
     /// Configuration of elements through method Configure.
     /// </description></item>
     /// </para>
+    /// <para>
+    /// A process can host several independent models, constructed, configured and run concurrently
+    /// on different threads or in turn on one thread. Each thread has a current model, which is made
+    /// by the constructor and held by the model control methods, see CurrentModelScope.
+    /// The library is initialized by the first model constructed and finalized by the last deleted.
+    /// </para>
     /// </remarks>
     class Model : public Container {
     public:
-        /// <summary>
-        /// The type of the current connector stack.
-        /// </summary>
-        typedef stack<Connector*> ConnectorStack;
         /// <summary>
         /// The type of the current container stack.
         /// </summary>
@@ -59,6 +71,13 @@ namespace Plato {
         /// Fetches the Model object for the current thread.
         /// </summary>
         inline static Model& Current() { return *((Model*)ThreadLocalVariable::GetVariableValue(mThreadContextKey)); }
+        /// <summary>
+        /// Fetches the Model object for the current thread, or NULL if there is none.
+        /// </summary>
+        /// <remarks>Unlike Current, this is safe to call before the library is initialized.</remarks>
+        inline static Model* FindCurrent() { 
+            return TypeInfo == NULL ? NULL : (Model*)ThreadLocalVariable::GetVariableValue(mThreadContextKey); 
+        }
 
     private:
         /// <summary>
@@ -67,12 +86,32 @@ namespace Plato {
         static ThreadLocalVariable::Key mThreadContextKey;
 
         /// <summary>
-        /// Tracks the number of model objects.
+        /// The thread local variable key holding the connector being applied by the thread.
+        /// </summary>
+        static ThreadLocalVariable::Key mConnectorKey;
+
+        /// <summary>
+        /// Tracks the number of model objects, guarded by mLibraryLock.
         /// </summary>
         /// <remarks>
         /// This is used to control library initialization and finalization.
         /// </remarks>
         static int mNumberOfModels;
+        /// <summary>
+        /// Serialises the construction and destruction of models on different threads
+        /// while the library is initialized and finalized.
+        /// </summary>
+        static Mutex mLibraryLock;
+        /// <summary>
+        /// The number of Ctrl-Cs, each of which stops every model running in the process.
+        /// </summary>
+        /// <remarks>
+        /// Run stops when the count changes from its value when Run started,
+        /// so an interrupt stops the runs in progress but not later ones.
+        /// </remarks>
+        static volatile long mInterruptCount;
+
+        friend class CurrentModelScope;
 #pragma endregion
 
 #pragma region // Instance variables.
@@ -106,19 +145,72 @@ namespace Plato {
         /// </summary>
         ErrorContext* ModelErrorContext;
         /// <summary>
-        /// A cache of the current connector being processed for model.
+        /// When traversing the container hierarchy a stack is maintained of the prior
+        /// CurrentContainer. Similar to pushd and popd.
         /// </summary>
-        Connector* CurrentConnector;
+        ContainerStack* CurrentContainerStack;
         /// <summary>
-        /// A stack of the Connectors in the process of being resolved.
+        /// The worker threads used to update the model in parallel,
+        /// or NULL when updating serially.
         /// </summary>
-        /// <remarks>Used to track the current connector for the model.</remarks>
-        ConnectorStack* CurrentConnectorStack;
+        /// <remarks>Created by Run according to Configuration::UpdateThreads.</remarks>
+        ThreadPool* UpdateThreadPool;
         /// <summary>
-        /// When traversing the container hierarchy a stack is maintained of the prior
-        /// CurrentContainer. Similar to pushd and popd.
+        /// The worker threads used to configure the model's elements in parallel,
+        /// or NULL when configuring serially.
         /// </summary>
-        ContainerStack* CurrentContainerStack;
+        /// <remarks>Exists only while Configure runs, according to Configuration::ConfigureThreads.</remarks>
+        ThreadPool* ConfigureThreadPool;
+        /// <summary>
+        /// Serialises the changes the configure threads make to containers and pads,
+        /// or NULL when configuring serially.
+        /// </summary>
+        /// <remarks>Exists alongside the ConfigureThreadPool, and is held through a ConfigureLock.</remarks>
+        Mutex* ConfigureMutex;
+        /// <summary>
+        /// The double buffered output values of the model's OutputPads.
+        /// </summary>
+        SignalArena* ModelSignals;
+        /// <summary>
+        /// The compiled pad connections, or NULL if the model has not been frozen.
+        /// </summary>
+        ConnectionGraph* ModelConnections;
+        /// <summary>
+        /// Tracks the Dispositions needing an update when Configuration::IncrementalUpdates is set,
+        /// otherwise NULL.
+        /// </summary>
+        /// <remarks>Created by Freeze, since it depends on ModelConnections.</remarks>
+        ChangeTracker* ModelChanges;
+        /// <summary>
+        /// The allocator for the properties built during construction and configuration.
+        /// </summary>
+        /// <remarks>
+        /// Active from the end of the Model constructor until Configure has applied the converters,
+        /// when Configuration::UseModelArena is set. The arena only grows: deleting an object carved
+        /// from it, e.g. a property removed during configuration, does not return its memory, which
+        /// is held until the model is destroyed.
+        /// </remarks>
+        ModelArena* ModelMemory;
+        /// <summary>
+        /// The path resolutions memoised by Path::GetProperty,
+        /// or NULL unless Configuration::MemoisePaths is set.
+        /// </summary>
+        PathMemo* ResolutionMemo;
+        /// <summary>
+        /// Writes the checkpoints taken while the model runs, or NULL when not checkpointing.
+        /// </summary>
+        /// <remarks>Created by Run according to Configuration::CheckpointInterval.</remarks>
+        Checkpointer* ModelCheckpoints;
+        /// <summary>
+        /// Counts and times the model's updates, or NULL when not profiling.
+        /// </summary>
+        /// <remarks>Created by Run according to Configuration::ProfileUpdates.</remarks>
+        Profiler* ModelProfile;
+        /// <summary>
+        /// The model's Configuration::PathPrefix with its environment variables expanded,
+        /// or NULL until Path::GetPathPrefix first needs it.
+        /// </summary>
+        string* ModelPathPrefix;
 #pragma endregion
 
 #pragma region // Constructors.
@@ -141,6 +233,19 @@ namespace Plato {
         /// Make sure model gets unloaded.
         /// </summary>
         virtual ~Model();
+        /// <summary>
+        /// Allocates a model from the heap.
+        /// </summary>
+        /// <remarks>
+        /// A model, and the objects its constructor creates before it becomes current, are never allocated
+        /// from the ModelArena of another model current on the thread, since they may outlive that model.
+        /// The thread has no current model until the constructor makes the new one current.
+        /// </remarks>
+        static void* operator new(size_t size);
+        /// <summary>
+        /// Releases memory allocated by operator new.
+        /// </summary>
+        static void operator delete(void* memory);
 #pragma endregion
 
 #pragma region // General methods.
@@ -153,14 +258,27 @@ namespace Plato {
             return CurrentContainerStack->empty() ? NULL : CurrentContainerStack->top();
         }
         /// <summary>
-        /// Make this connector the current connector being processed.
+        /// Gets the connector being applied by the calling thread, or NULL if none.
+        /// </summary>
+        inline static Connector* GetCurrentConnector() {
+            return (Connector*)ThreadLocalVariable::GetVariableValue(mConnectorKey);
+        }
+        /// <summary>
+        /// Make this connector the current connector being processed by the calling thread.
         /// </summary>
-        /// <param name="connector">The connector to push onto the stack and make current.</param>
-        void PushCurrentConnector(Connector& connector);
+        /// <remarks>
+        /// The current connector is held per thread so that subtrees can be configured concurrently.
+        /// Connectors applied while another is being applied restore it with PopCurrentConnector,
+        /// so the previous connectors are kept on the caller's stack.
+        /// </remarks>
+        /// <param name="connector">The connector to make current.</param>
+        /// <returns>Returns the previous current connector, to pass to PopCurrentConnector.</returns>
+        static Connector* PushCurrentConnector(Connector& connector);
         /// <summary>
         /// Restore the current connector to its previous value.
         /// </summary>
-        void PopCurrentConnector();
+        /// <param name="previous">The value returned by the matching PushCurrentConnector.</param>
+        static void PopCurrentConnector(Connector* previous);
         /// <summary>
         /// Attempts to fetch the named property's value from the model container.
         /// </summary>
@@ -170,8 +288,23 @@ namespace Plato {
         /// <summary>
         /// Produces a summary descriptio of this model object.
         /// </summary>
+        /// <remarks>When the model is profiling, the profile's report follows the summary.</remarks>
         /// <returns>Returns information on the model.</returns>
         string& StatusReport();
+        /// <summary>
+        /// Creates the random stream of a property for the current epoch.
+        /// </summary>
+        /// <remarks>
+        /// The stream is keyed by Configuration::RandomSeed and a stream number folded from the Order
+        /// of the property and of each of its parents, and starts at the current EpochTime.
+        /// It therefore gives the same values in every run of the same model, whichever thread
+        /// draws them and in whatever order the properties are updated.
+        /// Call RandomStream::SetEpoch to reuse the stream in later epochs.
+        /// RandomDistribution draws the points of its owner's geometry from this stream.
+        /// </remarks>
+        /// <param name="prop">The property drawing the values.</param>
+        /// <returns>Returns a new stream.</returns>
+        RandomStream* CreateRandomStream(const Property& prop) const;
 #pragma endregion
 
 #pragma region // Model control methods.
@@ -179,28 +312,78 @@ namespace Plato {
         /// <summary>
         /// Save model state to file.
         /// </summary>
+        /// <remarks>
+        /// Writes a ModelSnapshot of the configured model: its properties, connections and signals.
+        /// </remarks>
         /// <param name="archivePath">The path and filename to save state to, or NULL to use prior value.</param>
         /// <returns>Returns 0 if successful, otherwise error code.</returns>
         int Save(string* archivePath);
 
         /// <summary>
-        /// Load model state from file.
+        /// Load model state from file, in place of Configure.
         /// </summary>
+        /// <remarks>
+        /// <para>
+        /// Call on a model built by the same code as the one saved, instead of Configure.
+        /// The distributors are applied to rebuild the elements, then the snapshot's connections and
+        /// signals are restored onto the pads, skipping the path resolution of the connector and
+        /// converter phases, and the epoch time is restored.
+        /// </para>
+        /// <para>
+        /// Properties that the connectors or converters would have created, such as transducers,
+        /// are not recreated: the connections they made are restored directly.
+        /// </para>
+        /// <para>
+        /// The snapshot file is mapped and its tables used in place where the platform allows,
+        /// so only the output pads' signals and the input pads' connections are copied into the model.
+        /// Load still takes time in proportion to the size of the model: the distributors rebuild
+        /// every element and Restore visits every record, touching every page of the snapshot.
+        /// What mapping saves is the copy of the file, and the pages are shared by the processes
+        /// loading the same snapshot rather than each holding its own.
+        /// </para>
+        /// <para>
+        /// The deltas of a checkpoint written by Run are then replayed, see Checkpointer.
+        /// </para>
+        /// </remarks>
         /// <param name="archivePath">The path and filename to load state from, or NULL to use prior value.</param>
-        /// <returns>Returns model object if successful, otherwise NULL.</returns>
-        static Model* Load(string& archivePath);
+        /// <returns>Returns 0 if successful, otherwise error code.</returns>
+        int Load(string* archivePath);
 
         /// <summary>
         /// Run the model for the specified number of epochs.
         /// </summary>
         /// <remarks>
+        /// <para>
         /// The Run method can be called repeatedly for certain types of models.
+        /// </para>
+        /// <para>
+        /// When Configuration::CheckpointInterval is set, a checkpoint of the model is written to the
+        /// ArchivePath in the background every CheckpointInterval epochs, and Run waits for the
+        /// last one to be written before returning. A crashed model is resumed with Load.
+        /// </para>
+        /// <para>
+        /// When Configuration::ProfileUpdates is set, the updates and epochs are counted and timed
+        /// across runs, see Profiler, and written to the ProfilePath, if any, before returning.
+        /// </para>
+        /// <para>
+        /// Run stops early when StopEvent is set, or on Ctrl-C. Ctrl-C stops every model running at
+        /// the time, and the models can be run again afterwards.
+        /// </para>
         /// </remarks>
         /// <param name="numberOfEpochs">Number of epochs to run model for.
         /// If numberOfEpochs &lt; 0, the number of epochs will be infinite.
         /// </param>
         /// <returns>Returns 0 if successful, otherwise error code.</returns>
         int Run(long numberOfEpochs);
+    private:
+        /// <summary>
+        /// Advances the model by one epoch.
+        /// </summary>
+        void RunEpoch();
+        /// <summary>
+        /// Takes a checkpoint when one is due at the current epoch time.
+        /// </summary>
+        void CheckpointEpoch();
 #pragma endregion
 
 #pragma region // Epoch updating methods.
@@ -219,8 +402,23 @@ namespace Plato {
         /// <summary>
         /// Helper method that calls Update on the objects in the enumeration.
         /// </summary>
+        /// <remarks>
+        /// When the current model has an UpdateThreadPool the objects are split into ranges
+        /// that are updated concurrently, and the call returns once every range is complete.
+        /// This relies on the OutputPad double buffering: during an epoch containers read
+        /// the current buffer and write only the next buffer of their own pads,
+        /// so the result does not depend on the order in which containers are updated.
+        /// </remarks>
         /// <param name="properties">The properties that implement Update().</param>
         static void Update(vector<Property*>& properties);
+
+        /// <summary>
+        /// Calls Update on the emulated containers in a range of the properties.
+        /// </summary>
+        /// <param name="properties">The properties that implement Update().</param>
+        /// <param name="first">The index of the first property to update.</param>
+        /// <param name="last">One past the index of the last property to update.</param>
+        static void Update(vector<Property*>& properties, size_t first, size_t last);
 #pragma endregion
 
 #pragma region // Methods for the configuration process.
@@ -301,13 +499,69 @@ namespace Plato {
         /// </remarks>
         int Configure();
 
+        /// <summary>
+        /// Compiles the model's pad connections into ModelConnections.
+        /// </summary>
+        /// <remarks>
+        /// This is called at the end of Configure when Configuration::FreezeConnections
+        /// or Configuration::IncrementalUpdates is set, and recreates ModelChanges for the new graph.
+        /// It may be called again to pick up connections added since the last freeze,
+        /// unless the connections were released by a previous call.
+        /// </remarks>
+        /// <param name="releaseConnections">When true, the InputConnection objects of
+        /// compiled pads are deleted, leaving the graph as the only copy of the wiring.</param>
+        /// <returns>Returns the compiled graph.</returns>
+        ConnectionGraph& Freeze(bool releaseConnections);
+
+        /// <summary>
+        /// Indicates whether Freeze has released the pads' InputConnections.
+        /// </summary>
+        /// <remarks>Connections can then no longer be added to the compiled pads, see InputPad::Add.</remarks>
+        inline bool IsConnectionsReleased() const { return mIsConnectionsReleased; }
+
     private:
+        /// <summary>
+        /// Set once Freeze has released the pads' InputConnections.
+        /// </summary>
+        bool mIsConnectionsReleased;
+
+        /// <summary>
+        /// The type of ApplyDistributors, ApplyConnectors and ApplyConverters.
+        /// </summary>
+        typedef void (Model::*PhaseMethod)(Container& container, size_t firstElement);
+        friend class ModelConfigureTask;
+
+        /// <summary>
+        /// Applies one configuration phase to the whole model.
+        /// </summary>
+        /// <remarks>
+        /// With a ConfigureThreadPool, the phase is applied to each composite element of the model
+        /// as a separate task, and the model waits for them all before applying the phase to any
+        /// elements added meanwhile and to its own operators. This is the order the serial descent
+        /// follows, so the results match provided each element's distributors and converters only
+        /// add to that element's own subtree.
+        /// Changes to containers and pads are made under the ConfigureLock, and the containers are
+        /// compacted and their category caches filled beforehand, so a connector may reach into
+        /// other elements through parent, absolute and regex paths and connect their pads.
+        /// A task must still not read an element that another task is adding to.
+        /// </remarks>
+        /// <param name="apply">The phase method to apply.</param>
+        void ApplyPhase(PhaseMethod apply);
+
+        /// <summary>
+        /// Prepares a container and its composite elements for a parallel configure phase.
+        /// </summary>
+        /// <param name="container">The root of the containers to prepare.</param>
+        void PrepareContainers(Container& container);
+
 #pragma region // Configure: Distribution stage methods.
         /// <summary>
         /// Performs the distribution phase of configuration.
         /// </summary>
         /// <param name="container">The container to check for distributors.</param>
-        void ApplyDistributors(Container& container);
+        /// <param name="firstElement">The index of the first element to descend into,
+        /// non-zero when the earlier elements have already been configured.</param>
+        void ApplyDistributors(Container& container, size_t firstElement = 0);
 #pragma endregion
 
 #pragma region // Configure: Connector phase methods.
@@ -315,7 +569,9 @@ namespace Plato {
         /// Performs the connector phase of configuration.
         /// </summary>
         /// <param name="container">The container to check for connectors.</param>
-        void ApplyConnectors(Container& container);
+        /// <param name="firstElement">The index of the first element to descend into,
+        /// non-zero when the earlier elements have already been configured.</param>
+        void ApplyConnectors(Container& container, size_t firstElement = 0);
 #pragma endregion
 
 #pragma region // Configure: Converter phase methods.
@@ -323,7 +579,9 @@ namespace Plato {
         /// Performs the converter phase of configuration.
         /// </summary>
         /// <param name="container">The container to check for converters.</param>
-        void ApplyConverters(Container& container);
+        /// <param name="firstElement">The index of the first element to descend into,
+        /// non-zero when the earlier elements have already been configured.</param>
+        void ApplyConverters(Container& container, size_t firstElement = 0);
 #pragma endregion
 
 #pragma region // Methods for dealing with properties added on the fly.
@@ -331,13 +589,15 @@ namespace Plato {
         /// Applies the Distributor and Connector steps in a configuration phase to a container.
         /// </summary>
         /// <param name="container">The container to apply the configuration steps to.</param>
-        void ApplyDistributorsAndConnectors(Container& container);
+        /// <param name="resolutionMode">The resolution mode to apply the steps in.</param>
+        void ApplyDistributorsAndConnectors(Container& container, ResolutionModesEnum resolutionMode);
 
         /// <summary>
         /// Applies all the steps in a configuration phase to a container.
         /// </summary>
         /// <param name="container">The container to apply the configuration steps to.</param>
-        void ApplyAll(Container& container);
+        /// <param name="resolutionMode">The resolution mode to apply the steps in.</param>
+        void ApplyAll(Container& container, ResolutionModesEnum resolutionMode);
 
      public:
         /// <summary>
@@ -411,4 +671,56 @@ namespace Plato {
         /// <param name="sig">The signal id.</param>
         static void SignalHandler(int sig);
     };
+
+    /// <summary>
+    /// Makes a model the calling thread's current model for the lifetime of the object.
+    /// </summary>
+    /// <remarks>
+    /// The model control methods hold one, so that a thread can host several models
+    /// and configure or run each in turn.
+    /// </remarks>
+    class CurrentModelScope {
+    public:
+        /// <summary>
+        /// Makes model current, remembering the thread's current model.
+        /// </summary>
+        inline CurrentModelScope(Model& model) {
+            mPrevious = (Model*)ThreadLocalVariable::GetVariableValue(Model::mThreadContextKey);
+            ThreadLocalVariable::SetVariableValue(Model::mThreadContextKey,(ThreadLocalVariable::ValuePtr)&model);
+        }
+        /// <summary>
+        /// Restores the thread's previous current model.
+        /// </summary>
+        inline ~CurrentModelScope() {
+            ThreadLocalVariable::SetVariableValue(Model::mThreadContextKey,(ThreadLocalVariable::ValuePtr)mPrevious);
+        }
+    private:
+        Model* mPrevious;
+        CurrentModelScope(const CurrentModelScope&);
+        CurrentModelScope& operator=(const CurrentModelScope&);
+    };
+
+    /// <summary>
+    /// Holds a model's ConfigureMutex, if it has one, for the lifetime of the object.
+    /// </summary>
+    /// <remarks>
+    /// Taken by the methods that change a container or pad, so that tasks configuring different
+    /// elements of the model in parallel can add to a container they share. The lock is released
+    /// before any configuration the change triggers, so it is never held twice by a thread.
+    /// </remarks>
+    class ConfigureLock {
+    public:
+        /// <summary>
+        /// Locks the model's ConfigureMutex, unless the model is configuring serially.
+        /// </summary>
+        ConfigureLock(Model& model);
+        /// <summary>
+        /// Unlocks the ConfigureMutex locked by the constructor.
+        /// </summary>
+        ~ConfigureLock();
+    private:
+        Mutex* mMutex;
+        ConfigureLock(const ConfigureLock&);
+        ConfigureLock& operator=(const ConfigureLock&);
+    };
 }
@@ -0,0 +1,153 @@
+#pragma once
+
+namespace Plato {
+
+    /// <summary>
+    /// A bump allocator for the small objects built while a model is constructed and configured.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each Model owns an arena. Types opt in by routing their allocations through
+    /// ModelArena::New and ModelArena::Delete, either with class operator new and delete,
+    /// as Property, Identifier and Geometry do, or with Create and Destroy for library types
+    /// such as the vectors and hash maps inside a Container.
+    /// </para>
+    /// <para>
+    /// While the current model's arena IsActive, New carves the object from a large block,
+    /// otherwise it falls back to the heap. Every allocation is prefixed with a header naming
+    /// its arena, so Delete can tell the two apart. Deleting an arena object only runs its
+    /// destructor: the memory is released in bulk when the arena, and so the model, is destroyed.
+    /// </para>
+    /// <para>
+    /// The model activates its arena once its own constructor has run and deactivates it
+    /// when Configure has finished applying distributors, connectors and converters, so
+    /// objects created and deleted while the model runs are not held until it is destroyed.
+    /// Objects allocated from an arena must not outlive its model.
+    /// </para>
+    /// </remarks>
+    class ModelArena {
+    public:
+        /// <summary>
+        /// The alignment in bytes of the objects handed out.
+        /// </summary>
+        static const int Alignment = 16;
+        /// <summary>
+        /// The size of the first block, and of the largest block the arena grows to.
+        /// </summary>
+        static const int MinimumBlockSize = 64 * 1024;
+        static const int MaximumBlockSize = 1024 * 1024;
+
+#pragma region // Instance variables.
+    public:
+        /// <summary>
+        /// When true, ModelArena::New allocates from this arena if its model is current.
+        /// </summary>
+        bool IsActive;
+    private:
+        /// <summary>
+        /// Precedes every object allocated by New.
+        /// </summary>
+        union Header {
+            /// <summary>
+            /// The arena the object was allocated from, or NULL for the heap.
+            /// </summary>
+            ModelArena* Owner;
+            char Padding[Alignment];
+        };
+        /// <summary>
+        /// The blocks allocated so far.
+        /// </summary>
+        vector<char*> mBlocks;
+        /// <summary>
+        /// The free space remaining in the current block.
+        /// </summary>
+        char* mNext;
+        char* mEnd;
+        /// <summary>
+        /// The size of the next block to allocate.
+        /// </summary>
+        size_t mBlockSize;
+        /// <summary>
+        /// The number of bytes allocated in blocks, and handed out from them.
+        /// </summary>
+        size_t mReservedBytes;
+        size_t mUsedBytes;
+        /// <summary>
+        /// Serialises allocation by threads sharing the model.
+        /// </summary>
+        Mutex mLock;
+#pragma endregion
+
+#pragma region // Constructors.
+    public:
+        /// <summary>
+        /// Creates an inactive, empty arena.
+        /// </summary>
+        ModelArena();
+        /// <summary>
+        /// Releases every block, and with them every object allocated from the arena.
+        /// </summary>
+        ~ModelArena();
+    private:
+        ModelArena(const ModelArena&);
+        ModelArena& operator=(const ModelArena&);
+#pragma endregion
+
+#pragma region // Accessors.
+    public:
+        /// <summary>
+        /// Gets the number of bytes reserved in blocks.
+        /// </summary>
+        inline size_t ReservedBytes() const { return mReservedBytes; }
+        /// <summary>
+        /// Gets the number of bytes handed out, including headers and padding.
+        /// </summary>
+        inline size_t UsedBytes() const { return mUsedBytes; }
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Allocates memory from the current model's arena if it is active, otherwise from the heap.
+        /// </summary>
+        /// <param name="size">The number of bytes required.</param>
+        /// <returns>Returns memory aligned to ModelArena::Alignment, to be released with Delete.</returns>
+        static void* New(size_t size);
+        /// <summary>
+        /// Releases memory returned by New.
+        /// </summary>
+        /// <remarks>Heap memory is freed immediately, arena memory when its arena is destroyed.</remarks>
+        /// <param name="memory">The memory to release, or NULL.</param>
+        static void Delete(void* memory);
+        /// <summary>
+        /// Constructs an object with memory from New.
+        /// </summary>
+        template<class T> inline static T* Create() { return new (New(sizeof(T))) T(); }
+        /// <summary>
+        /// Copy constructs an object with memory from New.
+        /// </summary>
+        /// <param name="value">The value to copy.</param>
+        template<class T, class A> inline static T* Create(const A& value) { return new (New(sizeof(T))) T(value); }
+        /// <summary>
+        /// Destroys an object made by Create.
+        /// </summary>
+        /// <param name="value">The object to destroy, or NULL.</param>
+        template<class T> inline static void Destroy(const T* value) {
+            if (value != NULL) {
+                value->~T();
+                Delete((void*)value);
+            }
+        }
+        /// <summary>
+        /// Produces a summary of the arena's memory use.
+        /// </summary>
+        string& StatusReport() const;
+    private:
+        /// <summary>
+        /// Carves an allocation, including its header, from the current block.
+        /// </summary>
+        /// <param name="size">The number of bytes required, a multiple of Alignment.</param>
+        char* Allocate(size_t size);
+#pragma endregion
+    };
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+namespace Plato {
+
+    class Property;
+    class Container;
+    class SignalArena;
+    class ConnectionGraph;
+
+    /// <summary>
+    /// A versioned binary snapshot of a configured model, laid out as flat tables.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The snapshot holds one record per property of the model's hierarchy in pre-order,
+    /// skipping proxies, filters and group containers as the ConnectionGraph does, together with
+    /// the identifiers' names and positions, the input pads' connections and the output pads' signals.
+    /// Records refer to each other by table index, so the whole snapshot is one block of memory
+    /// that is written and read without per-object encoding.
+    /// </para>
+    /// <para>
+    /// Classes have no general factories, so a snapshot does not recreate the properties themselves.
+    /// It is restored onto a hierarchy built by the same model code, matching each record to the
+    /// property with the same Order and class in the matching parent, and replaces the path
+    /// resolution of the connector and converter phases: see Model::Load.
+    /// </para>
+    /// <para>
+    /// A snapshot can be mapped from its file instead of read, when the tables are used in place:
+    /// the file is not copied, and processes loading the same snapshot share its pages.
+    /// Opening a snapshot checks the header and the table bounds only, so it takes the same time
+    /// whatever the size of the model; Restore checks each record's indices as it visits it.
+    /// Restore visits every record, so restoring a model still reads the whole snapshot.
+    /// </para>
+    /// <para>
+    /// The tables are in the writer's byte order and a snapshot from a machine with another is rejected.
+    /// </para>
+    /// </remarks>
+    class ModelSnapshot {
+    public:
+        /// <summary>
+        /// The format version written, incremented whenever a record layout changes.
+        /// </summary>
+        static const uint32_t Version = 1;
+
+        /// <summary>
+        /// The start of a snapshot: where each table is and how many records it has.
+        /// </summary>
+        struct Header {
+            char Magic[8];
+            uint32_t Version;
+            uint32_t ByteOrder;
+            int64_t EpochTime;
+            uint32_t PropertyCount;
+            uint32_t PadCount;
+            uint32_t EdgeCount;
+            uint32_t SignalCount;
+            uint32_t PositionCount;
+            uint32_t NamesSize;
+            uint64_t PropertiesOffset;
+            uint64_t PadsOffset;
+            uint64_t EdgesOffset;
+            uint64_t SignalsOffset;
+            uint64_t PositionsOffset;
+            uint64_t NamesOffset;
+            uint64_t Size;
+        };
+        /// <summary>
+        /// A property: its parent's record and the indices of its entries in the other tables, or -1.
+        /// </summary>
+        struct PropertyRecord {
+            int32_t Parent;
+            int32_t Order;
+            uint32_t TypeCode;
+            int32_t Scope;
+            int32_t Name;
+            int32_t Position;
+            int32_t Signal;
+            int32_t Pad;
+        };
+        /// <summary>
+        /// An input pad and its run of records in the edge table.
+        /// </summary>
+        struct PadRecord {
+            int32_t Property;
+            int32_t FirstEdge;
+            int32_t EdgeCount;
+        };
+        /// <summary>
+        /// A connection to an input pad: the records of the source output pad and the connector that made it.
+        /// </summary>
+        struct EdgeRecord {
+            int32_t Source;
+            int32_t Connector;
+        };
+        /// <summary>
+        /// The current and next values of an output pad.
+        /// </summary>
+        struct SignalRecord {
+            int32_t Property;
+            float Current;
+            float Next;
+        };
+
+#pragma region // Instance variables.
+    private:
+        /// <summary>
+        /// The snapshot: the header followed by the tables.
+        /// </summary>
+        char* mData;
+        /// <summary>
+        /// The size of the file mapping holding mData, or zero if mData was allocated.
+        /// </summary>
+        size_t mMappedSize;
+#ifdef WIN32
+        /// <summary>
+        /// The file mapping holding mData, or NULL.
+        /// </summary>
+        HANDLE mMapping;
+#endif
+#pragma endregion
+
+#pragma region // Constructors.
+    private:
+        /// <summary>
+        /// Takes ownership of a block holding a snapshot.
+        /// </summary>
+        /// <param name="data">The block.</param>
+        /// <param name="mappedSize">The size of the file mapping holding the block, or zero if it was allocated with new[].</param>
+        ModelSnapshot(char* data, size_t mappedSize = 0);
+        ModelSnapshot(const ModelSnapshot&);
+        ModelSnapshot& operator=(const ModelSnapshot&);
+    public:
+        /// <summary>
+        /// Deallocate object.
+        /// </summary>
+        ~ModelSnapshot();
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Takes a snapshot of a hierarchy.
+        /// </summary>
+        /// <param name="root">The root of the hierarchy, normally the model.</param>
+        /// <param name="signals">The signals of the hierarchy's output pads.</param>
+        /// <param name="graph">The compiled connections, used for pads whose connections were released, or NULL.</param>
+        /// <param name="epochTime">The number of epochs the model has run for.</param>
+        /// <returns>Returns a new snapshot.</returns>
+        static ModelSnapshot* Capture(Container& root, const SignalArena& signals, const ConnectionGraph* graph, long epochTime);
+
+        /// <summary>
+        /// Reads a snapshot from a file.
+        /// </summary>
+        /// <param name="path">The path of the file.</param>
+        /// <returns>Returns a new snapshot, or NULL if the file is missing or not a valid snapshot of this version.</returns>
+        static ModelSnapshot* Read(const string& path);
+
+        /// <summary>
+        /// Maps a snapshot file into memory read only, to use its tables in place.
+        /// </summary>
+        /// <param name="path">The path of the file.</param>
+        /// <returns>Returns a new snapshot, or NULL if the file is missing, cannot be mapped or is not a valid snapshot of this version.</returns>
+        static ModelSnapshot* Map(const string& path);
+
+        /// <summary>
+        /// Writes the snapshot to a file.
+        /// </summary>
+        /// <param name="path">The path of the file.</param>
+        /// <returns>Returns zero if successful, otherwise an error code.</returns>
+        int Write(const string& path) const;
+
+        /// <summary>
+        /// Restores the connections and signals of the snapshot onto a hierarchy built by the same code.
+        /// </summary>
+        /// <remarks>
+        /// The connections restored replace any the matched input pads already have.
+        /// </remarks>
+        /// <param name="root">The root of the hierarchy.</param>
+        /// <param name="signals">The signals of the hierarchy's output pads.</param>
+        /// <returns>Returns the number of pads and connections in the snapshot that have no matching property
+        /// or refer outside the tables, which are skipped.</returns>
+        int Restore(Container& root, SignalArena& signals) const;
+
+        /// <summary>
+        /// Matches the property records to a hierarchy built by the same code.
+        /// </summary>
+        /// <param name="root">The root of the hierarchy.</param>
+        /// <param name="properties">Out parameter for the property matching each record, or NULL where none does.</param>
+        void Match(Container& root, vector<Property*>& properties) const;
+
+        /// <summary>
+        /// Gets the snapshot's header.
+        /// </summary>
+        inline const Header& GetHeader() const { return *(const Header*)mData; }
+
+        /// <summary>
+        /// Gets the number of bytes in the snapshot.
+        /// </summary>
+        inline size_t Size() const { return (size_t)GetHeader().Size; }
+
+        /// <summary>
+        /// Tests whether the snapshot is mapped from its file rather than held in private memory.
+        /// </summary>
+        inline bool IsMapped() const { return mMappedSize != 0; }
+
+        /// <summary>
+        /// Gets a property record.
+        /// </summary>
+        inline const PropertyRecord& GetProperty(int index) const {
+            return ((const PropertyRecord*)(mData + GetHeader().PropertiesOffset))[index];
+        }
+
+        /// <summary>
+        /// Gets the record of an output pad's signals.
+        /// </summary>
+        inline const SignalRecord& GetSignal(int index) const {
+            return ((const SignalRecord*)(mData + GetHeader().SignalsOffset))[index];
+        }
+
+        /// <summary>
+        /// Gets the identifier name of a property record, or an empty string if it is out of range.
+        /// </summary>
+        inline const char* GetName(const PropertyRecord& record) const {
+            const Header& header = GetHeader();
+            return record.Name < 0 || (uint32_t)record.Name >= header.NamesSize ? "" : mData + header.NamesOffset + record.Name;
+        }
+
+        /// <summary>
+        /// Gets the position of a property record, or NULL if it has none.
+        /// </summary>
+        /// <returns>Returns the Point::NumberOfCoordinates coordinates of the position.</returns>
+        const float* GetPosition(const PropertyRecord& record) const;
+
+        /// <summary>
+        /// Checks that a block holds a complete snapshot of this version and byte order.
+        /// </summary>
+        /// <remarks>
+        /// Only the header and the extent of each table are checked, not the records.
+        /// A block the size of the header is checked as a header alone.
+        /// </remarks>
+        /// <param name="data">The block.</param>
+        /// <param name="size">The number of bytes in the block.</param>
+        static bool IsValid(const char* data, size_t size);
+    private:
+        /// <summary>
+        /// Gets the first record of a table.
+        /// </summary>
+        template <class Record> inline const Record* GetTable(uint64_t offset) const {
+            return (const Record*)(mData + offset);
+        }
+#pragma endregion
+    };
+}
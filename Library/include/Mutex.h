@@ -0,0 +1,103 @@
+#pragma once
+
+namespace Plato {
+
+    /// <summary>
+    /// A platform independent mutual exclusion lock.
+    /// </summary>
+    class Mutex {
+    public:
+#ifdef WIN32
+        typedef CRITICAL_SECTION Handle;
+        inline Mutex() { InitializeCriticalSection(&mHandle); }
+        inline ~Mutex() { DeleteCriticalSection(&mHandle); }
+        inline void Lock() { EnterCriticalSection(&mHandle); }
+        inline void Unlock() { LeaveCriticalSection(&mHandle); }
+#else // POSIX
+        typedef pthread_mutex_t Handle;
+        inline Mutex() { pthread_mutex_init(&mHandle,NULL); }
+        inline ~Mutex() { pthread_mutex_destroy(&mHandle); }
+        inline void Lock() { pthread_mutex_lock(&mHandle); }
+        inline void Unlock() { pthread_mutex_unlock(&mHandle); }
+#endif
+    private:
+        friend class Condition;
+        /// <summary>
+        /// The native lock handle.
+        /// </summary>
+        Handle mHandle;
+        Mutex(const Mutex&);
+        Mutex& operator=(const Mutex&);
+    };
+
+    /// <summary>
+    /// A platform independent condition variable.
+    /// </summary>
+    /// <remarks>
+    /// Wait, Signal and Broadcast must be called with the associated Mutex locked.
+    /// </remarks>
+    class Condition {
+    public:
+#ifdef WIN32
+        inline Condition() { mWaiters = 0; mSemaphore = CreateSemaphore(NULL,0,LONG_MAX,NULL); }
+        inline ~Condition() { CloseHandle(mSemaphore); }
+        inline void Wait(Mutex& mutex) {
+            ++mWaiters; mutex.Unlock(); WaitForSingleObject(mSemaphore,INFINITE); mutex.Lock(); }
+        inline void Signal() { if(mWaiters>0) { --mWaiters; ReleaseSemaphore(mSemaphore,1,NULL); } }
+        inline void Broadcast() { if(mWaiters>0) { ReleaseSemaphore(mSemaphore,mWaiters,NULL); mWaiters = 0; } }
+    private:
+        /// <summary>
+        /// The number of threads blocked in Wait, guarded by the associated Mutex.
+        /// </summary>
+        LONG mWaiters;
+        HANDLE mSemaphore;
+#else // POSIX
+        inline Condition() { pthread_cond_init(&mHandle,NULL); }
+        inline ~Condition() { pthread_cond_destroy(&mHandle); }
+        inline void Wait(Mutex& mutex) { pthread_cond_wait(&mHandle,&mutex.mHandle); }
+        inline void Signal() { pthread_cond_signal(&mHandle); }
+        inline void Broadcast() { pthread_cond_broadcast(&mHandle); }
+    private:
+        pthread_cond_t mHandle;
+#endif
+        Condition(const Condition&);
+        Condition& operator=(const Condition&);
+    };
+
+    /// <summary>
+    /// Holds a Mutex locked for the lifetime of the MutexLock object.
+    /// </summary>
+    class MutexLock {
+    public:
+        inline MutexLock(Mutex& mutex) : mMutex(mutex) { mMutex.Lock(); }
+        inline ~MutexLock() { mMutex.Unlock(); }
+    private:
+        Mutex& mMutex;
+        MutexLock(const MutexLock&);
+        MutexLock& operator=(const MutexLock&);
+    };
+
+    /// <summary>
+    /// Atomic operations on word sized integers shared between threads.
+    /// </summary>
+    class Atomic {
+    public:
+#ifdef WIN32
+        typedef volatile LONG Value;
+        inline static long Increment(Value* v) { return InterlockedIncrement(v); }
+        inline static long Decrement(Value* v) { return InterlockedDecrement(v); }
+        inline static long Add(Value* v, long n) { return InterlockedExchangeAdd(v,n)+n; }
+        inline static long CompareExchange(Value* v, long newValue, long oldValue) {
+            return InterlockedCompareExchange(v,newValue,oldValue); }
+        inline static void YieldThread() { SwitchToThread(); }
+#else // POSIX
+        typedef volatile long Value;
+        inline static long Increment(Value* v) { return __sync_add_and_fetch(v,1L); }
+        inline static long Decrement(Value* v) { return __sync_sub_and_fetch(v,1L); }
+        inline static long Add(Value* v, long n) { return __sync_add_and_fetch(v,n); }
+        inline static long CompareExchange(Value* v, long newValue, long oldValue) {
+            return __sync_val_compare_and_swap(v,oldValue,newValue); }
+        inline static void YieldThread() { sched_yield(); }
+#endif
+    };
+}
@@ -54,6 +54,14 @@ namespace Plato {
         /// <remarks>Derived classes should override and call their copy constructor.</remarks>
         /// <returns>Returns a shallow copy.</returns>
         virtual Distribution* Clone() const;
+
+        /// <summary>
+        /// Creates the univariate distribution of one coordinate, for geometries that generate
+        /// points a coordinate at a time.
+        /// </summary>
+        /// <param name="coordinate">The coordinate.</param>
+        /// <returns>Returns a new distribution, which the caller deletes.</returns>
+        virtual UnivariateDistribution* CreateUnivariateDistribution(CoordinateNamesEnum coordinate) const;
     };
 
     /// <summary>
@@ -122,6 +122,15 @@ namespace Plato {
         /// Indexer for getting the nth value of the distribution.
         /// </summary>
         virtual float operator[](int index);
+
+        /// <summary>
+        /// Fills a buffer with a run of consecutive distribution values.
+        /// </summary>
+        /// <param name="first">The index of the first value.</param>
+        /// <param name="count">The number of values wanted.</param>
+        /// <param name="values">The buffer to fill, which must hold count values.</param>
+        /// <returns>Returns the number of values filled.</returns>
+        virtual int Fill(int first, int count, float* values);
     };
 
     /// <summary>
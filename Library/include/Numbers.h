@@ -146,5 +146,17 @@ namespace Plato {
         /// <param name="reset">When true, forces default value to be assigned to variable.</param>
         /// <returns>Returns revised value.</returns>
         static long CheckValue(long& v, long lo, long hi, long defaultValue, bool reset);
+
+        /// <summary>
+        /// Check the float is in range,
+        /// and initialise if it is not.
+        /// </summary>
+        /// <param name="v">The variable to check.</param>
+        /// <param name="lo">The lowest value of range.</param>
+        /// <param name="hi">The highest value of range.</param>
+        /// <param name="defaultValue">It's default value.</param>
+        /// <param name="reset">When true, forces default value to be assigned to variable.</param>
+        /// <returns>Returns revised value.</returns>
+        static float CheckValue(float& v, float lo, float hi, float defaultValue, bool reset);
     };
 }
@@ -7,15 +7,16 @@ namespace Plato {
     class Property;
     class Container;
     class Pad;
+    class SignalArena;
 
     /// <summary>
     /// Models an output pad.
     /// </summary>
     /// <remarks>
     /// Handles buffering of output values during emulation Update.
-    /// Source of output value alternates between two buffers.
-    /// The buffers are swapped when the emulation epoch number changes.
-    /// The emulation epoch number should be changed at the start of each emulation Update.
+    /// The values are held in the model's SignalArena: reads come from the current
+    /// buffer and writes go to the next buffer.
+    /// The model swaps the buffers at the start of each emulation Update.
     /// Note: the DID may want to store some state info per output pad,
     /// so we'd need to add a data member.
     /// </remarks>
@@ -31,15 +32,14 @@ namespace Plato {
         virtual const ClassTypeInfo* GetClassTypeInfo() const { return TypeInfo; }
 
         /// <summary>
-        /// Takes a value of 0 or 1, set via SetBuffer.
+        /// The arena holding the double buffered output value.
         /// </summary>
-    private:
-        static int CurrentBuffer;
+        SignalArena* Signals;
 
         /// <summary>
-        /// A binary buffer for DID output values.
+        /// The index of this pad's value in the Signals arrays.
         /// </summary>
-        float OutputValue[2];
+        int SignalIndex;
 
     public:
         /// <summary>
@@ -76,23 +76,17 @@ namespace Plato {
         /// </summary>
         virtual ~OutputPad();
 
-        /// <summary>
-        /// Sets the current output buffer.
-        /// </summary>
-        /// <param name="epochNumber">Used to set current buffer number to (epochNumber mod 2).</param>
-        inline static void SetBuffer(long epochNumber) { CurrentBuffer = (int)(epochNumber & 1); }
-
         /// <summary>
         /// The GetOutputValue always uses the opposite buffer to the SetValue.
         /// </summary>
         /// <returns>Returns the current output value.</returns>
-        inline float GetOutputValue() { return OutputValue[CurrentBuffer]; }
+        inline float GetOutputValue() { return Signals->Current[SignalIndex]; }
 
         /// <summary>
         /// Set output value. Takes effect next epoch.
         /// </summary>
         /// <param name="outputValue">The new output value.</param>
-        inline void SetOutputValue(float outputValue) { OutputValue[1-CurrentBuffer] = outputValue; }
+        inline void SetOutputValue(float outputValue) { Signals->Next[SignalIndex] = outputValue; }
 
     private:
         friend class InitializerCatalogue;
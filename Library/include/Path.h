@@ -8,6 +8,7 @@ namespace Plato {
     class IdentifierPtrHashCompare;
     class PathNode;
     class PathEnumerator;
+    class PathProgram;
 
     /// <summary>
     /// Models the path to a container. Similar conceptually to a file path.
@@ -135,11 +136,6 @@ namespace Plato {
         /// Hashtable for converting from a standard PathNode name to it's PathNode object.
         /// </summary>
         static HashMap* mStandardPathNodes;
-
-        /// <summary>
-        /// An immutable copy of the base dir.
-        /// </summary>
-        static string* mPathPrefix;
 #pragma endregion
         
 #pragma region // Instance variables.
@@ -153,6 +149,11 @@ namespace Plato {
         /// Stores a reference to the object's creator.
         /// </summary>
         Container* Creator;
+    private:
+        /// <summary>
+        /// The node chain compiled for GetProperty, or NULL until first needed.
+        /// </summary>
+        mutable PathProgram* mProgram;
 #pragma endregion
 
 #pragma region // Constructors.
@@ -200,6 +201,7 @@ namespace Plato {
         /// Accessor for the path prefix to add to paths when accessing
         /// the host FS.
         /// </summary>
+        /// <remarks>The prefix is the current model's, see Model::ModelPathPrefix.</remarks>
         static string* GetPathPrefix();
 #pragma endregion
 
@@ -217,6 +219,10 @@ namespace Plato {
         /// <param name="pathNode">Out parameter for the PathNode corresponding to the first branch container or leaf object.</param>
         /// <param name="contextContainer">Out parameter for the parent container of the property.</param>
         /// <returns>Returns the first branch container, or property if no branch found.</returns>
+        /// <remarks>
+        /// The path is compiled to a PathProgram on first use, and recompiled if its node chain
+        /// is edited. Resolutions without a requester may be answered from the model's PathMemo.
+        /// </remarks>
         Property* GetProperty(Container* currentContainer, const Property* requester, PropertyModesEnum mode,
                 PathNode*& pathNode, Container*& contextContainer) const;
 
@@ -14,6 +14,9 @@ namespace Plato {
     /// <summary>
     /// During enumeration a stack is maintained of details on each path node enumeration.
     /// </summary>
+    /// <remarks>
+    /// States are recycled by their PathEnumerator, which keeps the NodeEnumerator for reuse.
+    /// </remarks>
     class PathEnumeratorState {
     public:
         /// <summary>
@@ -43,30 +46,27 @@ namespace Plato {
         int CountRemaining;
 
         /// <summary>
-        /// Indicates when PathNode chain should be deleted.
+        /// Creates an unused state.
         /// </summary>
-        bool DoDelete;
+        PathEnumeratorState();
+
+        /// <summary>
+        /// Deallocate resources.
+        /// </summary>
+        ~PathEnumeratorState();
 
         /// <summary>
         /// Save path enumeration state details.
-        /// Also sets up node enumerator.
+        /// Also sets up node enumerator, unless the path node is an Any node, which is expanded instead.
         /// </summary>
         /// <param name="container">The current container to use for path node enumerator.</param>
         /// <param name="pathNode">The current path node, which is part of path.</param>
-        /// <param name="skipEnumerator">If true, skips setting node enumerator.</param>
         /// <param name="requester">A property situated in the container hierarchy of
         /// the property to fetch, or NULL if scope checking not required.</param>
         /// <param name="mode">The access mode for the requested property.</param>
         /// <param name="pathGroupTree">The current position in the group tree.</param>
-        /// <param name="countRemaining">The number of additional items needed to complete group.</param>
-        /// <param name="doDelete">Indicates when PathNode chain should be deleted.</param>
-        PathEnumeratorState(Container* container, PathNode* pathNode, bool skipEnumerator, 
-            const Property* requester, PropertyModesEnum mode, GroupContainer* pathGroupTree, int countRemaining, bool doDelete);
-
-        /// <summary>
-        /// Deallocate resources.
-        /// </summary>
-        ~PathEnumeratorState();
+        void Set(Container* container, PathNode* pathNode, const Property* requester, PropertyModesEnum mode, 
+            GroupContainer* pathGroupTree);
     };
 #pragma endregion
 
@@ -81,11 +81,6 @@ namespace Plato {
         /// </summary>
         GroupContainer* PathGroupTree;
         
-        /// <summary>
-        /// Path evaluation list: holds state details at points where evaluation branches.
-        /// </summary>
-        vector<PathEnumeratorState*>* PathEnumeratorStateList;
-
         /// <summary>
         /// The current item.
         /// </summary>
@@ -127,6 +122,44 @@ namespace Plato {
         /// A group handler for dealing with groupings.
         /// </summary>
         Connector* mGroupHandler;
+
+        /// <summary>
+        /// Path evaluation list: holds state details at points where evaluation branches.
+        /// </summary>
+        /// <remarks>
+        /// A ring buffer used as a deque: the current state is at the front for width-first descent,
+        /// otherwise at the back.
+        /// </remarks>
+        PathEnumeratorState** mStates;
+
+        /// <summary>
+        /// The position of the front state in mStates.
+        /// </summary>
+        int mStatesFront;
+
+        /// <summary>
+        /// The number of states in mStates.
+        /// </summary>
+        int mStatesCount;
+
+        /// <summary>
+        /// The size of mStates, a power of two.
+        /// </summary>
+        int mStatesCapacity;
+
+        /// <summary>
+        /// States no longer in use, kept for reuse.
+        /// </summary>
+        vector<PathEnumeratorState*> mFreeStates;
+
+        /// <summary>
+        /// The Wild nodes used to expand the Any nodes of the path, one per Any node.
+        /// </summary>
+        /// <remarks>
+        /// Each Wild node leads on to its Any node, but is not linked into the path,
+        /// so that A/AnyPattern/B can be expanded to A/WildPattern/AnyPattern/B without copying the path.
+        /// </remarks>
+        vector<PathNode*> mWildPathNodes;
 #pragma endregion
     public:
         /// <summary>
@@ -190,5 +223,42 @@ namespace Plato {
         /// <remarks>Calls MoveNext() and then Current.</remarks>
         /// <returns>Returns the next item or NULL if end of enumeration.</returns>
         inline Property* Next() { return MoveNext() ? Current : NULL; }
+
+    protected:
+        /// <summary>
+        /// Gets a state from the free list, or allocates one, and sets it up.
+        /// </summary>
+        PathEnumeratorState& NewState(Container* container, PathNode* pathNode, GroupContainer* pathGroupTree);
+
+        /// <summary>
+        /// Returns a state to the free list.
+        /// </summary>
+        void FreeState(PathEnumeratorState& state);
+
+        /// <summary>
+        /// Adds a state to the front of the list, where width-first descent takes the current state from.
+        /// </summary>
+        void PushFrontState(PathEnumeratorState& state);
+
+        /// <summary>
+        /// Adds a state to the back of the list, where depth-first descent takes the current state from.
+        /// </summary>
+        void PushBackState(PathEnumeratorState& state);
+
+        /// <summary>
+        /// Removes the current state from the list.
+        /// </summary>
+        /// <returns>Returns the state removed.</returns>
+        PathEnumeratorState* PopCurrentState();
+
+        /// <summary>
+        /// Doubles the size of the state list.
+        /// </summary>
+        void GrowStates();
+
+        /// <summary>
+        /// Gets the Wild node that leads on to an Any node of the path.
+        /// </summary>
+        PathNode* GetWildPathNode(PathNode& anyPathNode);
     };
 }
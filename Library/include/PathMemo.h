@@ -0,0 +1,195 @@
+#pragma once
+
+namespace Plato {
+
+    class Property;
+    class Container;
+    class PathNode;
+
+    /// <summary>
+    /// A memoised resolution of a PathProgram from one container.
+    /// </summary>
+    class PathResolution {
+    public:
+        /// <summary>
+        /// A container whose contents the resolution depends on, with its Generation at the time.
+        /// </summary>
+        struct Dependency {
+            Container* Hop;
+            long Generation;
+        };
+        /// <summary>
+        /// The NodeProperty assigned to a node during the resolution.
+        /// </summary>
+        struct NodeValue {
+            PathNode* Node;
+            Property* Value;
+        };
+
+#pragma region // Instance variables.
+    public:
+        /// <summary>
+        /// The result and out parameters of Path::GetProperty.
+        /// </summary>
+        Property* Result;
+        PathNode* ResultNode;
+        Container* ResultContext;
+        /// <summary>
+        /// False if the resolution involved a Director or a proxied property,
+        /// whose results cannot be checked through container generations.
+        /// </summary>
+        bool IsMemoisable;
+        /// <summary>
+        /// The containers looked into, in the order they were visited.
+        /// </summary>
+        vector<Dependency> Dependencies;
+        /// <summary>
+        /// The node values to restore when the resolution is reused.
+        /// </summary>
+        vector<NodeValue> NodeValues;
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        inline PathResolution() : Result(NULL), ResultNode(NULL), ResultContext(NULL), IsMemoisable(true) {}
+        /// <summary>
+        /// Records a container the result depends on.
+        /// </summary>
+        void AddDependency(Container& hop);
+        /// <summary>
+        /// Records the value assigned to a node.
+        /// </summary>
+        void AddNodeValue(PathNode& node, Property* value);
+        /// <summary>
+        /// Checks none of the containers depended on has changed since the resolution was made.
+        /// </summary>
+        /// <remarks>
+        /// The dependencies are checked in visiting order, so a container is only examined
+        /// once its parent is known to still hold it.
+        /// </remarks>
+        bool IsValid() const;
+        /// <summary>
+        /// Reassigns the node values and out parameters recorded.
+        /// </summary>
+        /// <returns>Returns the result of the resolution.</returns>
+        Property* Replay(PathNode*& pathNode, Container*& contextContainer) const;
+#pragma endregion
+    };
+
+    /// <summary>
+    /// A per model cache of path resolutions, keyed by starting container, program and mode.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Alias and Link properties, filters and searches resolve the same paths from the same
+    /// containers over and over. The memo remembers each result with the Generation of every
+    /// container looked into, and reuses it while none of those containers has had a property
+    /// added or removed. Container generations are stamps unique in the process, so a container
+    /// deleted and replaced by another at the same address is not mistaken for the original.
+    /// </para>
+    /// <para>
+    /// Only resolutions without a requester are memoised, since scope checks depend on where
+    /// the requester sits, and only in modes that do not produce properties on demand.
+    /// Resolutions that route through Directors or proxied properties are not memoised either.
+    /// The memo is emptied when it reaches Capacity.
+    /// </para>
+    /// </remarks>
+    class PathMemo {
+    public:
+        /// <summary>
+        /// The number of resolutions held before the memo is emptied.
+        /// </summary>
+        static const int Capacity = 8192;
+
+        /// <summary>
+        /// Identifies a memoised resolution.
+        /// </summary>
+        struct Key {
+            const Container* Start;
+            long ProgramId;
+            int Mode;
+            inline Key() : Start(NULL), ProgramId(0), Mode(0) {}
+            inline Key(const Container* start, long programId, int mode) : Start(start), ProgramId(programId), Mode(mode) {}
+        };
+        /// <summary>
+        /// FlatHashMap traits for Key.
+        /// </summary>
+        struct KeyTraits {
+            static size_t Hash(const Key& key);
+            inline static bool Equals(const Key& a, const Key& b) {
+                return a.Start == b.Start && a.ProgramId == b.ProgramId && a.Mode == b.Mode; }
+        };
+        typedef FlatHashMap<Key, PathResolution*, KeyTraits> HashTable;
+
+#pragma region // Class variables.
+    private:
+        /// <summary>
+        /// The last container generation handed out.
+        /// </summary>
+        static Atomic::Value mLastGeneration;
+#pragma endregion
+
+#pragma region // Instance variables.
+    private:
+        HashTable mResolutions;
+        /// <summary>
+        /// Serialises access from the update threads.
+        /// </summary>
+        Mutex mLock;
+        /// <summary>
+        /// The number of lookups answered from, and not found in, the memo.
+        /// </summary>
+        long mHits;
+        long mMisses;
+#pragma endregion
+
+#pragma region // Constructors.
+    public:
+        PathMemo();
+        ~PathMemo();
+    private:
+        PathMemo(const PathMemo&);
+        PathMemo& operator=(const PathMemo&);
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Hands out a new container generation.
+        /// </summary>
+        inline static long NewGeneration() { return Atomic::Increment(&mLastGeneration); }
+        /// <summary>
+        /// Gets the last generation handed out, which changes whenever any container's contents change.
+        /// </summary>
+        inline static long CurrentGeneration() { return mLastGeneration; }
+        /// <summary>
+        /// Reuses a valid resolution, replaying its node values and out parameters.
+        /// </summary>
+        /// <param name="result">Out parameter for the memoised result.</param>
+        /// <returns>Returns false if there is no resolution for the key or it is out of date.</returns>
+        bool Find(const Key& key, Property*& result, PathNode*& pathNode, Container*& contextContainer);
+        /// <summary>
+        /// Stores a resolution, replacing any previous one for the key.
+        /// </summary>
+        /// <param name="resolution">The resolution, now owned by the memo.</param>
+        void Store(const Key& key, PathResolution& resolution);
+        /// <summary>
+        /// Deletes every resolution.
+        /// </summary>
+        void Clear();
+        /// <summary>
+        /// Gets the number of resolutions held.
+        /// </summary>
+        int Count();
+        /// <summary>
+        /// Reports the size and hit rate of the memo.
+        /// </summary>
+        string& StatusReport();
+    private:
+        /// <summary>
+        /// Deletes every resolution, with the lock held.
+        /// </summary>
+        void DeleteResolutions();
+#pragma endregion
+    };
+}
@@ -14,6 +14,9 @@ namespace Plato {
     /// <remarks>
     /// Note, a PathNodeEnumrator does not descend the PathNode chain.
     /// That is done by PathEnumerator.
+    /// The path node is shared rather than copied, so it must outlive the enumerator,
+    /// and a Regex node is given its filter arguments the first time it is enumerated.
+    /// PathEnumerator enumerates its own copy of the path, so the node is not shared between threads.
     /// </remarks>
     class PathNodeEnumerator {
     public:
@@ -67,6 +70,12 @@ namespace Plato {
         /// </summary>
         ScopeEnumerator* mNodeEnumerator;
 
+        /// <summary>
+        /// Indicates mNodeEnumerator has been set up for the current enumeration.
+        /// It is kept between enumerations and reset rather than reallocated.
+        /// </summary>
+        bool mIsNodeEnumerating;
+
     public:
         /// <summary>
         /// Internal class used by Path to implement an enumerator over the items of a path node.
@@ -84,11 +93,26 @@ namespace Plato {
         /// </summary>
         ~PathNodeEnumerator();
 
+    protected:
+        /// <summary>
+        /// Starts enumerating a container, reusing the internal enumerator if there is one.
+        /// </summary>
+        void StartNodeEnumerator(Container& container);
+    public:
+
         /// <summary>
         /// Returns the enumerator to the start ready for re-use.
         /// </summary>
         void Reset();
 
+        /// <summary>
+        /// Returns the enumerator to the start of another path node and context, ready for re-use.
+        /// </summary>
+        /// <param name="currentPathNode">The PathNode to enumerate.</param>
+        /// <param name="nodeCurrentContainer">The relative position in the container hierarchy to use
+        /// with the path node.</param>
+        void Reset(PathNode& currentPathNode, Container* nodeCurrentContainer);
+
         /// <summary>
         /// Move to the next item in the path node if possible.
         /// </summary>
@@ -0,0 +1,172 @@
+#pragma once
+
+namespace Plato {
+
+    class Property;
+    class Container;
+    class Path;
+    class PathNode;
+    class PathResolution;
+
+#pragma region // PathOpcodes Enumeration.
+    namespace PathOpcodes {
+        /// <summary>
+        /// The operation performed by one instruction of a PathProgram.
+        /// </summary>
+        enum Enum {
+            /// <summary>
+            /// Look up the node's identifier in the current container.
+            /// </summary>
+            Child,
+            /// <summary>
+            /// Move to the model, for the Absolute, Start and End nodes.
+            /// </summary>
+            Root,
+            /// <summary>
+            /// Stay in the current container.
+            /// </summary>
+            Current,
+            /// <summary>
+            /// Move to the parent of the current container.
+            /// </summary>
+            Parent,
+            /// <summary>
+            /// Move to the container that created the path.
+            /// </summary>
+            Owner,
+            /// <summary>
+            /// Route through a Director of the current container.
+            /// </summary>
+            Director,
+            /// <summary>
+            /// A search node, which is resolved by Search rather than by the program.
+            /// </summary>
+            Search,
+            /// <summary>
+            /// Stop at a node that needs an enumerator: a regex, wildcard or filter.
+            /// </summary>
+            Branch
+        };
+    }
+    typedef PathOpcodes::Enum PathOpcodesEnum;
+#pragma endregion
+
+    /// <summary>
+    /// A Path lowered to a flat array of instructions, one per PathNode.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Path::GetProperty executes the program instead of dispatching on each node's kind while
+    /// chasing the Next pointers. The program remembers the node chain it was compiled from,
+    /// and IsCurrent lets the path recompile it after the chain has been edited in place.
+    /// </para>
+    /// <para>
+    /// Each program has an Id unique in the process, which together with the starting container
+    /// keys the resolutions memoised in the model's PathMemo.
+    /// </para>
+    /// </remarks>
+    class PathProgram {
+    public:
+        /// <summary>
+        /// One step of the program.
+        /// </summary>
+        struct Instruction {
+            PathOpcodesEnum Opcode;
+            /// <summary>
+            /// The node compiled, whose NodeProperty is set when the step is executed.
+            /// </summary>
+            PathNode* Node;
+        };
+
+#pragma region // Class variables.
+    private:
+        /// <summary>
+        /// The last Id handed out.
+        /// </summary>
+        static Atomic::Value mLastId;
+        /// <summary>
+        /// Serialises recompilation.
+        /// </summary>
+        static Mutex mCompileLock;
+#pragma endregion
+
+#pragma region // Instance variables.
+    public:
+        /// <summary>
+        /// A number unique to the program.
+        /// </summary>
+        const long Id;
+    private:
+        /// <summary>
+        /// The instructions, in path order.
+        /// </summary>
+        vector<Instruction> mInstructions;
+        /// <summary>
+        /// The program this one replaced, kept until the path is destroyed
+        /// since another thread may still be executing it.
+        /// </summary>
+        PathProgram* mPrevious;
+#pragma endregion
+
+#pragma region // Constructors.
+    public:
+        /// <summary>
+        /// Compiles the node chain of a path.
+        /// </summary>
+        /// <param name="path">The path to compile.</param>
+        /// <param name="previous">The program being replaced, or NULL.</param>
+        PathProgram(const Path& path, PathProgram* previous);
+        /// <summary>
+        /// Deletes this and any replaced programs.
+        /// </summary>
+        ~PathProgram();
+    private:
+        PathProgram(const PathProgram&);
+        PathProgram& operator=(const PathProgram&);
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Gets the program for a path, compiling it if there is none or the path's
+        /// node chain has changed.
+        /// </summary>
+        /// <param name="path">The path.</param>
+        /// <param name="program">The path's program, which is replaced when recompiled.</param>
+        static const PathProgram& GetCurrent(const Path& path, PathProgram*& program);
+
+        /// <summary>
+        /// Checks the program still matches the node chain of the path.
+        /// </summary>
+        bool IsCurrent(const Path& path) const;
+
+        /// <summary>
+        /// Resolves the program as Path::GetProperty does, consulting the current model's PathMemo
+        /// where the resolution can be memoised.
+        /// </summary>
+        /// <param name="currentContainer">The position in the container hierarchy to use as the current, relative position.</param>
+        /// <param name="requester">A property situated in the container hierarchy of
+        /// the property to fetch, or NULL if scope checking not required.</param>
+        /// <param name="mode">The access mode for the requested property.</param>
+        /// <param name="pathNode">Out parameter for the PathNode corresponding to the first branch container or leaf object.</param>
+        /// <param name="contextContainer">Out parameter for the parent container of the property.</param>
+        /// <returns>Returns the first branch container, or property if no branch found.</returns>
+        Property* Execute(Container* currentContainer, const Property* requester, PropertyModesEnum mode,
+                PathNode*& pathNode, Container*& contextContainer) const;
+
+    private:
+        /// <summary>
+        /// Runs the instructions.
+        /// </summary>
+        /// <param name="resolution">Receives the containers the result depends on,
+        /// or NULL if the resolution is not to be memoised.</param>
+        Property* Run(Container* currentContainer, const Property* requester, PropertyModesEnum mode,
+                PathNode*& pathNode, Container*& contextContainer, PathResolution* resolution) const;
+
+        /// <summary>
+        /// Gets the opcode for a node.
+        /// </summary>
+        static PathOpcodesEnum GetOpcode(const PathNode& node);
+#pragma endregion
+    };
+}
@@ -4,7 +4,8 @@ namespace Plato {
 
     class Geometry;
     class Distribution;
-    class DistributionEnumerator;
+    class UnivariateDistribution;
+    class PointBatch;
     class Bounds;
     class Scale;
     class Point;
@@ -19,14 +20,14 @@ namespace Plato {
     class PipeGeometry : public Geometry {
     private:
         /// <summary>
-        /// The point distribution for this shape instance.
+        /// The X coordinate distribution for this shape instance, created when the first point is allocated.
         /// </summary>
-        Distribution* mDX;
+        UnivariateDistribution* mDX;
 
         /// <summary>
-        /// Used to allocate new points, <see cref="Plato::PipeGeometry::GetPoint"/>.
+        /// The index of the next new point, <see cref="Plato::PipeGeometry::GetPoints"/>.
         /// </summary>
-        DistributionEnumerator* mEX;
+        int mNextIndex;
 
     public:
         /// <summary>
@@ -79,6 +80,15 @@ namespace Plato {
         /// <returns>Returns a point derived from Point according to a shapes
         /// coordinate system.</returns>
         virtual Point* GetPoint(CoordinateOperationsEnum operation, const PointSpace& pointSpace);
+
+        /// <summary>
+        /// Fills a batch with the next new points, generating each coordinate array in one pass
+        /// over the univariate distributions.
+        /// </summary>
+        /// <param name="operation">The operation to perform: only New is batched.</param>
+        /// <param name="batch">The batch to fill, up to its capacity.</param>
+        /// <returns>Returns the number of points filled, which is less than the capacity once the pipe is full.</returns>
+        virtual int GetPoints(CoordinateOperationsEnum operation, PointBatch& batch);
     };
 }
 
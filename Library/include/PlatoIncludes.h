@@ -33,8 +33,11 @@ using namespace __gnu_cxx;
 #include <cstdlib>
 #include <cfloat>
 #include <cmath>
+#include <ctime>
+#include <new>
 #include <string>
 #include <list>
+#include <deque>
 #include <vector>
 #include <stack>
 #include <algorithm>
@@ -43,3 +46,6 @@ using namespace __gnu_cxx;
 #include "pstdint.h" 
 
 using namespace std;
+
+// The library's own hash table, used by Container and so needed almost everywhere.
+#include "FlatHashMap.h"
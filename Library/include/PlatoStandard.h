@@ -14,6 +14,9 @@
 #include "Regexes.h" 
 #include "Arguments.h" 
 #include "ThreadLocalVariable.h"
+#include "Mutex.h"
+#include "ThreadPool.h"
+#include "ModelArena.h"
 #include "Archiver.h" 
 #include "ClassTypeInfo.h" 
 // Configure
@@ -25,12 +28,16 @@
 #include "Diagnostics.h" 
 #include "DiagnosticsCatalogue.h" 
 #include "EnvironmentVariables.h" 
+#include "LogWriter.h" 
 #include "Trace.h" 
 // Primitives
 #include "Point.h" 
+#include "PointBatch.h"
 #include "PointEnumerator.h" 
 #include "PointSpace.h" 
+#include "BoxSpace.h"
 #include "PointRegex.h" 
+#include "Symbol.h"
 #include "Identifier.h" 
 #include "IdentifierRegex.h" 
 #include "Property.h" 
@@ -45,9 +52,12 @@
 #include "Link.h" 
 #include "Path.h" 
 #include "PathEnumerator.h" 
+#include "PathMemo.h"
+#include "SpatialIndex.h"
 #include "PathNode.h" 
 #include "PathNodeEnumerator.h" 
 #include "PathOperators.h" 
+#include "PathProgram.h"
 #include "PathRegex.h" 
 #include "ScopeEnumerator.h" 
 #include "Search.h" 
@@ -68,6 +78,7 @@
 #include "LayerGeometry.h" 
 // Distributions
 #include "Random.h" 
+#include "RandomStream.h"
 #include "UnivariateDistribution.h" 
 #include "UnivariateDistributionEnumerator.h" 
 #include "RandomUnivariateDistribution.h" 
@@ -76,6 +87,7 @@
 #include "Distribution.h" 
 #include "DistributionEnumerator.h" 
 #include "NormalDistribution.h" 
+#include "RandomDistribution.h" 
 #include "UniformDistribution.h" 
 // Operators
 #include "Distributor.h" 
@@ -129,9 +141,15 @@
 #include "SearchProducer.h" 
 #include "Director.h" 
 // Elements
+#include "SignalArena.h"
 #include "Pad.h" 
 #include "OutputPad.h" 
 #include "InputPad.h" 
+#include "ConnectionGraph.h"
+#include "ChangeTracker.h"
+#include "ModelSnapshot.h"
+#include "Checkpointer.h"
+#include "Profiler.h"
 #include "Bundle.h"
 #include "Disposition.h" 
 #include "Flow.h" 
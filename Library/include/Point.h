@@ -130,6 +130,13 @@ namespace Plato {
         /// </summary>
         /// <param name="point">The point to copy.</param>
         Point(const Point& point);
+
+        /// <summary>
+        /// Assignment operator.
+        /// </summary>
+        /// <param name="point">The point to copy.</param>
+        /// <returns>Returns this point.</returns>
+        Point& operator=(const Point& point);
 #pragma endregion
 
     public:
@@ -0,0 +1,83 @@
+#pragma once
+
+namespace Plato {
+
+    class Point;
+
+    /// <summary>
+    /// A reusable buffer of points stored as one array per coordinate.
+    /// </summary>
+    /// <remarks>
+    /// Geometry::GetPoints fills a batch with many points at once, so distributing a large
+    /// number of elements takes neither a virtual call nor a Point allocation per element,
+    /// and the coordinate arrays can be processed with vector instructions.
+    /// </remarks>
+    class PointBatch {
+#pragma region // Instance variables.
+    public:
+        /// <summary>
+        /// The coordinate arrays, indexed by CoordinateNames, each holding Capacity values.
+        /// </summary>
+        float* Coordinates[Point::NumberOfCoordinates];
+        /// <summary>
+        /// The number of points the batch can hold.
+        /// </summary>
+        const int Capacity;
+        /// <summary>
+        /// The number of points currently held.
+        /// </summary>
+        int Count;
+    private:
+        /// <summary>
+        /// The storage shared by the coordinate arrays, or NULL if the caller supplied it.
+        /// </summary>
+        float* mValues;
+#pragma endregion
+
+#pragma region // Constructors.
+    public:
+        /// <summary>
+        /// Constructs an empty batch.
+        /// </summary>
+        /// <param name="capacity">The number of points the batch can hold.</param>
+        PointBatch(int capacity);
+        /// <summary>
+        /// Constructs an empty batch in storage supplied by the caller, such as a buffer on the stack.
+        /// </summary>
+        /// <param name="capacity">The number of points the batch can hold.</param>
+        /// <param name="values">Room for capacity values of each coordinate, which must outlive the batch.</param>
+        PointBatch(int capacity, float* values);
+        /// <summary>
+        /// Deallocate object.
+        /// </summary>
+        ~PointBatch();
+    private:
+        PointBatch(const PointBatch&);
+        PointBatch& operator=(const PointBatch&);
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Sets every coordinate of the points from first up to Capacity to a value.
+        /// </summary>
+        /// <param name="coordinate">The coordinate to set.</param>
+        /// <param name="first">The first point to set.</param>
+        /// <param name="value">The value.</param>
+        void SetCoordinate(CoordinateNamesEnum coordinate, int first, float value);
+        /// <summary>
+        /// Multiplies a coordinate of the points from first to Count by a factor.
+        /// </summary>
+        /// <param name="coordinate">The coordinate to scale.</param>
+        /// <param name="first">The first point to scale.</param>
+        /// <param name="factor">The factor.</param>
+        void ScaleCoordinate(CoordinateNamesEnum coordinate, int first, float factor);
+        /// <summary>
+        /// Copies a point out of the batch.
+        /// </summary>
+        /// <param name="index">The index of the point, less than Count.</param>
+        /// <returns>Returns a new point.</returns>
+        Point* GetPoint(int index) const;
+#pragma endregion
+    };
+}
@@ -4,6 +4,7 @@ namespace Plato {
 
     class Point;
     class PointSpace;
+    class Bounds;
 
     namespace PointRegexStatus {
         /// <summary>
@@ -68,6 +69,11 @@ namespace Plato {
         /// <param name="point">The point to check for a match.</param>
         /// <returns>Returns true if the point matches.</returns>
         inline bool Match(const Point& point) const { return mPointSpace.IsContained(point); }
+        /// <summary>
+        /// Gets the smallest box containing the points that would match.
+        /// </summary>
+        /// <returns>Returns new bounds, which the caller deletes, or NULL if the regex point is unbounded.</returns>
+        inline Bounds* BoundingBox() const { return mPointSpace.BoundingBox(); }
 
         /// <summary>
         /// Determines whether the given regex point would match this regex point.
@@ -41,7 +41,8 @@ namespace Plato {
         /// Note that the point space may be spherical or a disjoint set of spaces.
         /// For points, the dimensions (e.g. width) of the box will be zero.
         /// </remarks>
-        /// <returns>Returns the bounds of the box.</returns>
+        /// <returns>Returns new bounds of the box, which the caller deletes,
+        /// or NULL if the space is unbounded.</returns>
         virtual Bounds* BoundingBox();
     };
 }
@@ -0,0 +1,194 @@
+#pragma once
+
+namespace Plato {
+
+    class ClassTypeInfo;
+    class Container;
+
+    /// <summary>
+    /// Measures where a running model spends its epochs.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Model::Update times each container's Update through the profiler, counting per class
+    /// the updates, the ticks they took, the ticks less those of the containers they updated in turn,
+    /// and the model objects allocated through ModelArena::New while they ran.
+    /// Model::RunEpoch records the ticks each epoch took in a histogram of power of two buckets.
+    /// </para>
+    /// <para>
+    /// Ticks are read from the processor's time stamp counter where the compiler exposes it,
+    /// otherwise from the monotonic clock, and are converted to seconds by comparing the two
+    /// over the profiler's lifetime.
+    /// </para>
+    /// <para>
+    /// Each thread counts into its own table, so updating in parallel takes no lock, and the tables
+    /// are merged when a report is made, which must be between epochs.
+    /// A container whose children are updated by the UpdateThreadPool is charged, as its own ticks,
+    /// the time it spends waiting for them.
+    /// </para>
+    /// <para>
+    /// The model creates a profiler only when Configuration::ProfileUpdates is set,
+    /// so when profiling is off the cost is a test for NULL per container.
+    /// </para>
+    /// </remarks>
+    class Profiler {
+    public:
+        /// <summary>
+        /// The number of buckets in the epoch histogram: bucket i counts the epochs
+        /// taking from 2^i up to 2^(i+1) ticks.
+        /// </summary>
+        static const int HistogramSize = 64;
+
+        /// <summary>
+        /// The counts of a class's updates.
+        /// </summary>
+        struct TypeCounters {
+            const ClassTypeInfo* Type;
+            uint64_t Updates;
+            /// <summary>
+            /// The ticks taken by the updates, including the containers they updated.
+            /// </summary>
+            uint64_t Ticks;
+            /// <summary>
+            /// The ticks taken by the updates, excluding the containers they updated.
+            /// </summary>
+            uint64_t SelfTicks;
+            /// <summary>
+            /// The objects allocated while updating, including by the containers they updated.
+            /// </summary>
+            uint64_t Allocations;
+        };
+
+        struct ThreadCounters;
+
+#pragma region // Instance variables.
+    private:
+        /// <summary>
+        /// The thread local key holding each thread's counters.
+        /// </summary>
+        ThreadLocalVariable::Key mCountersKey;
+        /// <summary>
+        /// The counters of every thread that has counted, guarded by mLock.
+        /// </summary>
+        vector<ThreadCounters*> mThreads;
+        Mutex mLock;
+        /// <summary>
+        /// The epoch histogram and totals, only updated by the thread running the model.
+        /// </summary>
+        uint64_t mHistogram[HistogramSize];
+        uint64_t mEpochs;
+        uint64_t mEpochTicks;
+        uint64_t mMinimumEpochTicks;
+        uint64_t mMaximumEpochTicks;
+        /// <summary>
+        /// The tick count at the start of the current epoch.
+        /// </summary>
+        uint64_t mEpochStart;
+        /// <summary>
+        /// The tick count and the monotonic clock, in nanoseconds, when the profiler was created.
+        /// </summary>
+        uint64_t mStartTicks;
+        uint64_t mStartNanoseconds;
+#pragma endregion
+
+#pragma region // Constructors.
+    public:
+        /// <summary>
+        /// Creates a profiler with no counts.
+        /// </summary>
+        Profiler();
+        /// <summary>
+        /// Deallocate object.
+        /// </summary>
+        /// <remarks>
+        /// Delete after the UpdateThreadPool, since the pool's threads hold the counters.
+        /// </remarks>
+        ~Profiler();
+    private:
+        Profiler(const Profiler&);
+        Profiler& operator=(const Profiler&);
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Updates a container, counting the update against its class.
+        /// </summary>
+        /// <param name="container">The container to update.</param>
+        void Update(Container& container);
+
+        /// <summary>
+        /// Counts an allocation made by the calling thread.
+        /// </summary>
+        /// <param name="size">The number of bytes allocated.</param>
+        void CountAllocation(size_t size);
+
+        /// <summary>
+        /// Marks the start of an epoch.
+        /// </summary>
+        inline void BeginEpoch() { mEpochStart = GetTicks(); }
+
+        /// <summary>
+        /// Marks the end of an epoch, adding the ticks it took to the histogram.
+        /// </summary>
+        void EndEpoch();
+
+        /// <summary>
+        /// Gets the merged counts of every thread for a class.
+        /// </summary>
+        /// <param name="type">The class.</param>
+        /// <param name="counters">Out parameter for the counts, all zero if the class has not been updated.</param>
+        /// <returns>Returns false if the class has not been updated.</returns>
+        bool GetCounters(const ClassTypeInfo& type, TypeCounters& counters);
+
+        /// <summary>
+        /// Gets the number of epochs recorded.
+        /// </summary>
+        inline uint64_t GetEpochCount() const { return mEpochs; }
+
+        /// <summary>
+        /// Gets the number of epochs recorded in a bucket of the histogram.
+        /// </summary>
+        inline uint64_t GetHistogramCount(int bucket) const { return mHistogram[bucket]; }
+
+        /// <summary>
+        /// Gets the number of ticks per second, measured over the profiler's lifetime.
+        /// </summary>
+        double GetTicksPerSecond() const;
+
+        /// <summary>
+        /// Produces a report of the counts, with the classes in decreasing order of their own ticks.
+        /// </summary>
+        string& StatusReport();
+
+        /// <summary>
+        /// Writes the counts to a file in JSON.
+        /// </summary>
+        /// <param name="path">The path of the file.</param>
+        /// <returns>Returns zero if successful, otherwise an error code.</returns>
+        int Write(const string& path);
+
+        /// <summary>
+        /// Reads the tick counter.
+        /// </summary>
+        static uint64_t GetTicks();
+
+        /// <summary>
+        /// Reads the monotonic clock in nanoseconds.
+        /// </summary>
+        static uint64_t GetNanoseconds();
+    private:
+        /// <summary>
+        /// Gets the calling thread's counters, creating them on first use.
+        /// </summary>
+        ThreadCounters& GetCounters();
+        /// <summary>
+        /// Merges the counts of every thread.
+        /// </summary>
+        /// <param name="types">Out parameter for the counts of each class updated, in decreasing order of their own ticks.</param>
+        /// <param name="allocations">Out parameter for the number of objects allocated.</param>
+        /// <param name="bytes">Out parameter for the number of bytes allocated.</param>
+        void Merge(vector<TypeCounters>& types, uint64_t& allocations, uint64_t& bytes);
+#pragma endregion
+    };
+}
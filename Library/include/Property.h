@@ -26,7 +26,11 @@ namespace Plato {
             /// <summary>
             /// Class is a Converter.
             /// </summary>
-            Converter
+            Converter,
+            /// <summary>
+            /// Class is a Disposition.
+            /// </summary>
+            Disposition
         }; 
     }
     typedef ClassKinds::Enum ClassKindsEnum;
@@ -189,6 +193,15 @@ namespace Plato {
         /// Deallocate property.
         /// </summary>
         virtual ~Property();
+
+        /// <summary>
+        /// Allocates properties from the current model's ModelArena while it is active.
+        /// </summary>
+        static void* operator new(size_t size);
+        /// <summary>
+        /// Releases memory allocated by operator new.
+        /// </summary>
+        static void operator delete(void* memory);
 #pragma endregion
 
 #pragma region // Accessors.
@@ -276,4 +289,25 @@ namespace Plato {
 		    return xKey->Identity->CompareTo(*(yKey->Identity))<0;
 		}
     };
+
+    /// <summary>
+    /// Traits class for FlatHashMap tables keyed by the address of a Property.
+    /// </summary>
+    /// <remarks>
+    /// Keys are never dereferenced, so the table may hold properties that have been deleted.
+    /// </remarks>
+    class PropertyAddressTraits {
+    public:
+        /// <summary>
+        /// Mixes the address, dropping the bits that are constant due to alignment.
+        /// </summary>
+        inline static size_t Hash(const Property* const& key) {
+            size_t h = ((size_t)key) >> 4;
+            return h ^ (h >> 7) ^ (h >> 17);
+        }
+        /// <summary>
+        /// Tests whether two keys are the same object.
+        /// </summary>
+        inline static bool Equals(const Property* const& xKey, const Property* const& yKey) { return xKey == yKey; }
+    };
 }
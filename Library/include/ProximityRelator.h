@@ -8,6 +8,7 @@ namespace Plato {
     class IdentifierRegex;
     class Point;
     class Relator;
+    class ThreadPool;
 
 #pragma region // ProximityRelator class.
     /// <summary>
@@ -17,6 +18,20 @@ namespace Plato {
     /// </summary>
     class ProximityRelator : public Relator {
     public:
+        /// <summary>
+        /// Receives the tuples found by EnumerateMatches.
+        /// </summary>
+        class TupleReceiver {
+        public:
+            virtual ~TupleReceiver() {}
+            /// <summary>
+            /// Receives one tuple of elements.
+            /// </summary>
+            /// <param name="elements">The tuple, which is only valid for the duration of the call.</param>
+            /// <returns>Returns false to stop the enumeration.</returns>
+            virtual bool Receive(vector<Property*>& elements) = 0;
+        };
+
         /// <summary>
         /// Set to true if the relator is symmetric in its arguments,
         /// i.e. the order of arguments has no effect on validity.
@@ -92,27 +107,41 @@ namespace Plato {
         static int BinarySearch(vector<int>& pattern, vector<vector<int>*>& searchVector);
 
         /// <summary>
-        /// Find all the unique tuple of elements that match this relator's patterns.
+        /// Passes each unique tuple of elements that matches this relator's patterns, and
+        /// satisfies ValidRelation, to a receiver as it is found.
         /// </summary>
         /// <remarks>
         /// <para>
-        /// The objective is to find all the unique element tuples that match this relator.
+        /// Algorithm:
+        /// 1) Index the container: each element is matched once against each distinct pattern,
+        ///    giving a bitset and an ascending list of element-order indexes (EOIs) per pattern.
+        /// 2) Join the candidate lists depth first, skipping elements already in the tuple.
+        ///    Tuples come out in ascending EOI order, so no sorting is needed.
+        /// 3) If IsSymmetric, tuples are reported with their EOIs in ascending order.
+        ///    Adjacent patterns with the same candidates only take ascending EOIs, which
+        ///    prunes their permutations, and any remaining duplicates are dropped through a hash set.
         /// </para>
         /// <para>
-        /// Algorithm:
-        /// 1) For the relator build a list of lists of matches for each pattern in relator:
-        ///    a) For each pattern in relator loop over elements finding those that match.
-        ///    b) Store element-order index (EOI) for speed in lists.
-        /// 2) Compute unique sets:
-        ///    For the relator, if arity is n, build a list of n-arity tuples:
-        ///    a) Construct an n-hierarchy of loops to construct tuples.
-        ///    b) Sort tuples on first n elements.
-        ///    c) Remove duplicates.
+        /// The elements are indexed before the first tuple is received, so the receiver may add
+        /// elements to the container without them being considered.
         /// </para>
         /// </remarks>
         /// <param name="container">The container upon which to apply the relator.</param>
-        /// <returns>Returns a list of tuples.</returns>
-        vector<vector<Property*>*>* FindMatches(Container& container);
+        /// <param name="receiver">Receives the tuples.</param>
+        void EnumerateMatches(Container& container, TupleReceiver& receiver);
+
+        /// <summary>
+        /// Find all the unique tuple of elements that match this relator's patterns.
+        /// </summary>
+        /// <remarks>
+        /// The tuples are those reported by EnumerateMatches, in the same order.
+        /// If a thread pool is given, the candidates of the first pattern are split between
+        /// tasks, so ValidRelation must then be safe to call concurrently.
+        /// </remarks>
+        /// <param name="container">The container upon which to apply the relator.</param>
+        /// <param name="pool">An optional thread pool to enumerate with.</param>
+        /// <returns>Returns a list of tuples, which the caller deletes.</returns>
+        vector<vector<Property*>*>* FindMatches(Container& container, ThreadPool* pool = NULL);
     };
 #pragma endregion
 
@@ -6,6 +6,10 @@ namespace Plato {
     /// Class for generating pseudo random numbers.
     /// Based on combining three cyclic generators to give a long repeat epoch.
     /// </summary>
+    /// <remarks>
+    /// The generator's state changes with every number drawn, so an instance cannot be shared
+    /// between threads. Use RandomStream for parallel or reproducible streams.
+    /// </remarks>
     class Random {
 
     private:
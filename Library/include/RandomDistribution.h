@@ -0,0 +1,88 @@
+#pragma once
+
+namespace Plato {
+
+    class Distribution;
+    class DistributionEnumerator;
+    class PointSpace;
+    class Point;
+    class Property;
+    class UnivariateDistribution;
+    class RandomUnivariateDistribution;
+
+    /// <summary>
+    /// In a random distribution the points are randomly distributed across [0.0,1.0].
+    /// </summary>
+    /// <remarks>
+    /// The values are drawn from the random stream of the property that owns the distribution,
+    /// see Model::CreateRandomStream, so the same model gives the same points in every run.
+    /// Each coordinate draws from its own part of the stream.
+    /// Note: it doesn't make sense to have a UnboundedCapacity random distribution.
+    /// </remarks>
+    class RandomDistribution : public Distribution {
+    public:
+        /// <summary>
+        /// The distance between the parts of the stream drawn by each coordinate.
+        /// </summary>
+        static const uint64_t CoordinateStride = (uint64_t)1 << 32;
+
+    private:
+        /// <summary>
+        /// The cross-product of 3 univariate distributions is used to form distribution.
+        /// </summary>
+        RandomUnivariateDistribution* mUnivariateDistributions[3];
+
+    public:
+        /// <summary>
+        /// Creates a new RandomDistribution object with the required capacity,
+        /// drawing from the random stream of a property of the current model.
+        /// </summary>
+        /// <param name="owner">The property that owns the distribution, normally the geometry's container.</param>
+        /// <param name="aCapacity">The maximum number of points this distribution contains in the A dimension.</param>
+        /// <param name="bCapacity">The maximum number of points this distribution contains in the B dimension.</param>
+        /// <param name="cCapacity">The maximum number of points this distribution contains in the C dimension.</param>
+        RandomDistribution(const Property& owner,
+            int aCapacity=UnivariateDistribution::UnboundedCapacity,
+            int bCapacity=UnivariateDistribution::UnboundedCapacity,
+            int cCapacity=UnivariateDistribution::UnboundedCapacity);
+        /// <summary>
+        /// Copy constructor.
+        /// </summary>
+        /// <param name="distribution">The distribution to copy.</param>
+        RandomDistribution(const RandomDistribution& distribution);
+        /// <summary>
+        /// Deallocate object.
+        /// </summary>
+        virtual ~RandomDistribution();
+        /// <summary>
+        /// Get a new enumerator for this distribition instance.
+        /// </summary>
+        /// <returns>Returns a distribution enumerator.</returns>
+        virtual DistributionEnumerator* GetEnumerator();
+        /// <summary>
+        /// Copy this distribution instance.
+        /// </summary>
+        /// <returns>Returns a copy.</returns>
+        virtual Distribution* Clone() const;
+
+        /// <summary>
+        /// Creates the univariate distribution of one coordinate, for geometries that generate
+        /// points a coordinate at a time.
+        /// </summary>
+        /// <param name="coordinate">The coordinate.</param>
+        /// <returns>Returns a new distribution, which the caller deletes.</returns>
+        virtual UnivariateDistribution* CreateUnivariateDistribution(CoordinateNamesEnum coordinate) const;
+    };
+
+    /// <summary>
+    /// Type safe convenience class for constructing random distribution enumerators.
+    /// </summary>
+    class RandomDistributionEnumerator : public DistributionEnumerator {
+    public:
+        /// <summary>
+        ///  Construct a new enumerator for the random distribution.
+        /// </summary>
+        /// <param name="distribution">The random distribution for which an enumerator is required.</param>
+        RandomDistributionEnumerator(RandomDistribution& distribution);
+    };
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+namespace Plato {
+
+    /// <summary>
+    /// A counter based generator of pseudo random numbers, after the Philox4x32-10 generator
+    /// of Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC11.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each value is a pure function of a key and a counter rather than of mutable seeds,
+    /// so any number of streams can be drawn independently, on any thread, and any value
+    /// of a stream can be found without generating those before it.
+    /// A stream is keyed by a model seed and a stream number, normally identifying the property
+    /// drawing it, and the counter combines the epoch with the position in the stream.
+    /// The same key, epoch and position always give the same value on every platform.
+    /// </para>
+    /// <para>
+    /// A stream instance buffers the current block of four values, so it should only
+    /// be used by one thread at a time. Use one stream per property rather than sharing one.
+    /// </para>
+    /// </remarks>
+    class RandomStream {
+#pragma region // Class variables.
+    public:
+        /// <summary>
+        /// The number of 32 bit values generated per counter.
+        /// </summary>
+        static const int BlockSize = 4;
+#pragma endregion
+
+#pragma region // Instance variables.
+    private:
+        /// <summary>
+        /// The key: the model seed and stream number.
+        /// </summary>
+        uint32_t mKey[2];
+        /// <summary>
+        /// The epoch, held in the third counter word.
+        /// </summary>
+        uint32_t mEpoch;
+        /// <summary>
+        /// The index of the next block to generate.
+        /// </summary>
+        uint64_t mBlock;
+        /// <summary>
+        /// The values of the last block generated and the index of the next one to return.
+        /// </summary>
+        uint32_t mBuffer[BlockSize];
+        int mBufferIndex;
+#pragma endregion
+
+#pragma region // Constructors.
+    public:
+        /// <summary>
+        /// Construct a stream positioned at its first value.
+        /// </summary>
+        /// <param name="seed">The model seed.</param>
+        /// <param name="stream">The stream number, unique for each stream drawn with the same seed.</param>
+        /// <param name="epoch">The epoch the values are drawn in.</param>
+        RandomStream(uint32_t seed = 0, uint32_t stream = 0, uint32_t epoch = 0);
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Computes one block of values, i.e. ten Philox rounds.
+        /// </summary>
+        /// <param name="key">The two key words.</param>
+        /// <param name="counter">The four counter words.</param>
+        /// <param name="result">Out parameter for the four values.</param>
+        static void Generate(const uint32_t key[2], const uint32_t counter[BlockSize], uint32_t result[BlockSize]);
+
+        /// <summary>
+        /// Moves the stream to the first value of an epoch.
+        /// </summary>
+        void SetEpoch(uint32_t epoch);
+
+        /// <summary>
+        /// Moves the stream to a value.
+        /// </summary>
+        /// <param name="position">The index of the next value to return, counting 32 bit values from the start of the epoch.</param>
+        void Seek(uint64_t position);
+
+        /// <summary>
+        /// Gets the index of the next value to be returned.
+        /// </summary>
+        inline uint64_t GetPosition() const { return mBlock * BlockSize - (BlockSize - mBufferIndex); }
+
+        /// <summary>
+        /// Return a random 32 bit integer.
+        /// </summary>
+        uint32_t NextUInt();
+
+        /// <summary>
+        /// Return a random number in [0.0 &lt;= r &lt; 1.0), consuming two values.
+        /// </summary>
+        double NextDouble();
+
+        /// <summary>
+        /// Return a random number in [0.0 &lt;= r &lt; 1.0), with 24 bits of precision.
+        /// </summary>
+        float NextFloat();
+
+        /// <summary>
+        /// Return random integer, [0 &lt;= r &lt; maxValue).
+        /// </summary>
+        /// <param name="maxValue">Upper bound, i.e. one more than maximum number to return.</param>
+        /// <returns>Returns a pseudo random integer from zero up to, but not including maxValue.</returns>
+        int Next(int maxValue);
+
+        /// <summary>
+        /// Fills a buffer with the next random numbers, as if by calling NextFloat for each.
+        /// </summary>
+        /// <remarks>Whole blocks are generated four at a time with vector instructions where available.</remarks>
+        /// <param name="values">The buffer to fill.</param>
+        /// <param name="count">The number of values to fill.</param>
+        void Fill(float* values, int count);
+
+        /// <summary>
+        /// Fills a buffer with the next random integers, as if by calling NextUInt for each.
+        /// </summary>
+        /// <param name="values">The buffer to fill.</param>
+        /// <param name="count">The number of values to fill.</param>
+        void Fill(uint32_t* values, int count);
+    private:
+        /// <summary>
+        /// Generates block mBlock into mBuffer and advances mBlock.
+        /// </summary>
+        void NextBlock();
+        /// <summary>
+        /// Generates count whole blocks from mBlock into values and advances mBlock.
+        /// </summary>
+        void GenerateBlocks(uint32_t* values, int count);
+#pragma endregion
+    };
+}
@@ -5,6 +5,7 @@ namespace Plato {
     class UnivariateDistribution;
     class UnivariateDistributionEnumerator;
     class RandomUnivariateDistributionEnumerator;
+    class RandomStream;
 
     /// <summary>
     /// In a random distribution the points are randomly distributed across [0.0,1.0].
@@ -19,6 +20,10 @@ namespace Plato {
         /// The sorted, but random, distribution values.
         /// </summary>
         vector<float>* mDistributionValues;
+        /// <summary>
+        /// The stream the distribution values are drawn from, positioned at the first value.
+        /// </summary>
+        RandomStream* mStream;
 
     public:
         /// <summary>
@@ -27,7 +32,15 @@ namespace Plato {
         /// <param name="capacity">Capacity of new distribution. The default value
         /// will construct a new RandomDistribution instance with an unbounded capacity.
         /// </param>
-        RandomUnivariateDistribution(int capacity=UnivariateDistribution::UnboundedCapacity);
+        /// <param name="seed">The seed of the stream the values are drawn from, see RandomStream.</param>
+        RandomUnivariateDistribution(int capacity=UnivariateDistribution::UnboundedCapacity, uint32_t seed=0);
+        /// <summary>
+        /// Construct a new RandomDistribution instance drawing from a given stream,
+        /// normally one made by Model::CreateRandomStream for the property that owns the distribution.
+        /// </summary>
+        /// <param name="capacity">Capacity of new distribution.</param>
+        /// <param name="stream">The stream the values are drawn from, from its current position. It is copied.</param>
+        RandomUnivariateDistribution(int capacity, const RandomStream& stream);
         /// <summary>
         /// Copy constructor.
         /// </summary>
@@ -51,15 +64,14 @@ namespace Plato {
         /// <remarks>
         /// TO DO: if capacity is adjusted it recomputes the whole distribution, i.e. slow.
         /// It would be better to adjust the distribution up or down in size.
-        /// In this case, must allow for clones of distribution that would need a deep copy of rnd too.
         /// </remarks>
         virtual void SetCapacity(int value);
 
         /// <summary>
-        /// Shallow copy this distribution instance.
+        /// Copy this distribution instance, including its values.
         /// </summary>
         /// <remarks>Derived classes should override and call their copy constructor.</remarks>
-        /// <returns>Returns a shallow copy.</returns>
+        /// <returns>Returns a copy.</returns>
         virtual UnivariateDistribution* Clone() const;
 
         /// <summary>
@@ -67,11 +79,22 @@ namespace Plato {
         /// </summary>
         virtual float operator[](int index);
 
+        /// <summary>
+        /// Fills a buffer with a run of consecutive distribution values.
+        /// </summary>
+        /// <param name="first">The index of the first value.</param>
+        /// <param name="count">The number of values wanted.</param>
+        /// <param name="values">The buffer to fill, which must hold count values.</param>
+        /// <returns>Returns the number of values filled.</returns>
+        virtual int Fill(int first, int count, float* values);
+
         /// <summary>
         /// Resets the distribution.
         /// </summary>
         /// <remarks>
         /// Normally called internally by SetCapacity or in constructor.
+        /// The values are drawn from the same position of the stream each time, so the same stream
+        /// and capacity always give the same distribution.
         /// </remarks>
         void Reset();
     };
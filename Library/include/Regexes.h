@@ -2,11 +2,131 @@
 
 namespace Plato {
 
+    class Mutex;
+
+#pragma region // RegexPatternKinds Enumeration.
+    namespace RegexPatternKinds {
+        /// <summary>
+        /// How a compiled pattern is matched.
+        /// </summary>
+        enum Enum {
+            /// <summary>
+            /// By the regex package.
+            /// </summary>
+            Regex,
+            /// <summary>
+            /// Matches any text, e.g. ".*".
+            /// </summary>
+            Any,
+            /// <summary>
+            /// Matches any non empty text, i.e. the wild pattern ".+".
+            /// </summary>
+            NonEmpty,
+            /// <summary>
+            /// One or more literal alternatives, possibly anchored, e.g. "Connector", "^in" or "^(in|out)$".
+            /// </summary>
+            Literals
+        };
+    }
+    typedef RegexPatternKinds::Enum RegexPatternKindsEnum;
+#pragma endregion
+
+    /// <summary>
+    /// A regular expression compiled by the underlying package, shared through the Regexes cache.
+    /// </summary>
+    /// <remarks>
+    /// Patterns that are literals, or wild, are classified when compiled so RegexMatcher can match
+    /// them without calling the regex package. Matches are unanchored searches, as in the package,
+    /// so the literal "in" matches "input" while "^in$" only matches "in".
+    /// </remarks>
+    class CompiledRegex {
+    public:
+        /// <summary>
+        /// The regular expression pattern.
+        /// </summary>
+        const string Pattern;
+        /// <summary>
+        /// The regular expression as represented by the regex package, or NULL if it did not compile.
+        /// </summary>
+        void* RegexPatternPtr;
+        /// <summary>
+        /// Extra information for use by the regex package, including any JIT compiled code.
+        /// </summary>
+        void* RegexExtraPtr;
+        /// <summary>
+        /// How the pattern is matched.
+        /// </summary>
+        RegexPatternKindsEnum Kind;
+        /// <summary>
+        /// The alternatives of a Literals pattern.
+        /// </summary>
+        vector<string> Literals;
+        /// <summary>
+        /// Indicates the alternatives of a Literals pattern must match at the start of the text.
+        /// </summary>
+        bool IsStartAnchored;
+        /// <summary>
+        /// Indicates the alternatives of a Literals pattern must match at the end of the text.
+        /// </summary>
+        bool IsEndAnchored;
+
+        /// <summary>
+        /// Matches the text against the alternatives of a Literals pattern.
+        /// </summary>
+        bool MatchesLiterals(const char* text, size_t length) const;
+
+    private:
+        friend class Regexes;
+        /// <summary>
+        /// Strings::SuperFastHash of Pattern.
+        /// </summary>
+        uint32_t mHash;
+        /// <summary>
+        /// The number of RegexMatchers using the pattern. Patterns in use are never evicted.
+        /// </summary>
+        int mUseCount;
+        /// <summary>
+        /// The next pattern in the same hash chain.
+        /// </summary>
+        CompiledRegex* mNext;
+        /// <summary>
+        /// The neighbours in the cache's least recently used list.
+        /// </summary>
+        CompiledRegex* mNewer;
+        CompiledRegex* mOlder;
+
+        /// <summary>
+        /// Compiles and studies the pattern.
+        /// </summary>
+        CompiledRegex(const char* pattern, size_t length, uint32_t hash);
+        /// <summary>
+        /// Frees the package's representation of the pattern.
+        /// </summary>
+        ~CompiledRegex();
+        /// <summary>
+        /// Sets Kind, and the literals of a Literals pattern.
+        /// </summary>
+        void Classify();
+        /// <summary>
+        /// Splits a pattern, or the group holding it, into literal alternatives.
+        /// </summary>
+        /// <returns>Returns false if an alternative is not a literal.</returns>
+        bool SplitLiterals(size_t begin, size_t end);
+        /// <summary>
+        /// Checks whether the character at a position in Pattern is escaped by a backslash.
+        /// </summary>
+        bool IsEscaped(size_t position) const;
+        CompiledRegex(const CompiledRegex&);
+        CompiledRegex& operator=(const CompiledRegex&);
+    };
+
     /// <summary>
     /// A wrapper class around the underlying regular expression package.
     /// </summary>
     /// <remarks>
     /// Hides the package implementation.
+    /// The compiled pattern is fetched from the Regexes cache, so constructing a matcher
+    /// for a pattern that has been seen recently does not recompile it.
     /// </remarks>
     class RegexMatcher {
 
@@ -29,13 +149,9 @@ namespace Plato {
 
     private:
         /// <summary>
-        /// The regular expression as represented by the regex package.
+        /// The compiled pattern, held until the matcher is destroyed.
         /// </summary>
-        void* RegexPatternPtr;
-        /// <summary>
-        /// Extra information for use by the regex package.
-        /// </summary>
-        void* RegexExtraPtr;
+        CompiledRegex* mCompiledRegex;
 
     public:
         /// <summary>
@@ -49,7 +165,7 @@ namespace Plato {
         /// <remarks>The caller is responsible for deleting pattern.</remarks>
         RegexMatcher(const string* pattern);
         /// <summary>
-        /// Deallocates Regex objects.
+        /// Releases the compiled pattern back to the cache.
         /// </summary>
         ~RegexMatcher();
         /// <summary>
@@ -64,12 +180,56 @@ namespace Plato {
         /// <param name="text">The text to check for a regex match.</param>
         /// <returns>Returns true if text satisfied the pattern.</returns>
         bool Matches(const string& text);
+        /// <summary>
+        /// Gets the text an exact literal pattern, e.g. "^in$", matches.
+        /// </summary>
+        /// <returns>Returns the literal, or NULL if the pattern is not an exact literal.</returns>
+        const string* GetExactLiteral() const;
+    private:
+        /// <summary>
+        /// Matches text of a given length, taking the fast path for classified patterns.
+        /// </summary>
+        bool Matches(const char* text, size_t length);
+        RegexMatcher(const RegexMatcher&);
+        RegexMatcher& operator=(const RegexMatcher&);
     };
 
     /// <summary>
     /// Regular Expression Helper Class.
     /// </summary>
+    /// <remarks>
+    /// Regexes keeps a process wide cache of compiled patterns, keyed by the pattern text.
+    /// Path patterns are heavily reused, e.g. by Connectors during Configure, so most
+    /// RegexMatchers find their pattern already compiled. Once the cache holds more than
+    /// CacheCapacity patterns, the least recently used patterns not in use are freed.
+    /// The cache is shared by all models and threads.
+    /// </remarks>
     class Regexes {
+    public:
+        /// <summary>
+        /// The number of compiled patterns kept when they are no longer in use.
+        /// </summary>
+        static const int CacheCapacity = 512;
+
+    private:
+        /// <summary>
+        /// The hash chains of the cache, a power of two in number.
+        /// </summary>
+        static vector<CompiledRegex*>* mBuckets;
+        /// <summary>
+        /// The most and least recently used patterns.
+        /// </summary>
+        static CompiledRegex* mNewest;
+        static CompiledRegex* mOldest;
+        /// <summary>
+        /// The number of patterns in the cache.
+        /// </summary>
+        static int mCacheCount;
+        /// <summary>
+        /// Serialises access to the cache.
+        /// </summary>
+        static Mutex mLock;
+
     public:
         /// <summary>
         /// The characters whose occurrence in a string imply
@@ -130,7 +290,35 @@ namespace Plato {
         /// <returns>Returns true if the text is a regular expression.</returns>
         static bool IsRegex(const char* inputText);
 
+        /// <summary>
+        /// Fetches the compiled form of a pattern, compiling it if it is not cached.
+        /// </summary>
+        /// <remarks>Each call must be matched by a call to Release.</remarks>
+        /// <param name="pattern">The characters of the pattern.</param>
+        /// <param name="length">The number of characters in pattern.</param>
+        /// <returns>Returns the compiled pattern, which is not evicted until released.</returns>
+        static CompiledRegex& Acquire(const char* pattern, size_t length);
+
+        /// <summary>
+        /// Releases a pattern returned by Acquire.
+        /// </summary>
+        /// <param name="regex">The pattern to release.</param>
+        static void Release(CompiledRegex& regex);
+
+        /// <summary>
+        /// Gets the number of compiled patterns in the cache.
+        /// </summary>
+        static int CacheCount();
+
     private:
+        /// <summary>
+        /// Unlinks a pattern from the least recently used list.
+        /// </summary>
+        static void Unlink(CompiledRegex& regex);
+        /// <summary>
+        /// Frees the least recently used patterns not in use, down to CacheCapacity.
+        /// </summary>
+        static void Evict();
         friend class InitializerCatalogue;
         /// <summary>
         /// The class initializer.
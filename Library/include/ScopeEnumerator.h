@@ -56,10 +56,24 @@ namespace Plato {
         /// </summary>
         void Reset();
 
+        /// <summary>
+        /// Returns the enumerator to the start of another container, so it can be reused without reallocation.
+        /// </summary>
+        /// <param name="container">The container to enumerate over.</param>
+        void Reset(Container& container);
+
         /// <summary>
         /// Move to the next item that is in scope, if possible.
         /// </summary>
         /// <returns>Returns true if there are more items in the enumerator. </returns>
         bool MoveNext();
+
+        /// <summary>
+        /// Checks whether an item is in scope of a requester, as MoveNext does.
+        /// </summary>
+        /// <param name="item">The item to check.</param>
+        /// <param name="requester">The property requesting the item, or NULL if scope checking not required.</param>
+        /// <returns>Returns true if the item is in scope.</returns>
+        static bool IsInScope(const Property& item, const Property* requester);
     };
 }
@@ -0,0 +1,131 @@
+#pragma once
+
+namespace Plato {
+
+    /// <summary>
+    /// Contiguous storage for the double buffered output signals of a model's OutputPads.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each OutputPad is allocated a slot index into two flat float arrays:
+    /// Current, which is read during an epoch, and Next, which is written.
+    /// At the end of an epoch the arrays are swapped by exchanging pointers.
+    /// </para>
+    /// <para>
+    /// Slots are handed out in pad construction order, so the pads of a Disposition
+    /// and its bundles occupy neighbouring slots and are read with sequential loads.
+    /// The arrays are aligned to SignalArena::Alignment bytes and padded to a multiple
+    /// of it, so kernels may process whole vector lanes without bounds checks.
+    /// </para>
+    /// </remarks>
+    class SignalArena {
+    public:
+        /// <summary>
+        /// The alignment in bytes of the signal arrays, a cache line.
+        /// </summary>
+        static const int Alignment = 64;
+        /// <summary>
+        /// The number of floats per aligned block.
+        /// </summary>
+        static const int BlockSize = Alignment / sizeof(float);
+
+#pragma region // Instance variables.
+    public:
+        /// <summary>
+        /// The signal values readable during the current epoch.
+        /// </summary>
+        float* Current;
+        /// <summary>
+        /// The signal values being written for the next epoch.
+        /// </summary>
+        float* Next;
+    private:
+        /// <summary>
+        /// The unaligned allocations underlying Current and Next.
+        /// </summary>
+        char* mCurrentBlock;
+        char* mNextBlock;
+        /// <summary>
+        /// The number of slots handed out, including released slots.
+        /// </summary>
+        int mCount;
+        /// <summary>
+        /// The number of slots the arrays can hold.
+        /// </summary>
+        int mCapacity;
+        /// <summary>
+        /// Released slots available for reuse.
+        /// </summary>
+        vector<int> mFreeSlots;
+        /// <summary>
+        /// Serialises Allocate and Release, which may be called while the model is configured in parallel.
+        /// </summary>
+        Mutex mLock;
+#pragma endregion
+
+#pragma region // Constructors.
+    public:
+        /// <summary>
+        /// Creates an arena.
+        /// </summary>
+        /// <param name="initialCapacity">The number of slots to reserve initially.</param>
+        SignalArena(int initialCapacity = 1024);
+        /// <summary>
+        /// Releases the signal arrays.
+        /// </summary>
+        ~SignalArena();
+    private:
+        SignalArena(const SignalArena&);
+        SignalArena& operator=(const SignalArena&);
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Gets the number of slots in use, including any released slots below the high water mark.
+        /// </summary>
+        inline int Count() const { return mCount; }
+        /// <summary>
+        /// Gets the number of slots the arrays can currently hold.
+        /// </summary>
+        inline int Capacity() const { return mCapacity; }
+        /// <summary>
+        /// Allocates a slot and zeroes its current and next values.
+        /// </summary>
+        /// <remarks>
+        /// This may reallocate the arrays, so callers must hold slot indexes, not pointers.
+        /// Allocate and Release are locked, so the configure threads can allocate slots at once,
+        /// but the arrays may move under any thread reading or writing the values meanwhile.
+        /// Allocation should therefore happen during model construction and configuration, not while running.
+        /// </remarks>
+        /// <returns>Returns the slot index.</returns>
+        int Allocate();
+        /// <summary>
+        /// Returns a slot to the arena for reuse.
+        /// </summary>
+        /// <param name="slot">The slot index returned by Allocate.</param>
+        void Release(int slot);
+        /// <summary>
+        /// Makes the Next values current, ready for the next epoch.
+        /// </summary>
+        /// <remarks>
+        /// This is a pointer swap. A slot not written during an epoch
+        /// reads back the value it held two epochs earlier, unless a ChangeTracker
+        /// has carried the Current values over into Next.
+        /// </remarks>
+        inline void Swap() { float* tmp = Current; Current = Next; Next = tmp; }
+    private:
+        /// <summary>
+        /// Grows the arrays to hold at least the given number of slots.
+        /// </summary>
+        void Reserve(int capacity);
+        /// <summary>
+        /// Allocates a zeroed, aligned float array.
+        /// </summary>
+        /// <param name="capacity">The number of floats.</param>
+        /// <param name="block">Returns the underlying allocation to be deleted.</param>
+        /// <returns>Returns the aligned array.</returns>
+        static float* AllocateAligned(int capacity, char*& block);
+#pragma endregion
+    };
+}
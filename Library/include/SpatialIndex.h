@@ -0,0 +1,145 @@
+#pragma once
+
+namespace Plato {
+
+    class Point;
+    class Property;
+
+    /// <summary>
+    /// A uniform grid over the spatial coordinates of the positioned properties of a container.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each property whose Identity has a Position is filed in the cube shaped cell holding the
+    /// first Point::NumberOfSpatialCoordinates of its coordinates. Only occupied cells are stored,
+    /// in a hash table keyed by the cell's integer coordinates, so a query visits the cells
+    /// overlapping its region, or the occupied cells if there are fewer of them, instead of
+    /// every property in the container. The overlay coordinate is ignored.
+    /// </para>
+    /// <para>
+    /// The container keeps the index up to date as properties are added and removed.
+    /// A property's position should therefore not be changed while it is in a container.
+    /// </para>
+    /// </remarks>
+    class SpatialIndex {
+    public:
+        /// <summary>
+        /// The integer coordinates of a cell.
+        /// </summary>
+        struct Cell {
+            int X, Y, Z;
+        };
+        /// <summary>
+        /// FlatHashMap traits for Cell.
+        /// </summary>
+        struct CellTraits {
+            static size_t Hash(const Cell& cell);
+            inline static bool Equals(const Cell& a, const Cell& b) { return a.X == b.X && a.Y == b.Y && a.Z == b.Z; }
+        };
+        typedef FlatHashMap<Cell, vector<Property*>*, CellTraits> HashTable;
+
+#pragma region // Instance variables.
+    private:
+        /// <summary>
+        /// The width of a cell in every spatial coordinate.
+        /// </summary>
+        float mCellSize;
+        /// <summary>
+        /// The properties in each occupied cell.
+        /// </summary>
+        HashTable mCells;
+        /// <summary>
+        /// The number of properties indexed.
+        /// </summary>
+        int mCount;
+        /// <summary>
+        /// The smallest and largest spatial coordinates of the properties indexed.
+        /// </summary>
+        mutable float mLower[3];
+        mutable float mUpper[3];
+        /// <summary>
+        /// Set when a property on the boundary has been removed, so the extent may be larger than needed.
+        /// It is recalculated by the next GetExtent rather than by every Erase.
+        /// </summary>
+        mutable bool mIsExtentStale;
+#pragma endregion
+
+#pragma region // Constructors.
+    public:
+        /// <summary>
+        /// Constructs an empty index.
+        /// </summary>
+        /// <param name="cellSize">The width of a cell, which defaults to the unit spacing of lattice positions.</param>
+        SpatialIndex(float cellSize = 1.0f);
+        /// <summary>
+        /// Deallocate object.
+        /// </summary>
+        ~SpatialIndex();
+    private:
+        SpatialIndex(const SpatialIndex&);
+        SpatialIndex& operator=(const SpatialIndex&);
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Gets the number of properties indexed.
+        /// </summary>
+        inline int Count() const { return mCount; }
+        /// <summary>
+        /// Files a property under its position.
+        /// </summary>
+        /// <returns>Returns false if the property has no position.</returns>
+        bool Insert(Property& prop);
+        /// <summary>
+        /// Removes a property.
+        /// </summary>
+        /// <returns>Returns false if the property was not indexed.</returns>
+        bool Erase(const Property& prop);
+        /// <summary>
+        /// Removes every property.
+        /// </summary>
+        void Clear();
+        /// <summary>
+        /// Finds the properties within an axis aligned box, bounds included.
+        /// </summary>
+        /// <param name="lower">The lower corner of the box.</param>
+        /// <param name="upper">The upper corner of the box.</param>
+        /// <param name="results">The vector the properties found are appended to, in no particular order.</param>
+        /// <returns>Returns the number of occupied cells searched.</returns>
+        int FindInBox(const Point& lower, const Point& upper, vector<Property*>& results) const;
+        /// <summary>
+        /// Finds the properties within a distance of a point, bounds included.
+        /// </summary>
+        /// <param name="centre">The centre of the sphere.</param>
+        /// <param name="radius">The radius of the sphere.</param>
+        /// <param name="results">The vector the properties found are appended to, in no particular order.</param>
+        /// <returns>Returns the number of occupied cells searched.</returns>
+        int FindInSphere(const Point& centre, float radius, vector<Property*>& results) const;
+        /// <summary>
+        /// Gets the smallest box holding the positions of all the properties indexed.
+        /// </summary>
+        /// <param name="lower">Out parameter for the lower corner of the box.</param>
+        /// <param name="upper">Out parameter for the upper corner of the box.</param>
+        /// <returns>Returns false if the index is empty.</returns>
+        bool GetExtent(Point& lower, Point& upper) const;
+    private:
+        /// <summary>
+        /// Finds the properties within a box and, when centre is not NULL, also within radius of centre.
+        /// </summary>
+        int Find(const float* lower, const float* upper, const float* centre, float radius, vector<Property*>& results) const;
+        /// <summary>
+        /// Gets the cell holding a position.
+        /// </summary>
+        Cell GetCell(const float* coordinates) const;
+        /// <summary>
+        /// Gets the cell coordinate for a spatial coordinate, clamped so unbounded coordinates do not overflow.
+        /// </summary>
+        int ToCell(float coordinate) const;
+        /// <summary>
+        /// Recalculates the extent once a property on its boundary has been removed.
+        /// </summary>
+        void UpdateExtent() const;
+#pragma endregion
+    };
+}
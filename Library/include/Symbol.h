@@ -0,0 +1,112 @@
+#pragma once
+
+namespace Plato {
+
+    /// <summary>
+    /// An interned name, shared by every Identifier with the same Name.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Symbols are looked up or created by Intern and are immutable once created,
+    /// so equal names always yield the same Symbol. Identifiers compare names by
+    /// comparing their Symbols, and reuse the HashCode computed when the name was interned.
+    /// </para>
+    /// <para>
+    /// HashCode is a bijective mix of Id rather than a hash of the characters, so distinct
+    /// names never collide, and names differing only in a numeric suffix, e.g. generated
+    /// identifiers, are spread evenly across the low bits used by FlatHashMap.
+    /// </para>
+    /// <para>
+    /// The table is shared by all models and threads, and is emptied by the library
+    /// finalizer once the last model has been destroyed.
+    /// </para>
+    /// </remarks>
+    class Symbol {
+#pragma region // Class variables.
+    private:
+        /// <summary>
+        /// The hash chains of the table, a power of two in number.
+        /// </summary>
+        static vector<Symbol*>* mBuckets;
+        /// <summary>
+        /// The number of symbols in the table.
+        /// </summary>
+        static int mCount;
+        /// <summary>
+        /// Serialises access to the table.
+        /// </summary>
+        static Mutex mLock;
+#pragma endregion
+
+#pragma region // Instance variables.
+    public:
+        /// <summary>
+        /// The interned name.
+        /// </summary>
+        const string Name;
+        /// <summary>
+        /// The hash code of the name, unique to the symbol.
+        /// </summary>
+        const size_t HashCode;
+        /// <summary>
+        /// A number unique to the symbol, in order of creation.
+        /// </summary>
+        const int Id;
+    private:
+        /// <summary>
+        /// Strings::SuperFastHash of Name, used to find the symbol in the table.
+        /// </summary>
+        uint32_t mNameHash;
+        /// <summary>
+        /// The next symbol in the same hash chain.
+        /// </summary>
+        Symbol* mNext;
+#pragma endregion
+
+#pragma region // Constructors.
+    private:
+        Symbol(const char* name, size_t length, uint32_t nameHash, int id);
+        Symbol(const Symbol&);
+        Symbol& operator=(const Symbol&);
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Fetches the symbol for a name, creating it if this is the first use of the name.
+        /// </summary>
+        /// <param name="name">The characters of the name.</param>
+        /// <param name="length">The number of characters in name.</param>
+        static const Symbol& Intern(const char* name, size_t length);
+        /// <summary>
+        /// Fetches the symbol for a NUL terminated name.
+        /// </summary>
+        inline static const Symbol& Intern(const char* name) { return Intern(name, strlen(name)); }
+        /// <summary>
+        /// Fetches the symbol for a string.
+        /// </summary>
+        inline static const Symbol& Intern(const string& name) { return Intern(name.data(), name.size()); }
+        /// <summary>
+        /// Gets the number of symbols interned.
+        /// </summary>
+        static int Count();
+        /// <summary>
+        /// Class initializer.
+        /// </summary>
+        static void Initializer();
+        /// <summary>
+        /// Class finalizer, deletes every symbol.
+        /// </summary>
+        static void Finalizer();
+    private:
+        /// <summary>
+        /// Mixes the bits of an Id to give a well distributed, unique hash code.
+        /// </summary>
+        static size_t MixId(int id);
+        /// <summary>
+        /// Doubles the number of buckets and redistributes the symbols.
+        /// </summary>
+        static void Grow();
+#pragma endregion
+    };
+}
@@ -13,6 +13,7 @@ namespace Plato {
         inline static Key GetKey() { return TlsAlloc(); } 
         inline static ValuePtr GetVariableValue(Key key) { return TlsGetValue(key); }
         inline static void SetVariableValue(Key key,const ValuePtr pValue) { TlsSetValue(key,pValue); }
+        inline static void FreeKey(Key key) { TlsFree(key); }
 #else // POSIX
         typedef pthread_key_t Key;
         typedef void* ValuePtr;
@@ -20,6 +21,7 @@ namespace Plato {
         inline static bool AllocateKey(Key* pKey) { return (pthread_key_create(pKey, NULL)==0); }
         inline static ValuePtr GetVariableValue(Key key) { return pthread_getspecific(key); }
         inline static void SetVariableValue(Key key,const ValuePtr pValue) { pthread_setspecific(key, pValue);  }       
+        inline static void FreeKey(Key key) { pthread_key_delete(key); }
 #endif
     };
 }
@@ -0,0 +1,179 @@
+#pragma once
+
+namespace Plato {
+
+    /// <summary>
+    /// A pool of worker threads that execute tasks using work-stealing.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each worker owns a task deque. Tasks submitted by a worker are pushed onto
+    /// the back of its own deque and popped from the back (LIFO), which keeps
+    /// recursive work, such as nested Region updates, cache local.
+    /// Idle workers steal from the front of the other deques (FIFO).
+    /// </para>
+    /// <para>
+    /// Tasks are grouped into TaskGroups. A thread that waits on a group helps
+    /// execute queued tasks until the group completes, so nested fork-join
+    /// parallelism does not deadlock the pool.
+    /// </para>
+    /// </remarks>
+    class ThreadPool {
+    public:
+        class TaskGroup;
+
+        /// <summary>
+        /// A unit of work executed by the pool.
+        /// </summary>
+        class Task {
+        public:
+            /// <summary>
+            /// The group the task belongs to, set on submission.
+            /// </summary>
+            TaskGroup* Group;
+            Task() { Group = NULL; }
+            virtual ~Task() {}
+            /// <summary>
+            /// Performs the work of the task.
+            /// </summary>
+            virtual void Execute() = 0;
+        };
+
+        /// <summary>
+        /// Tracks completion of a set of submitted tasks.
+        /// </summary>
+        class TaskGroup {
+        public:
+            /// <summary>
+            /// The number of tasks not yet completed.
+            /// </summary>
+            Atomic::Value Pending;
+            /// <summary>
+            /// Set when a task in the group threw an exception.
+            /// </summary>
+            Atomic::Value Failures;
+            TaskGroup() { Pending = 0; Failures = 0; }
+        };
+
+#pragma region // Instance variables.
+    private:
+        /// <summary>
+        /// The type of a worker's task deque.
+        /// </summary>
+        typedef deque<Task*> TaskDeque;
+#ifdef WIN32
+        typedef HANDLE ThreadHandle;
+#else
+        typedef pthread_t ThreadHandle;
+#endif
+        /// <summary>
+        /// Per worker state.
+        /// </summary>
+        struct Worker {
+            ThreadPool* Pool;
+            int Index;
+            ThreadHandle Thread;
+            Mutex QueueLock;
+            TaskDeque Queue;
+        };
+        /// <summary>
+        /// The workers, including slot 0 which is used for tasks submitted by non-pool threads.
+        /// </summary>
+        vector<Worker*> mWorkers;
+        /// <summary>
+        /// Thread local key holding the current thread's worker index plus one.
+        /// </summary>
+        ThreadLocalVariable::Key mWorkerKey;
+        /// <summary>
+        /// A thread context key and value that workers set on start up, e.g. Model::Current().
+        /// </summary>
+        ThreadLocalVariable::Key mContextKey;
+        ThreadLocalVariable::ValuePtr mContextValue;
+        /// <summary>
+        /// The number of tasks sitting in the deques.
+        /// </summary>
+        Atomic::Value mQueuedCount;
+        /// <summary>
+        /// The number of workers waiting for work.
+        /// </summary>
+        int mSleepingCount;
+        /// <summary>
+        /// Signals the workers to exit.
+        /// </summary>
+        volatile bool mIsStopping;
+        /// <summary>
+        /// Guards the sleeping state of workers.
+        /// </summary>
+        Mutex mIdleLock;
+        /// <summary>
+        /// Wakes sleeping workers when tasks are submitted.
+        /// </summary>
+        Condition mIdleCondition;
+#pragma endregion
+
+#pragma region // Constructors.
+    public:
+        /// <summary>
+        /// Creates a pool and starts its worker threads.
+        /// </summary>
+        /// <param name="numberOfThreads">The number of worker threads,
+        /// or 0 for one per processor.</param>
+        /// <param name="contextKey">A thread local key to initialise on each worker.</param>
+        /// <param name="contextValue">The value to store under contextKey on each worker.</param>
+        ThreadPool(int numberOfThreads, ThreadLocalVariable::Key contextKey, ThreadLocalVariable::ValuePtr contextValue);
+        /// <summary>
+        /// Stops and joins the worker threads.
+        /// </summary>
+        /// <remarks>Any tasks still queued are deleted without being executed.</remarks>
+        ~ThreadPool();
+#pragma endregion
+
+#pragma region // Methods.
+    public:
+        /// <summary>
+        /// Gets the number of threads that participate in executing tasks.
+        /// </summary>
+        inline int GetNumberOfThreads() const { return (int)mWorkers.size(); }
+        /// <summary>
+        /// Queues a task for execution. The pool takes ownership of the task.
+        /// </summary>
+        /// <param name="task">The task to execute.</param>
+        /// <param name="group">The group used to wait for completion of the task.</param>
+        void Submit(Task& task, TaskGroup& group);
+        /// <summary>
+        /// Executes queued tasks until all of the group's tasks have completed.
+        /// </summary>
+        /// <param name="group">The group to wait on.</param>
+        /// <returns>Returns the number of tasks in the group that threw exceptions.</returns>
+        int Wait(TaskGroup& group);
+        /// <summary>
+        /// Gets the number of processors available to the process.
+        /// </summary>
+        static int GetProcessorCount();
+    private:
+        /// <summary>
+        /// Takes a task from the calling worker's deque, or steals one from another deque.
+        /// </summary>
+        /// <param name="self">The index of the calling worker.</param>
+        /// <returns>Returns a task, or NULL if all deques are empty.</returns>
+        Task* TryTake(int self);
+        /// <summary>
+        /// Executes a task and signals its group.
+        /// </summary>
+        static void Run(Task* task);
+        /// <summary>
+        /// Gets the calling thread's worker index, or 0 for non-pool threads.
+        /// </summary>
+        int GetWorkerIndex() const;
+        /// <summary>
+        /// The worker thread main loop.
+        /// </summary>
+        void WorkerLoop(Worker& worker);
+#ifdef WIN32
+        static DWORD WINAPI WorkerStart(LPVOID arg);
+#else
+        static void* WorkerStart(void* arg);
+#endif
+#pragma endregion
+    };
+}
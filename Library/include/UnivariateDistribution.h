@@ -125,5 +125,19 @@ namespace Plato {
         /// Index in {0..(Capacity-1)}.
         /// </summary>
         virtual float operator[](int index);
+
+        /// <summary>
+        /// Fills a buffer with a run of consecutive distribution values.
+        /// </summary>
+        /// <remarks>
+        /// Equivalent to calling the indexer for each index in turn, stopping at the first
+        /// out of range value, but derived classes compute the run in one vectorised pass.
+        /// This default implementation calls the indexer.
+        /// </remarks>
+        /// <param name="first">The index of the first value.</param>
+        /// <param name="count">The number of values wanted.</param>
+        /// <param name="values">The buffer to fill, which must hold count values.</param>
+        /// <returns>Returns the number of values filled, which is less than count at the end of the distribution.</returns>
+        virtual int Fill(int first, int count, float* values);
     };
 }
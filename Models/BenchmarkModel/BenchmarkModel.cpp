@@ -0,0 +1,381 @@
+#include "Plato.h"
+#include "FlatHashMapTest.h"
+#ifdef WIN32
+#include <psapi.h>
+#else // POSIX
+#include <sys/resource.h>
+#endif
+#include "BenchmarkModel.h"
+
+// Spreads consecutive lookups over a table, as path resolution does, but in the same order every run.
+static long BenchmarkScatter(long index, long count) {
+    return (long)(((unsigned long)index * 2654435761ul) % (unsigned long)count);
+}
+
+// Gets the name of the index'th element of a part of the synthetic model.
+static string& BenchmarkName(const char* prefix, long index) {
+    string& name = Numbers::ToString(index);
+    name.insert(0, prefix);
+    return name;
+}
+
+// Writes a JSON member with a number formatted to a fixed precision, so that the output always has the same shape.
+static void BenchmarkWrite(ostream& output, const char* key, double value, const char* format) {
+    string& text = Strings::Format(format, value);
+    output << ",\n  \"" << key << "\": " << text;
+    delete &text;
+}
+
+BenchmarkRegion::BenchmarkRegion(Container* parent, const string& name)
+        : Region(parent, name.c_str(), PropertyScopes::Public) {
+}
+
+BenchmarkModel::BenchmarkModel(char* arguments[])
+        : Model("BenchmarkModel",arguments) {
+    CommandLine* parameters = ModelConfiguration->ModelParameters;
+    Depth = parameters->GetOptionValue("BenchmarkDepth", 5L);
+    Branching = parameters->GetOptionValue("BenchmarkBranching", 4L);
+    Bundles = parameters->GetOptionValue("BenchmarkBundles", 16L);
+    Width = parameters->GetOptionValue("BenchmarkWidth", 256L);
+    Fan = parameters->GetOptionValue("BenchmarkFan", 64L);
+    Lookups = parameters->GetOptionValue("BenchmarkLookups", 1000000L);
+    Epochs = parameters->GetOptionValue("BenchmarkEpochs", 100L);
+    HashKeys = parameters->GetOptionValue("BenchmarkHashKeys", 4096L);
+    Connections = 0;
+
+    Source = new OutputPad(this, *this, *new Identifier("Source"), PropertyScopes::Public);
+    Add(*Source);
+    // Connects the source to the inputs of every part but the fan, whose own connectors are applied by Configure.
+    mSourceConnector = new Connector(*new Path(NULL, *Path::Relative / ".*" / "i"),
+        *new Path(NULL, *Path::Relative / "Source"), ConnectorPatterns::Star);
+    Add(*mSourceConnector);
+
+    TreeRegion = new BenchmarkRegion(this, "Tree");
+    Add(*TreeRegion);
+    vector<string> names;
+    BuildTree(TreeRegion, names, Depth);
+    BundleRegion = new BenchmarkRegion(this, "Bundles");
+    Add(*BundleRegion);
+    BuildBundles();
+    FanRegion = new BenchmarkRegion(this, "Fan");
+    Add(*FanRegion);
+    BuildFan();
+}
+
+BenchmarkModel::~BenchmarkModel() {
+    vector<Path*>::iterator itr;
+    for (itr = LeafPaths.begin(); itr != LeafPaths.end(); ++itr) {
+        delete *itr;
+    }
+    vector<Identifier*>::iterator nitr;
+    for (nitr = PadNames.begin(); nitr != PadNames.end(); ++nitr) {
+        delete *nitr;
+    }
+}
+
+OutputPad* BenchmarkModel::AddDisposition(BenchmarkRegion* region, AnalogueDID* disposition) {
+    region->Add(*(Container*)disposition);
+    OutputPad* output = new OutputPad(disposition, *disposition, *new Identifier("o"), PropertyScopes::Public);
+    disposition->Add(*output);
+    Outputs.push_back(output);
+    return output;
+}
+
+InputPad* BenchmarkModel::AddInput(Container* container, const char* name, OutputPad& from, Connector& connector) {
+    InputPad* input = new InputPad(container, *container, *new Identifier(name), PropertyScopes::Public);
+    container->Add(*input);
+    if (input->Add(from, connector)) {
+        ++Connections;
+    }
+    return input;
+}
+
+void BenchmarkModel::BuildTree(BenchmarkRegion* region, vector<string>& names, long depth) {
+    if (depth <= 0) {
+        OrDID* leaf = new OrDID(region, region, *new Identifier("d"));
+        AddDisposition(region, leaf);
+        AddInput(leaf, "i", *Source, *mSourceConnector);
+        PathNode* node = Path::Relative->GetWritable();
+        vector<string>::iterator itr;
+        for (itr = names.begin(); itr != names.end(); ++itr) {
+            node = &(*node / itr->c_str());
+        }
+        LeafPaths.push_back(new Path(NULL, *node / "d" / "o"));
+        return;
+    }
+    for (long index = 0; index < Branching; ++index) {
+        string& name = BenchmarkName("r", index);
+        BenchmarkRegion* child = new BenchmarkRegion(region, name);
+        region->Add(*child);
+        names.push_back(name);
+        delete &name;
+        BuildTree(child, names, depth - 1);
+        names.pop_back();
+    }
+}
+
+void BenchmarkModel::BuildBundles() {
+    for (long index = 0; index < Width; ++index) {
+        string& name = BenchmarkName("i", index);
+        PadNames.push_back(new Identifier(name));
+    }
+    for (long index = 0; index < Bundles; ++index) {
+        string& name = BenchmarkName("d", index);
+        AndDID* disposition = new AndDID(BundleRegion, BundleRegion, *new Identifier(name));
+        AddDisposition(BundleRegion, disposition);
+        disposition->AddBundle(*new Identifier("b"), true);
+        Container* bundle = (Container*)disposition->Container::GetProperty(Identifier("b"));
+        for (long pad = 0; pad < Width; ++pad) {
+            AndInputPad* input = new AndInputPad(bundle, *bundle, *new Identifier(*PadNames[pad]), PropertyScopes::Public);
+            bundle->Add(*input);
+            if (input->Add(*Source, *mSourceConnector)) {
+                ++Connections;
+            }
+        }
+        WideBundles.push_back(bundle);
+    }
+}
+
+void BenchmarkModel::BuildFan() {
+    BenchmarkRegion* in = new BenchmarkRegion(FanRegion, "In");
+    FanRegion->Add(*in);
+    BenchmarkRegion* out = new BenchmarkRegion(FanRegion, "Out");
+    FanRegion->Add(*out);
+    // Every input "i" of Out takes every output of In, and the input "j" of each takes the first output of In.
+    Connector* fanIn = new Connector(*new Path(NULL, *Path::Relative / "Out" / "d.*" / "i"),
+        *new Path(NULL, *Path::Relative / "In" / "s.*" / "o"), ConnectorPatterns::FanIn);
+    FanRegion->Add(*fanIn);
+    Connector* fanOut = new Connector(*new Path(NULL, *Path::Relative / "Out" / "d.*" / "j"),
+        *new Path(NULL, *Path::Relative / "In" / "s0" / "o"), ConnectorPatterns::FanOut);
+    FanRegion->Add(*fanOut);
+
+    vector<OutputPad*> sources;
+    for (long index = 0; index < Fan; ++index) {
+        string& name = BenchmarkName("s", index);
+        OrDID* disposition = new OrDID(in, in, *new Identifier(name));
+        sources.push_back(AddDisposition(in, disposition));
+        AddInput(disposition, "i", *Source, *mSourceConnector);
+    }
+    // The connectors are applied by Configure, but as Connector groups are not yet bound
+    // the benchmark makes the connections their patterns describe itself.
+    for (long index = 0; index < Fan; ++index) {
+        string& name = BenchmarkName("d", index);
+        AndDID* disposition = new AndDID(out, out, *new Identifier(name));
+        AddDisposition(out, disposition);
+        InputPad* input = AddInput(disposition, "i", *sources[0], *fanIn);
+        for (long from = 1; from < Fan; ++from) {
+            if (input->Add(*sources[from], *fanIn)) {
+                ++Connections;
+            }
+        }
+        AddInput(disposition, "j", *sources[0], *fanOut);
+    }
+}
+
+void BenchmarkModel::SetSource(float value) {
+    ModelSignals->Current[Source->SignalIndex] = value;
+    ModelSignals->Next[Source->SignalIndex] = value;
+}
+
+double BenchmarkModel::MeasureContainerLookups(long& hits) {
+    if (WideBundles.empty() || PadNames.empty()) {
+        hits = 0;
+        return 0.0;
+    }
+    vector<Container*> containers(Lookups);
+    vector<Identifier*> names(Lookups);
+    for (long index = 0; index < Lookups; ++index) {
+        containers[index] = WideBundles[index % (long)WideBundles.size()];
+        names[index] = PadNames[BenchmarkScatter(index, (long)PadNames.size())];
+    }
+    hits = 0;
+    uint64_t start = Profiler::GetNanoseconds();
+    for (long index = 0; index < Lookups; ++index) {
+        if (containers[index]->GetProperty(*names[index]) != NULL) {
+            ++hits;
+        }
+    }
+    uint64_t finish = Profiler::GetNanoseconds();
+    return Lookups > 0 ? (double)(finish - start) / (double)Lookups : 0.0;
+}
+
+double BenchmarkModel::MeasurePathLookups(long& hits) {
+    if (LeafPaths.empty()) {
+        hits = 0;
+        return 0.0;
+    }
+    vector<Path*> paths(Lookups);
+    for (long index = 0; index < Lookups; ++index) {
+        paths[index] = LeafPaths[BenchmarkScatter(index, (long)LeafPaths.size())];
+    }
+    hits = 0;
+    uint64_t start = Profiler::GetNanoseconds();
+    for (long index = 0; index < Lookups; ++index) {
+        if (paths[index]->GetProperty(TreeRegion, NULL, PropertyModes::Traversing) != NULL) {
+            ++hits;
+        }
+    }
+    uint64_t finish = Profiler::GetNanoseconds();
+    return Lookups > 0 ? (double)(finish - start) / (double)Lookups : 0.0;
+}
+
+double BenchmarkModel::MeasureRegexEnumeration(long& matches) {
+    PathNode* leaves = Path::Relative->GetWritable();
+    for (long level = 0; level < Depth; ++level) {
+        leaves = &(*leaves / "r.*");
+    }
+    Path treePath(NULL, *leaves / "d" / "o");
+    Path fanPath(NULL, *Path::Relative / "Out" / "d.*" / "[ij]");
+
+    // Enumerate in whole rounds until at least Lookups properties have been enumerated.
+    matches = 0;
+    long rounds = 0;
+    uint64_t start = Profiler::GetNanoseconds();
+    do {
+        long found = 0;
+        PathEnumerator treeEnumerator(treePath, TreeRegion, NULL, PropertyModes::Traversing, false, NULL);
+        while (treeEnumerator.MoveNext()) {
+            ++found;
+        }
+        PathEnumerator fanEnumerator(fanPath, FanRegion, NULL, PropertyModes::Traversing, false, NULL);
+        while (fanEnumerator.MoveNext()) {
+            ++found;
+        }
+        if (found == 0) {
+            break;
+        }
+        matches += found;
+        ++rounds;
+    } while (matches < Lookups);
+    uint64_t finish = Profiler::GetNanoseconds();
+    // Report the matches of one round, which do not depend on the number of lookups.
+    if (rounds == 0) {
+        return 0.0;
+    }
+    double nanoseconds = (double)(finish - start) / (double)matches;
+    matches /= rounds;
+    return nanoseconds;
+}
+
+double BenchmarkModel::MeasureHashMapLookups(double& flatMapNanoseconds, long& misses) {
+    flatMapNanoseconds = 0.0;
+    if (HashKeys <= 0) {
+        misses = 0;
+        return 0.0;
+    }
+    long rounds = Lookups / HashKeys;
+    string message;
+    double hashMapNanoseconds;
+    misses = FlatHashMapTest::ConductBenchmark(message, (int)HashKeys, rounds > 0 ? (int)rounds : 1,
+        hashMapNanoseconds, flatMapNanoseconds);
+    return hashMapNanoseconds;
+}
+
+double BenchmarkModel::MeasureEpochs(double& checksum) {
+    uint64_t start = Profiler::GetNanoseconds();
+    Run(Epochs);
+    uint64_t finish = Profiler::GetNanoseconds();
+    checksum = 0.0;
+    vector<OutputPad*>::iterator itr;
+    for (itr = Outputs.begin(); itr != Outputs.end(); ++itr) {
+        checksum += (*itr)->GetOutputValue();
+    }
+    return finish > start ? 1e9 * (double)Epochs / (double)(finish - start) : 0.0;
+}
+
+long BenchmarkModel::GetPeakResidentKilobytes() {
+#ifdef WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return (long)(counters.PeakWorkingSetSize / 1024);
+#else // POSIX
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return (long)(usage.ru_maxrss / 1024);
+#else
+    return (long)usage.ru_maxrss;
+#endif
+#endif
+}
+
+int main(int argc, char *argv[ ]) {
+    Debug::Initializer();
+    if(Configuration::CheckForTerminalOption(argv)) return 0;
+    uint64_t start = Profiler::GetNanoseconds();
+    BenchmarkModel* model = new BenchmarkModel(argv);
+    uint64_t built = Profiler::GetNanoseconds();
+    int result = model->Configure();
+    uint64_t configured = Profiler::GetNanoseconds();
+    if (result != 0) {
+        delete model;
+        Debug::Finalizer();
+        return result;
+    }
+    model->SetSource(0.5f);
+
+    long containerHits;
+    double containerNanoseconds = model->MeasureContainerLookups(containerHits);
+    long pathHits;
+    double pathNanoseconds = model->MeasurePathLookups(pathHits);
+    long regexMatches;
+    double regexNanoseconds = model->MeasureRegexEnumeration(regexMatches);
+    long hashMisses;
+    double flatMapNanoseconds;
+    double hashMapNanoseconds = model->MeasureHashMapLookups(flatMapNanoseconds, hashMisses);
+    double checksum;
+    double epochsPerSecond = model->MeasureEpochs(checksum);
+    long peakKilobytes = BenchmarkModel::GetPeakResidentKilobytes();
+
+    string standardOutput;
+    const string& outputPath = model->ModelConfiguration->ModelParameters->GetOptionValue("BenchmarkOutput", standardOutput);
+    ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath.c_str(), ios::out | ios::trunc);
+        if (!file.is_open()) {
+            cerr << "BenchmarkModel: unable to write " << outputPath << "\n";
+            delete model;
+            Debug::Finalizer();
+            return 1;
+        }
+    }
+    ostream& output = outputPath.empty() ? cout : file;
+    output << "{\n  \"benchmark\": \"BenchmarkModel\"";
+    BenchmarkWrite(output, "depth", (double)model->Depth, "%.0f");
+    BenchmarkWrite(output, "branching", (double)model->Branching, "%.0f");
+    BenchmarkWrite(output, "bundles", (double)model->Bundles, "%.0f");
+    BenchmarkWrite(output, "width", (double)model->Width, "%.0f");
+    BenchmarkWrite(output, "fan", (double)model->Fan, "%.0f");
+    BenchmarkWrite(output, "lookups", (double)model->Lookups, "%.0f");
+    BenchmarkWrite(output, "epochs", (double)model->Epochs, "%.0f");
+    BenchmarkWrite(output, "hashKeys", (double)model->HashKeys, "%.0f");
+    BenchmarkWrite(output, "dispositions", (double)model->Outputs.size(), "%.0f");
+    BenchmarkWrite(output, "connections", (double)model->Connections, "%.0f");
+    BenchmarkWrite(output, "buildMilliseconds", (double)(built - start) / 1e6, "%.3f");
+    BenchmarkWrite(output, "configureMilliseconds", (double)(configured - built) / 1e6, "%.3f");
+    BenchmarkWrite(output, "containerGetPropertyNanoseconds", containerNanoseconds, "%.3f");
+    BenchmarkWrite(output, "containerGetPropertyHits", (double)containerHits, "%.0f");
+    BenchmarkWrite(output, "pathGetPropertyNanoseconds", pathNanoseconds, "%.3f");
+    BenchmarkWrite(output, "pathGetPropertyHits", (double)pathHits, "%.0f");
+    BenchmarkWrite(output, "regexEnumerationNanoseconds", regexNanoseconds, "%.3f");
+    BenchmarkWrite(output, "regexEnumerationMatches", (double)regexMatches, "%.0f");
+    BenchmarkWrite(output, "hashMapFindNanoseconds", hashMapNanoseconds, "%.3f");
+    BenchmarkWrite(output, "flatHashMapFindNanoseconds", flatMapNanoseconds, "%.3f");
+    BenchmarkWrite(output, "hashMapMisses", (double)hashMisses, "%.0f");
+    BenchmarkWrite(output, "epochsPerSecond", epochsPerSecond, "%.3f");
+    BenchmarkWrite(output, "outputChecksum", checksum, "%.6f");
+    BenchmarkWrite(output, "peakResidentKilobytes", (double)peakKilobytes, "%.0f");
+    output << "\n}\n";
+    output.flush();
+    if (!outputPath.empty()) {
+        file.close();
+        result = file.fail() ? 1 : 0;
+    }
+    delete model;
+    Debug::Finalizer();
+    return result;
+}
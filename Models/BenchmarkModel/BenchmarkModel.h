@@ -0,0 +1,160 @@
+#pragma once
+/// <summary>
+/// A region the benchmark builds its synthetic models from.
+/// </summary>
+class BenchmarkRegion : public Region {
+public:
+    /// <summary>
+    /// Constructor for a public region.
+    /// </summary>
+    /// <param name="parent">The containing region or model.</param>
+    /// <param name="name">The name of the region.</param>
+    BenchmarkRegion(Container* parent, const string& name);
+};
+
+/// <summary>
+/// Measures the library on synthetic models whose size is set on the command line.
+/// </summary>
+/// <remarks>
+/// <para>
+/// The model holds four synthetic parts, each sized by a command line option:
+/// a Region tree BenchmarkDepth levels deep with BenchmarkBranching sub-regions per level and an OrDID at each leaf;
+/// BenchmarkBundles AndDIDs each with an input Bundle of BenchmarkWidth pads;
+/// two Regions of BenchmarkFan OrDIDs and AndDIDs joined by fan-in and fan-out Connectors;
+/// and regex paths that enumerate the leaves of the tree and of the fan.
+/// </para>
+/// <para>
+/// It measures the Configure wall time, the nanoseconds per Container::GetProperty and per Path::GetProperty
+/// over BenchmarkLookups lookups, the nanoseconds per property enumerated by a regex path,
+/// the epochs per second over BenchmarkEpochs epochs, and the peak resident set size.
+/// It also runs FlatHashMapTest::ConductBenchmark, timing about BenchmarkLookups lookups among
+/// BenchmarkHashKeys identifiers in a FlatHashMap and in the hash_map it replaced.
+/// The results are written in JSON to BenchmarkOutput, or to standard output if it is not set,
+/// with the keys always in the same order so that the results of two builds can be diffed.
+/// </para>
+/// </remarks>
+class BenchmarkModel : public Model {
+public:
+    long Depth;
+    long Branching;
+    long Bundles;
+    long Width;
+    long Fan;
+    long Lookups;
+    long Epochs;
+    long HashKeys;
+    /// <summary>
+    /// The pad driving every input of the synthetic model.
+    /// </summary>
+    OutputPad* Source;
+    /// <summary>
+    /// The regions holding each part of the synthetic model.
+    /// </summary>
+    BenchmarkRegion* TreeRegion;
+    BenchmarkRegion* BundleRegion;
+    BenchmarkRegion* FanRegion;
+    /// <summary>
+    /// The paths, relative to TreeRegion, of the output pads at the leaves of the tree.
+    /// </summary>
+    vector<Path*> LeafPaths;
+    /// <summary>
+    /// The bundles of BundleRegion, and the names of the pads of one.
+    /// </summary>
+    vector<Container*> WideBundles;
+    vector<Identifier*> PadNames;
+    /// <summary>
+    /// The output pads of every disposition, whose values are summed to check the epochs.
+    /// </summary>
+    vector<OutputPad*> Outputs;
+    /// <summary>
+    /// The number of input connections made.
+    /// </summary>
+    long Connections;
+
+    /// <summary>
+    /// Constructor for new model instances, which builds the synthetic model.
+    /// </summary>
+    /// <param name="arguments">The command line arguments.</param>
+    BenchmarkModel(char* arguments[]);
+    ~BenchmarkModel();
+
+    /// <summary>
+    /// Sets the value of the source pad, after the model is configured.
+    /// </summary>
+    void SetSource(float value);
+
+    /// <summary>
+    /// Looks up the pads of the wide bundles by name.
+    /// </summary>
+    /// <param name="hits">Out parameter for the number of pads found.</param>
+    /// <returns>Returns the nanoseconds per lookup.</returns>
+    double MeasureContainerLookups(long& hits);
+
+    /// <summary>
+    /// Looks up the leaves of the tree by path.
+    /// </summary>
+    /// <param name="hits">Out parameter for the number of pads found.</param>
+    /// <returns>Returns the nanoseconds per lookup.</returns>
+    double MeasurePathLookups(long& hits);
+
+    /// <summary>
+    /// Enumerates the leaves of the tree and of the fan with regex paths.
+    /// </summary>
+    /// <param name="matches">Out parameter for the number of properties enumerated.</param>
+    /// <returns>Returns the nanoseconds per property enumerated.</returns>
+    double MeasureRegexEnumeration(long& matches);
+
+    /// <summary>
+    /// Looks up identifiers in a hash_map and in a FlatHashMap.
+    /// </summary>
+    /// <param name="flatMapNanoseconds">Out parameter for the nanoseconds per FlatHashMap lookup.</param>
+    /// <param name="misses">Out parameter for the number of keys not found, which should be zero.</param>
+    /// <returns>Returns the nanoseconds per hash_map lookup.</returns>
+    double MeasureHashMapLookups(double& flatMapNanoseconds, long& misses);
+
+    /// <summary>
+    /// Runs the epochs.
+    /// </summary>
+    /// <param name="checksum">Out parameter for the sum of the output values after the last epoch.</param>
+    /// <returns>Returns the epochs per second.</returns>
+    double MeasureEpochs(double& checksum);
+
+    /// <summary>
+    /// Gets the peak resident set size of the process in kilobytes.
+    /// </summary>
+    static long GetPeakResidentKilobytes();
+
+private:
+    /// <summary>
+    /// Builds a level of the tree under a region.
+    /// </summary>
+    /// <param name="region">The region to build under.</param>
+    /// <param name="names">The names of the regions from TreeRegion down to the region.</param>
+    /// <param name="depth">The number of levels still to build.</param>
+    void BuildTree(BenchmarkRegion* region, vector<string>& names, long depth);
+    void BuildBundles();
+    void BuildFan();
+    /// <summary>
+    /// Adds a disposition to a region, with an output pad named "o".
+    /// </summary>
+    /// <returns>Returns the output pad.</returns>
+    OutputPad* AddDisposition(BenchmarkRegion* region, AnalogueDID* disposition);
+    /// <summary>
+    /// Adds an input pad to a container, connected to an output pad.
+    /// </summary>
+    /// <returns>Returns the input pad.</returns>
+    InputPad* AddInput(Container* container, const char* name, OutputPad& from, Connector& connector);
+
+    /// <summary>
+    /// The connector recorded against the connections from the source pad.
+    /// </summary>
+    Connector* mSourceConnector;
+};
+
+/// <summary>
+/// Standard entry point.
+/// </summary>
+/// <param name="argc">Number of args</param>
+/// <param name="argv">Normal command-line options for application and plato library.</param>
+/// <returns>Returns zero on success.</returns>
+int main(int argc, char* argv[]);